@@ -0,0 +1,52 @@
+﻿
+/// @file AigBuilder.cc
+/// @brief AigBuilder の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "AigBuilder.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+// クラス AigBuilder
+//////////////////////////////////////////////////////////////////////
+
+// @brief AND ゲートを作る．
+BnNodeHandle
+AigBuilder::_make_and(
+  BnNodeHandle a,
+  BnNodeHandle b
+)
+{
+  auto lit0{literal(a)};
+  auto lit1{literal(b)};
+  if ( lit0 < lit1 ) {
+    std::swap(lit0, lit1);
+  }
+  Key key{lit0, lit1};
+  auto p{mHash.find(key)};
+  if ( p != mHash.end() ) {
+    return BnNodeHandle{p->second};
+  }
+  SizeType var{mFirstVar + mAndList.size()};
+  mAndList.push_back(AndNode{lit0, lit1});
+  mHash.emplace(key, var);
+  return BnNodeHandle{var};
+}
+
+// @brief XOR ゲートを作る．
+BnNodeHandle
+AigBuilder::_make_xor(
+  BnNodeHandle a,
+  BnNodeHandle b
+)
+{
+  // a ^ b = ~(~(a & ~b) & ~(~a & b))
+  return make_or(make_and(a, ~b), make_and(~a, b));
+}
+
+END_NAMESPACE_YM_MVN
@@ -0,0 +1,164 @@
+﻿#ifndef AIGBUILDER_H
+#define AIGBUILDER_H
+
+/// @file AigBuilder.h
+/// @brief AigBuilder のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "BitBuilder.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+/// @class AigBuilder AigBuilder.h "AigBuilder.h"
+/// @brief AIG (and-inverter graph) を作る BitBuilder
+///
+/// BnNodeHandle のノード番号をそのまま AIGER の変数番号として用いる．
+/// AND ノードには first_var から順に番号を振るので，
+/// 入力とラッチの変数は first_var 未満でなければならない．
+/// XOR は3つの AND で表す．
+/// 同じ入力を持つ AND ノードは一つしか作らない(構造ハッシュ)．
+//////////////////////////////////////////////////////////////////////
+class AigBuilder :
+  public BitBuilder
+{
+public:
+
+  /// @brief AND ノードの入力のリテラルの組
+  ///
+  /// AIGER の規約に従って mLit0 >= mLit1 となっている．
+  struct AndNode
+  {
+    SizeType mLit0;
+    SizeType mLit1;
+  };
+
+
+public:
+
+  /// @brief コンストラクタ
+  AigBuilder(
+    SizeType first_var ///< [in] 最初の AND ノードの変数番号
+  ) : mFirstVar{first_var}
+  {
+  }
+
+  /// @brief デストラクタ
+  ~AigBuilder() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ハンドルに対応する AIGER のリテラルを返す．
+  static
+  SizeType
+  literal(
+    BnNodeHandle handle ///< [in] ハンドル
+  )
+  {
+    ASSERT_COND( handle.is_valid() );
+    if ( handle.is_zero() ) {
+      return 0;
+    }
+    if ( handle.is_one() ) {
+      return 1;
+    }
+    return handle.id() * 2 + static_cast<SizeType>(handle.inv());
+  }
+
+  /// @brief 最初の AND ノードの変数番号を返す．
+  SizeType
+  first_var() const
+  {
+    return mFirstVar;
+  }
+
+  /// @brief AND ノードのリストを返す．
+  ///
+  /// i 番目の要素の変数番号は first_var() + i となる．
+  const vector<AndNode>&
+  and_list() const
+  {
+    return mAndList;
+  }
+
+
+protected:
+  //////////////////////////////////////////////////////////////////////
+  // BitBuilder の仮想関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief AND ゲートを作る．
+  BnNodeHandle
+  _make_and(
+    BnNodeHandle a,
+    BnNodeHandle b
+  ) override;
+
+  /// @brief XOR ゲートを作る．
+  BnNodeHandle
+  _make_xor(
+    BnNodeHandle a,
+    BnNodeHandle b
+  ) override;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // 構造ハッシュのキー
+  struct Key
+  {
+    SizeType mLit0;
+    SizeType mLit1;
+
+    bool
+    operator==(
+      const Key& right
+    ) const
+    {
+      return mLit0 == right.mLit0 && mLit1 == right.mLit1;
+    }
+  };
+
+  // Key のハッシュ関数
+  struct KeyHash
+  {
+    SizeType
+    operator()(
+      const Key& key
+    ) const
+    {
+      return key.mLit0 * 1048573 + key.mLit1;
+    }
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 最初の AND ノードの変数番号
+  SizeType mFirstVar;
+
+  // AND ノードのリスト
+  vector<AndNode> mAndList;
+
+  // 構造ハッシュ
+  unordered_map<Key, SizeType, KeyHash> mHash;
+
+};
+
+END_NAMESPACE_YM_MVN
+
+#endif // AIGBUILDER_H
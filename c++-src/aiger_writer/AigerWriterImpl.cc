@@ -0,0 +1,314 @@
+﻿
+/// @file AigerWriterImpl.cc
+/// @brief AigerWriterImpl の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "AigerWriterImpl.h"
+#include "AigBuilder.h"
+#include "MvnLevelizer.h"
+#include "ym/MvnBnMap.h"
+#include "ym/MvnMgr.h"
+#include "ym/MvnModule.h"
+#include "ym/MvnNode.h"
+#include "ym/MvnPort.h"
+#include "ym/MvnInputPin.h"
+#include "ym/MvnBvConst.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+BEGIN_NONAMESPACE
+
+// 入出力ノードの名前を求める．
+//
+// そのノードだけを単純に参照している名前付きのポートがあれば
+// その名前を用いる．
+string
+node_name(
+  const MvnModule* module,
+  const MvnNode* node
+)
+{
+  SizeType np{module->port_num()};
+  for ( SizeType i = 0; i < np; ++ i ) {
+    auto port{module->port(i)};
+    if ( port->port_ref_num() == 1 ) {
+      auto& port_ref{port->port_ref(0)};
+      if ( port_ref.node() == node &&
+	   port_ref.is_simple() &&
+	   port->name() != string() ) {
+	return port->name();
+      }
+    }
+  }
+  ostringstream buf;
+  buf << "node" << node->id();
+  return buf.str();
+}
+
+// シンボル名を作る．
+string
+bit_name(
+  const string& name,
+  SizeType bw,
+  SizeType b
+)
+{
+  if ( bw == 1 ) {
+    return name;
+  }
+  ostringstream buf;
+  buf << name << "[" << b << "]";
+  return buf.str();
+}
+
+// ファンインのビットを得る．
+//
+// 接続されていない場合は定数0となる．
+BnNodeHandle
+input_bit(
+  const MvnNode* node,
+  SizeType pos,
+  SizeType b,
+  const MvnBnMap& nodemap
+)
+{
+  auto src{node->input(pos)->src_node()};
+  if ( src == nullptr || b >= src->bit_width() ) {
+    return BnNodeHandle::zero();
+  }
+  return nodemap.get(src, b);
+}
+
+// ラッチを割り当てたノードの情報
+struct LatchInfo
+{
+  // 元のノード(DFF か LATCH)
+  const MvnNode* mNode;
+
+  // 最下位ビットのラッチの変数番号
+  SizeType mVar;
+
+};
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス AigerWriterImpl
+//////////////////////////////////////////////////////////////////////
+
+// @brief 内容を出力する．
+void
+AigerWriterImpl::write(
+  ostream& s,
+  const MvnMgr& mgr
+)
+{
+  MvnBnMap nodemap{mgr};
+
+  vector<const MvnModule*> module_list;
+  vector<MvnLevelizer> lv_list;
+  for ( auto module: mgr.topmodule_list() ) {
+    module_list.push_back(module);
+    lv_list.push_back(MvnLevelizer{mgr, module});
+  }
+  SizeType nm{module_list.size()};
+
+  // AIGER の変数番号は入力，ラッチ，AND の順に振らなければならない．
+  SizeType var{1};
+  vector<string> input_names;
+  for ( SizeType i = 0; i < nm; ++ i ) {
+    auto module{module_list[i]};
+    vector<const MvnNode*> input_list;
+    for ( SizeType j = 0; j < module->input_num(); ++ j ) {
+      input_list.push_back(module->input(j));
+    }
+    for ( SizeType j = 0; j < module->inout_num(); ++ j ) {
+      auto node{module->inout(j)};
+      if ( MvnLevelizer::is_source(node) ) {
+	input_list.push_back(node);
+      }
+    }
+    for ( auto node: input_list ) {
+      auto name{node_name(module, node)};
+      SizeType bw{node->bit_width()};
+      for ( SizeType b = 0; b < bw; ++ b ) {
+	nodemap.put(node, b, BnNodeHandle{var});
+	++ var;
+	input_names.push_back(bit_name(name, bw, b));
+      }
+    }
+  }
+  SizeType ni{var - 1};
+
+  vector<LatchInfo> latch_list;
+  for ( auto& lv: lv_list ) {
+    for ( auto node: lv.node_list() ) {
+      auto type{node->type()};
+      if ( type != MvnNodeType::DFF && type != MvnNodeType::LATCH ) {
+	continue;
+      }
+      latch_list.push_back(LatchInfo{node, var});
+      SizeType bw{node->bit_width()};
+      if ( type == MvnNodeType::DFF ) {
+	for ( SizeType b = 0; b < bw; ++ b ) {
+	  nodemap.put(node, b, BnNodeHandle{var + b});
+	}
+      }
+      var += bw;
+    }
+  }
+  SizeType nl{var - 1 - ni};
+
+  // 組み合わせ回路部分をレベル順に展開する．
+  AigBuilder builder{var};
+  unordered_map<SizeType, SizeType> latch_map;
+  for ( auto& info: latch_list ) {
+    latch_map.emplace(info.mNode->id(), info.mVar);
+  }
+  vector<SizeType> output_lits;
+  vector<string> output_names;
+  for ( SizeType i = 0; i < nm; ++ i ) {
+    auto module{module_list[i]};
+    for ( auto node: lv_list[i].node_list() ) {
+      auto type{node->type()};
+      if ( MvnLevelizer::is_source(node) && type != MvnNodeType::CONSTVALUE ) {
+	continue;
+      }
+      if ( type == MvnNodeType::LATCH ) {
+	// イネーブルが 1 の時はデータ入力を，0 の時は保持している値を出す．
+	SizeType var0{latch_map.at(node->id())};
+	auto enable{input_bit(node, 1, 0, nodemap)};
+	for ( SizeType b = 0; b < node->bit_width(); ++ b ) {
+	  auto data{input_bit(node, 0, b, nodemap)};
+	  auto q{BnNodeHandle{var0 + b}};
+	  nodemap.put(node, b, builder.make_mux(enable, data, q));
+	}
+	continue;
+      }
+      if ( !mBnConv.conv_node(node, builder, nodemap) ) {
+	// 変換できないノードがあるので何も出力しない．
+	s.setstate(std::ios::failbit);
+	return;
+      }
+    }
+
+    vector<const MvnNode*> output_list;
+    for ( SizeType j = 0; j < module->output_num(); ++ j ) {
+      output_list.push_back(module->output(j));
+    }
+    for ( SizeType j = 0; j < module->inout_num(); ++ j ) {
+      auto node{module->inout(j)};
+      if ( !MvnLevelizer::is_source(node) ) {
+	output_list.push_back(node);
+      }
+    }
+    for ( auto node: output_list ) {
+      auto name{node_name(module, node)};
+      SizeType bw{node->bit_width()};
+      for ( SizeType b = 0; b < bw; ++ b ) {
+	output_lits.push_back(AigBuilder::literal(nodemap.get(node, b)));
+	output_names.push_back(bit_name(name, bw, b));
+      }
+    }
+  }
+
+  // ラッチの次状態を作る．
+  vector<SizeType> next_lits;
+  vector<string> latch_names;
+  next_lits.reserve(nl);
+  for ( auto& info: latch_list ) {
+    auto node{info.mNode};
+    SizeType bw{node->bit_width()};
+    ostringstream buf;
+    buf << "node" << node->id();
+    auto name{buf.str()};
+    if ( node->type() == MvnNodeType::LATCH ) {
+      for ( SizeType b = 0; b < bw; ++ b ) {
+	next_lits.push_back(AigBuilder::literal(nodemap.get(node, b)));
+	latch_names.push_back(bit_name(name, bw, b));
+      }
+      continue;
+    }
+    // 非同期制御信号は同期化する．
+    // 番号の若い制御信号ほど外側のマルチプレクサになる．
+    SizeType nc{node->input_num() - 2};
+    vector<BnNodeHandle> ctrl_list(nc);
+    for ( SizeType i = 0; i < nc; ++ i ) {
+      auto ctrl{input_bit(node, i + 2, 0, nodemap)};
+      if ( node->control_pol(i) == MvnPolarity::Negative ) {
+	ctrl = ~ctrl;
+      }
+      ctrl_list[i] = ctrl;
+    }
+    for ( SizeType b = 0; b < bw; ++ b ) {
+      auto next{input_bit(node, 0, b, nodemap)};
+      for ( SizeType i = nc; i > 0; -- i ) {
+	auto val{node->control_val(i - 1)->const_value()};
+	auto v{b < val.size() && val[b] ?
+	       BnNodeHandle::one() : BnNodeHandle::zero()};
+	next = builder.make_mux(ctrl_list[i - 1], v, next);
+      }
+      next_lits.push_back(AigBuilder::literal(next));
+      latch_names.push_back(bit_name(name, bw, b));
+    }
+  }
+
+  // ヘッダ
+  auto& and_list{builder.and_list()};
+  SizeType na{and_list.size()};
+  SizeType no{output_lits.size()};
+  s << "aig " << (ni + nl + na)
+    << " " << ni
+    << " " << nl
+    << " " << no
+    << " " << na << "\n";
+
+  // ラッチと出力はアスキー形式
+  for ( auto lit: next_lits ) {
+    s << lit << "\n";
+  }
+  for ( auto lit: output_lits ) {
+    s << lit << "\n";
+  }
+
+  // AND ノードは差分を可変長符号で出力する．
+  SizeType lhs{builder.first_var() * 2};
+  for ( auto& node: and_list ) {
+    write_delta(s, lhs - node.mLit0);
+    write_delta(s, node.mLit0 - node.mLit1);
+    lhs += 2;
+  }
+
+  // シンボルテーブル
+  for ( SizeType i = 0; i < ni; ++ i ) {
+    s << "i" << i << " " << input_names[i] << "\n";
+  }
+  for ( SizeType i = 0; i < nl; ++ i ) {
+    s << "l" << i << " " << latch_names[i] << "\n";
+  }
+  for ( SizeType i = 0; i < no; ++ i ) {
+    s << "o" << i << " " << output_names[i] << "\n";
+  }
+  s.flush();
+}
+
+// @brief 符号なし整数を 7 ビットずつの可変長符号で出力する．
+void
+AigerWriterImpl::write_delta(
+  ostream& s,
+  SizeType n
+)
+{
+  while ( n & ~0x7FUL ) {
+    s.put(static_cast<char>((n & 0x7F) | 0x80));
+    n >>= 7;
+  }
+  s.put(static_cast<char>(n));
+}
+
+END_NAMESPACE_YM_MVN
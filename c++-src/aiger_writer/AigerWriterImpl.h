@@ -0,0 +1,79 @@
+﻿#ifndef AIGERWRITERIMPL_H
+#define AIGERWRITERIMPL_H
+
+/// @file AigerWriterImpl.h
+/// @brief AigerWriterImpl のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/mvn.h"
+#include "ym/MvnBnConv.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+/// @class AigerWriterImpl AigerWriterImpl.h
+/// @brief MvnAigerWriter の実際の処理を行うクラス
+///
+/// ノードの展開には MvnBnConv の変換器をそのまま用いる．
+//////////////////////////////////////////////////////////////////////
+class AigerWriterImpl
+{
+public:
+
+  /// @brief コンストラクタ
+  AigerWriterImpl() = default;
+
+  /// @brief デストラクタ
+  ~AigerWriterImpl() = default;
+
+
+public:
+
+  /// @brief 算術演算を展開する際の構成を設定する．
+  void
+  set_arith_arch(
+    const MvnArithArch& arch ///< [in] 構成
+  )
+  {
+    mBnConv.set_arith_arch(arch);
+  }
+
+  /// @brief 内容を出力する．
+  void
+  write(
+    ostream& s,       ///< [in] 出力先のストリーム
+    const MvnMgr& mgr ///< [in] MvnMgr
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で使われる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 符号なし整数を 7 ビットずつの可変長符号で出力する．
+  static
+  void
+  write_delta(
+    ostream& s,
+    SizeType n
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // ノードの変換器
+  MvnBnConv mBnConv;
+
+};
+
+END_NAMESPACE_YM_MVN
+
+#endif // AIGERWRITERIMPL_H
@@ -0,0 +1,51 @@
+﻿
+/// @file MvnAigerWriter.cc
+/// @brief MvnAigerWriter の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/MvnAigerWriter.h"
+#include "AigerWriterImpl.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+// クラス MvnAigerWriter
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+MvnAigerWriter::MvnAigerWriter(
+) : mImpl{unique_ptr<AigerWriterImpl>{new AigerWriterImpl()}}
+{
+}
+
+// @brief デストラクタ
+MvnAigerWriter::~MvnAigerWriter()
+{
+  // AigerWriterImpl.h を必要とするため
+  // ヘッダ中で = default 宣言はできない．
+}
+
+// @brief 算術演算を展開する際の構成を設定する．
+void
+MvnAigerWriter::set_arith_arch(
+  const MvnArithArch& arch
+)
+{
+  mImpl->set_arith_arch(arch);
+}
+
+// @brief 内容を AIGER 形式で出力する
+void
+MvnAigerWriter::operator()(
+  ostream& s,
+  const MvnMgr& mgr
+)
+{
+  mImpl->write(s, mgr);
+}
+
+END_NAMESPACE_YM_MVN
@@ -0,0 +1,134 @@
+﻿#ifndef BINFORMAT_H
+#define BINFORMAT_H
+
+/// @file BinFormat.h
+/// @brief Mvn のバイナリ形式の定義
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/mvn.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+// Mvn のバイナリ形式
+//
+// ファイルは以下のセクションからなる．
+// 各セクションの先頭は 8 バイト境界に揃えられており，
+// 位置はヘッダにファイル先頭からのバイト数で記録される．
+//
+// - ヘッダ        (BinHeader)
+// - モジュール表  (BinModule x mModuleNum)
+// - ノード表      (BinNode x mNodeNum)
+// - ワード領域    (std::uint64_t x mWordNum)
+// - 名前表        (std::uint64_t x 2 x mNodeNum, 省略可)
+// - 名前索引      (std::uint64_t x mIndexNum, 省略可)
+// - 文字領域      (char x mCharNum)
+//
+// モジュールとノードは詰めた通し番号(インデックス)で参照する．
+// モジュールは ID 番号順，ノードは読み込み時に生成される順
+// (各モジュールの入出力ノード，DFF 以外のノード，DFF の順で，それぞれの中は ID 番号順)
+// に並べるので，読み込んだ結果を書き出すと元と同じ内容になる．
+// 可変長の情報はワード領域に置き，各レコードからはワード位置で参照する．
+// 文字列は文字領域中の位置と長さの組で表す．
+// 名前表は MvnVlMap の内容をノードごとに (位置, 長さ) で記録したもので，
+// 長さが 0 のノードは名前を持たない．
+// 名前索引は名前を持つノードのインデックスを名前の辞書順に並べたもので，
+// 名前からノードを二分探索で求めるために用いる．
+//
+// ノードのレコードは固定長で，入力元のインデックスはワード領域中の
+// 決まった位置にあるので，任意のノードから必要な部分だけを
+// たどることができる．
+//
+// モジュールのワード領域の内容
+// - 入力ノードのインデックス x mInputNum
+// - 出力ノードのインデックス x mOutputNum
+// - 入出力ノードのインデックス x mInoutNum
+// - ポートごとに 名前の位置，名前の長さ，ポート参照式の数，
+//   ポート参照式ごとに ノードのインデックス，種類，msb(bitpos)，lsb
+//
+// ノードのワード領域の内容
+// - 入力ピンのビット幅 x mInputNum
+// - 入力元のノードのインデックス + 1 x mInputNum (0 は未接続)
+// - 型ごとの属性
+//   - DFF:             クロックの極性，
+//                      制御信号ごとに 極性，値を表すノードのインデックス
+//   - CASEEQ:          Xマスク(定数形式)
+//   - CONSTVALUE:      値(定数形式)
+//   - CONSTBITSELECT:  ビット位置
+//   - CONSTPARTSELECT: msb，lsb
+//   - CELL:            セル名の位置，長さ
+//
+// 定数形式はビット幅に続いて 64 ビットごとに詰めた値を置いたもの．
+//////////////////////////////////////////////////////////////////////
+
+/// @brief マジックナンバー
+static const char BIN_MAGIC[8]{'Y', 'M', 'M', 'V', 'N', 'B', 'I', 'N'};
+
+/// @brief 形式のバージョン
+static const std::uint32_t BIN_VERSION{2};
+
+/// @brief エンディアンの確認用の値
+static const std::uint32_t BIN_ENDIAN{0x01020304};
+
+/// @brief ポート参照式の種類
+static const std::uint64_t BIN_PORTREF_SIMPLE{0};
+static const std::uint64_t BIN_PORTREF_BITSELECT{1};
+static const std::uint64_t BIN_PORTREF_PARTSELECT{2};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @brief ヘッダ
+//////////////////////////////////////////////////////////////////////
+struct BinHeader
+{
+  char mMagic[8];
+  std::uint32_t mVersion;
+  std::uint32_t mEndian;
+  std::uint64_t mModuleNum;
+  std::uint64_t mNodeNum;
+  std::uint64_t mWordNum;
+  std::uint64_t mCharNum;
+  std::uint64_t mModuleOffset;
+  std::uint64_t mNodeOffset;
+  std::uint64_t mWordOffset;
+  std::uint64_t mNameOffset;  // 名前表を持たない場合は 0
+  std::uint64_t mIndexNum;
+  std::uint64_t mIndexOffset; // 名前索引を持たない場合は 0
+  std::uint64_t mCharOffset;
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @brief モジュールのレコード
+//////////////////////////////////////////////////////////////////////
+struct BinModule
+{
+  std::uint64_t mName;      // 名前の文字領域中の位置
+  std::uint64_t mNameLen;   // 名前の長さ
+  std::uint64_t mPortNum;
+  std::uint64_t mInputNum;
+  std::uint64_t mOutputNum;
+  std::uint64_t mInoutNum;
+  std::uint64_t mData;      // ワード領域中の位置
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @brief ノードのレコード
+//////////////////////////////////////////////////////////////////////
+struct BinNode
+{
+  std::uint32_t mType;      // MvnNodeType
+  std::uint32_t mModule;    // モジュールのインデックス
+  std::uint64_t mBitWidth;
+  std::uint64_t mInputNum;
+  std::uint64_t mData;      // ワード領域中の位置
+};
+
+END_NAMESPACE_YM_MVN
+
+#endif // BINFORMAT_H
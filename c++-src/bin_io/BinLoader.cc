@@ -0,0 +1,1045 @@
+﻿
+/// @file BinLoader.cc
+/// @brief BinLoader の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "BinLoader.h"
+#include "ym/MvnMgr.h"
+#include "ym/MvnModule.h"
+#include "ym/MvnPort.h"
+#include "ym/MvnNode.h"
+#include "ym/MvnInputPin.h"
+#include "ym/MvnBvConst.h"
+#include "ym/MvnVlMap.h"
+#include "ym/ClibCellLibrary.h"
+#include "ym/ClibCell.h"
+#include <algorithm>
+#include <unordered_map>
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+BEGIN_NONAMESPACE
+
+// セクションがファイルに収まっているか調べる．
+bool
+check_section(
+  SizeType file_size,
+  std::uint64_t offset,
+  std::uint64_t num,
+  SizeType unit
+)
+{
+  if ( offset % 8 != 0 || offset > file_size ) {
+    return false;
+  }
+  return num <= (file_size - offset) / unit;
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス BinLoader
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+BinLoader::BinLoader(
+  const string& filename
+) : mFilename{filename},
+    mFile{filename}
+{
+  if ( !mFile.is_valid() ) {
+    error("cannot open file");
+    return;
+  }
+  SizeType size{mFile.size()};
+  if ( size < sizeof(BinHeader) ) {
+    error("file too short");
+    return;
+  }
+  auto header{reinterpret_cast<const BinHeader*>(mFile.data())};
+  for ( SizeType i = 0; i < 8; ++ i ) {
+    if ( header->mMagic[i] != BIN_MAGIC[i] ) {
+      error("not a mvn binary file");
+      return;
+    }
+  }
+  if ( header->mEndian != BIN_ENDIAN ) {
+    error("endian mismatch");
+    return;
+  }
+  if ( header->mVersion != BIN_VERSION ) {
+    error("unsupported version");
+    return;
+  }
+  if ( !check_section(size, header->mModuleOffset,
+		      header->mModuleNum, sizeof(BinModule)) ||
+       !check_section(size, header->mNodeOffset,
+		      header->mNodeNum, sizeof(BinNode)) ||
+       !check_section(size, header->mWordOffset,
+		      header->mWordNum, sizeof(std::uint64_t)) ||
+       !check_section(size, header->mCharOffset,
+		      header->mCharNum, sizeof(char)) ) {
+    error("broken section table");
+    return;
+  }
+  if ( header->mNameOffset != 0 ) {
+    if ( header->mNodeNum > (size / sizeof(std::uint64_t)) / 2 ||
+	 !check_section(size, header->mNameOffset,
+			header->mNodeNum * 2, sizeof(std::uint64_t)) ) {
+      error("broken section table");
+      return;
+    }
+    mNames = reinterpret_cast<const std::uint64_t*>(mFile.data() + header->mNameOffset);
+  }
+  if ( header->mIndexOffset != 0 ) {
+    if ( mNames == nullptr ||
+	 header->mIndexNum > header->mNodeNum ||
+	 !check_section(size, header->mIndexOffset,
+			header->mIndexNum, sizeof(std::uint64_t)) ) {
+      error("broken section table");
+      return;
+    }
+    mIndex = reinterpret_cast<const std::uint64_t*>(mFile.data() + header->mIndexOffset);
+  }
+
+  mModuleRecs = reinterpret_cast<const BinModule*>(mFile.data() + header->mModuleOffset);
+  mNodeRecs = reinterpret_cast<const BinNode*>(mFile.data() + header->mNodeOffset);
+  mWords = reinterpret_cast<const std::uint64_t*>(mFile.data() + header->mWordOffset);
+  mChars = mFile.data() + header->mCharOffset;
+  mHeader = header;
+}
+
+// @brief ファイル中のネットワークを全て構築する．
+bool
+BinLoader::load(
+  MvnMgr& mgr,
+  MvnVlMap* node_map
+)
+{
+  ASSERT_COND( is_valid() );
+
+  SizeType nm{mHeader->mModuleNum};
+  SizeType nn{mHeader->mNodeNum};
+  mModuleArray.clear();
+  mModuleArray.resize(nm, nullptr);
+  mNodeArray.clear();
+  mNodeArray.resize(nn, nullptr);
+
+  for ( SizeType i = 0; i < nm; ++ i ) {
+    if ( !new_module(mgr, i) ) {
+      return false;
+    }
+  }
+
+  // DFF は制御信号の値を表す定数ノードを必要とするので後回しにする．
+  for ( SizeType i = 0; i < nn; ++ i ) {
+    auto type{static_cast<MvnNodeType>(node_rec(i).mType)};
+    if ( type != MvnNodeType::DFF && mNodeArray[i] == nullptr ) {
+      if ( !new_node(mgr, i) ) {
+	return false;
+      }
+    }
+  }
+  for ( SizeType i = 0; i < nn; ++ i ) {
+    if ( mNodeArray[i] == nullptr ) {
+      if ( !new_node(mgr, i) ) {
+	return false;
+      }
+    }
+  }
+
+  for ( SizeType i = 0; i < nn; ++ i ) {
+    if ( !connect(mgr, i) ) {
+      return false;
+    }
+  }
+
+  for ( SizeType i = 0; i < nm; ++ i ) {
+    if ( !init_port(mgr, i) ) {
+      return false;
+    }
+  }
+
+  if ( node_map != nullptr && mNames != nullptr ) {
+    for ( SizeType i = 0; i < nn; ++ i ) {
+      SizeType len{mNames[i * 2 + 1]};
+      if ( len > 0 ) {
+	auto name{get_string(mNames[i * 2 + 0], len)};
+	node_map->reg_node(mNodeArray[i]->id(), name);
+      }
+    }
+    if ( mRangeError ) {
+      return error("broken name table");
+    }
+  }
+
+  return true;
+}
+
+// @brief 指定されたノードの推移的ファンインのみを構築する．
+bool
+BinLoader::load_cone(
+  MvnMgr& mgr,
+  MvnVlMap* node_map,
+  const vector<SizeType>& root_list
+)
+{
+  ASSERT_COND( is_valid() );
+
+  SizeType nm{mHeader->mModuleNum};
+  SizeType nn{mHeader->mNodeNum};
+  mModuleArray.clear();
+  mModuleArray.resize(nm, nullptr);
+  mNodeArray.clear();
+  mNodeArray.resize(nn, nullptr);
+  mExtraList.clear();
+
+  // 根から入力元をたどってコーンに含まれるノードに印をつける．
+  // 固定長のレコードとワード領域を直接参照するので
+  // コーンに含まれないノードのレコードは読まない．
+  vector<bool> mark(nn, false);
+  vector<SizeType> node_list;
+  for ( auto index: root_list ) {
+    ASSERT_COND( index < nn );
+    if ( !mark[index] ) {
+      mark[index] = true;
+      node_list.push_back(index);
+    }
+  }
+  for ( SizeType rpos = 0; rpos < node_list.size(); ++ rpos ) {
+    auto& rec{node_rec(node_list[rpos])};
+    if ( rec.mModule >= nm ||
+	 rec.mInputNum > mHeader->mWordNum ) {
+      return error("broken node record");
+    }
+    SizeType ni{rec.mInputNum};
+    for ( SizeType i = 0; i < ni; ++ i ) {
+      SizeType src{word(rec.mData + ni + i)};
+      if ( mRangeError || src > nn ) {
+	return error("broken node record");
+      }
+      if ( src > 0 && !mark[src - 1] ) {
+	mark[src - 1] = true;
+	node_list.push_back(src - 1);
+      }
+    }
+    if ( static_cast<MvnNodeType>(rec.mType) == MvnNodeType::DFF ) {
+      // 非同期セットの値を表す定数ノードも必要
+      SizeType attr{rec.mData + ni * 2};
+      for ( SizeType i = 0; i + 2 < ni; ++ i ) {
+	SizeType val{word(attr + 2 + i * 2)};
+	if ( mRangeError || val >= nn ) {
+	  return error("broken DFF record");
+	}
+	if ( !mark[val] ) {
+	  mark[val] = true;
+	  node_list.push_back(val);
+	}
+      }
+    }
+  }
+
+  // コーンに含まれるノードを持つモジュールを生成する．
+  vector<bool> module_mark(nm, false);
+  for ( auto index: node_list ) {
+    module_mark[node_rec(index).mModule] = true;
+  }
+  for ( SizeType i = 0; i < nm; ++ i ) {
+    if ( module_mark[i] ) {
+      if ( !new_cone_module(mgr, i, mark, root_list) ) {
+	return false;
+      }
+    }
+  }
+
+  // 生成順を全体を読み込む場合と揃えるためにインデックス順に並べる．
+  std::sort(node_list.begin(), node_list.end());
+  for ( auto index: node_list ) {
+    auto type{static_cast<MvnNodeType>(node_rec(index).mType)};
+    if ( type != MvnNodeType::DFF && mNodeArray[index] == nullptr ) {
+      if ( !new_node(mgr, index) ) {
+	return false;
+      }
+    }
+  }
+  for ( auto index: node_list ) {
+    if ( mNodeArray[index] == nullptr ) {
+      if ( !new_node(mgr, index) ) {
+	return false;
+      }
+    }
+  }
+
+  for ( auto index: node_list ) {
+    if ( !connect(mgr, index) ) {
+      return false;
+    }
+  }
+  for ( auto& p: mExtraList ) {
+    auto onode{p.first};
+    auto root{mNodeArray[p.second]};
+    mgr.connect(root, 0, onode, 0);
+  }
+
+  if ( node_map != nullptr && mNames != nullptr ) {
+    for ( auto index: node_list ) {
+      SizeType len{mNames[index * 2 + 1]};
+      if ( len > 0 ) {
+	auto name{get_string(mNames[index * 2 + 0], len)};
+	node_map->reg_node(mNodeArray[index]->id(), name);
+      }
+    }
+    if ( mRangeError ) {
+      return error("broken name table");
+    }
+  }
+
+  return true;
+}
+
+// @brief モジュール名からインデックスを求める．
+bool
+BinLoader::find_module(
+  const string& name,
+  SizeType& m_index
+)
+{
+  SizeType nm{mHeader->mModuleNum};
+  for ( SizeType i = 0; i < nm; ++ i ) {
+    auto& rec{module_rec(i)};
+    if ( get_string(rec.mName, rec.mNameLen) == name ) {
+      m_index = i;
+      return true;
+    }
+  }
+  if ( mRangeError ) {
+    return error("broken module record");
+  }
+  return error("module '" + name + "' not found");
+}
+
+// @brief モジュールの出力ノードのインデックスを求める．
+bool
+BinLoader::find_output(
+  SizeType m_index,
+  SizeType pos,
+  SizeType& n_index
+)
+{
+  auto& rec{module_rec(m_index)};
+  if ( pos >= rec.mOutputNum ) {
+    ostringstream buf;
+    buf << "output #" << pos << " out of range";
+    return error(buf.str());
+  }
+  n_index = word(rec.mData + rec.mInputNum + pos);
+  if ( mRangeError || n_index >= mHeader->mNodeNum ) {
+    return error("broken module record");
+  }
+  return true;
+}
+
+// @brief 名前索引を用いてノードのインデックスを求める．
+bool
+BinLoader::find_node(
+  const string& name,
+  SizeType& n_index
+)
+{
+  if ( mIndex == nullptr ) {
+    return error("no name index");
+  }
+  // name 以上の最初の要素を二分探索で求める．
+  SizeType left{0};
+  SizeType right{mHeader->mIndexNum};
+  while ( left < right ) {
+    SizeType mid{(left + right) / 2};
+    SizeType index{mIndex[mid]};
+    if ( index >= mHeader->mNodeNum ) {
+      return error("broken name index");
+    }
+    if ( compare_name(index, name) < 0 ) {
+      left = mid + 1;
+    }
+    else {
+      right = mid;
+    }
+  }
+  if ( mRangeError ) {
+    return error("broken name table");
+  }
+  if ( left < mHeader->mIndexNum ) {
+    SizeType index{mIndex[left]};
+    if ( index < mHeader->mNodeNum && compare_name(index, name) == 0 ) {
+      n_index = index;
+      return true;
+    }
+  }
+  return error("node '" + name + "' not found");
+}
+
+// @brief コーンに含まれる部分のみのモジュールを生成する．
+bool
+BinLoader::new_cone_module(
+  MvnMgr& mgr,
+  SizeType m_index,
+  const vector<bool>& mark,
+  const vector<SizeType>& root_list
+)
+{
+  auto& rec{module_rec(m_index)};
+  SizeType nn{mHeader->mNodeNum};
+  SizeType ni{rec.mInputNum};
+  SizeType no{rec.mOutputNum};
+  SizeType nio{rec.mInoutNum};
+  if ( ni > nn || no > nn || nio > nn ||
+       rec.mPortNum > mHeader->mWordNum ) {
+    return error("broken module record");
+  }
+
+  // 単純なポート参照式一つからなるポートの名前を入出力ノードの名前とする．
+  std::unordered_map<SizeType, string> port_name_map;
+  {
+    SizeType pos{rec.mData + ni + no + nio};
+    for ( SizeType i = 0; i < rec.mPortNum; ++ i ) {
+      auto name{get_string(word(pos), word(pos + 1))};
+      SizeType nr{word(pos + 2)};
+      if ( mRangeError || nr > mHeader->mWordNum ) {
+	return error("broken port record");
+      }
+      if ( nr == 1 && word(pos + 4) == BIN_PORTREF_SIMPLE ) {
+	port_name_map.emplace(word(pos + 3), name);
+      }
+      pos += 3 + nr * 4;
+    }
+    if ( mRangeError ) {
+      return error("broken port record");
+    }
+  }
+  auto io_name = [&](SizeType index) -> string {
+    auto p{port_name_map.find(index)};
+    if ( p != port_name_map.end() ) {
+      return p->second;
+    }
+    if ( mNames != nullptr ) {
+      return get_string(mNames[index * 2 + 0], mNames[index * 2 + 1]);
+    }
+    return string();
+  };
+
+  // コーンに含まれる入出力ノードを選ぶ．
+  vector<SizeType> io_list;
+  vector<SizeType> iw_array;
+  vector<SizeType> ow_array;
+  vector<SizeType> iow_array;
+  for ( SizeType i = 0; i < ni + no + nio; ++ i ) {
+    SizeType index{word(rec.mData + i)};
+    if ( mRangeError || index >= nn || mNodeArray[index] != nullptr ) {
+      return error("broken module record");
+    }
+    if ( !mark[index] ) {
+      continue;
+    }
+    auto& nrec{node_rec(index)};
+    auto type{i < ni ? MvnNodeType::INPUT :
+	      i < ni + no ? MvnNodeType::OUTPUT : MvnNodeType::INOUT};
+    if ( static_cast<MvnNodeType>(nrec.mType) != type ||
+	 nrec.mModule != m_index ) {
+      return error("broken module record");
+    }
+    io_list.push_back(index);
+    if ( i < ni ) {
+      iw_array.push_back(nrec.mBitWidth);
+    }
+    else if ( i < ni + no ) {
+      ow_array.push_back(nrec.mBitWidth);
+    }
+    else {
+      iow_array.push_back(nrec.mBitWidth);
+    }
+  }
+  SizeType nio_ret{iow_array.size()};
+  SizeType no_org{ow_array.size()};
+
+  // 入出力ノードでない根には出力ノードを付け加える．
+  vector<SizeType> extra_list;
+  for ( auto index: root_list ) {
+    auto& nrec{node_rec(index)};
+    if ( nrec.mModule != m_index ) {
+      continue;
+    }
+    auto type{static_cast<MvnNodeType>(nrec.mType)};
+    if ( type == MvnNodeType::INPUT ||
+	 type == MvnNodeType::OUTPUT ||
+	 type == MvnNodeType::INOUT ) {
+      continue;
+    }
+    if ( std::find(extra_list.begin(), extra_list.end(), index) != extra_list.end() ) {
+      continue;
+    }
+    extra_list.push_back(index);
+    ow_array.push_back(nrec.mBitWidth);
+  }
+
+  SizeType np{io_list.size() + extra_list.size()};
+  auto name{get_string(rec.mName, rec.mNameLen)};
+  if ( mRangeError ) {
+    return error("broken module record");
+  }
+  auto module{mgr.new_module(name, np, iw_array, ow_array, iow_array)};
+  mModuleArray[m_index] = module;
+
+  SizeType ipos{0};
+  SizeType opos{0};
+  SizeType iopos{0};
+  SizeType port_pos{0};
+  for ( auto index: io_list ) {
+    auto type{static_cast<MvnNodeType>(node_rec(index).mType)};
+    MvnNode* node{nullptr};
+    if ( type == MvnNodeType::INPUT ) {
+      node = module->input(ipos);
+      ++ ipos;
+    }
+    else if ( type == MvnNodeType::OUTPUT ) {
+      node = module->output(opos);
+      ++ opos;
+    }
+    else {
+      node = module->inout(iopos);
+      ++ iopos;
+    }
+    mNodeArray[index] = node;
+    if ( !check_node(index) ) {
+      return false;
+    }
+    mgr.init_port(module, port_pos, {MvnPortRef{node}}, io_name(index));
+    ++ port_pos;
+  }
+  ASSERT_COND( opos == no_org && iopos == nio_ret );
+  for ( auto index: extra_list ) {
+    auto node{module->output(opos)};
+    ++ opos;
+    mExtraList.push_back(make_pair(node, index));
+    string port_name;
+    if ( mNames != nullptr ) {
+      port_name = get_string(mNames[index * 2 + 0], mNames[index * 2 + 1]);
+    }
+    mgr.init_port(module, port_pos, {MvnPortRef{node}}, port_name);
+    ++ port_pos;
+  }
+  if ( mRangeError ) {
+    return error("broken name table");
+  }
+  return true;
+}
+
+// @brief モジュールを生成する．
+bool
+BinLoader::new_module(
+  MvnMgr& mgr,
+  SizeType m_index
+)
+{
+  auto& rec{module_rec(m_index)};
+  SizeType nn{mHeader->mNodeNum};
+  SizeType ni{rec.mInputNum};
+  SizeType no{rec.mOutputNum};
+  SizeType nio{rec.mInoutNum};
+  if ( ni > nn || no > nn || nio > nn ||
+       rec.mPortNum > mHeader->mWordNum ) {
+    return error("broken module record");
+  }
+  SizeType nall{ni + no + nio};
+  vector<SizeType> index_array(nall);
+  vector<SizeType> width_array(nall);
+  for ( SizeType i = 0; i < nall; ++ i ) {
+    SizeType index{word(rec.mData + i)};
+    if ( mRangeError || index >= nn || mNodeArray[index] != nullptr ) {
+      return error("broken module record");
+    }
+    auto& nrec{node_rec(index)};
+    auto type{i < ni ? MvnNodeType::INPUT :
+	      i < ni + no ? MvnNodeType::OUTPUT : MvnNodeType::INOUT};
+    if ( static_cast<MvnNodeType>(nrec.mType) != type ||
+	 nrec.mModule != m_index ) {
+      return error("broken module record");
+    }
+    index_array[i] = index;
+    width_array[i] = nrec.mBitWidth;
+  }
+  vector<SizeType> iw_array(width_array.begin(), width_array.begin() + ni);
+  vector<SizeType> ow_array(width_array.begin() + ni, width_array.begin() + ni + no);
+  vector<SizeType> iow_array(width_array.begin() + ni + no, width_array.end());
+  auto name{get_string(rec.mName, rec.mNameLen)};
+  if ( mRangeError ) {
+    return error("broken module record");
+  }
+  auto module{mgr.new_module(name, rec.mPortNum, iw_array, ow_array, iow_array)};
+  mModuleArray[m_index] = module;
+  for ( SizeType i = 0; i < ni; ++ i ) {
+    mNodeArray[index_array[i]] = module->input(i);
+  }
+  for ( SizeType i = 0; i < no; ++ i ) {
+    mNodeArray[index_array[ni + i]] = module->output(i);
+  }
+  for ( SizeType i = 0; i < nio; ++ i ) {
+    mNodeArray[index_array[ni + no + i]] = module->inout(i);
+  }
+  for ( auto index: index_array ) {
+    if ( !check_node(index) ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// @brief 入出力ノード以外のノードを生成する．
+bool
+BinLoader::new_node(
+  MvnMgr& mgr,
+  SizeType n_index
+)
+{
+  auto& rec{node_rec(n_index)};
+  if ( rec.mModule >= mHeader->mModuleNum ||
+       rec.mType > static_cast<std::uint32_t>(MvnNodeType::CELL) ||
+       rec.mInputNum > mHeader->mWordNum ) {
+    return error("broken node record");
+  }
+  auto module{mModuleArray[rec.mModule]};
+  SizeType ni{rec.mInputNum};
+  SizeType bw{rec.mBitWidth};
+  // 入力ピンのビット幅
+  vector<SizeType> iw_array(ni);
+  for ( SizeType i = 0; i < ni; ++ i ) {
+    iw_array[i] = word(rec.mData + i);
+  }
+  // 属性の位置
+  SizeType attr{rec.mData + ni * 2};
+  if ( mRangeError ) {
+    return error("broken node record");
+  }
+
+  auto type{static_cast<MvnNodeType>(rec.mType)};
+  // 入力数が型から決まる場合の確認
+  SizeType req_ni{0};
+  switch ( type ) {
+  case MvnNodeType::INPUT:
+  case MvnNodeType::OUTPUT:
+  case MvnNodeType::INOUT:
+    // モジュールの入出力として登録されていない．
+    return error("dangling I/O node");
+
+  case MvnNodeType::AND:
+  case MvnNodeType::OR:
+  case MvnNodeType::XOR:
+  case MvnNodeType::CONCAT:
+  case MvnNodeType::CONSTVALUE:
+  case MvnNodeType::CELL:
+    req_ni = ni;
+    break;
+
+  case MvnNodeType::DFF:
+    req_ni = ni < 2 ? 2 : ni;
+    break;
+
+  case MvnNodeType::LATCH:
+  case MvnNodeType::EQ:
+  case MvnNodeType::LT:
+  case MvnNodeType::CASEEQ:
+  case MvnNodeType::SLL:
+  case MvnNodeType::SRL:
+  case MvnNodeType::SLA:
+  case MvnNodeType::SRA:
+  case MvnNodeType::ADD:
+  case MvnNodeType::SUB:
+  case MvnNodeType::MUL:
+  case MvnNodeType::DIV:
+  case MvnNodeType::MOD:
+  case MvnNodeType::POW:
+  case MvnNodeType::BITSELECT:
+  case MvnNodeType::PARTSELECT:
+    req_ni = 2;
+    break;
+
+  case MvnNodeType::ITE:
+    req_ni = 3;
+    break;
+
+  default:
+    req_ni = 1;
+    break;
+  }
+  if ( ni != req_ni ) {
+    return error("wrong input number");
+  }
+
+  MvnNode* node{nullptr};
+  switch ( type ) {
+  case MvnNodeType::DFF:
+    {
+      auto clock_pol{static_cast<MvnPolarity>(word(attr))};
+      SizeType nc{ni - 2};
+      vector<MvnPolarity> pol_array(nc);
+      vector<MvnNode*> val_array(nc);
+      for ( SizeType i = 0; i < nc; ++ i ) {
+	pol_array[i] = static_cast<MvnPolarity>(word(attr + 1 + i * 2));
+	SizeType val_index{word(attr + 2 + i * 2)};
+	if ( val_index >= mHeader->mNodeNum ||
+	     mNodeArray[val_index] == nullptr ||
+	     mNodeArray[val_index]->type() != MvnNodeType::CONSTVALUE ||
+	     mNodeArray[val_index]->parent() != module ) {
+	  return error("broken DFF record");
+	}
+	val_array[i] = mNodeArray[val_index];
+      }
+      node = mgr.new_dff(module, clock_pol, pol_array, val_array, bw);
+    }
+    break;
+
+  case MvnNodeType::LATCH:
+    node = mgr.new_latch(module, bw);
+    break;
+
+  case MvnNodeType::THROUGH:
+    node = mgr.new_through(module, bw);
+    break;
+
+  case MvnNodeType::NOT:
+    node = mgr.new_not(module, bw);
+    break;
+
+  case MvnNodeType::AND:
+    node = mgr.new_and(module, ni, bw);
+    break;
+
+  case MvnNodeType::OR:
+    node = mgr.new_or(module, ni, bw);
+    break;
+
+  case MvnNodeType::XOR:
+    node = mgr.new_xor(module, ni, bw);
+    break;
+
+  case MvnNodeType::RAND:
+    node = mgr.new_rand(module, iw_array[0]);
+    break;
+
+  case MvnNodeType::ROR:
+    node = mgr.new_ror(module, iw_array[0]);
+    break;
+
+  case MvnNodeType::RXOR:
+    node = mgr.new_rxor(module, iw_array[0]);
+    break;
+
+  case MvnNodeType::EQ:
+    node = mgr.new_equal(module, iw_array[0]);
+    break;
+
+  case MvnNodeType::LT:
+    node = mgr.new_lt(module, iw_array[0]);
+    break;
+
+  case MvnNodeType::CASEEQ:
+    {
+      auto xmask{get_const(attr)};
+      if ( xmask.size() != iw_array[0] ) {
+	return error("broken CASEEQ record");
+      }
+      node = mgr.new_caseeq(module, iw_array[0], xmask);
+    }
+    break;
+
+  case MvnNodeType::SLL:
+    node = mgr.new_sll(module, iw_array[0], iw_array[1], bw);
+    break;
+
+  case MvnNodeType::SRL:
+    node = mgr.new_srl(module, iw_array[0], iw_array[1], bw);
+    break;
+
+  case MvnNodeType::SLA:
+    node = mgr.new_sla(module, iw_array[0], iw_array[1], bw);
+    break;
+
+  case MvnNodeType::SRA:
+    node = mgr.new_sra(module, iw_array[0], iw_array[1], bw);
+    break;
+
+  case MvnNodeType::CMPL:
+    node = mgr.new_cmpl(module, bw);
+    break;
+
+  case MvnNodeType::ADD:
+    node = mgr.new_add(module, iw_array[0], iw_array[1], bw);
+    break;
+
+  case MvnNodeType::SUB:
+    node = mgr.new_sub(module, iw_array[0], iw_array[1], bw);
+    break;
+
+  case MvnNodeType::MUL:
+    node = mgr.new_mult(module, iw_array[0], iw_array[1], bw);
+    break;
+
+  case MvnNodeType::DIV:
+    node = mgr.new_div(module, iw_array[0], iw_array[1], bw);
+    break;
+
+  case MvnNodeType::MOD:
+    node = mgr.new_mod(module, iw_array[0], iw_array[1], bw);
+    break;
+
+  case MvnNodeType::POW:
+    node = mgr.new_pow(module, iw_array[0], iw_array[1], bw);
+    break;
+
+  case MvnNodeType::ITE:
+    node = mgr.new_ite(module, bw);
+    break;
+
+  case MvnNodeType::CONCAT:
+    node = mgr.new_concat(module, iw_array);
+    break;
+
+  case MvnNodeType::CONSTBITSELECT:
+    node = mgr.new_constbitselect(module, word(attr), iw_array[0]);
+    break;
+
+  case MvnNodeType::CONSTPARTSELECT:
+    node = mgr.new_constpartselect(module, word(attr), word(attr + 1),
+				   iw_array[0]);
+    break;
+
+  case MvnNodeType::BITSELECT:
+    node = mgr.new_bitselect(module, iw_array[0], iw_array[1]);
+    break;
+
+  case MvnNodeType::PARTSELECT:
+    node = mgr.new_partselect(module, iw_array[0], iw_array[1], bw);
+    break;
+
+  case MvnNodeType::CONSTVALUE:
+    node = mgr.new_const(module, get_const(attr));
+    break;
+
+  case MvnNodeType::CELL:
+    {
+      auto name{get_string(word(attr), word(attr + 1))};
+      auto library{mgr.library()};
+      auto cell_id{library.cell_id(name)};
+      if ( cell_id == CLIB_NULLID ) {
+	return error("cell '" + name + "' not found");
+      }
+      node = mgr.new_cell(module, library.cell(cell_id));
+    }
+    break;
+
+  default:
+    ASSERT_NOT_REACHED;
+    break;
+  }
+  if ( mRangeError ) {
+    return error("broken node record");
+  }
+
+  mNodeArray[n_index] = node;
+  return check_node(n_index);
+}
+
+// @brief 生成したノードが記録と一致しているか確かめる．
+bool
+BinLoader::check_node(
+  SizeType n_index
+)
+{
+  auto& rec{node_rec(n_index)};
+  auto node{mNodeArray[n_index]};
+  SizeType ni{rec.mInputNum};
+  if ( node->bit_width() != rec.mBitWidth || node->input_num() != ni ) {
+    return error("inconsistent node record");
+  }
+  for ( SizeType i = 0; i < ni; ++ i ) {
+    if ( node->input(i)->bit_width() != word(rec.mData + i) ) {
+      return error("inconsistent node record");
+    }
+  }
+  if ( mRangeError ) {
+    return error("broken node record");
+  }
+  return true;
+}
+
+// @brief ノードの入力を接続する．
+bool
+BinLoader::connect(
+  MvnMgr& mgr,
+  SizeType n_index
+)
+{
+  auto& rec{node_rec(n_index)};
+  auto node{mNodeArray[n_index]};
+  SizeType ni{rec.mInputNum};
+  for ( SizeType i = 0; i < ni; ++ i ) {
+    SizeType src{word(rec.mData + ni + i)};
+    if ( mRangeError || src > mHeader->mNodeNum ) {
+      return error("broken node record");
+    }
+    if ( src == 0 ) {
+      continue;
+    }
+    auto src_node{mNodeArray[src - 1]};
+    if ( src_node->parent() != node->parent() ||
+	 src_node->bit_width() != node->input(i)->bit_width() ) {
+      return error("inconsistent connection");
+    }
+    if ( !mgr.connect(src_node, 0, node, i) ) {
+      return error("inconsistent connection");
+    }
+  }
+  return true;
+}
+
+// @brief モジュールのポートを設定する．
+bool
+BinLoader::init_port(
+  MvnMgr& mgr,
+  SizeType m_index
+)
+{
+  auto& rec{module_rec(m_index)};
+  auto module{mModuleArray[m_index]};
+  SizeType pos{rec.mData + rec.mInputNum + rec.mOutputNum + rec.mInoutNum};
+  for ( SizeType i = 0; i < rec.mPortNum; ++ i ) {
+    auto name{get_string(word(pos), word(pos + 1))};
+    SizeType nr{word(pos + 2)};
+    pos += 3;
+    if ( mRangeError || nr > mHeader->mWordNum ) {
+      return error("broken port record");
+    }
+    vector<MvnPortRef> portref_list;
+    portref_list.reserve(nr);
+    for ( SizeType j = 0; j < nr; ++ j ) {
+      SizeType index{word(pos)};
+      SizeType kind{word(pos + 1)};
+      SizeType msb{word(pos + 2)};
+      SizeType lsb{word(pos + 3)};
+      pos += 4;
+      if ( mRangeError || index >= mHeader->mNodeNum ||
+	   mNodeArray[index]->parent() != module ) {
+	return error("broken port record");
+      }
+      auto node{mNodeArray[index]};
+      if ( kind == BIN_PORTREF_SIMPLE ) {
+	portref_list.push_back(MvnPortRef{node});
+      }
+      else if ( kind == BIN_PORTREF_BITSELECT ) {
+	portref_list.push_back(MvnPortRef{node, msb});
+      }
+      else if ( kind == BIN_PORTREF_PARTSELECT ) {
+	portref_list.push_back(MvnPortRef{node, msb, lsb});
+      }
+      else {
+	return error("broken port record");
+      }
+    }
+    mgr.init_port(module, i, portref_list, name);
+  }
+  return true;
+}
+
+// @brief ワード領域の内容を返す．
+SizeType
+BinLoader::word(
+  SizeType pos
+)
+{
+  if ( pos >= mHeader->mWordNum ) {
+    mRangeError = true;
+    return 0;
+  }
+  return mWords[pos];
+}
+
+// @brief 文字領域から文字列を取り出す．
+string
+BinLoader::get_string(
+  SizeType pos,
+  SizeType len
+)
+{
+  if ( pos > mHeader->mCharNum || len > mHeader->mCharNum - pos ) {
+    mRangeError = true;
+    return string();
+  }
+  return string(mChars + pos, len);
+}
+
+// @brief ワード領域から定数を取り出す．
+MvnBvConst
+BinLoader::get_const(
+  SizeType pos
+)
+{
+  SizeType n{word(pos)};
+  if ( mRangeError || n / 64 >= mHeader->mWordNum ) {
+    mRangeError = true;
+    return MvnBvConst();
+  }
+  MvnBvConst val(n);
+  for ( SizeType i = 0; i < n; i += 64 ) {
+    auto bits{word(pos + 1 + i / 64)};
+    if ( mRangeError ) {
+      break;
+    }
+    for ( SizeType j = 0; j < 64 && i + j < n; ++ j ) {
+      val.set_val(i + j, (bits >> j) & 1);
+    }
+  }
+  return val;
+}
+
+// @brief 名前表の名前と文字列を比較する．
+int
+BinLoader::compare_name(
+  SizeType n_index,
+  const string& name
+)
+{
+  SizeType pos{mNames[n_index * 2 + 0]};
+  SizeType len{mNames[n_index * 2 + 1]};
+  if ( pos > mHeader->mCharNum || len > mHeader->mCharNum - pos ) {
+    mRangeError = true;
+    return 0;
+  }
+  SizeType n{std::min<SizeType>(len, name.size())};
+  int r = std::char_traits<char>::compare(mChars + pos, name.data(), n);
+  if ( r != 0 ) {
+    return r;
+  }
+  if ( len < name.size() ) {
+    return -1;
+  }
+  if ( len > name.size() ) {
+    return 1;
+  }
+  return 0;
+}
+
+// @brief エラーメッセージを出力する．
+bool
+BinLoader::error(
+  const string& msg
+)
+{
+  cerr << mFilename << ": " << msg << endl;
+  return false;
+}
+
+END_NAMESPACE_YM_MVN
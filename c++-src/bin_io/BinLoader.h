@@ -0,0 +1,260 @@
+﻿#ifndef BINLOADER_H
+#define BINLOADER_H
+
+/// @file BinLoader.h
+/// @brief BinLoader のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/mvn.h"
+#include "BinFormat.h"
+#include "MappedFile.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+/// @class BinLoader BinLoader.h "BinLoader.h"
+/// @brief バイナリ形式のファイルから MvnMgr を構築するクラス
+///
+/// ファイルの内容は MappedFile で写像したものを直接参照する．
+/// ワード領域と文字領域への参照は範囲を検査し，
+/// 範囲外の参照があった場合はエラーとする．
+//////////////////////////////////////////////////////////////////////
+class BinLoader
+{
+public:
+
+  /// @brief コンストラクタ
+  ///
+  /// ヘッダと各セクションの範囲を検査する．
+  /// 問題があった場合は is_valid() が false となる．
+  BinLoader(
+    const string& filename ///< [in] ファイル名
+  );
+
+  /// @brief デストラクタ
+  ~BinLoader() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ファイルが正しく読み込めた時 true を返す．
+  bool
+  is_valid() const
+  {
+    return mHeader != nullptr;
+  }
+
+  /// @brief ファイル中のネットワークを全て構築する．
+  /// @return 成功したら true を返す．
+  bool
+  load(
+    MvnMgr& mgr,       ///< [in] 結果を格納する Mvn ネットワーク
+    MvnVlMap* node_map ///< [out] ノードと Verilog 名の対応表 (nullptr も可)
+  );
+
+  /// @brief 指定されたノードの推移的ファンインのみを構築する．
+  /// @return 成功したら true を返す．
+  ///
+  /// 対象のノードを一つでも含むモジュールのみが生成される．
+  /// 生成されたモジュールはコーンに含まれる入出力ノードのみを持ち，
+  /// 入出力ノードでない根には新たに出力ノードを付け加える．
+  /// ポートは入出力ノードごとに一つずつ作られる．
+  bool
+  load_cone(
+    MvnMgr& mgr,                    ///< [in] 結果を格納する Mvn ネットワーク
+    MvnVlMap* node_map,               ///< [out] ノードと Verilog 名の対応表 (nullptr も可)
+    const vector<SizeType>& root_list ///< [in] 根のノードのインデックスのリスト
+  );
+
+  /// @brief モジュール名からインデックスを求める．
+  /// @return 見つからなかった場合はエラーを出力して false を返す．
+  bool
+  find_module(
+    const string& name, ///< [in] モジュール名
+    SizeType& m_index   ///< [out] モジュールのインデックス
+  );
+
+  /// @brief モジュールの出力ノードのインデックスを求める．
+  /// @return 範囲外の場合はエラーを出力して false を返す．
+  bool
+  find_output(
+    SizeType m_index, ///< [in] モジュールのインデックス
+    SizeType pos,     ///< [in] 出力番号
+    SizeType& n_index ///< [out] ノードのインデックス
+  );
+
+  /// @brief 名前索引を用いてノードのインデックスを求める．
+  /// @return 見つからなかった場合はエラーを出力して false を返す．
+  bool
+  find_node(
+    const string& name, ///< [in] ノードの名前
+    SizeType& n_index   ///< [out] ノードのインデックス
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief モジュールを生成する．
+  ///
+  /// 入出力ノードを mNodeArray に登録する．
+  bool
+  new_module(
+    MvnMgr& mgr,     ///< [in] Mvn ネットワーク
+    SizeType m_index ///< [in] モジュールのインデックス
+  );
+
+  /// @brief コーンに含まれる部分のみのモジュールを生成する．
+  ///
+  /// 入出力ノードを mNodeArray に登録し，
+  /// 付け加えた出力ノードと根の組を mExtraList に追加する．
+  bool
+  new_cone_module(
+    MvnMgr& mgr,                      ///< [in] Mvn ネットワーク
+    SizeType m_index,                 ///< [in] モジュールのインデックス
+    const vector<bool>& mark,         ///< [in] コーンに含まれるノードの印
+    const vector<SizeType>& root_list ///< [in] 根のノードのインデックスのリスト
+  );
+
+  /// @brief 入出力ノード以外のノードを生成する．
+  bool
+  new_node(
+    MvnMgr& mgr,     ///< [in] Mvn ネットワーク
+    SizeType n_index ///< [in] ノードのインデックス
+  );
+
+  /// @brief 生成したノードが記録と一致しているか確かめる．
+  bool
+  check_node(
+    SizeType n_index ///< [in] ノードのインデックス
+  );
+
+  /// @brief ノードの入力を接続する．
+  bool
+  connect(
+    MvnMgr& mgr,     ///< [in] Mvn ネットワーク
+    SizeType n_index ///< [in] ノードのインデックス
+  );
+
+  /// @brief モジュールのポートを設定する．
+  bool
+  init_port(
+    MvnMgr& mgr,     ///< [in] Mvn ネットワーク
+    SizeType m_index ///< [in] モジュールのインデックス
+  );
+
+  /// @brief モジュールのレコードを返す．
+  const BinModule&
+  module_rec(
+    SizeType m_index ///< [in] モジュールのインデックス
+  ) const
+  {
+    return mModuleRecs[m_index];
+  }
+
+  /// @brief ノードのレコードを返す．
+  const BinNode&
+  node_rec(
+    SizeType n_index ///< [in] ノードのインデックス
+  ) const
+  {
+    return mNodeRecs[n_index];
+  }
+
+  /// @brief ワード領域の内容を返す．
+  ///
+  /// 範囲外の場合はエラーを記録して 0 を返す．
+  SizeType
+  word(
+    SizeType pos ///< [in] 位置
+  );
+
+  /// @brief 文字領域から文字列を取り出す．
+  ///
+  /// 範囲外の場合はエラーを記録して空文字列を返す．
+  string
+  get_string(
+    SizeType pos, ///< [in] 位置
+    SizeType len  ///< [in] 長さ
+  );
+
+  /// @brief ワード領域から定数を取り出す．
+  MvnBvConst
+  get_const(
+    SizeType pos ///< [in] 位置
+  );
+
+  /// @brief 名前表の名前と文字列を比較する．
+  /// @return 名前表の名前が小さければ負，等しければ 0，大きければ正を返す．
+  int
+  compare_name(
+    SizeType n_index,  ///< [in] ノードのインデックス
+    const string& name ///< [in] 比較する文字列
+  );
+
+  /// @brief エラーメッセージを出力する．
+  /// @return 常に false を返す．
+  bool
+  error(
+    const string& msg ///< [in] メッセージ
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // ファイル名
+  string mFilename;
+
+  // ファイルの内容
+  MappedFile mFile;
+
+  // ヘッダ
+  const BinHeader* mHeader{nullptr};
+
+  // モジュールのレコードの先頭
+  const BinModule* mModuleRecs{nullptr};
+
+  // ノードのレコードの先頭
+  const BinNode* mNodeRecs{nullptr};
+
+  // ワード領域の先頭
+  const std::uint64_t* mWords{nullptr};
+
+  // 名前表の先頭 (省略されている場合は nullptr)
+  const std::uint64_t* mNames{nullptr};
+
+  // 名前索引の先頭 (省略されている場合は nullptr)
+  const std::uint64_t* mIndex{nullptr};
+
+  // 文字領域の先頭
+  const char* mChars{nullptr};
+
+  // 範囲外の参照があった時に true にするフラグ
+  bool mRangeError{false};
+
+  // モジュールのインデックスをキーにして生成したモジュールを格納する配列
+  vector<MvnModule*> mModuleArray;
+
+  // ノードのインデックスをキーにして生成したノードを格納する配列
+  vector<MvnNode*> mNodeArray;
+
+  // load_cone() で付け加えた出力ノードと根のインデックスの組のリスト
+  vector<pair<MvnNode*, SizeType>> mExtraList;
+
+};
+
+END_NAMESPACE_YM_MVN
+
+#endif // BINLOADER_H
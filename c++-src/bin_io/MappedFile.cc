@@ -0,0 +1,78 @@
+﻿
+/// @file MappedFile.cc
+/// @brief MappedFile の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "MappedFile.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+// クラス MappedFile
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+MappedFile::MappedFile(
+  const string& filename
+)
+{
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if ( fd < 0 ) {
+    return;
+  }
+  struct stat st;
+  if ( ::fstat(fd, &st) < 0 ) {
+    ::close(fd);
+    return;
+  }
+  mSize = st.st_size;
+  if ( mSize == 0 ) {
+    // 空のファイルは mmap() できない．
+    ::close(fd);
+    mBuffer.resize(1);
+    mData = reinterpret_cast<const char*>(mBuffer.data());
+    return;
+  }
+  auto addr = ::mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+  if ( addr != MAP_FAILED ) {
+    ::close(fd);
+    mMapAddr = addr;
+    mData = static_cast<const char*>(addr);
+    return;
+  }
+
+  // mmap() が使えない場合は普通に読み込む．
+  mBuffer.resize((mSize + 7) / 8);
+  auto buff = reinterpret_cast<char*>(mBuffer.data());
+  SizeType pos{0};
+  while ( pos < mSize ) {
+    auto n = ::read(fd, buff + pos, mSize - pos);
+    if ( n <= 0 ) {
+      ::close(fd);
+      mBuffer.clear();
+      mSize = 0;
+      return;
+    }
+    pos += n;
+  }
+  ::close(fd);
+  mData = buff;
+}
+
+// @brief デストラクタ
+MappedFile::~MappedFile()
+{
+  if ( mMapAddr != nullptr ) {
+    ::munmap(mMapAddr, mSize);
+  }
+}
+
+END_NAMESPACE_YM_MVN
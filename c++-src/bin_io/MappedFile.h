@@ -0,0 +1,97 @@
+﻿#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+/// @file MappedFile.h
+/// @brief MappedFile のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/mvn.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+/// @class MappedFile MappedFile.h "MappedFile.h"
+/// @brief ファイルの内容を読み出し専用でメモリ上に写像するクラス
+///
+/// mmap() が使えない場合にはファイルの内容を読み込んだバッファを用いる．
+/// どちらの場合も data() は 8 バイト境界に揃っている．
+//////////////////////////////////////////////////////////////////////
+class MappedFile
+{
+public:
+
+  /// @brief コンストラクタ
+  ///
+  /// 失敗した場合は is_valid() が false となる．
+  MappedFile(
+    const string& filename ///< [in] ファイル名
+  );
+
+  /// @brief コピーコンストラクタは禁止
+  MappedFile(
+    const MappedFile& src
+  ) = delete;
+
+  /// @brief 代入演算子も禁止
+  MappedFile&
+  operator=(
+    const MappedFile& src
+  ) = delete;
+
+  /// @brief デストラクタ
+  ~MappedFile();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 読み込みに成功した時 true を返す．
+  bool
+  is_valid() const
+  {
+    return mData != nullptr;
+  }
+
+  /// @brief 内容の先頭を返す．
+  const char*
+  data() const
+  {
+    return mData;
+  }
+
+  /// @brief 内容のサイズ(バイト数)を返す．
+  SizeType
+  size() const
+  {
+    return mSize;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 内容の先頭
+  const char* mData{nullptr};
+
+  // サイズ
+  SizeType mSize{0};
+
+  // mmap() で写像した領域
+  void* mMapAddr{nullptr};
+
+  // mmap() が使えなかった時のバッファ
+  vector<std::uint64_t> mBuffer;
+
+};
+
+END_NAMESPACE_YM_MVN
+
+#endif // MAPPEDFILE_H
@@ -0,0 +1,113 @@
+﻿
+/// @file MvnBinReader.cc
+/// @brief MvnBinReader の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/MvnBinReader.h"
+#include "BinLoader.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+// クラス MvnBinReader
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+MvnBinReader::MvnBinReader()
+{
+}
+
+// @brief デストラクタ
+MvnBinReader::~MvnBinReader()
+{
+}
+
+// @brief ファイルを読み込む．
+bool
+MvnBinReader::read(
+  const string& filename,
+  MvnMgr& mgr
+)
+{
+  BinLoader loader{filename};
+  if ( !loader.is_valid() ) {
+    return false;
+  }
+  return loader.load(mgr, nullptr);
+}
+
+// @brief ノードの名前とともにファイルを読み込む．
+bool
+MvnBinReader::read(
+  const string& filename,
+  MvnMgr& mgr,
+  MvnVlMap& node_map
+)
+{
+  BinLoader loader{filename};
+  if ( !loader.is_valid() ) {
+    return false;
+  }
+  return loader.load(mgr, &node_map);
+}
+
+// @brief 指定された出力のファンインコーンのみを読み込む．
+bool
+MvnBinReader::read_cone(
+  const string& filename,
+  const string& module_name,
+  const vector<SizeType>& output_list,
+  MvnMgr& mgr,
+  MvnVlMap& node_map
+)
+{
+  BinLoader loader{filename};
+  if ( !loader.is_valid() ) {
+    return false;
+  }
+  SizeType m_index;
+  if ( !loader.find_module(module_name, m_index) ) {
+    return false;
+  }
+  vector<SizeType> root_list;
+  root_list.reserve(output_list.size());
+  for ( auto pos: output_list ) {
+    SizeType n_index;
+    if ( !loader.find_output(m_index, pos, n_index) ) {
+      return false;
+    }
+    root_list.push_back(n_index);
+  }
+  return loader.load_cone(mgr, &node_map, root_list);
+}
+
+// @brief 指定された名前のノードのファンインコーンのみを読み込む．
+bool
+MvnBinReader::read_cone(
+  const string& filename,
+  const vector<string>& name_list,
+  MvnMgr& mgr,
+  MvnVlMap& node_map
+)
+{
+  BinLoader loader{filename};
+  if ( !loader.is_valid() ) {
+    return false;
+  }
+  vector<SizeType> root_list;
+  root_list.reserve(name_list.size());
+  for ( auto& name: name_list ) {
+    SizeType n_index;
+    if ( !loader.find_node(name, n_index) ) {
+      return false;
+    }
+    root_list.push_back(n_index);
+  }
+  return loader.load_cone(mgr, &node_map, root_list);
+}
+
+END_NAMESPACE_YM_MVN
@@ -0,0 +1,434 @@
+﻿
+/// @file MvnBinWriter.cc
+/// @brief MvnBinWriter の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/MvnBinWriter.h"
+#include "ym/MvnMgr.h"
+#include "ym/MvnModule.h"
+#include "ym/MvnPort.h"
+#include "ym/MvnNode.h"
+#include "ym/MvnInputPin.h"
+#include "ym/MvnBvConst.h"
+#include "ym/MvnVlMap.h"
+#include "ym/ClibCell.h"
+#include "BinFormat.h"
+#include <algorithm>
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+BEGIN_NONAMESPACE
+
+//////////////////////////////////////////////////////////////////////
+// バイナリ形式の各セクションを組み立てるクラス
+//////////////////////////////////////////////////////////////////////
+class BinBuilder
+{
+public:
+
+  // コンストラクタ
+  BinBuilder(
+    const MvnMgr& mgr
+  ) : mNodeIndex(mgr.max_node_id(), 0)
+  {
+    // モジュールとノードのインデックスを決める．
+    SizeType nm{mgr.max_module_id()};
+    vector<SizeType> module_index(nm, 0);
+    SizeType module_num{0};
+    for ( SizeType i = 0; i < nm; ++ i ) {
+      if ( mgr.module(i) != nullptr ) {
+	module_index[i] = module_num;
+	++ module_num;
+      }
+    }
+
+    // ノードは読み込み時に生成される順に並べる．
+    // - 各モジュールの入力，出力，入出力ノード
+    // - DFF 以外のノード
+    // - DFF ノード
+    // こうしておけば読み込んだ結果を書き出すと同じ内容になる．
+    for ( SizeType i = 0; i < nm; ++ i ) {
+      auto module{mgr.module(i)};
+      if ( module == nullptr ) {
+	continue;
+      }
+      for ( SizeType j = 0; j < module->input_num(); ++ j ) {
+	add_node(module->input(j));
+      }
+      for ( SizeType j = 0; j < module->output_num(); ++ j ) {
+	add_node(module->output(j));
+      }
+      for ( SizeType j = 0; j < module->inout_num(); ++ j ) {
+	add_node(module->inout(j));
+      }
+    }
+    SizeType nn{mgr.max_node_id()};
+    for ( SizeType i = 0; i < nn; ++ i ) {
+      auto node{mgr.node(i)};
+      if ( node == nullptr ) {
+	continue;
+      }
+      auto type{node->type()};
+      if ( type != MvnNodeType::INPUT && type != MvnNodeType::OUTPUT &&
+	   type != MvnNodeType::INOUT && type != MvnNodeType::DFF ) {
+	add_node(node);
+      }
+    }
+    for ( SizeType i = 0; i < nn; ++ i ) {
+      auto node{mgr.node(i)};
+      if ( node != nullptr && node->type() == MvnNodeType::DFF ) {
+	add_node(node);
+      }
+    }
+
+    mModuleArray.reserve(module_num);
+    for ( SizeType i = 0; i < nm; ++ i ) {
+      auto module{mgr.module(i)};
+      if ( module != nullptr ) {
+	put_module(module);
+      }
+    }
+
+    mNodeArray.reserve(mNodeList.size());
+    for ( auto node: mNodeList ) {
+      put_node(node, module_index[node->parent()->id()]);
+    }
+  }
+
+  // 名前表を作る．
+  void
+  put_names(
+    const MvnMgr& mgr,
+    const MvnVlMap& node_map
+  )
+  {
+    mNameArray.clear();
+    mNameArray.reserve(mNodeArray.size() * 2);
+    for ( auto node: mNodeList ) {
+      auto name{node_map.get_name(node->id())};
+      mNameArray.push_back(put_string(name));
+      mNameArray.push_back(name.size());
+    }
+
+    // 名前索引を作る．
+    mIndexArray.clear();
+    SizeType nn2{mNameArray.size() / 2};
+    for ( SizeType i = 0; i < nn2; ++ i ) {
+      if ( mNameArray[i * 2 + 1] > 0 ) {
+	mIndexArray.push_back(i);
+      }
+    }
+    std::stable_sort(mIndexArray.begin(), mIndexArray.end(),
+		     [&](SizeType a, SizeType b) {
+		       auto a_pos{mNameArray[a * 2 + 0]};
+		       auto a_len{mNameArray[a * 2 + 1]};
+		       auto b_pos{mNameArray[b * 2 + 0]};
+		       auto b_len{mNameArray[b * 2 + 1]};
+		       return mCharArray.compare(a_pos, a_len,
+						 mCharArray, b_pos, b_len) < 0;
+		     });
+  }
+
+  // 内容を出力する．
+  void
+  write(
+    ostream& s
+  ) const
+  {
+    BinHeader header;
+    for ( SizeType i = 0; i < 8; ++ i ) {
+      header.mMagic[i] = BIN_MAGIC[i];
+    }
+    header.mVersion = BIN_VERSION;
+    header.mEndian = BIN_ENDIAN;
+    header.mModuleNum = mModuleArray.size();
+    header.mNodeNum = mNodeArray.size();
+    header.mWordNum = mWordArray.size();
+    header.mCharNum = mCharArray.size();
+    SizeType offset{sizeof(BinHeader)};
+    header.mModuleOffset = offset;
+    offset += sizeof(BinModule) * mModuleArray.size();
+    header.mNodeOffset = offset;
+    offset += sizeof(BinNode) * mNodeArray.size();
+    header.mWordOffset = offset;
+    offset += sizeof(std::uint64_t) * mWordArray.size();
+    if ( mNameArray.empty() ) {
+      header.mNameOffset = 0;
+    }
+    else {
+      header.mNameOffset = offset;
+      offset += sizeof(std::uint64_t) * mNameArray.size();
+    }
+    header.mIndexNum = mIndexArray.size();
+    if ( mIndexArray.empty() ) {
+      header.mIndexOffset = 0;
+    }
+    else {
+      header.mIndexOffset = offset;
+      offset += sizeof(std::uint64_t) * mIndexArray.size();
+    }
+    header.mCharOffset = offset;
+
+    s.write(reinterpret_cast<const char*>(&header), sizeof(BinHeader));
+    write_array(s, mModuleArray);
+    write_array(s, mNodeArray);
+    write_array(s, mWordArray);
+    write_array(s, mNameArray);
+    write_array(s, mIndexArray);
+    s.write(mCharArray.data(), mCharArray.size());
+    // 末尾を 8 バイト境界に揃える．
+    SizeType pad{(8 - mCharArray.size() % 8) % 8};
+    for ( SizeType i = 0; i < pad; ++ i ) {
+      s.put('\0');
+    }
+  }
+
+
+private:
+
+  // ノードにインデックスを割り当てる．
+  void
+  add_node(
+    const MvnNode* node
+  )
+  {
+    mNodeIndex[node->id()] = mNodeList.size();
+    mNodeList.push_back(node);
+  }
+
+  // モジュールのレコードを作る．
+  void
+  put_module(
+    const MvnModule* module
+  )
+  {
+    BinModule rec;
+    auto name{module->name()};
+    rec.mName = put_string(name);
+    rec.mNameLen = name.size();
+    rec.mPortNum = module->port_num();
+    rec.mInputNum = module->input_num();
+    rec.mOutputNum = module->output_num();
+    rec.mInoutNum = module->inout_num();
+    rec.mData = mWordArray.size();
+    for ( SizeType i = 0; i < rec.mInputNum; ++ i ) {
+      mWordArray.push_back(mNodeIndex[module->input(i)->id()]);
+    }
+    for ( SizeType i = 0; i < rec.mOutputNum; ++ i ) {
+      mWordArray.push_back(mNodeIndex[module->output(i)->id()]);
+    }
+    for ( SizeType i = 0; i < rec.mInoutNum; ++ i ) {
+      mWordArray.push_back(mNodeIndex[module->inout(i)->id()]);
+    }
+    for ( SizeType i = 0; i < rec.mPortNum; ++ i ) {
+      auto port{module->port(i)};
+      auto port_name{port->name()};
+      mWordArray.push_back(put_string(port_name));
+      mWordArray.push_back(port_name.size());
+      SizeType nr{port->port_ref_num()};
+      mWordArray.push_back(nr);
+      for ( SizeType j = 0; j < nr; ++ j ) {
+	auto& port_ref{port->port_ref(j)};
+	mWordArray.push_back(mNodeIndex[port_ref.node()->id()]);
+	if ( port_ref.has_bitselect() ) {
+	  mWordArray.push_back(BIN_PORTREF_BITSELECT);
+	  mWordArray.push_back(port_ref.bitpos());
+	  mWordArray.push_back(0);
+	}
+	else if ( port_ref.has_partselect() ) {
+	  mWordArray.push_back(BIN_PORTREF_PARTSELECT);
+	  mWordArray.push_back(port_ref.msb());
+	  mWordArray.push_back(port_ref.lsb());
+	}
+	else {
+	  mWordArray.push_back(BIN_PORTREF_SIMPLE);
+	  mWordArray.push_back(0);
+	  mWordArray.push_back(0);
+	}
+      }
+    }
+    mModuleArray.push_back(rec);
+  }
+
+  // ノードのレコードを作る．
+  void
+  put_node(
+    const MvnNode* node,
+    SizeType module_index
+  )
+  {
+    BinNode rec;
+    rec.mType = static_cast<std::uint32_t>(node->type());
+    rec.mModule = module_index;
+    rec.mBitWidth = node->bit_width();
+    rec.mInputNum = node->input_num();
+    rec.mData = mWordArray.size();
+    for ( SizeType i = 0; i < rec.mInputNum; ++ i ) {
+      mWordArray.push_back(node->input(i)->bit_width());
+    }
+    for ( SizeType i = 0; i < rec.mInputNum; ++ i ) {
+      auto src_node{node->input(i)->src_node()};
+      if ( src_node != nullptr ) {
+	mWordArray.push_back(mNodeIndex[src_node->id()] + 1);
+      }
+      else {
+	mWordArray.push_back(0);
+      }
+    }
+    switch ( node->type() ) {
+    case MvnNodeType::DFF:
+      mWordArray.push_back(static_cast<std::uint64_t>(node->clock_pol()));
+      for ( SizeType i = 0; i + 2 < rec.mInputNum; ++ i ) {
+	mWordArray.push_back(static_cast<std::uint64_t>(node->control_pol(i)));
+	mWordArray.push_back(mNodeIndex[node->control_val(i)->id()]);
+      }
+      break;
+
+    case MvnNodeType::CASEEQ:
+      put_const(node->xmask());
+      break;
+
+    case MvnNodeType::CONSTVALUE:
+      put_const(node->const_value());
+      break;
+
+    case MvnNodeType::CONSTBITSELECT:
+      mWordArray.push_back(node->bitpos());
+      break;
+
+    case MvnNodeType::CONSTPARTSELECT:
+      mWordArray.push_back(node->msb());
+      mWordArray.push_back(node->lsb());
+      break;
+
+    case MvnNodeType::CELL:
+      {
+	auto name{node->cell().name()};
+	mWordArray.push_back(put_string(name));
+	mWordArray.push_back(name.size());
+      }
+      break;
+
+    default:
+      break;
+    }
+    mNodeArray.push_back(rec);
+  }
+
+  // 定数をワード領域に書き込む．
+  void
+  put_const(
+    const MvnBvConst& val
+  )
+  {
+    SizeType n{val.size()};
+    mWordArray.push_back(n);
+    SizeType base{mWordArray.size()};
+    mWordArray.resize(base + (n + 63) / 64, 0);
+    for ( SizeType i = 0; i < n; ++ i ) {
+      if ( val[i] ) {
+	mWordArray[base + i / 64] |= (1ULL << (i % 64));
+      }
+    }
+  }
+
+  // 文字列を文字領域に書き込む．
+  // 位置を返す．
+  SizeType
+  put_string(
+    const string& str
+  )
+  {
+    SizeType pos{mCharArray.size()};
+    mCharArray += str;
+    return pos;
+  }
+
+  // 配列の内容をそのまま出力する．
+  template <typename T>
+  static
+  void
+  write_array(
+    ostream& s,
+    const vector<T>& array
+  )
+  {
+    s.write(reinterpret_cast<const char*>(array.data()),
+	    sizeof(T) * array.size());
+  }
+
+
+private:
+
+  // インデックス順に並べたノードのリスト
+  vector<const MvnNode*> mNodeList;
+
+  // ノードの ID 番号をキーにしてインデックスを格納する配列
+  vector<SizeType> mNodeIndex;
+
+  // モジュールのレコード
+  vector<BinModule> mModuleArray;
+
+  // ノードのレコード
+  vector<BinNode> mNodeArray;
+
+  // ワード領域
+  vector<std::uint64_t> mWordArray;
+
+  // 名前表
+  vector<std::uint64_t> mNameArray;
+
+  // 名前索引
+  vector<std::uint64_t> mIndexArray;
+
+  // 文字領域
+  string mCharArray;
+
+};
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス MvnBinWriter
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+MvnBinWriter::MvnBinWriter()
+{
+}
+
+// @brief デストラクタ
+MvnBinWriter::~MvnBinWriter()
+{
+}
+
+// @brief 内容をバイナリ形式で出力する．
+void
+MvnBinWriter::operator()(
+  ostream& s,
+  const MvnMgr& mgr
+)
+{
+  BinBuilder builder{mgr};
+  builder.write(s);
+}
+
+// @brief ノードの名前とともに内容をバイナリ形式で出力する．
+void
+MvnBinWriter::operator()(
+  ostream& s,
+  const MvnMgr& mgr,
+  const MvnVlMap& node_map
+)
+{
+  BinBuilder builder{mgr};
+  builder.put_names(mgr, node_map);
+  builder.write(s);
+}
+
+END_NAMESPACE_YM_MVN
@@ -0,0 +1,98 @@
+﻿
+/// @file BnBuilder.cc
+/// @brief BnBuilder の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "BnBuilder.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+// クラス BnBuilder
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+BnBuilder::BnBuilder(
+  BnModifier& network
+) : mNetwork{network}
+{
+}
+
+// @brief ハンドルに対応するノードを返す．
+BnNode
+BnBuilder::node(
+  BnNodeHandle handle
+)
+{
+  ASSERT_COND( handle.is_valid() );
+
+  if ( handle.is_zero() ) {
+    if ( mConst0 == BNET_NULLID ) {
+      auto node{mNetwork.new_logic_primitive(string(), PrimType::C0, {})};
+      mConst0 = node.id();
+    }
+    return mNetwork.node(mConst0);
+  }
+  if ( handle.is_one() ) {
+    if ( mConst1 == BNET_NULLID ) {
+      auto node{mNetwork.new_logic_primitive(string(), PrimType::C1, {})};
+      mConst1 = node.id();
+    }
+    return mNetwork.node(mConst1);
+  }
+  SizeType id{handle.id()};
+  if ( !handle.inv() ) {
+    return mNetwork.node(id);
+  }
+  if ( mInvMap.count(id) == 0 ) {
+    auto inv{mNetwork.new_logic_primitive(string(), PrimType::Not,
+					  {mNetwork.node(id)})};
+    mInvMap.emplace(id, inv.id());
+  }
+  return mNetwork.node(mInvMap.at(id));
+}
+
+// @brief AND ゲートを作る．
+BnNodeHandle
+BnBuilder::_make_and(
+  BnNodeHandle a,
+  BnNodeHandle b
+)
+{
+  return new_gate(PrimType::And, a, b);
+}
+
+// @brief XOR ゲートを作る．
+BnNodeHandle
+BnBuilder::_make_xor(
+  BnNodeHandle a,
+  BnNodeHandle b
+)
+{
+  return new_gate(PrimType::Xor, a, b);
+}
+
+// @brief 2入力ゲートを作る．
+BnNodeHandle
+BnBuilder::new_gate(
+  PrimType type,
+  BnNodeHandle a,
+  BnNodeHandle b
+)
+{
+  Key key{type, a.body(), b.body()};
+  auto p{mHash.find(key)};
+  if ( p != mHash.end() ) {
+    return BnNodeHandle{p->second};
+  }
+  vector<BnNode> fanin_list{node(a), node(b)};
+  auto gate{mNetwork.new_logic_primitive(string(), type, fanin_list)};
+  mHash.emplace(key, gate.id());
+  return BnNodeHandle{gate.id()};
+}
+
+END_NAMESPACE_YM_MVN
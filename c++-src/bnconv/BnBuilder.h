@@ -0,0 +1,150 @@
+﻿#ifndef BNBUILDER_H
+#define BNBUILDER_H
+
+/// @file BnBuilder.h
+/// @brief BnBuilder のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "BitBuilder.h"
+#include "ym/BnModifier.h"
+#include "ym/BnNode.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+/// @class BnBuilder BnBuilder.h "BnBuilder.h"
+/// @brief BnModifier 上に論理ゲートを作る BitBuilder
+///
+/// 同じ入力を持つ同じ種類のゲートは一つしか作らない(構造ハッシュ)．
+/// BnNodeHandle の反転属性は実際のノードが必要になった時点で
+/// NOT ゲートに置き換える．
+//////////////////////////////////////////////////////////////////////
+class BnBuilder :
+  public BitBuilder
+{
+public:
+
+  /// @brief コンストラクタ
+  BnBuilder(
+    BnModifier& network ///< [in] 対象のネットワーク
+  );
+
+  /// @brief デストラクタ
+  ~BnBuilder() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ハンドルに対応するノードを返す．
+  ///
+  /// 反転属性を持つ場合には NOT ゲートを，
+  /// 定数の場合には定数ノードを必要に応じて作る．
+  BnNode
+  node(
+    BnNodeHandle handle ///< [in] ハンドル
+  );
+
+
+protected:
+  //////////////////////////////////////////////////////////////////////
+  // BitBuilder の仮想関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief AND ゲートを作る．
+  BnNodeHandle
+  _make_and(
+    BnNodeHandle a,
+    BnNodeHandle b
+  ) override;
+
+  /// @brief XOR ゲートを作る．
+  BnNodeHandle
+  _make_xor(
+    BnNodeHandle a,
+    BnNodeHandle b
+  ) override;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // 構造ハッシュのキー
+  struct Key
+  {
+    PrimType mType;
+    SizeType mBody0;
+    SizeType mBody1;
+
+    bool
+    operator==(
+      const Key& right
+    ) const
+    {
+      return mType == right.mType &&
+	mBody0 == right.mBody0 &&
+	mBody1 == right.mBody1;
+    }
+  };
+
+  // Key のハッシュ関数
+  struct KeyHash
+  {
+    SizeType
+    operator()(
+      const Key& key
+    ) const
+    {
+      return (key.mBody0 * 1048573 + key.mBody1) * 3 +
+	static_cast<SizeType>(key.mType);
+    }
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 2入力ゲートを作る．
+  BnNodeHandle
+  new_gate(
+    PrimType type,
+    BnNodeHandle a,
+    BnNodeHandle b
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 対象のネットワーク
+  BnModifier& mNetwork;
+
+  // 構造ハッシュ
+  unordered_map<Key, SizeType, KeyHash> mHash;
+
+  // ノード番号をキーにして NOT ゲートのノード番号を格納するハッシュ表
+  unordered_map<SizeType, SizeType> mInvMap;
+
+  // 定数0のノード番号
+  SizeType mConst0{BNET_NULLID};
+
+  // 定数1のノード番号
+  SizeType mConst1{BNET_NULLID};
+
+};
+
+END_NAMESPACE_YM_MVN
+
+#endif // BNBUILDER_H
@@ -0,0 +1,151 @@
+﻿
+/// @file BufBuilder.cc
+/// @brief BufBuilder の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "BufBuilder.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+// クラス BufBuilder
+//////////////////////////////////////////////////////////////////////
+
+// @brief 記録したゲートのうち root_list から到達可能なものに印をつける．
+vector<bool>
+BufBuilder::live_mark(
+  const vector<BnNodeHandle>& root_list
+) const
+{
+  SizeType n{mGateList.size()};
+  vector<bool> mark(n, false);
+  auto set_mark = [&](BnNodeHandle h) {
+    if ( h.is_valid() && !h.is_const() && h.id() >= mBase ) {
+      SizeType pos{h.id() - mBase};
+      ASSERT_COND( pos < n );
+      mark[pos] = true;
+    }
+  };
+  for ( auto h: root_list ) {
+    set_mark(h);
+  }
+  // ゲートの入力は必ずそれより前に記録されているので
+  // 後ろから一回たどれば十分
+  for ( SizeType pos = n; pos > 0; -- pos ) {
+    if ( mark[pos - 1] ) {
+      auto& gate{mGateList[pos - 1]};
+      set_mark(gate.mA);
+      set_mark(gate.mB);
+    }
+  }
+  return mark;
+}
+
+// @brief 記録したゲートを builder 上に記録順に作り直す．
+void
+BufBuilder::replay(
+  BitBuilder& builder
+)
+{
+  replay(builder, vector<bool>(mGateList.size(), true), {});
+}
+
+// @brief 印のついたゲートだけを builder 上に記録順に作り直す．
+void
+BufBuilder::replay(
+  BitBuilder& builder,
+  const vector<bool>& mark,
+  const vector<BnNodeHandle>& src_list
+)
+{
+  ASSERT_COND( mark.size() == mGateList.size() );
+  mSrcList = src_list;
+  mXlatList.clear();
+  mXlatList.reserve(mGateList.size());
+  for ( SizeType pos = 0; pos < mGateList.size(); ++ pos ) {
+    if ( !mark[pos] ) {
+      mXlatList.push_back(BnNodeHandle{});
+      continue;
+    }
+    auto& gate{mGateList[pos]};
+    // ゲートの入力は必ずそれより前に記録されている．
+    auto a{translate(gate.mA)};
+    auto b{translate(gate.mB)};
+    if ( gate.mXor ) {
+      mXlatList.push_back(builder.make_xor(a, b));
+    }
+    else {
+      mXlatList.push_back(builder.make_and(a, b));
+    }
+  }
+}
+
+// @brief 仮のハンドルを replay() で作り直したハンドルに変換する．
+BnNodeHandle
+BufBuilder::translate(
+  BnNodeHandle handle
+) const
+{
+  if ( !handle.is_valid() || handle.is_const() ) {
+    return handle;
+  }
+  SizeType id{handle.id()};
+  if ( id < mBase ) {
+    if ( mSrcList.empty() ) {
+      return handle;
+    }
+    ASSERT_COND( id < mSrcList.size() );
+    auto ans{mSrcList[id]};
+    return handle.inv() ? ~ans : ans;
+  }
+  SizeType pos{id - mBase};
+  ASSERT_COND( pos < mXlatList.size() );
+  auto ans{mXlatList[pos]};
+  ASSERT_COND( ans.is_valid() );
+  return handle.inv() ? ~ans : ans;
+}
+
+// @brief AND ゲートを作る．
+BnNodeHandle
+BufBuilder::_make_and(
+  BnNodeHandle a,
+  BnNodeHandle b
+)
+{
+  return new_gate(false, a, b);
+}
+
+// @brief XOR ゲートを作る．
+BnNodeHandle
+BufBuilder::_make_xor(
+  BnNodeHandle a,
+  BnNodeHandle b
+)
+{
+  return new_gate(true, a, b);
+}
+
+// @brief ゲートを記録する．
+BnNodeHandle
+BufBuilder::new_gate(
+  bool is_xor,
+  BnNodeHandle a,
+  BnNodeHandle b
+)
+{
+  Key key{is_xor, a.body(), b.body()};
+  auto p{mHash.find(key)};
+  if ( p != mHash.end() ) {
+    return BnNodeHandle{p->second};
+  }
+  SizeType id{mBase + mGateList.size()};
+  mGateList.push_back({is_xor, a, b});
+  mHash.emplace(key, id);
+  return BnNodeHandle{id};
+}
+
+END_NAMESPACE_YM_MVN
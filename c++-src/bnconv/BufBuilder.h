@@ -0,0 +1,208 @@
+﻿#ifndef BUFBUILDER_H
+#define BUFBUILDER_H
+
+/// @file BufBuilder.h
+/// @brief BufBuilder のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "BitBuilder.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+/// @class BufBuilder BufBuilder.h "BufBuilder.h"
+/// @brief 作ったゲートをバッファに記録しておく BitBuilder
+///
+/// 並列変換の際にスレッドごとに用いる．
+/// 記録したゲートは開始位置(デフォルトは LOCAL_BASE)以上の仮のノード番号を
+/// 持つハンドルで表し，後で replay() によって実際の BitBuilder 上に作り直す．
+/// 開始位置未満のノード番号を持つハンドルはバッファの外のノードを表す．
+/// 同じ入力を持つ同じ種類のゲートはバッファ内で一つしか作らない．
+///
+/// MvnBnConv では差分変換のためにネットワーク全体の影としても用いる．
+/// この場合は印をつけたゲートだけを replay() で作り直す．
+//////////////////////////////////////////////////////////////////////
+class BufBuilder :
+  public BitBuilder
+{
+public:
+
+  /// @brief 仮のノード番号の開始位置
+  static constexpr SizeType LOCAL_BASE{static_cast<SizeType>(1) << 48};
+
+  /// @brief コンストラクタ
+  explicit
+  BufBuilder(
+    SizeType base = LOCAL_BASE ///< [in] 仮のノード番号の開始位置
+  ) : mBase{base}
+  {
+  }
+
+  /// @brief デストラクタ
+  ~BufBuilder() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 記録したゲート数を返す．
+  SizeType
+  gate_num() const
+  {
+    return mGateList.size();
+  }
+
+  /// @brief 記録したゲートのうち root_list から到達可能なものに印をつける．
+  /// @return ゲートの記録順に並んだ印のリストを返す．
+  vector<bool>
+  live_mark(
+    const vector<BnNodeHandle>& root_list ///< [in] 根のハンドルのリスト
+  ) const;
+
+  /// @brief 記録したゲートを builder 上に記録順に作り直す．
+  ///
+  /// 以降 translate() で仮のハンドルを変換できるようになる．
+  /// バッファの外のノードはそのまま用いる．
+  void
+  replay(
+    BitBuilder& builder ///< [in] ゲートを作るオブジェクト
+  );
+
+  /// @brief 印のついたゲートだけを builder 上に記録順に作り直す．
+  ///
+  /// バッファの外のノード番号 id は src_list[id] に置き換える．
+  /// src_list が空の場合はそのまま用いる．
+  /// 印のついたゲートの入力には印がついていなければならない．
+  void
+  replay(
+    BitBuilder& builder,                 ///< [in] ゲートを作るオブジェクト
+    const vector<bool>& mark,            ///< [in] live_mark() の結果
+    const vector<BnNodeHandle>& src_list ///< [in] 外のノードの置き換え先
+  );
+
+  /// @brief 仮のハンドルを replay() で作り直したハンドルに変換する．
+  ///
+  /// バッファの外のノードの場合は replay() の指定に従って置き換える．
+  /// 作り直さなかったゲートを指定してはいけない．
+  BnNodeHandle
+  translate(
+    BnNodeHandle handle ///< [in] ハンドル
+  ) const;
+
+
+protected:
+  //////////////////////////////////////////////////////////////////////
+  // BitBuilder の仮想関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief AND ゲートを作る．
+  BnNodeHandle
+  _make_and(
+    BnNodeHandle a,
+    BnNodeHandle b
+  ) override;
+
+  /// @brief XOR ゲートを作る．
+  BnNodeHandle
+  _make_xor(
+    BnNodeHandle a,
+    BnNodeHandle b
+  ) override;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // 記録したゲート
+  struct Gate
+  {
+    // XOR の時 true
+    bool mXor;
+
+    // 入力1
+    BnNodeHandle mA;
+
+    // 入力2
+    BnNodeHandle mB;
+  };
+
+  // 構造ハッシュのキー
+  struct Key
+  {
+    bool mXor;
+    SizeType mBody0;
+    SizeType mBody1;
+
+    bool
+    operator==(
+      const Key& right
+    ) const
+    {
+      return mXor == right.mXor &&
+	mBody0 == right.mBody0 &&
+	mBody1 == right.mBody1;
+    }
+  };
+
+  // Key のハッシュ関数
+  struct KeyHash
+  {
+    SizeType
+    operator()(
+      const Key& key
+    ) const
+    {
+      return (key.mBody0 * 1048573 + key.mBody1) * 2 +
+	static_cast<SizeType>(key.mXor);
+    }
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ゲートを記録する．
+  BnNodeHandle
+  new_gate(
+    bool is_xor,
+    BnNodeHandle a,
+    BnNodeHandle b
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 仮のノード番号の開始位置
+  SizeType mBase;
+
+  // 記録したゲートのリスト
+  vector<Gate> mGateList;
+
+  // 構造ハッシュ
+  unordered_map<Key, SizeType, KeyHash> mHash;
+
+  // replay() で作り直したハンドルのリスト
+  // mGateList と同じ順に並んでいる．
+  vector<BnNodeHandle> mXlatList;
+
+  // replay() で指定された外のノードの置き換え先
+  vector<BnNodeHandle> mSrcList;
+
+};
+
+END_NAMESPACE_YM_MVN
+
+#endif // BUFBUILDER_H
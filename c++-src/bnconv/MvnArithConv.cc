@@ -0,0 +1,142 @@
+﻿
+/// @file MvnArithConv.cc
+/// @brief MvnArithConv の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "MvnConv.h"
+#include "BitBuilder.h"
+#include "ym/MvnBnMap.h"
+#include "ym/MvnNode.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+// クラス MvnArithConv
+//////////////////////////////////////////////////////////////////////
+
+// @brief MvnNode をビットレベルのゲートに変換する．
+bool
+MvnArithConv::operator()(
+  const MvnNode* node,
+  BitBuilder& builder,
+  MvnBnMap& nodemap
+)
+{
+  SizeType ow{node->bit_width()};
+  auto& arch{mConv.arith_arch(node)};
+  switch ( node->type() ) {
+  case MvnNodeType::CMPL:
+    {
+      vector<BnNodeHandle> zero(ow, BnNodeHandle::zero());
+      auto abits{ext_bits(input_bits(node, 0, nodemap), ow)};
+      put_bits(node, make_subtractor(builder, zero, abits, nullptr,
+				     arch.mAdder), nodemap);
+    }
+    return true;
+
+  case MvnNodeType::ADD:
+    {
+      auto abits{ext_bits(input_bits(node, 0, nodemap), ow)};
+      auto bbits{ext_bits(input_bits(node, 1, nodemap), ow)};
+      put_bits(node, make_adder(builder, abits, bbits, BnNodeHandle::zero(),
+				nullptr, arch.mAdder),
+	       nodemap);
+    }
+    return true;
+
+  case MvnNodeType::SUB:
+    {
+      auto abits{ext_bits(input_bits(node, 0, nodemap), ow)};
+      auto bbits{ext_bits(input_bits(node, 1, nodemap), ow)};
+      put_bits(node, make_subtractor(builder, abits, bbits, nullptr,
+				     arch.mAdder),
+	       nodemap);
+    }
+    return true;
+
+  case MvnNodeType::MUL:
+    {
+      auto abits{ext_bits(input_bits(node, 0, nodemap), ow)};
+      auto bbits{ext_bits(input_bits(node, 1, nodemap), ow)};
+      put_bits(node, make_multiplier(builder, abits, bbits, ow, arch),
+	       nodemap);
+    }
+    return true;
+
+  case MvnNodeType::DIV:
+  case MvnNodeType::MOD:
+    {
+      // 引き戻し法による除算器
+      auto abits{input_bits(node, 0, nodemap)};
+      auto bbits{input_bits(node, 1, nodemap)};
+      SizeType bw{std::max(std::max(abits.size(), bbits.size()), ow)};
+      abits = ext_bits(abits, bw);
+      auto bbits1{ext_bits(bbits, bw + 1)};
+      vector<BnNodeHandle> q(bw);
+      vector<BnNodeHandle> r(bw, BnNodeHandle::zero());
+      for ( SizeType i = bw; i > 0; -- i ) {
+	SizeType pos{i - 1};
+	// r1 = (r << 1) | a[pos]
+	vector<BnNodeHandle> r1(bw + 1);
+	r1[0] = abits[pos];
+	for ( SizeType j = 0; j < bw; ++ j ) {
+	  r1[j + 1] = r[j];
+	}
+	BnNodeHandle borrow;
+	auto d{make_subtractor(builder, r1, bbits1, &borrow, arch.mAdder)};
+	q[pos] = ~borrow;
+	for ( SizeType j = 0; j < bw; ++ j ) {
+	  r[j] = builder.make_mux(q[pos], d[j], r1[j]);
+	}
+      }
+      // 0 で割った時は商も余りも 0 にする．
+      auto nz{make_nonzero(builder, bbits)};
+      auto& ans{node->type() == MvnNodeType::DIV ? q : r};
+      for ( auto& h: ans ) {
+	h = builder.make_and(h, nz);
+      }
+      put_bits(node, ans, nodemap);
+    }
+    return true;
+
+  case MvnNodeType::POW:
+    {
+      // 二乗と乗算を繰り返す．
+      auto base{ext_bits(input_bits(node, 0, nodemap), ow)};
+      auto ebits{input_bits(node, 1, nodemap)};
+      vector<BnNodeHandle> ans(ow, BnNodeHandle::zero());
+      if ( ow > 0 ) {
+	ans[0] = BnNodeHandle::one();
+      }
+      SizeType last{0};
+      for ( SizeType k = 0; k < ebits.size(); ++ k ) {
+	if ( !ebits[k].is_zero() ) {
+	  last = k + 1;
+	}
+      }
+      for ( SizeType k = 0; k < last; ++ k ) {
+	if ( !ebits[k].is_zero() ) {
+	  auto prod{make_multiplier(builder, ans, base, ow, arch)};
+	  for ( SizeType j = 0; j < ow; ++ j ) {
+	    ans[j] = builder.make_mux(ebits[k], prod[j], ans[j]);
+	  }
+	}
+	if ( k + 1 < last ) {
+	  base = make_multiplier(builder, base, base, ow, arch);
+	}
+      }
+      put_bits(node, ans, nodemap);
+    }
+    return true;
+
+  default:
+    break;
+  }
+  return false;
+}
+
+END_NAMESPACE_YM_MVN
@@ -0,0 +1,981 @@
+﻿
+/// @file MvnBnConv.cc
+/// @brief MvnBnConv の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/MvnBnConv.h"
+#include "ym/MvnBnMap.h"
+#include "ym/MvnMgr.h"
+#include "ym/MvnModule.h"
+#include "ym/MvnNode.h"
+#include "ym/MvnPort.h"
+#include "ym/MvnInputPin.h"
+#include "ym/MvnBvConst.h"
+#include "ym/BnNetwork.h"
+#include "ym/BnModifier.h"
+#include "ym/BnPort.h"
+#include "ym/BnDff.h"
+#include "ym/BnNode.h"
+#include "MvnConv.h"
+#include "BnBuilder.h"
+#include "BufBuilder.h"
+#include "MvnLevelizer.h"
+#include <atomic>
+#include <thread>
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+BEGIN_NONAMESPACE
+
+// 入出力ノードの名前を求める．
+//
+// そのノードだけを単純に参照している名前付きのポートがあれば
+// その名前を用いる．
+string
+node_name(
+  const MvnModule* module,
+  const MvnNode* node
+)
+{
+  SizeType np{module->port_num()};
+  for ( SizeType i = 0; i < np; ++ i ) {
+    auto port{module->port(i)};
+    if ( port->port_ref_num() == 1 ) {
+      auto& port_ref{port->port_ref(0)};
+      if ( port_ref.node() == node &&
+	   port_ref.is_simple() &&
+	   port->name() != string() ) {
+	return port->name();
+      }
+    }
+  }
+  ostringstream buf;
+  buf << "node" << node->id();
+  return buf.str();
+}
+
+// ファンインのビットを得る．
+//
+// 接続されていない場合は定数0となる．
+BnNodeHandle
+input_bit(
+  const MvnNode* node,
+  SizeType pos,
+  SizeType b,
+  const MvnBnMap& nodemap
+)
+{
+  auto src{node->input(pos)->src_node()};
+  if ( src == nullptr || b >= src->bit_width() ) {
+    return BnNodeHandle::zero();
+  }
+  return nodemap.get(src, b);
+}
+
+// 組み合わせ回路として変換するノードの時 true を返す．
+//
+// 入力と DFF の出力はソースとして扱う．
+// ラッチの出力もソースとして扱い，入力は DFF と同様に最後に接続する．
+bool
+is_comb(
+  const MvnNode* node
+)
+{
+  auto type{node->type()};
+  if ( MvnLevelizer::is_source(node) && type != MvnNodeType::CONSTVALUE ) {
+    return false;
+  }
+  return type != MvnNodeType::LATCH;
+}
+
+// 影のネットワークのゲートに用いるノード番号の開始位置
+//
+// 入力と DFF/ラッチの出力のビットには 0 から順に番号を振る．
+// conv_parallel() で用いる BufBuilder の仮の番号とは重ならない．
+const SizeType SHADOW_BASE{static_cast<SizeType>(1) << 40};
+
+// 入出力ノードと DFF/ラッチの種類
+enum class IoKind {
+  Input,
+  Dff,
+  Latch,
+  Output
+};
+
+// 入出力ノードと DFF/ラッチの情報
+//
+// BnNetwork のポートと DFF/ラッチはこのリストの順に作る．
+// リストが前回と異なる場合は全体を変換し直す．
+struct IoInfo
+{
+  // 種類
+  IoKind mKind;
+
+  // 元のノード番号
+  SizeType mNodeId;
+
+  // ビット幅
+  SizeType mBitWidth;
+
+  // DFF の非同期制御信号の数
+  SizeType mCtrlNum;
+
+  // ポート名
+  string mName;
+
+  // 等価比較演算子
+  bool
+  operator==(
+    const IoInfo& right
+  ) const
+  {
+    return mKind == right.mKind &&
+      mNodeId == right.mNodeId &&
+      mBitWidth == right.mBitWidth &&
+      mCtrlNum == right.mCtrlNum &&
+      mName == right.mName;
+  }
+
+};
+
+// DFF/ラッチの入力の情報
+//
+// ハンドルは影のネットワーク上のもの．
+struct FFInfo
+{
+  // ビットごとのデータ入力
+  vector<BnNodeHandle> mDataList;
+
+  // クロック(ラッチの場合はイネーブル)
+  BnNodeHandle mClock;
+
+  // ビットごとのクリア(制御信号がない場合は空)
+  vector<BnNodeHandle> mClearList;
+
+  // ビットごとのプリセット(制御信号がない場合は空)
+  vector<BnNodeHandle> mPresetList;
+
+};
+
+// 入出力ノードと DFF/ラッチのリストを作る．
+vector<IoInfo>
+make_io_list(
+  const vector<const MvnModule*>& module_list,
+  const vector<MvnLevelizer>& lv_list
+)
+{
+  vector<IoInfo> io_list;
+  for ( SizeType i = 0; i < module_list.size(); ++ i ) {
+    auto module{module_list[i]};
+    auto add = [&](IoKind kind, const MvnNode* node, SizeType nc) {
+      io_list.push_back({kind, static_cast<SizeType>(node->id()),
+			 node->bit_width(), nc,
+			 node_name(module, node)});
+    };
+
+    for ( SizeType j = 0; j < module->input_num(); ++ j ) {
+      add(IoKind::Input, module->input(j), 0);
+    }
+    for ( SizeType j = 0; j < module->inout_num(); ++ j ) {
+      auto node{module->inout(j)};
+      if ( MvnLevelizer::is_source(node) ) {
+	add(IoKind::Input, node, 0);
+      }
+    }
+
+    for ( auto node: lv_list[i].node_list() ) {
+      auto type{node->type()};
+      if ( type == MvnNodeType::DFF ) {
+	add(IoKind::Dff, node, node->input_num() - 2);
+      }
+      else if ( type == MvnNodeType::LATCH ) {
+	add(IoKind::Latch, node, 0);
+      }
+    }
+
+    for ( SizeType j = 0; j < module->output_num(); ++ j ) {
+      add(IoKind::Output, module->output(j), 0);
+    }
+    for ( SizeType j = 0; j < module->inout_num(); ++ j ) {
+      auto node{module->inout(j)};
+      if ( !MvnLevelizer::is_source(node) ) {
+	add(IoKind::Output, node, 0);
+      }
+    }
+  }
+  return io_list;
+}
+
+// DFF/ラッチの入力を作る．
+FFInfo
+make_ff(
+  const MvnNode* node,
+  BitBuilder& builder,
+  const MvnBnMap& nodemap
+)
+{
+  FFInfo info;
+  SizeType bw{node->bit_width()};
+  // クロック(ラッチの場合はイネーブル)
+  auto clock{input_bit(node, 1, 0, nodemap)};
+  if ( node->type() == MvnNodeType::DFF &&
+       node->clock_pol() == MvnPolarity::Negative ) {
+    clock = ~clock;
+  }
+  info.mClock = clock;
+  // 非同期制御信号は番号の若い方が優先される．
+  SizeType nc{node->type() == MvnNodeType::DFF ? node->input_num() - 2 : 0};
+  vector<BnNodeHandle> act_list(nc);
+  {
+    auto higher{BnNodeHandle::zero()};
+    for ( SizeType i = 0; i < nc; ++ i ) {
+      auto ctrl{input_bit(node, i + 2, 0, nodemap)};
+      if ( node->control_pol(i) == MvnPolarity::Negative ) {
+	ctrl = ~ctrl;
+      }
+      act_list[i] = builder.make_and(ctrl, ~higher);
+      higher = builder.make_or(higher, ctrl);
+    }
+  }
+  for ( SizeType b = 0; b < bw; ++ b ) {
+    info.mDataList.push_back(input_bit(node, 0, b, nodemap));
+    if ( nc > 0 ) {
+      vector<BnNodeHandle> clear_list;
+      vector<BnNodeHandle> preset_list;
+      for ( SizeType i = 0; i < nc; ++ i ) {
+	auto val{node->control_val(i)->const_value()};
+	if ( b < val.size() && val[b] ) {
+	  preset_list.push_back(act_list[i]);
+	}
+	else {
+	  clear_list.push_back(act_list[i]);
+	}
+      }
+      info.mClearList.push_back(builder.make_or(clear_list));
+      info.mPresetList.push_back(builder.make_or(preset_list));
+    }
+  }
+  return info;
+}
+
+// 全ての DFF/ラッチの入力を作る．
+//
+// io_list の DFF/ラッチの順に並べる．
+vector<FFInfo>
+make_ff_list(
+  const MvnMgr& mvmgr,
+  const vector<IoInfo>& io_list,
+  BitBuilder& builder,
+  const MvnBnMap& nodemap
+)
+{
+  vector<FFInfo> ff_list;
+  for ( auto& info: io_list ) {
+    if ( info.mKind == IoKind::Dff || info.mKind == IoKind::Latch ) {
+      auto node{mvmgr.node(info.mNodeId)};
+      ff_list.push_back(make_ff(node, builder, nodemap));
+    }
+  }
+  return ff_list;
+}
+
+// ノードの全ビットのハンドルを前回の結果からコピーする．
+void
+copy_bits(
+  const MvnNode* node,
+  const MvnBnMap& src_map,
+  MvnBnMap& dst_map
+)
+{
+  for ( SizeType b = 0; b < node->bit_width(); ++ b ) {
+    dst_map.put(node, b, src_map.get(node, b));
+  }
+}
+
+// 定数のリストが等しい時 true を返す．
+bool
+same_const_list(
+  const vector<MvnBvConst>& left,
+  const vector<MvnBvConst>& right
+)
+{
+  if ( left.size() != right.size() ) {
+    return false;
+  }
+  for ( SizeType i = 0; i < left.size(); ++ i ) {
+    if ( left[i].size() != right[i].size() || !(left[i] == right[i]) ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// ノードの構造の記録
+//////////////////////////////////////////////////////////////////////
+struct MvnBnConv::NodeRec
+{
+  // 有効な記録の時 true
+  bool mValid{false};
+
+  // 型
+  MvnNodeType mType{MvnNodeType::INPUT};
+
+  // 整数で表される属性のリスト
+  //
+  // ビット幅，入力数，入力ごとのビット幅とファンインのノード番号，
+  // 型ごとの属性の順に並べる．
+  vector<SizeType> mAttrList;
+
+  // 定数で表される属性のリスト
+  vector<MvnBvConst> mConstList;
+
+  // セル名
+  string mCellName;
+
+  // 等価比較演算子
+  bool
+  operator==(
+    const NodeRec& right
+  ) const
+  {
+    return mValid == right.mValid &&
+      mType == right.mType &&
+      mAttrList == right.mAttrList &&
+      same_const_list(mConstList, right.mConstList) &&
+      mCellName == right.mCellName;
+  }
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// 差分変換用に前回の変換結果を保持する構造体
+//////////////////////////////////////////////////////////////////////
+struct MvnBnConv::IncData
+{
+  // コンストラクタ
+  IncData(
+    const MvnMgr& mvmgr,
+    BnNetwork& bnetwork
+  ) : mNetwork{&bnetwork},
+      mShadow{new BufBuilder{SHADOW_BASE}},
+      mShadowMap{mvmgr}
+  {
+  }
+
+  // 変換先のネットワーク
+  BnNetwork* mNetwork;
+
+  // 入出力ノードと DFF/ラッチのリスト
+  vector<IoInfo> mIoList;
+
+  // 影のネットワーク
+  //
+  // これまでに作った全てのゲートを記録しておき，
+  // BnNetwork は参照されているゲートだけから毎回作り直す．
+  // 構造ハッシュを次回の変換でも再利用する．
+  unique_ptr<BufBuilder> mShadow;
+
+  // 影のネットワーク上の対応関係
+  MvnBnMap mShadowMap;
+
+  // DFF/ラッチの入力のリスト
+  // mIoList の DFF/ラッチの順に並んでいる．
+  vector<FFInfo> mFFList;
+
+  // ノード番号をキーにして構造の記録を格納する配列
+  vector<NodeRec> mRecArray;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス MvnBnConv
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+MvnBnConv::MvnBnConv()
+{
+  mConvList.push_back(unique_ptr<MvnConv>{new MvnConstConv});
+  mConvList.push_back(unique_ptr<MvnConv>{new MvnLogicConv});
+  mConvList.push_back(unique_ptr<MvnConv>{new MvnCmpConv{*this}});
+  mConvList.push_back(unique_ptr<MvnConv>{new MvnShiftConv});
+  mConvList.push_back(unique_ptr<MvnConv>{new MvnArithConv{*this}});
+  mConvList.push_back(unique_ptr<MvnConv>{new MvnSelectConv});
+  mConvList.push_back(unique_ptr<MvnConv>{new MvnCellConv});
+}
+
+// @brief デストラクタ
+MvnBnConv::~MvnBnConv()
+{
+  // MvnConv の定義が必要なのでヘッダファイルには書けない．
+}
+
+// @brief ビット幅ごとの構成を設定する．
+void
+MvnBnConv::set_arith_arch(
+  SizeType min_width,
+  const MvnArithArch& arch
+)
+{
+  auto p{mWidthArchList.begin()};
+  for ( ; p != mWidthArchList.end(); ++ p ) {
+    if ( p->first == min_width ) {
+      p->second = arch;
+      return;
+    }
+    if ( p->first > min_width ) {
+      break;
+    }
+  }
+  mWidthArchList.insert(p, make_pair(min_width, arch));
+}
+
+// @brief ノードごとの構成を設定する．
+void
+MvnBnConv::set_arith_arch(
+  const MvnNode* node,
+  const MvnArithArch& arch
+)
+{
+  mNodeArchMap[node->id()] = arch;
+}
+
+// @brief ノードに適用される構成を返す．
+const MvnArithArch&
+MvnBnConv::arith_arch(
+  const MvnNode* node
+) const
+{
+  auto p{mNodeArchMap.find(node->id())};
+  if ( p != mNodeArchMap.end() ) {
+    return p->second;
+  }
+  SizeType bw{node->bit_width()};
+  if ( node->type() == MvnNodeType::LT ) {
+    bw = std::max(node->input(0)->bit_width(), node->input(1)->bit_width());
+  }
+  for ( SizeType i = mWidthArchList.size(); i > 0; -- i ) {
+    auto& elem{mWidthArchList[i - 1]};
+    if ( elem.first <= bw ) {
+      return elem.second;
+    }
+  }
+  return mDefaultArch;
+}
+
+// @brief 変換に用いるスレッド数を設定する．
+void
+MvnBnConv::set_thread_num(
+  SizeType thread_num
+)
+{
+  mThreadNum = thread_num;
+  if ( mThreadNum == 0 ) {
+    mThreadNum = std::thread::hardware_concurrency();
+    if ( mThreadNum == 0 ) {
+      mThreadNum = 1;
+    }
+  }
+}
+
+// @brief MvnMgr の内容を BnNetwork に変換する．
+bool
+MvnBnConv::operator()(
+  const MvnMgr& mvmgr,
+  BnNetwork& bnetwork,
+  MvnBnMap& mvnode_map
+)
+{
+  return conv_all(mvmgr, bnetwork, mvnode_map);
+}
+
+// @brief 前回の変換結果を再利用して変換し直す．
+bool
+MvnBnConv::update(
+  const MvnMgr& mvmgr,
+  BnNetwork& bnetwork,
+  MvnBnMap& mvnode_map
+)
+{
+  if ( mIncData == nullptr || mIncData->mNetwork != &bnetwork ) {
+    return conv_all(mvmgr, bnetwork, mvnode_map);
+  }
+
+  auto module_list{mvmgr.topmodule_list()};
+  vector<MvnLevelizer> lv_list;
+  for ( auto module: module_list ) {
+    lv_list.push_back(MvnLevelizer{mvmgr, module});
+  }
+  if ( make_io_list(module_list, lv_list) != mIncData->mIoList ) {
+    return conv_all(mvmgr, bnetwork, mvnode_map);
+  }
+
+  auto& data{*mIncData};
+  auto& shadow{*data.mShadow};
+  auto& old_map{data.mShadowMap};
+
+  SizeType n{mvmgr.max_node_id()};
+  vector<NodeRec> rec_array(n);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    auto node{mvmgr.node(i)};
+    if ( node != nullptr ) {
+      rec_array[i] = node_rec(node);
+    }
+  }
+  // 構造が前回と等しい時 true を返す．
+  auto same_rec = [&](SizeType id) -> bool {
+    return id < data.mRecArray.size() && data.mRecArray[id] == rec_array[id];
+  };
+
+  // ビットが前回と変わったノードの印
+  MvnBnMap shadow_map{mvmgr};
+  vector<bool> changed(n, false);
+  SizeType count{0};
+  for ( auto& lv: lv_list ) {
+    for ( auto node: lv.node_list() ) {
+      SizeType id{static_cast<SizeType>(node->id())};
+      if ( !is_comb(node) ) {
+	// 入力と DFF/ラッチの出力は前回と同じ．
+	copy_bits(node, old_map, shadow_map);
+	continue;
+      }
+      bool dirty{!same_rec(id)};
+      SizeType ni{MvnLevelizer::fanin_num(node)};
+      for ( SizeType i = 0; i < ni && !dirty; ++ i ) {
+	auto src{MvnLevelizer::fanin(node, i)};
+	if ( src != nullptr && changed[src->id()] ) {
+	  dirty = true;
+	}
+      }
+      if ( !dirty ) {
+	copy_bits(node, old_map, shadow_map);
+	continue;
+      }
+      if ( !conv_node(node, shadow, shadow_map) ) {
+	return false;
+      }
+      ++ count;
+      if ( !same_rec(id) ) {
+	changed[id] = true;
+	continue;
+      }
+      for ( SizeType b = 0; b < node->bit_width(); ++ b ) {
+	if ( shadow_map.get(node, b) != old_map.get(node, b) ) {
+	  changed[id] = true;
+	  break;
+	}
+      }
+    }
+  }
+
+  // DFF とラッチの入力は構造ハッシュで同じものが得られるので全て作り直す．
+  data.mFFList = make_ff_list(mvmgr, data.mIoList, shadow, shadow_map);
+  data.mShadowMap = std::move(shadow_map);
+  emit(mvmgr, data, bnetwork, mvnode_map);
+
+  data.mRecArray.swap(rec_array);
+  mConvNum = count;
+
+  return true;
+}
+
+// @brief 全体を変換する．
+bool
+MvnBnConv::conv_all(
+  const MvnMgr& mvmgr,
+  BnNetwork& bnetwork,
+  MvnBnMap& mvnode_map
+)
+{
+  auto module_list{mvmgr.topmodule_list()};
+  vector<MvnLevelizer> lv_list;
+  for ( auto module: module_list ) {
+    lv_list.push_back(MvnLevelizer{mvmgr, module});
+  }
+
+  unique_ptr<IncData> data{new IncData{mvmgr, bnetwork}};
+  data->mIoList = make_io_list(module_list, lv_list);
+  auto& shadow{*data->mShadow};
+  auto& shadow_map{data->mShadowMap};
+
+  // 入力と DFF/ラッチの出力のビットに番号を振る．
+  SizeType src_id{0};
+  for ( auto& info: data->mIoList ) {
+    if ( info.mKind == IoKind::Output ) {
+      continue;
+    }
+    auto node{mvmgr.node(info.mNodeId)};
+    for ( SizeType b = 0; b < info.mBitWidth; ++ b ) {
+      shadow_map.put(node, b, BnNodeHandle{src_id});
+      ++ src_id;
+    }
+  }
+  ASSERT_COND( src_id < SHADOW_BASE );
+
+  // 組み合わせ回路部分をレベル順に変換する．
+  SizeType count{0};
+  for ( auto& lv: lv_list ) {
+    if ( mThreadNum > 1 && !lv.has_loop() ) {
+      if ( !conv_parallel(lv, shadow, shadow_map) ) {
+	return false;
+      }
+    }
+    else {
+      for ( auto node: lv.node_list() ) {
+	if ( is_comb(node) && !conv_node(node, shadow, shadow_map) ) {
+	  return false;
+	}
+      }
+    }
+    count += std::count_if(lv.node_list().begin(), lv.node_list().end(),
+			   is_comb);
+  }
+
+  data->mFFList = make_ff_list(mvmgr, data->mIoList, shadow, shadow_map);
+  emit(mvmgr, *data, bnetwork, mvnode_map);
+
+  // 次回の差分変換のために構造を記録しておく．
+  SizeType n{mvmgr.max_node_id()};
+  data->mRecArray.resize(n);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    auto node{mvmgr.node(i)};
+    if ( node != nullptr ) {
+      data->mRecArray[i] = node_rec(node);
+    }
+  }
+  mIncData.swap(data);
+  mConvNum = count;
+
+  return true;
+}
+
+// @brief 組み合わせ回路部分をレベルごとに並列に変換する．
+bool
+MvnBnConv::conv_parallel(
+  const MvnLevelizer& lv,
+  BitBuilder& builder,
+  MvnBnMap& nodemap
+) const
+{
+  // 同じレベルのノードは互いに依存しない．
+  vector<vector<const MvnNode*>> level_list(lv.max_level() + 1);
+  for ( auto node: lv.node_list() ) {
+    if ( is_comb(node) ) {
+      level_list[lv.level(node->id())].push_back(node);
+    }
+  }
+
+  for ( auto& node_list: level_list ) {
+    SizeType n{node_list.size()};
+    if ( n == 0 ) {
+      continue;
+    }
+
+    // ノードごとに別々のバッファに変換する．
+    // ファンインは前のレベルで併合済みなので nodemap から読むだけでよい．
+    // 各スレッドは自分の変換したノードの領域にのみ書き込む．
+    vector<BufBuilder> buf_list(n);
+    vector<char> ok_list(n, 0);
+    std::atomic<SizeType> next_pos{0};
+    auto worker = [&]() {
+      for ( ; ; ) {
+	SizeType pos{next_pos ++};
+	if ( pos >= n ) {
+	  break;
+	}
+	ok_list[pos] = conv_node(node_list[pos], buf_list[pos], nodemap);
+      }
+    };
+    SizeType nt{std::min(mThreadNum, n)};
+    if ( nt == 1 ) {
+      worker();
+    }
+    else {
+      vector<std::thread> thread_list;
+      thread_list.reserve(nt - 1);
+      for ( SizeType tid = 1; tid < nt; ++ tid ) {
+	thread_list.push_back(std::thread{worker});
+      }
+      worker();
+      for ( auto& th: thread_list ) {
+	th.join();
+      }
+    }
+    for ( auto ok: ok_list ) {
+      if ( !ok ) {
+	return false;
+      }
+    }
+
+    // ノードの順に併合する．
+    for ( SizeType pos = 0; pos < n; ++ pos ) {
+      auto node{node_list[pos]};
+      auto& buf{buf_list[pos]};
+      buf.replay(builder);
+      for ( SizeType b = 0; b < node->bit_width(); ++ b ) {
+	nodemap.put(node, b, buf.translate(nodemap.get(node, b)));
+      }
+    }
+  }
+  return true;
+}
+
+// @brief 組み合わせ回路のノードをビットレベルのゲートに変換する．
+bool
+MvnBnConv::conv_node(
+  const MvnNode* node,
+  BitBuilder& builder,
+  MvnBnMap& nodemap
+) const
+{
+  for ( auto& conv: mConvList ) {
+    if ( (*conv)(node, builder, nodemap) ) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// @brief 影のネットワークから BnNetwork を作る．
+void
+MvnBnConv::emit(
+  const MvnMgr& mvmgr,
+  IncData& data,
+  BnNetwork& bnetwork,
+  MvnBnMap& mvnode_map
+) const
+{
+  auto& shadow{*data.mShadow};
+  auto& shadow_map{data.mShadowMap};
+  SizeType n{mvmgr.max_node_id()};
+
+  // 現在のノードのビットと DFF/ラッチの入力から
+  // たどれるゲートだけを作る．
+  vector<BnNodeHandle> root_list;
+  for ( SizeType i = 0; i < n; ++ i ) {
+    auto node{mvmgr.node(i)};
+    if ( node == nullptr ) {
+      continue;
+    }
+    for ( SizeType b = 0; b < node->bit_width(); ++ b ) {
+      root_list.push_back(shadow_map.get(node, b));
+    }
+  }
+  for ( auto& ff: data.mFFList ) {
+    root_list.insert(root_list.end(), ff.mDataList.begin(), ff.mDataList.end());
+    root_list.push_back(ff.mClock);
+    root_list.insert(root_list.end(), ff.mClearList.begin(), ff.mClearList.end());
+    root_list.insert(root_list.end(), ff.mPresetList.begin(), ff.mPresetList.end());
+  }
+  auto mark{shadow.live_mark(root_list)};
+
+  // ポートと DFF/ラッチを作る．
+  BnModifier bnmod;
+  BnBuilder builder{bnmod};
+  vector<BnNodeHandle> src_list;
+  vector<SizeType> oport_list;
+  vector<vector<SizeType>> dff_list;
+  for ( auto& info: data.mIoList ) {
+    SizeType bw{info.mBitWidth};
+    switch ( info.mKind ) {
+    case IoKind::Input:
+      {
+	auto port{bnmod.new_input_port(info.mName, bw)};
+	for ( SizeType b = 0; b < bw; ++ b ) {
+	  src_list.push_back(BnNodeHandle{port.bit(b).id()});
+	}
+      }
+      break;
+
+    case IoKind::Dff:
+    case IoKind::Latch:
+      {
+	bool has_ctrl{info.mCtrlNum > 0};
+	vector<SizeType> id_list(bw);
+	for ( SizeType b = 0; b < bw; ++ b ) {
+	  ostringstream buf;
+	  buf << "node" << info.mNodeId << "[" << b << "]";
+	  auto dff{info.mKind == IoKind::Dff ?
+		   bnmod.new_dff(buf.str(), has_ctrl, has_ctrl) :
+		   bnmod.new_latch(buf.str(), false, false)};
+	  id_list[b] = dff.id();
+	  src_list.push_back(BnNodeHandle{dff.data_out().id()});
+	}
+	dff_list.push_back(id_list);
+      }
+      break;
+
+    case IoKind::Output:
+      oport_list.push_back(bnmod.new_output_port(info.mName, bw).id());
+      break;
+    }
+  }
+
+  // ゲートを作る．
+  shadow.replay(builder, mark, src_list);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    auto node{mvmgr.node(i)};
+    if ( node == nullptr ) {
+      continue;
+    }
+    for ( SizeType b = 0; b < node->bit_width(); ++ b ) {
+      auto h{shadow_map.get(node, b)};
+      if ( h.is_valid() ) {
+	mvnode_map.put(node, b, shadow.translate(h));
+      }
+    }
+  }
+
+  // 出力ポートと DFF/ラッチの入力を接続する．
+  auto real_node = [&](BnNodeHandle h) {
+    return builder.node(shadow.translate(h));
+  };
+  SizeType opos{0};
+  SizeType fpos{0};
+  for ( auto& info: data.mIoList ) {
+    if ( info.mKind == IoKind::Output ) {
+      auto node{mvmgr.node(info.mNodeId)};
+      auto port{bnmod.port(oport_list[opos])};
+      ++ opos;
+      for ( SizeType b = 0; b < info.mBitWidth; ++ b ) {
+	bnmod.set_output_src(port.bit(b), real_node(shadow_map.get(node, b)));
+      }
+    }
+    else if ( info.mKind != IoKind::Input ) {
+      auto& ff{data.mFFList[fpos]};
+      auto& id_list{dff_list[fpos]};
+      ++ fpos;
+      for ( SizeType b = 0; b < info.mBitWidth; ++ b ) {
+	auto dff{bnmod.dff(id_list[b])};
+	bnmod.set_output_src(dff.data_in(), real_node(ff.mDataList[b]));
+	bnmod.set_output_src(dff.clock(), real_node(ff.mClock));
+	if ( !ff.mClearList.empty() ) {
+	  bnmod.set_output_src(dff.clear(), real_node(ff.mClearList[b]));
+	  bnmod.set_output_src(dff.preset(), real_node(ff.mPresetList[b]));
+	}
+      }
+    }
+  }
+  bnetwork = BnNetwork{std::move(bnmod)};
+
+  // 参照されないゲートの方が多くなったら影のネットワークを詰める．
+  SizeType live_num = std::count(mark.begin(), mark.end(), true);
+  if ( shadow.gate_num() > live_num * 2 ) {
+    unique_ptr<BufBuilder> new_shadow{new BufBuilder{SHADOW_BASE}};
+    shadow.replay(*new_shadow, mark, {});
+    for ( SizeType i = 0; i < n; ++ i ) {
+      auto node{mvmgr.node(i)};
+      if ( node == nullptr ) {
+	continue;
+      }
+      for ( SizeType b = 0; b < node->bit_width(); ++ b ) {
+	auto h{shadow_map.get(node, b)};
+	if ( h.is_valid() ) {
+	  shadow_map.put(node, b, shadow.translate(h));
+	}
+      }
+    }
+    for ( auto& ff: data.mFFList ) {
+      for ( auto& h: ff.mDataList ) {
+	h = shadow.translate(h);
+      }
+      ff.mClock = shadow.translate(ff.mClock);
+      for ( auto& h: ff.mClearList ) {
+	h = shadow.translate(h);
+      }
+      for ( auto& h: ff.mPresetList ) {
+	h = shadow.translate(h);
+      }
+    }
+    data.mShadow.swap(new_shadow);
+  }
+}
+
+// @brief ノードの構造を記録する．
+MvnBnConv::NodeRec
+MvnBnConv::node_rec(
+  const MvnNode* node
+) const
+{
+  NodeRec rec;
+  rec.mValid = true;
+  auto type{node->type()};
+  rec.mType = type;
+  auto& attr_list{rec.mAttrList};
+  attr_list.push_back(node->bit_width());
+
+  // セルノードは代表ノードの入力を参照する．
+  auto rep{type == MvnNodeType::CELL ? node->cell_node() : node};
+  SizeType ni{rep->input_num()};
+  attr_list.push_back(ni);
+  for ( SizeType i = 0; i < ni; ++ i ) {
+    auto ipin{rep->input(i)};
+    auto src{ipin->src_node()};
+    attr_list.push_back(ipin->bit_width());
+    attr_list.push_back(src != nullptr ? src->id() + 1 : 0);
+  }
+
+  switch ( type ) {
+  case MvnNodeType::DFF:
+    attr_list.push_back(static_cast<SizeType>(node->clock_pol()));
+    for ( SizeType i = 0; i + 2 < ni; ++ i ) {
+      attr_list.push_back(static_cast<SizeType>(node->control_pol(i)));
+      rec.mConstList.push_back(node->control_val(i)->const_value());
+    }
+    break;
+
+  case MvnNodeType::CONSTVALUE:
+    rec.mConstList.push_back(node->const_value());
+    break;
+
+  case MvnNodeType::CASEEQ:
+    rec.mConstList.push_back(node->xmask());
+    break;
+
+  case MvnNodeType::CONSTBITSELECT:
+    attr_list.push_back(node->bitpos());
+    break;
+
+  case MvnNodeType::CONSTPARTSELECT:
+    attr_list.push_back(node->msb());
+    attr_list.push_back(node->lsb());
+    break;
+
+  case MvnNodeType::CELL:
+    rec.mCellName = node->cell().name();
+    attr_list.push_back(node->cell_opin_pos());
+    attr_list.push_back(rep->id());
+    break;
+
+  case MvnNodeType::LT:
+  case MvnNodeType::CMPL:
+  case MvnNodeType::ADD:
+  case MvnNodeType::SUB:
+  case MvnNodeType::MUL:
+  case MvnNodeType::DIV:
+  case MvnNodeType::MOD:
+  case MvnNodeType::POW:
+    {
+      auto& arch{arith_arch(node)};
+      attr_list.push_back(static_cast<SizeType>(arch.mAdder));
+      attr_list.push_back(static_cast<SizeType>(arch.mMult));
+      attr_list.push_back(arch.mBooth ? 1 : 0);
+    }
+    break;
+
+  default:
+    break;
+  }
+  return rec;
+}
+
+END_NAMESPACE_YM_MVN
@@ -0,0 +1,162 @@
+﻿
+/// @file MvnBnMap.cc
+/// @brief MvnBnMap の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2016, 2021, 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/MvnBnMap.h"
+#include "ym/MvnMgr.h"
+#include "ym/MvnNode.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+// クラス MvnBnMap
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+MvnBnMap::MvnBnMap(
+  const MvnMgr& mgr
+) : mOffsetArray(mgr.max_node_id() + 1, 0)
+{
+  SizeType n{mgr.max_node_id()};
+  for ( SizeType i = 0; i < n; ++ i ) {
+    auto node{mgr.node(i)};
+    SizeType bw{node != nullptr ? node->bit_width() : 0};
+    mOffsetArray[i + 1] = mOffsetArray[i] + bw;
+  }
+  mHandleArray.resize(mOffsetArray[n]);
+}
+
+// @brief デストラクタ
+MvnBnMap::~MvnBnMap()
+{
+}
+
+// @brief 登録する．(1ビット版)
+void
+MvnBnMap::put(
+  const MvnNode* mvnode,
+  BnNodeHandle handle
+)
+{
+  ASSERT_COND( mvnode->bit_width() == 1 );
+  put(mvnode, 0, handle);
+}
+
+// @brief 登録する．(ベクタ版)
+void
+MvnBnMap::put(
+  const MvnNode* mvnode,
+  int index,
+  BnNodeHandle handle
+)
+{
+  SizeType bw{mvnode->bit_width()};
+  ASSERT_COND( 0 <= index && static_cast<SizeType>(index) < bw );
+  SizeType id{static_cast<SizeType>(mvnode->id())};
+  if ( slot_size(id) != bw ) {
+    // コンストラクタの後で作られたか，ビット幅の変わったノード
+    resize_slot(id, bw);
+  }
+  ASSERT_COND( static_cast<SizeType>(index) < slot_size(id) );
+  mHandleArray[mOffsetArray[id] + index] = handle;
+}
+
+// @brief 探す．(1ビット版)
+BnNodeHandle
+MvnBnMap::get(
+  const MvnNode* mvnode
+) const
+{
+  ASSERT_COND( mvnode->bit_width() == 1 );
+  return get(mvnode, 0);
+}
+
+// @brief 探す．(ベクタ版)
+BnNodeHandle
+MvnBnMap::get(
+  const MvnNode* mvnode,
+  int index
+) const
+{
+  SizeType bw{mvnode->bit_width()};
+  ASSERT_COND( 0 <= index && static_cast<SizeType>(index) < bw );
+  SizeType id{static_cast<SizeType>(mvnode->id())};
+  if ( slot_size(id) != bw ) {
+    // 登録されていないノード
+    return BnNodeHandle{};
+  }
+  ASSERT_COND( static_cast<SizeType>(index) < slot_size(id) );
+  // 登録されていない場合は不正値のままになっている．
+  return mHandleArray[mOffsetArray[id] + index];
+}
+
+// @brief ノードの格納領域の大きさを返す．
+SizeType
+MvnBnMap::slot_size(
+  SizeType id
+) const
+{
+  if ( id + 1 >= mOffsetArray.size() ) {
+    return 0;
+  }
+  return mOffsetArray[id + 1] - mOffsetArray[id];
+}
+
+// @brief ノードの格納領域の大きさを変える．
+void
+MvnBnMap::resize_slot(
+  SizeType id,
+  SizeType bw
+)
+{
+  SizeType old_n{mOffsetArray.size() - 1};
+  SizeType new_n{std::max(old_n, id + 1)};
+  vector<SizeType> offset_array(new_n + 1, 0);
+  for ( SizeType i = 0; i < new_n; ++ i ) {
+    SizeType size{i == id ? bw : slot_size(i)};
+    offset_array[i + 1] = offset_array[i] + size;
+  }
+  vector<BnNodeHandle> handle_array(offset_array[new_n]);
+  for ( SizeType i = 0; i < old_n; ++ i ) {
+    if ( i == id ) {
+      // 以前の内容は別のノードのものなので捨てる．
+      continue;
+    }
+    auto src{mHandleArray.begin() + mOffsetArray[i]};
+    std::copy(src, src + slot_size(i), handle_array.begin() + offset_array[i]);
+  }
+  mOffsetArray.swap(offset_array);
+  mHandleArray.swap(handle_array);
+}
+
+// @brief MvnBnMap の内容を出力する．
+void
+dump_mvnode_map(
+  ostream& s,
+  const MvnMgr& mvmgr,
+  const MvnBnMap& mvnode_map
+)
+{
+  SizeType n{mvmgr.max_node_id()};
+  for ( SizeType i = 0; i < n; ++ i ) {
+    auto node{mvmgr.node(i)};
+    if ( node == nullptr ) {
+      continue;
+    }
+    SizeType bw{node->bit_width()};
+    for ( SizeType j = 0; j < bw; ++ j ) {
+      s << "// node" << node->id();
+      if ( bw > 1 ) {
+	s << " [" << j << "]";
+      }
+      s << " : " << mvnode_map.get(node, j) << endl;
+    }
+  }
+}
+
+END_NAMESPACE_YM_MVN
@@ -0,0 +1,94 @@
+﻿
+/// @file MvnCellConv.cc
+/// @brief MvnCellConv の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "MvnConv.h"
+#include "BitBuilder.h"
+#include "ym/MvnBnMap.h"
+#include "ym/MvnNode.h"
+#include "ym/ClibCell.h"
+#include "ym/Expr.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+BEGIN_NONAMESPACE
+
+// 論理式をゲートに変換する．
+BnNodeHandle
+conv_expr(
+  const Expr& expr,
+  const vector<BnNodeHandle>& input_list,
+  BitBuilder& builder
+)
+{
+  if ( expr.is_zero() ) {
+    return BnNodeHandle::zero();
+  }
+  if ( expr.is_one() ) {
+    return BnNodeHandle::one();
+  }
+  if ( expr.is_posi_literal() ) {
+    return input_list[expr.varid()];
+  }
+  if ( expr.is_nega_literal() ) {
+    return ~input_list[expr.varid()];
+  }
+  SizeType n{expr.operand_num()};
+  vector<BnNodeHandle> fanin_list(n);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    fanin_list[i] = conv_expr(expr.operand(i), input_list, builder);
+  }
+  if ( expr.is_and() ) {
+    return builder.make_and(fanin_list);
+  }
+  if ( expr.is_or() ) {
+    return builder.make_or(fanin_list);
+  }
+  if ( expr.is_xor() ) {
+    return builder.make_xor(fanin_list);
+  }
+  ASSERT_NOT_REACHED;
+  return BnNodeHandle{};
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス MvnCellConv
+//////////////////////////////////////////////////////////////////////
+
+// @brief MvnNode をビットレベルのゲートに変換する．
+bool
+MvnCellConv::operator()(
+  const MvnNode* node,
+  BitBuilder& builder,
+  MvnBnMap& nodemap
+)
+{
+  if ( node->type() != MvnNodeType::CELL ) {
+    return false;
+  }
+
+  auto cell{node->cell()};
+  SizeType opos = node->cell_opin_pos();
+  auto ans{BnNodeHandle::zero()};
+  if ( cell.has_logic(opos) ) {
+    SizeType ni{node->cell_node()->input_num()};
+    vector<BnNodeHandle> input_list(ni);
+    for ( SizeType i = 0; i < ni; ++ i ) {
+      auto ibits{input_bits(node, i, nodemap)};
+      input_list[i] = ibits.empty() ? BnNodeHandle::zero() : ibits[0];
+    }
+    ans = conv_expr(cell.logic_expr(opos), input_list, builder);
+  }
+  put_bits(node, {ans}, nodemap);
+  return true;
+}
+
+END_NAMESPACE_YM_MVN
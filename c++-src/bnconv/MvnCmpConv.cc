@@ -0,0 +1,69 @@
+﻿
+/// @file MvnCmpConv.cc
+/// @brief MvnCmpConv の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "MvnConv.h"
+#include "BitBuilder.h"
+#include "ym/MvnBnMap.h"
+#include "ym/MvnNode.h"
+#include "ym/MvnBvConst.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+// クラス MvnCmpConv
+//////////////////////////////////////////////////////////////////////
+
+// @brief MvnNode をビットレベルのゲートに変換する．
+bool
+MvnCmpConv::operator()(
+  const MvnNode* node,
+  BitBuilder& builder,
+  MvnBnMap& nodemap
+)
+{
+  auto type{node->type()};
+  if ( type != MvnNodeType::EQ &&
+       type != MvnNodeType::CASEEQ &&
+       type != MvnNodeType::LT ) {
+    return false;
+  }
+
+  auto abits{input_bits(node, 0, nodemap)};
+  auto bbits{input_bits(node, 1, nodemap)};
+  SizeType iw{abits.size()};
+  SizeType bw{std::max(abits.size(), bbits.size())};
+  abits = ext_bits(abits, bw);
+  bbits = ext_bits(bbits, bw);
+
+  BnNodeHandle ans;
+  if ( type == MvnNodeType::LT ) {
+    make_subtractor(builder, abits, bbits, &ans,
+		    mConv.arith_arch(node).mAdder);
+  }
+  else {
+    MvnBvConst xmask;
+    if ( type == MvnNodeType::CASEEQ ) {
+      xmask = node->xmask();
+    }
+    vector<BnNodeHandle> eq_list;
+    eq_list.reserve(bw);
+    for ( SizeType b = 0; b < bw; ++ b ) {
+      if ( b < iw && b < xmask.size() && xmask[b] ) {
+	// ドントケアのビットは比較しない．
+	continue;
+      }
+      eq_list.push_back(~builder.make_xor(abits[b], bbits[b]));
+    }
+    ans = builder.make_and(eq_list);
+  }
+  put_bits(node, {ans}, nodemap);
+  return true;
+}
+
+END_NAMESPACE_YM_MVN
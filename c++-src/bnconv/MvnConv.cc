@@ -0,0 +1,456 @@
+﻿
+/// @file MvnConv.cc
+/// @brief MvnConv の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "MvnConv.h"
+#include "BitBuilder.h"
+#include "MvnLevelizer.h"
+#include "ym/MvnBnMap.h"
+#include "ym/MvnNode.h"
+#include "ym/MvnInputPin.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+// クラス MvnConv
+//////////////////////////////////////////////////////////////////////
+
+// @brief ファンインのビットベクタを得る．
+vector<BnNodeHandle>
+MvnConv::input_bits(
+  const MvnNode* node,
+  SizeType pos,
+  const MvnBnMap& nodemap
+)
+{
+  auto src{MvnLevelizer::fanin(node, pos)};
+  if ( src == nullptr ) {
+    auto rep{node->type() == MvnNodeType::CELL ? node->cell_node() : node};
+    return vector<BnNodeHandle>(rep->input(pos)->bit_width(),
+				BnNodeHandle::zero());
+  }
+  SizeType bw{src->bit_width()};
+  vector<BnNodeHandle> bits(bw);
+  for ( SizeType b = 0; b < bw; ++ b ) {
+    bits[b] = nodemap.get(src, b);
+    ASSERT_COND( bits[b].is_valid() );
+  }
+  return bits;
+}
+
+// @brief ノードのビットベクタを登録する．
+void
+MvnConv::put_bits(
+  const MvnNode* node,
+  const vector<BnNodeHandle>& bits,
+  MvnBnMap& nodemap
+)
+{
+  SizeType bw{node->bit_width()};
+  for ( SizeType b = 0; b < bw; ++ b ) {
+    nodemap.put(node, b, b < bits.size() ? bits[b] : BnNodeHandle::zero());
+  }
+}
+
+// @brief 0 拡張もしくは切り詰めを行う．
+vector<BnNodeHandle>
+MvnConv::ext_bits(
+  const vector<BnNodeHandle>& bits,
+  SizeType bw
+)
+{
+  vector<BnNodeHandle> ans(bw, BnNodeHandle::zero());
+  SizeType n{std::min(bw, bits.size())};
+  for ( SizeType b = 0; b < n; ++ b ) {
+    ans[b] = bits[b];
+  }
+  return ans;
+}
+
+// @brief 全ビットが 0 でない時 1 となる信号を作る．
+BnNodeHandle
+MvnConv::make_nonzero(
+  BitBuilder& builder,
+  const vector<BnNodeHandle>& bits
+)
+{
+  return builder.make_or(bits);
+}
+
+// @brief 加算器を作る．
+vector<BnNodeHandle>
+MvnConv::make_adder(
+  BitBuilder& builder,
+  const vector<BnNodeHandle>& a,
+  const vector<BnNodeHandle>& b,
+  BnNodeHandle cin,
+  BnNodeHandle* cout,
+  MvnAdderArch arch
+)
+{
+  ASSERT_COND( a.size() == b.size() );
+
+  SizeType n{a.size()};
+  vector<BnNodeHandle> ans(n);
+  if ( arch == MvnAdderArch::RippleCarry || n <= 1 ) {
+    // リップルキャリー加算器
+    auto c{cin};
+    for ( SizeType i = 0; i < n; ++ i ) {
+      auto p{builder.make_xor(a[i], b[i])};
+      ans[i] = builder.make_xor(p, c);
+      c = builder.make_or(builder.make_and(a[i], b[i]),
+			  builder.make_and(p, c));
+    }
+    if ( cout != nullptr ) {
+      *cout = c;
+    }
+    return ans;
+  }
+
+  // 並列プレフィックス加算器
+  // g[i], p[i] は i ビット目までの generate/propagate 信号
+  // キャリー入力は 0 ビット目の generate に含めておく．
+  vector<BnNodeHandle> p(n);
+  vector<BnNodeHandle> g(n);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    p[i] = builder.make_xor(a[i], b[i]);
+    g[i] = builder.make_and(a[i], b[i]);
+  }
+  auto p0{p};
+  g[0] = builder.make_or(g[0], builder.make_and(p[0], cin));
+
+  // (g[i], p[i]) に (g[j], p[j]) を結合する．
+  auto combine = [&](SizeType i, SizeType j) {
+    g[i] = builder.make_or(g[i], builder.make_and(p[i], g[j]));
+    p[i] = builder.make_and(p[i], p[j]);
+  };
+
+  if ( arch == MvnAdderArch::KoggeStone ) {
+    for ( SizeType d = 1; d < n; d <<= 1 ) {
+      // 上位から処理すれば同じ段の結果を参照せずに済む．
+      for ( SizeType i = n - 1; i >= d; -- i ) {
+	combine(i, i - d);
+      }
+    }
+  }
+  else {
+    // Brent-Kung: 上りの木で 2^k - 1 ビット目を求めてから
+    // 下りの木で残りのビットを埋める．
+    // top は n 未満の最大の 2 のべき乗
+    SizeType top{1};
+    while ( top * 2 < n ) {
+      top <<= 1;
+    }
+    for ( SizeType d = 1; d <= top; d <<= 1 ) {
+      for ( SizeType i = d * 2 - 1; i < n; i += d * 2 ) {
+	combine(i, i - d);
+      }
+    }
+    for ( SizeType d = top / 2; d >= 1; d >>= 1 ) {
+      for ( SizeType i = d * 3 - 1; i < n; i += d * 2 ) {
+	combine(i, i - d);
+      }
+    }
+  }
+
+  ans[0] = builder.make_xor(p0[0], cin);
+  for ( SizeType i = 1; i < n; ++ i ) {
+    ans[i] = builder.make_xor(p0[i], g[i - 1]);
+  }
+  if ( cout != nullptr ) {
+    *cout = g[n - 1];
+  }
+  return ans;
+}
+
+// @brief 減算器を作る．
+vector<BnNodeHandle>
+MvnConv::make_subtractor(
+  BitBuilder& builder,
+  const vector<BnNodeHandle>& a,
+  const vector<BnNodeHandle>& b,
+  BnNodeHandle* borrow,
+  MvnAdderArch arch
+)
+{
+  // a - b = a + ~b + 1
+  SizeType n{b.size()};
+  vector<BnNodeHandle> nb(n);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    nb[i] = ~b[i];
+  }
+  BnNodeHandle cout;
+  auto ans{make_adder(builder, a, nb, BnNodeHandle::one(), &cout, arch)};
+  if ( borrow != nullptr ) {
+    *borrow = ~cout;
+  }
+  return ans;
+}
+
+// @brief 乗算器を作る．
+vector<BnNodeHandle>
+MvnConv::make_multiplier(
+  BitBuilder& builder,
+  const vector<BnNodeHandle>& a,
+  const vector<BnNodeHandle>& b,
+  SizeType bw,
+  const MvnArithArch& arch
+)
+{
+  // 部分積を作る．
+  // 結果は下位 bw ビットしか必要ないので各部分積も bw ビットで切り詰める．
+  vector<vector<BnNodeHandle>> pp_list;
+  if ( arch.mBooth ) {
+    // radix-4 の Booth 符号化
+    // b を 2 ビットずつ区切って {-2, -1, 0, 1, 2} の桁に置き換える．
+    // 負の部分積は 1 の補数で表して，最後の +1 を別の行にまとめる．
+    auto a1{ext_bits(a, bw)};
+    auto b1{ext_bits(b, bw)};
+    vector<BnNodeHandle> neg_row(bw, BnNodeHandle::zero());
+    for ( SizeType i = 0; i < bw; i += 2 ) {
+      auto bh{i + 1 < bw ? b1[i + 1] : BnNodeHandle::zero()};
+      auto bm{b1[i]};
+      auto bl{i > 0 ? b1[i - 1] : BnNodeHandle::zero()};
+      auto neg{bh};
+      auto one{builder.make_xor(bm, bl)};
+      auto two{builder.make_or(builder.make_and({bh, ~bm, ~bl}),
+			       builder.make_and({~bh, bm, bl}))};
+      vector<BnNodeHandle> pp(bw, BnNodeHandle::zero());
+      for ( SizeType j = 0; j + i < bw; ++ j ) {
+	auto m1{builder.make_and(one, a1[j])};
+	auto m2{j > 0 ? builder.make_and(two, a1[j - 1]) : BnNodeHandle::zero()};
+	pp[j + i] = builder.make_xor(builder.make_or(m1, m2), neg);
+      }
+      pp_list.push_back(pp);
+      neg_row[i] = neg;
+    }
+    pp_list.push_back(neg_row);
+  }
+  else {
+    SizeType nb{std::min(b.size(), bw)};
+    for ( SizeType i = 0; i < nb; ++ i ) {
+      if ( b[i].is_zero() ) {
+	continue;
+      }
+      vector<BnNodeHandle> pp(bw, BnNodeHandle::zero());
+      for ( SizeType j = 0; j + i < bw && j < a.size(); ++ j ) {
+	pp[j + i] = builder.make_and(a[j], b[i]);
+      }
+      pp_list.push_back(pp);
+    }
+  }
+
+  if ( arch.mMult == MvnMultArch::Array ) {
+    // 部分積を順に足していくアレイ乗算器
+    vector<BnNodeHandle> acc(bw, BnNodeHandle::zero());
+    for ( auto& pp: pp_list ) {
+      acc = make_adder(builder, acc, pp, BnNodeHandle::zero(),
+		       nullptr, arch.mAdder);
+    }
+    return acc;
+  }
+
+  // 桁ごとのビットのリストに直して全加算器と半加算器で圧縮する．
+  vector<vector<BnNodeHandle>> col_list(bw);
+  for ( auto& pp: pp_list ) {
+    for ( SizeType i = 0; i < bw; ++ i ) {
+      if ( !pp[i].is_zero() ) {
+	col_list[i].push_back(pp[i]);
+      }
+    }
+  }
+  if ( arch.mMult == MvnMultArch::Wallace ) {
+    reduce_wallace(builder, col_list);
+  }
+  else {
+    reduce_dadda(builder, col_list);
+  }
+
+  // 残った2行を最終段の加算器で足す．
+  vector<BnNodeHandle> row0(bw, BnNodeHandle::zero());
+  vector<BnNodeHandle> row1(bw, BnNodeHandle::zero());
+  for ( SizeType i = 0; i < bw; ++ i ) {
+    auto& col{col_list[i]};
+    ASSERT_COND( col.size() <= 2 );
+    if ( col.size() > 0 ) {
+      row0[i] = col[0];
+    }
+    if ( col.size() > 1 ) {
+      row1[i] = col[1];
+    }
+  }
+  return make_adder(builder, row0, row1, BnNodeHandle::zero(),
+		    nullptr, arch.mAdder);
+}
+
+// @brief Wallace tree で部分積を圧縮する．
+void
+MvnConv::reduce_wallace(
+  BitBuilder& builder,
+  vector<vector<BnNodeHandle>>& col_list
+)
+{
+  SizeType bw{col_list.size()};
+  for ( ; ; ) {
+    SizeType max_h{0};
+    for ( auto& col: col_list ) {
+      max_h = std::max(max_h, col.size());
+    }
+    if ( max_h <= 2 ) {
+      break;
+    }
+    // 各桁のビットを3つずつ全加算器でまとめる．
+    vector<vector<BnNodeHandle>> next_list(bw);
+    for ( SizeType i = 0; i < bw; ++ i ) {
+      auto& col{col_list[i]};
+      SizeType n{col.size()};
+      if ( n <= 2 ) {
+	next_list[i].insert(next_list[i].end(), col.begin(), col.end());
+	continue;
+      }
+      SizeType pos{0};
+      for ( ; pos + 3 <= n; pos += 3 ) {
+	auto x{col[pos + 0]};
+	auto y{col[pos + 1]};
+	auto z{col[pos + 2]};
+	next_list[i].push_back(builder.make_xor({x, y, z}));
+	if ( i + 1 < bw ) {
+	  next_list[i + 1].push_back(make_majority(builder, x, y, z));
+	}
+      }
+      if ( pos + 2 == n ) {
+	auto x{col[pos + 0]};
+	auto y{col[pos + 1]};
+	next_list[i].push_back(builder.make_xor(x, y));
+	if ( i + 1 < bw ) {
+	  next_list[i + 1].push_back(builder.make_and(x, y));
+	}
+      }
+      else if ( pos + 1 == n ) {
+	next_list[i].push_back(col[pos]);
+      }
+    }
+    col_list.swap(next_list);
+  }
+}
+
+// @brief Dadda tree で部分積を圧縮する．
+void
+MvnConv::reduce_dadda(
+  BitBuilder& builder,
+  vector<vector<BnNodeHandle>>& col_list
+)
+{
+  SizeType bw{col_list.size()};
+  SizeType max_h{0};
+  for ( auto& col: col_list ) {
+    max_h = std::max(max_h, col.size());
+  }
+  // 各段の目標の高さ d(1) = 2, d(j + 1) = floor(1.5 * d(j))
+  vector<SizeType> target_list{2};
+  while ( target_list.back() < max_h ) {
+    target_list.push_back(target_list.back() * 3 / 2);
+  }
+  target_list.pop_back();
+
+  for ( SizeType k = target_list.size(); k > 0; -- k ) {
+    SizeType d{target_list[k - 1]};
+    vector<vector<BnNodeHandle>> next_list(bw);
+    for ( SizeType i = 0; i < bw; ++ i ) {
+      // 下位の桁からのキャリーは next_list[i] に入っている．
+      auto& col{col_list[i]};
+      auto& next{next_list[i]};
+      SizeType n{col.size()};
+      SizeType pos{0};
+      // 高さは残りのビット数とこの段で作ったビット数の和
+      while ( n - pos + next.size() > d ) {
+	SizeType h{n - pos + next.size()};
+	if ( h - d >= 2 && pos + 3 <= n ) {
+	  auto x{col[pos + 0]};
+	  auto y{col[pos + 1]};
+	  auto z{col[pos + 2]};
+	  next.push_back(builder.make_xor({x, y, z}));
+	  if ( i + 1 < bw ) {
+	    next_list[i + 1].push_back(make_majority(builder, x, y, z));
+	  }
+	  pos += 3;
+	}
+	else if ( pos + 2 <= n ) {
+	  auto x{col[pos + 0]};
+	  auto y{col[pos + 1]};
+	  next.push_back(builder.make_xor(x, y));
+	  if ( i + 1 < bw ) {
+	    next_list[i + 1].push_back(builder.make_and(x, y));
+	  }
+	  pos += 2;
+	}
+	else {
+	  break;
+	}
+      }
+      next.insert(next.end(), col.begin() + pos, col.end());
+    }
+    col_list.swap(next_list);
+  }
+}
+
+// @brief 多数決関数を作る．
+BnNodeHandle
+MvnConv::make_majority(
+  BitBuilder& builder,
+  BnNodeHandle x,
+  BnNodeHandle y,
+  BnNodeHandle z
+)
+{
+  return builder.make_or({builder.make_and(x, y),
+			  builder.make_and(x, z),
+			  builder.make_and(y, z)});
+}
+
+// @brief バレルシフタを作る．
+vector<BnNodeHandle>
+MvnConv::make_shifter(
+  BitBuilder& builder,
+  const vector<BnNodeHandle>& a,
+  const vector<BnNodeHandle>& sft,
+  bool left,
+  BnNodeHandle fill
+)
+{
+  SizeType n{a.size()};
+  auto cur{a};
+  // シフト量が n 以上になる条件
+  auto ovf{BnNodeHandle::zero()};
+  for ( SizeType k = 0; k < sft.size(); ++ k ) {
+    if ( k >= 64 || (1ULL << k) >= n ) {
+      ovf = builder.make_or(ovf, sft[k]);
+      continue;
+    }
+    SizeType amount{1ULL << k};
+    vector<BnNodeHandle> next(n);
+    for ( SizeType j = 0; j < n; ++ j ) {
+      BnNodeHandle shifted;
+      if ( left ) {
+	shifted = j >= amount ? cur[j - amount] : BnNodeHandle::zero();
+      }
+      else {
+	shifted = j + amount < n ? cur[j + amount] : fill;
+      }
+      next[j] = builder.make_mux(sft[k], shifted, cur[j]);
+    }
+    cur.swap(next);
+  }
+  auto ofill{left ? BnNodeHandle::zero() : fill};
+  for ( SizeType j = 0; j < n; ++ j ) {
+    cur[j] = builder.make_mux(ovf, ofill, cur[j]);
+  }
+  return cur;
+}
+
+END_NAMESPACE_YM_MVN
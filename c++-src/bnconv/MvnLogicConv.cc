@@ -0,0 +1,121 @@
+﻿
+/// @file MvnLogicConv.cc
+/// @brief MvnConstConv, MvnLogicConv の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "MvnConv.h"
+#include "BitBuilder.h"
+#include "ym/MvnBnMap.h"
+#include "ym/MvnNode.h"
+#include "ym/MvnBvConst.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+// クラス MvnConstConv
+//////////////////////////////////////////////////////////////////////
+
+// @brief MvnNode をビットレベルのゲートに変換する．
+bool
+MvnConstConv::operator()(
+  const MvnNode* node,
+  BitBuilder& builder,
+  MvnBnMap& nodemap
+)
+{
+  if ( node->type() != MvnNodeType::CONSTVALUE ) {
+    return false;
+  }
+
+  auto val{node->const_value()};
+  SizeType bw{node->bit_width()};
+  vector<BnNodeHandle> bits(bw, BnNodeHandle::zero());
+  for ( SizeType b = 0; b < bw && b < val.size(); ++ b ) {
+    if ( val[b] ) {
+      bits[b] = BnNodeHandle::one();
+    }
+  }
+  put_bits(node, bits, nodemap);
+  return true;
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス MvnLogicConv
+//////////////////////////////////////////////////////////////////////
+
+// @brief MvnNode をビットレベルのゲートに変換する．
+bool
+MvnLogicConv::operator()(
+  const MvnNode* node,
+  BitBuilder& builder,
+  MvnBnMap& nodemap
+)
+{
+  SizeType ow{node->bit_width()};
+  switch ( node->type() ) {
+  case MvnNodeType::OUTPUT:
+  case MvnNodeType::INOUT:
+  case MvnNodeType::THROUGH:
+    put_bits(node, input_bits(node, 0, nodemap), nodemap);
+    return true;
+
+  case MvnNodeType::NOT:
+    {
+      auto bits{ext_bits(input_bits(node, 0, nodemap), ow)};
+      for ( auto& h: bits ) {
+	h = ~h;
+      }
+      put_bits(node, bits, nodemap);
+    }
+    return true;
+
+  case MvnNodeType::AND:
+  case MvnNodeType::OR:
+  case MvnNodeType::XOR:
+    {
+      SizeType ni{node->input_num()};
+      vector<vector<BnNodeHandle>> ibits_list(ni);
+      for ( SizeType i = 0; i < ni; ++ i ) {
+	ibits_list[i] = ext_bits(input_bits(node, i, nodemap), ow);
+      }
+      vector<BnNodeHandle> bits(ow);
+      vector<BnNodeHandle> fanin_list(ni);
+      for ( SizeType b = 0; b < ow; ++ b ) {
+	for ( SizeType i = 0; i < ni; ++ i ) {
+	  fanin_list[i] = ibits_list[i][b];
+	}
+	switch ( node->type() ) {
+	case MvnNodeType::AND: bits[b] = builder.make_and(fanin_list); break;
+	case MvnNodeType::OR:  bits[b] = builder.make_or(fanin_list); break;
+	case MvnNodeType::XOR: bits[b] = builder.make_xor(fanin_list); break;
+	default: break;
+	}
+      }
+      put_bits(node, bits, nodemap);
+    }
+    return true;
+
+  case MvnNodeType::RAND:
+    put_bits(node, {builder.make_and(input_bits(node, 0, nodemap))}, nodemap);
+    return true;
+
+  case MvnNodeType::ROR:
+    put_bits(node, {builder.make_or(input_bits(node, 0, nodemap))}, nodemap);
+    return true;
+
+  case MvnNodeType::RXOR:
+    put_bits(node, {builder.make_xor(input_bits(node, 0, nodemap))}, nodemap);
+    return true;
+
+  default:
+    break;
+  }
+  return false;
+}
+
+END_NAMESPACE_YM_MVN
@@ -0,0 +1,98 @@
+﻿
+/// @file MvnSelectConv.cc
+/// @brief MvnSelectConv の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "MvnConv.h"
+#include "BitBuilder.h"
+#include "ym/MvnBnMap.h"
+#include "ym/MvnNode.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+// クラス MvnSelectConv
+//////////////////////////////////////////////////////////////////////
+
+// @brief MvnNode をビットレベルのゲートに変換する．
+bool
+MvnSelectConv::operator()(
+  const MvnNode* node,
+  BitBuilder& builder,
+  MvnBnMap& nodemap
+)
+{
+  SizeType ow{node->bit_width()};
+  switch ( node->type() ) {
+  case MvnNodeType::ITE:
+    {
+      auto c{make_nonzero(builder, input_bits(node, 0, nodemap))};
+      auto bits1{ext_bits(input_bits(node, 1, nodemap), ow)};
+      auto bits2{ext_bits(input_bits(node, 2, nodemap), ow)};
+      vector<BnNodeHandle> bits(ow);
+      for ( SizeType b = 0; b < ow; ++ b ) {
+	bits[b] = builder.make_mux(c, bits1[b], bits2[b]);
+      }
+      put_bits(node, bits, nodemap);
+    }
+    return true;
+
+  case MvnNodeType::CONCAT:
+    {
+      // 最後の入力が LSB 側になる．
+      vector<BnNodeHandle> bits;
+      bits.reserve(ow);
+      SizeType ni{node->input_num()};
+      for ( SizeType i = ni; i > 0; -- i ) {
+	auto ibits{input_bits(node, i - 1, nodemap)};
+	bits.insert(bits.end(), ibits.begin(), ibits.end());
+      }
+      put_bits(node, bits, nodemap);
+    }
+    return true;
+
+  case MvnNodeType::CONSTBITSELECT:
+    {
+      auto ibits{input_bits(node, 0, nodemap)};
+      SizeType pos{node->bitpos()};
+      put_bits(node, {pos < ibits.size() ? ibits[pos] : BnNodeHandle::zero()},
+	       nodemap);
+    }
+    return true;
+
+  case MvnNodeType::CONSTPARTSELECT:
+    {
+      auto ibits{input_bits(node, 0, nodemap)};
+      SizeType lsb{node->lsb()};
+      vector<BnNodeHandle> bits(ow, BnNodeHandle::zero());
+      for ( SizeType b = 0; b < ow && lsb + b < ibits.size(); ++ b ) {
+	bits[b] = ibits[lsb + b];
+      }
+      put_bits(node, bits, nodemap);
+    }
+    return true;
+
+  case MvnNodeType::BITSELECT:
+  case MvnNodeType::PARTSELECT:
+    {
+      // 2番目の入力を LSB の位置とみなす．
+      // 範囲外のビットは 0 になる．
+      auto ibits{input_bits(node, 0, nodemap)};
+      auto sbits{input_bits(node, 1, nodemap)};
+      auto bits{make_shifter(builder, ibits, sbits, false,
+			     BnNodeHandle::zero())};
+      put_bits(node, bits, nodemap);
+    }
+    return true;
+
+  default:
+    break;
+  }
+  return false;
+}
+
+END_NAMESPACE_YM_MVN
@@ -0,0 +1,64 @@
+﻿
+/// @file MvnShiftConv.cc
+/// @brief MvnShiftConv の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "MvnConv.h"
+#include "BitBuilder.h"
+#include "ym/MvnBnMap.h"
+#include "ym/MvnNode.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+// クラス MvnShiftConv
+//////////////////////////////////////////////////////////////////////
+
+// @brief MvnNode をビットレベルのゲートに変換する．
+bool
+MvnShiftConv::operator()(
+  const MvnNode* node,
+  BitBuilder& builder,
+  MvnBnMap& nodemap
+)
+{
+  auto type{node->type()};
+  bool left;
+  switch ( type ) {
+  case MvnNodeType::SLL:
+  case MvnNodeType::SLA:
+    left = true;
+    break;
+
+  case MvnNodeType::SRL:
+  case MvnNodeType::SRA:
+    left = false;
+    break;
+
+  default:
+    return false;
+  }
+
+  auto abits{input_bits(node, 0, nodemap)};
+  auto sbits{input_bits(node, 1, nodemap)};
+  SizeType iw{abits.size()};
+  SizeType ow{node->bit_width()};
+  SizeType bw{std::max(iw, ow)};
+  auto fill{BnNodeHandle::zero()};
+  if ( type == MvnNodeType::SRA && iw > 0 ) {
+    // 符号拡張する．
+    fill = abits[iw - 1];
+    abits.resize(bw, fill);
+  }
+  else {
+    abits = ext_bits(abits, bw);
+  }
+  put_bits(node, make_shifter(builder, abits, sbits, left, fill), nodemap);
+  return true;
+}
+
+END_NAMESPACE_YM_MVN
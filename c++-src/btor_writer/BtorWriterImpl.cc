@@ -0,0 +1,663 @@
+﻿
+/// @file BtorWriterImpl.cc
+/// @brief BtorWriterImpl の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "BtorWriterImpl.h"
+#include "MvnLevelizer.h"
+#include "ym/MvnMgr.h"
+#include "ym/MvnModule.h"
+#include "ym/MvnNode.h"
+#include "ym/MvnPort.h"
+#include "ym/MvnInputPin.h"
+#include "ym/MvnBvConst.h"
+#include "ym/ClibCell.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+// クラス BtorWriterImpl
+//////////////////////////////////////////////////////////////////////
+
+// @brief 内容を出力する．
+void
+BtorWriterImpl::dump(
+  ostream& s,
+  const MvnMgr& mgr
+)
+{
+  mS = &s;
+  mLastId = 0;
+  mSortMap.clear();
+  mStateMap.clear();
+  mIdArray.clear();
+  mIdArray.resize(mgr.max_node_id(), 0);
+
+  for ( auto module: mgr.topmodule_list() ) {
+    dump_module(module, mgr);
+  }
+  s.flush();
+}
+
+// @brief モジュールの内容を出力する．
+void
+BtorWriterImpl::dump_module(
+  const MvnModule* module,
+  const MvnMgr& mgr
+)
+{
+  auto& s{*mS};
+  MvnLevelizer lv{mgr, module};
+
+  // 入力
+  vector<const MvnNode*> input_list;
+  for ( SizeType i = 0; i < module->input_num(); ++ i ) {
+    input_list.push_back(module->input(i));
+  }
+  for ( SizeType i = 0; i < module->inout_num(); ++ i ) {
+    auto node{module->inout(i)};
+    if ( MvnLevelizer::is_source(node) ) {
+      input_list.push_back(node);
+    }
+  }
+  for ( auto node: input_list ) {
+    auto sid{sort(node->bit_width())};
+    auto id{new_line()};
+    s << "input " << sid << " " << node_name(module, node) << "\n";
+    mIdArray[node->id()] = id;
+  }
+
+  // DFF と LATCH の状態
+  // 組み合わせ回路から参照されるので先に出力しておく．
+  for ( auto node: lv.node_list() ) {
+    auto type{node->type()};
+    if ( type != MvnNodeType::DFF && type != MvnNodeType::LATCH ) {
+      continue;
+    }
+    SizeType bw{node->bit_width()};
+    auto sid{sort(bw)};
+    auto id{new_line()};
+    s << "state " << sid << " node" << node->id() << "\n";
+    auto init{zero(bw)};
+    new_line();
+    s << "init " << sid << " " << id << " " << init << "\n";
+    mStateMap.emplace(node->id(), id);
+    if ( type == MvnNodeType::DFF ) {
+      mIdArray[node->id()] = id;
+    }
+  }
+
+  // 組み合わせ回路
+  for ( auto node: lv.node_list() ) {
+    if ( MvnLevelizer::is_source(node) &&
+	 node->type() != MvnNodeType::CONSTVALUE ) {
+      continue;
+    }
+    mIdArray[node->id()] = dump_node(node);
+  }
+
+  // 出力
+  vector<const MvnNode*> output_list;
+  for ( SizeType i = 0; i < module->output_num(); ++ i ) {
+    output_list.push_back(module->output(i));
+  }
+  for ( SizeType i = 0; i < module->inout_num(); ++ i ) {
+    auto node{module->inout(i)};
+    if ( !MvnLevelizer::is_source(node) ) {
+      output_list.push_back(node);
+    }
+  }
+  for ( auto node: output_list ) {
+    new_line();
+    s << "output " << mIdArray[node->id()]
+      << " " << node_name(module, node) << "\n";
+  }
+
+  // 次状態
+  for ( auto node: lv.node_list() ) {
+    auto type{node->type()};
+    if ( type == MvnNodeType::DFF ) {
+      dump_dff_next(node);
+    }
+    else if ( type == MvnNodeType::LATCH ) {
+      // 出力の値をそのまま保持する．
+      auto sid{sort(node->bit_width())};
+      new_line();
+      s << "next " << sid << " " << mStateMap.at(node->id())
+	<< " " << mIdArray[node->id()] << "\n";
+    }
+  }
+}
+
+// @brief 組み合わせ回路のノードの式を出力する．
+SizeType
+BtorWriterImpl::dump_node(
+  const MvnNode* node
+)
+{
+  SizeType ow{node->bit_width()};
+  switch ( node->type() ) {
+  case MvnNodeType::OUTPUT:
+  case MvnNodeType::INOUT:
+  case MvnNodeType::THROUGH:
+    return input_val(node, 0, ow);
+
+  case MvnNodeType::LATCH:
+    // イネーブルが 0 の時は値を保持する．
+    {
+      auto en{input_nz(node, 1)};
+      auto data{input_val(node, 0, ow)};
+      return ite(ow, en, data, mStateMap.at(node->id()));
+    }
+
+  case MvnNodeType::NOT:
+    return op1("not", ow, input_val(node, 0, ow));
+
+  case MvnNodeType::AND:
+  case MvnNodeType::OR:
+  case MvnNodeType::XOR:
+    {
+      const char* op = node->type() == MvnNodeType::AND ? "and" :
+	node->type() == MvnNodeType::OR ? "or" : "xor";
+      auto acc{input_val(node, 0, ow)};
+      for ( SizeType i = 1; i < node->input_num(); ++ i ) {
+	acc = op2(op, ow, acc, input_val(node, i, ow));
+      }
+      return acc;
+    }
+
+  case MvnNodeType::RAND:
+  case MvnNodeType::ROR:
+  case MvnNodeType::RXOR:
+    {
+      const char* op = node->type() == MvnNodeType::RAND ? "redand" :
+	node->type() == MvnNodeType::ROR ? "redor" : "redxor";
+      SizeType iw;
+      auto a{input_raw(node, 0, iw)};
+      return op1(op, 1, a);
+    }
+
+  case MvnNodeType::EQ:
+  case MvnNodeType::LT:
+    {
+      SizeType w0;
+      SizeType w1;
+      auto a{input_raw(node, 0, w0)};
+      auto b{input_raw(node, 1, w1)};
+      SizeType bw{std::max(w0, w1)};
+      a = adapt(a, w0, bw);
+      b = adapt(b, w1, bw);
+      return op2(node->type() == MvnNodeType::EQ ? "eq" : "ult", 1, a, b);
+    }
+
+  case MvnNodeType::CASEEQ:
+    {
+      // ドントケアのビットをマスクしてから比較する．
+      SizeType w0;
+      SizeType w1;
+      auto a{input_raw(node, 0, w0)};
+      auto b{input_raw(node, 1, w1)};
+      SizeType bw{std::max(w0, w1)};
+      a = adapt(a, w0, bw);
+      b = adapt(b, w1, bw);
+      auto xmask{node->xmask()};
+      MvnBvConst care(bw);
+      for ( SizeType i = 0; i < bw; ++ i ) {
+	bool x{i < w0 && i < xmask.size() && xmask[i]};
+	care.set_val(i, !x);
+      }
+      auto diff{op2("xor", bw, a, b)};
+      auto masked{op2("and", bw, diff, const_val(care, bw))};
+      return op2("eq", 1, masked, zero(bw));
+    }
+
+  case MvnNodeType::SLL:
+  case MvnNodeType::SLA:
+  case MvnNodeType::SRL:
+  case MvnNodeType::SRA:
+    {
+      // max(入力のビット幅, 出力のビット幅) で計算する．
+      // BTOR2 のシフトは2つのオペランドのビット幅が等しくなければならない．
+      SizeType iw;
+      SizeType sw;
+      auto a{input_raw(node, 0, iw)};
+      auto sft{input_raw(node, 1, sw)};
+      SizeType bw{std::max(std::max(iw, ow), sw)};
+      const char* op;
+      switch ( node->type() ) {
+      case MvnNodeType::SRL: op = "srl"; a = adapt(a, iw, bw); break;
+      case MvnNodeType::SRA: op = "sra"; a = sext(a, iw, bw); break;
+      default:               op = "sll"; a = adapt(a, iw, bw); break;
+      }
+      auto ans{op2(op, bw, a, adapt(sft, sw, bw))};
+      return adapt(ans, bw, ow);
+    }
+
+  case MvnNodeType::CMPL:
+    return op1("neg", ow, input_val(node, 0, ow));
+
+  case MvnNodeType::ADD:
+    return op2("add", ow, input_val(node, 0, ow), input_val(node, 1, ow));
+
+  case MvnNodeType::SUB:
+    return op2("sub", ow, input_val(node, 0, ow), input_val(node, 1, ow));
+
+  case MvnNodeType::MUL:
+    return op2("mul", ow, input_val(node, 0, ow), input_val(node, 1, ow));
+
+  case MvnNodeType::DIV:
+  case MvnNodeType::MOD:
+    {
+      // 0 で割った時は商も余りも 0 にする．
+      SizeType w0;
+      SizeType w1;
+      auto a{input_raw(node, 0, w0)};
+      auto b{input_raw(node, 1, w1)};
+      SizeType bw{std::max(std::max(w0, w1), ow)};
+      a = adapt(a, w0, bw);
+      b = adapt(b, w1, bw);
+      auto nz{op1("redor", 1, b)};
+      const char* op = node->type() == MvnNodeType::DIV ? "udiv" : "urem";
+      auto ans{op2(op, bw, a, b)};
+      ans = ite(bw, nz, ans, zero(bw));
+      return adapt(ans, bw, ow);
+    }
+
+  case MvnNodeType::POW:
+    {
+      // 二乗と乗算を繰り返す．
+      auto base{input_val(node, 0, ow)};
+      SizeType ew;
+      auto e{input_raw(node, 1, ew)};
+      auto sid{sort(ow)};
+      auto acc{new_line()};
+      *mS << "one " << sid << "\n";
+      for ( SizeType k = 0; k < ew; ++ k ) {
+	auto bit{slice(e, k, k)};
+	auto prod{op2("mul", ow, acc, base)};
+	acc = ite(ow, bit, prod, acc);
+	if ( k + 1 < ew ) {
+	  base = op2("mul", ow, base, base);
+	}
+      }
+      return acc;
+    }
+
+  case MvnNodeType::ITE:
+    {
+      auto c{input_nz(node, 0)};
+      return ite(ow, c, input_val(node, 1, ow), input_val(node, 2, ow));
+    }
+
+  case MvnNodeType::CONCAT:
+    {
+      // 最初の入力が MSB 側になる．
+      SizeType aw;
+      auto acc{input_raw(node, 0, aw)};
+      for ( SizeType i = 1; i < node->input_num(); ++ i ) {
+	SizeType w;
+	auto a{input_raw(node, i, w)};
+	acc = op2("concat", aw + w, acc, a);
+	aw += w;
+      }
+      return adapt(acc, aw, ow);
+    }
+
+  case MvnNodeType::CONSTBITSELECT:
+    {
+      SizeType iw;
+      auto a{input_raw(node, 0, iw)};
+      SizeType pos{node->bitpos()};
+      if ( pos < iw ) {
+	return slice(a, pos, pos);
+      }
+      return zero(1);
+    }
+
+  case MvnNodeType::CONSTPARTSELECT:
+    {
+      // 範囲外のビットは 0 になる．
+      SizeType iw;
+      auto a{input_raw(node, 0, iw)};
+      SizeType lsb{node->lsb()};
+      if ( lsb >= iw ) {
+	return zero(ow);
+      }
+      SizeType msb{std::min(lsb + ow - 1, iw - 1)};
+      return adapt(slice(a, msb, lsb), msb - lsb + 1, ow);
+    }
+
+  case MvnNodeType::BITSELECT:
+  case MvnNodeType::PARTSELECT:
+    {
+      // 2番目の入力を LSB の位置とみなす．
+      // 範囲外のビットは 0 になる．
+      SizeType iw;
+      SizeType sw;
+      auto a{input_raw(node, 0, iw)};
+      auto sft{input_raw(node, 1, sw)};
+      SizeType bw{std::max(std::max(iw, ow), sw)};
+      auto ans{op2("srl", bw, adapt(a, iw, bw), adapt(sft, sw, bw))};
+      return adapt(ans, bw, ow);
+    }
+
+  case MvnNodeType::CONSTVALUE:
+    return const_val(node->const_value(), ow);
+
+  case MvnNodeType::CELL:
+    {
+      auto cell{node->cell()};
+      SizeType opos = node->cell_opin_pos();
+      if ( !cell.has_logic(opos) ) {
+	return zero(1);
+      }
+      SizeType ni{MvnLevelizer::fanin_num(node)};
+      vector<SizeType> input_list(ni);
+      for ( SizeType i = 0; i < ni; ++ i ) {
+	SizeType w;
+	auto a{input_raw(node, i, w)};
+	input_list[i] = w == 1 ? a : slice(a, 0, 0);
+      }
+      return dump_expr(cell.logic_expr(opos), input_list);
+    }
+
+  default:
+    break;
+  }
+  cerr << "MvnBtorWriter: unexpected node type for node" << node->id() << endl;
+  return zero(ow);
+}
+
+// @brief DFF の next を出力する．
+void
+BtorWriterImpl::dump_dff_next(
+  const MvnNode* node
+)
+{
+  SizeType bw{node->bit_width()};
+  auto next{input_val(node, 0, bw)};
+  // 非同期制御信号は同期化する．
+  // 番号の若い制御信号ほど外側の ite になる．
+  SizeType nc{node->input_num() - 2};
+  for ( SizeType i = nc; i > 0; -- i ) {
+    SizeType w;
+    auto ctrl{input_raw(node, i + 1, w)};
+    if ( w > 1 ) {
+      ctrl = slice(ctrl, 0, 0);
+    }
+    if ( node->control_pol(i - 1) == MvnPolarity::Negative ) {
+      ctrl = op1("not", 1, ctrl);
+    }
+    // 値の定数ノードは組み合わせ回路として出力済みなので
+    // ビット幅が同じならその行を用いる．
+    auto cnode{node->control_val(i - 1)};
+    auto val{mIdArray[cnode->id()]};
+    if ( val == 0 || cnode->bit_width() != bw ) {
+      val = const_val(cnode->const_value(), bw);
+    }
+    next = ite(bw, ctrl, val, next);
+  }
+  auto sid{sort(bw)};
+  new_line();
+  *mS << "next " << sid << " " << mStateMap.at(node->id())
+      << " " << next << "\n";
+}
+
+// @brief セルの論理式を出力する．
+SizeType
+BtorWriterImpl::dump_expr(
+  const Expr& expr,
+  const vector<SizeType>& input_list
+)
+{
+  if ( expr.is_zero() ) {
+    return zero(1);
+  }
+  if ( expr.is_one() ) {
+    auto sid{sort(1)};
+    auto id{new_line()};
+    *mS << "one " << sid << "\n";
+    return id;
+  }
+  if ( expr.is_posi_literal() ) {
+    return input_list[expr.varid()];
+  }
+  if ( expr.is_nega_literal() ) {
+    return op1("not", 1, input_list[expr.varid()]);
+  }
+  const char* op = expr.is_and() ? "and" : expr.is_or() ? "or" : "xor";
+  SizeType n{expr.operand_num()};
+  auto acc{dump_expr(expr.operand(0), input_list)};
+  for ( SizeType i = 1; i < n; ++ i ) {
+    acc = op2(op, 1, acc, dump_expr(expr.operand(i), input_list));
+  }
+  return acc;
+}
+
+// @brief ファンインの値を表す行番号を返す．
+SizeType
+BtorWriterImpl::input_raw(
+  const MvnNode* node,
+  SizeType pos,
+  SizeType& width
+)
+{
+  auto src{MvnLevelizer::fanin(node, pos)};
+  if ( src == nullptr ) {
+    auto rep{node->type() == MvnNodeType::CELL ? node->cell_node() : node};
+    width = rep->input(pos)->bit_width();
+    return zero(width);
+  }
+  width = src->bit_width();
+  return mIdArray[src->id()];
+}
+
+// @brief ファンインの値をビット幅 bw に合わせた行番号を返す．
+SizeType
+BtorWriterImpl::input_val(
+  const MvnNode* node,
+  SizeType pos,
+  SizeType bw
+)
+{
+  SizeType w;
+  auto id{input_raw(node, pos, w)};
+  return adapt(id, w, bw);
+}
+
+// @brief ファンインの値が 0 でない時 1 となる 1 ビットの行番号を返す．
+SizeType
+BtorWriterImpl::input_nz(
+  const MvnNode* node,
+  SizeType pos
+)
+{
+  SizeType w;
+  auto id{input_raw(node, pos, w)};
+  if ( w == 1 ) {
+    return id;
+  }
+  return op1("redor", 1, id);
+}
+
+// @brief ビット幅を合わせる．
+SizeType
+BtorWriterImpl::adapt(
+  SizeType id,
+  SizeType from_bw,
+  SizeType to_bw
+)
+{
+  if ( from_bw == to_bw ) {
+    return id;
+  }
+  if ( from_bw > to_bw ) {
+    return slice(id, to_bw - 1, 0);
+  }
+  auto sid{sort(to_bw)};
+  auto ans{new_line()};
+  *mS << "uext " << sid << " " << id << " " << (to_bw - from_bw) << "\n";
+  return ans;
+}
+
+// @brief 符号拡張を行う．
+SizeType
+BtorWriterImpl::sext(
+  SizeType id,
+  SizeType from_bw,
+  SizeType to_bw
+)
+{
+  if ( from_bw >= to_bw ) {
+    return adapt(id, from_bw, to_bw);
+  }
+  auto sid{sort(to_bw)};
+  auto ans{new_line()};
+  *mS << "sext " << sid << " " << id << " " << (to_bw - from_bw) << "\n";
+  return ans;
+}
+
+// @brief ビット幅 bw のソートの行番号を返す．
+SizeType
+BtorWriterImpl::sort(
+  SizeType bw
+)
+{
+  auto p{mSortMap.find(bw)};
+  if ( p != mSortMap.end() ) {
+    return p->second;
+  }
+  auto id{new_line()};
+  *mS << "sort bitvec " << bw << "\n";
+  mSortMap.emplace(bw, id);
+  return id;
+}
+
+// @brief 新しい行番号を割り当てて行頭を出力する．
+SizeType
+BtorWriterImpl::new_line()
+{
+  ++ mLastId;
+  *mS << mLastId << " ";
+  return mLastId;
+}
+
+// @brief 単項演算の行を出力する．
+SizeType
+BtorWriterImpl::op1(
+  const char* op,
+  SizeType bw,
+  SizeType a
+)
+{
+  auto sid{sort(bw)};
+  auto id{new_line()};
+  *mS << op << " " << sid << " " << a << "\n";
+  return id;
+}
+
+// @brief 2項演算の行を出力する．
+SizeType
+BtorWriterImpl::op2(
+  const char* op,
+  SizeType bw,
+  SizeType a,
+  SizeType b
+)
+{
+  auto sid{sort(bw)};
+  auto id{new_line()};
+  *mS << op << " " << sid << " " << a << " " << b << "\n";
+  return id;
+}
+
+// @brief ite の行を出力する．
+SizeType
+BtorWriterImpl::ite(
+  SizeType bw,
+  SizeType c,
+  SizeType t,
+  SizeType e
+)
+{
+  auto sid{sort(bw)};
+  auto id{new_line()};
+  *mS << "ite " << sid << " " << c << " " << t << " " << e << "\n";
+  return id;
+}
+
+// @brief slice の行を出力する．
+SizeType
+BtorWriterImpl::slice(
+  SizeType a,
+  SizeType msb,
+  SizeType lsb
+)
+{
+  auto sid{sort(msb - lsb + 1)};
+  auto id{new_line()};
+  *mS << "slice " << sid << " " << a << " " << msb << " " << lsb << "\n";
+  return id;
+}
+
+// @brief 定数0の行を出力する．
+SizeType
+BtorWriterImpl::zero(
+  SizeType bw
+)
+{
+  auto sid{sort(bw)};
+  auto id{new_line()};
+  *mS << "zero " << sid << "\n";
+  return id;
+}
+
+// @brief 定数の行を出力する．
+SizeType
+BtorWriterImpl::const_val(
+  const MvnBvConst& val,
+  SizeType bw
+)
+{
+  auto sid{sort(bw)};
+  auto id{new_line()};
+  *mS << "const " << sid << " ";
+  for ( SizeType i = bw; i > 0; -- i ) {
+    SizeType b{i - 1};
+    *mS << (b < val.size() && val[b] ? '1' : '0');
+  }
+  *mS << "\n";
+  return id;
+}
+
+// @brief 入出力ノードの名前を返す．
+string
+BtorWriterImpl::node_name(
+  const MvnModule* module,
+  const MvnNode* node
+)
+{
+  // そのノードだけを単純に参照している名前付きのポートがあれば
+  // その名前を用いる．
+  SizeType np{module->port_num()};
+  for ( SizeType i = 0; i < np; ++ i ) {
+    auto port{module->port(i)};
+    if ( port->port_ref_num() == 1 ) {
+      auto& port_ref{port->port_ref(0)};
+      if ( port_ref.node() == node &&
+	   port_ref.is_simple() &&
+	   port->name() != string() ) {
+	return port->name();
+      }
+    }
+  }
+  ostringstream buf;
+  buf << "node" << node->id();
+  return buf.str();
+}
+
+END_NAMESPACE_YM_MVN
@@ -0,0 +1,213 @@
+﻿#ifndef BTORWRITERIMPL_H
+#define BTORWRITERIMPL_H
+
+/// @file BtorWriterImpl.h
+/// @brief BtorWriterImpl のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/mvn.h"
+#include "ym/Expr.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+/// @class BtorWriterImpl BtorWriterImpl.h
+/// @brief MvnBtorWriter の実際の処理を行うクラス
+///
+/// BTOR2 の行番号は 1 から順に振る．
+/// ソート(ビット幅)の行は初めて必要になった時点で出力する．
+//////////////////////////////////////////////////////////////////////
+class BtorWriterImpl
+{
+public:
+
+  /// @brief コンストラクタ
+  BtorWriterImpl() = default;
+
+  /// @brief デストラクタ
+  ~BtorWriterImpl() = default;
+
+
+public:
+
+  /// @brief 内容を出力する．
+  void
+  dump(
+    ostream& s,       ///< [in] 出力先のストリーム
+    const MvnMgr& mgr ///< [in] MvnMgr
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で使われる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief モジュールの内容を出力する．
+  void
+  dump_module(
+    const MvnModule* module,
+    const MvnMgr& mgr
+  );
+
+  /// @brief 組み合わせ回路のノードの式を出力する．
+  /// @return 結果の行番号を返す．
+  SizeType
+  dump_node(
+    const MvnNode* node
+  );
+
+  /// @brief DFF の next を出力する．
+  void
+  dump_dff_next(
+    const MvnNode* node
+  );
+
+  /// @brief セルの論理式を出力する．
+  /// @return 結果の行番号を返す．
+  SizeType
+  dump_expr(
+    const Expr& expr,
+    const vector<SizeType>& input_list
+  );
+
+  /// @brief ファンインの値を表す行番号を返す．
+  ///
+  /// 結果のビット幅は width に格納される．
+  /// 接続されていない場合は入力ピンのビット幅の 0 となる．
+  SizeType
+  input_raw(
+    const MvnNode* node,
+    SizeType pos,
+    SizeType& width
+  );
+
+  /// @brief ファンインの値をビット幅 bw に合わせた行番号を返す．
+  ///
+  /// 0 拡張もしくは下位ビットの切り出しを行う．
+  SizeType
+  input_val(
+    const MvnNode* node,
+    SizeType pos,
+    SizeType bw
+  );
+
+  /// @brief ファンインの値が 0 でない時 1 となる 1 ビットの行番号を返す．
+  SizeType
+  input_nz(
+    const MvnNode* node,
+    SizeType pos
+  );
+
+  /// @brief ビット幅を合わせる．
+  SizeType
+  adapt(
+    SizeType id,
+    SizeType from_bw,
+    SizeType to_bw
+  );
+
+  /// @brief 符号拡張を行う．
+  SizeType
+  sext(
+    SizeType id,
+    SizeType from_bw,
+    SizeType to_bw
+  );
+
+  /// @brief ビット幅 bw のソートの行番号を返す．
+  SizeType
+  sort(
+    SizeType bw
+  );
+
+  /// @brief 新しい行番号を割り当てて行頭を出力する．
+  SizeType
+  new_line();
+
+  /// @brief 単項演算の行を出力する．
+  SizeType
+  op1(
+    const char* op,
+    SizeType bw,
+    SizeType a
+  );
+
+  /// @brief 2項演算の行を出力する．
+  SizeType
+  op2(
+    const char* op,
+    SizeType bw,
+    SizeType a,
+    SizeType b
+  );
+
+  /// @brief ite の行を出力する．
+  SizeType
+  ite(
+    SizeType bw,
+    SizeType c,
+    SizeType t,
+    SizeType e
+  );
+
+  /// @brief slice の行を出力する．
+  SizeType
+  slice(
+    SizeType a,
+    SizeType msb,
+    SizeType lsb
+  );
+
+  /// @brief 定数0の行を出力する．
+  SizeType
+  zero(
+    SizeType bw
+  );
+
+  /// @brief 定数の行を出力する．
+  SizeType
+  const_val(
+    const MvnBvConst& val,
+    SizeType bw
+  );
+
+  /// @brief 入出力ノードの名前を返す．
+  static
+  string
+  node_name(
+    const MvnModule* module,
+    const MvnNode* node
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 出力先のストリーム
+  ostream* mS;
+
+  // 最後に割り当てた行番号
+  SizeType mLastId{0};
+
+  // ビット幅をキーにしてソートの行番号を格納するハッシュ表
+  unordered_map<SizeType, SizeType> mSortMap;
+
+  // ノード番号をキーにして値の行番号を格納する配列
+  vector<SizeType> mIdArray;
+
+  // ノード番号をキーにして state の行番号を格納するハッシュ表
+  // (DFF と LATCH のみ)
+  unordered_map<SizeType, SizeType> mStateMap;
+
+};
+
+END_NAMESPACE_YM_MVN
+
+#endif // BTORWRITERIMPL_H
@@ -0,0 +1,42 @@
+﻿
+/// @file MvnBtorWriter.cc
+/// @brief MvnBtorWriter の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/MvnBtorWriter.h"
+#include "BtorWriterImpl.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+// クラス MvnBtorWriter
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+MvnBtorWriter::MvnBtorWriter(
+) : mImpl{unique_ptr<BtorWriterImpl>{new BtorWriterImpl()}}
+{
+}
+
+// @brief デストラクタ
+MvnBtorWriter::~MvnBtorWriter()
+{
+  // BtorWriterImpl.h を必要とするため
+  // ヘッダ中で = default 宣言はできない．
+}
+
+// @brief 内容を BTOR2 形式で出力する
+void
+MvnBtorWriter::operator()(
+  ostream& s,
+  const MvnMgr& mgr
+)
+{
+  mImpl->dump(s, mgr);
+}
+
+END_NAMESPACE_YM_MVN
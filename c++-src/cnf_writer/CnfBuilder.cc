@@ -0,0 +1,104 @@
+﻿
+/// @file CnfBuilder.cc
+/// @brief CnfBuilder の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "CnfBuilder.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+// クラス CnfBuilder
+//////////////////////////////////////////////////////////////////////
+
+// @brief 節を出力する．
+void
+CnfBuilder::add_clause(
+  const vector<BnNodeHandle>& lit_list
+)
+{
+  ++ mClauseNum;
+  if ( mStreamPtr == nullptr ) {
+    return;
+  }
+  auto& s{*mStreamPtr};
+  for ( auto h: lit_list ) {
+    s << literal(h) << " ";
+  }
+  s << "0\n";
+}
+
+// @brief コメント行を出力する．
+void
+CnfBuilder::add_comment(
+  const string& comment
+)
+{
+  if ( mStreamPtr != nullptr ) {
+    *mStreamPtr << "c " << comment << "\n";
+  }
+}
+
+// @brief AND ゲートを作る．
+BnNodeHandle
+CnfBuilder::_make_and(
+  BnNodeHandle a,
+  BnNodeHandle b
+)
+{
+  bool found;
+  auto x{find_or_new(false, a, b, found)};
+  if ( !found ) {
+    // x = a & b
+    add_clause({~x, a});
+    add_clause({~x, b});
+    add_clause({x, ~a, ~b});
+  }
+  return x;
+}
+
+// @brief XOR ゲートを作る．
+BnNodeHandle
+CnfBuilder::_make_xor(
+  BnNodeHandle a,
+  BnNodeHandle b
+)
+{
+  bool found;
+  auto x{find_or_new(true, a, b, found)};
+  if ( !found ) {
+    // x = a ^ b
+    add_clause({~x, a, b});
+    add_clause({~x, ~a, ~b});
+    add_clause({x, ~a, b});
+    add_clause({x, a, ~b});
+  }
+  return x;
+}
+
+// @brief 構造ハッシュを探す．
+BnNodeHandle
+CnfBuilder::find_or_new(
+  bool xor_gate,
+  BnNodeHandle a,
+  BnNodeHandle b,
+  bool& found
+)
+{
+  Key key{xor_gate, a.body(), b.body()};
+  auto p{mHash.find(key)};
+  if ( p != mHash.end() ) {
+    found = true;
+    return BnNodeHandle{p->second};
+  }
+  found = false;
+  auto x{new_var()};
+  mHash.emplace(key, x.id());
+  return x;
+}
+
+END_NAMESPACE_YM_MVN
@@ -0,0 +1,192 @@
+﻿#ifndef CNFBUILDER_H
+#define CNFBUILDER_H
+
+/// @file CnfBuilder.h
+/// @brief CnfBuilder のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "BitBuilder.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+/// @class CnfBuilder CnfBuilder.h "CnfBuilder.h"
+/// @brief ゲートを作る代わりに Tseitin 符号化の節を出力する BitBuilder
+///
+/// BnNodeHandle のノード番号をそのまま CNF の変数番号(1から始まる)として用いる．
+/// 節は作られた時点で DIMACS 形式で出力するので，節の集合は保持しない．
+/// 出力先が nullptr の時は変数と節の数を数えるだけとなる．
+/// 定数の伝搬は BitBuilder で行われるので定数を含む節は作られない．
+/// 同じ入力を持つゲートは一つしか作らない(構造ハッシュ)．
+//////////////////////////////////////////////////////////////////////
+class CnfBuilder :
+  public BitBuilder
+{
+public:
+
+  /// @brief コンストラクタ
+  CnfBuilder(
+    ostream* s ///< [in] 出力先のストリーム
+  ) : mStreamPtr{s}
+  {
+  }
+
+  /// @brief デストラクタ
+  ~CnfBuilder() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 新しい変数を作る．
+  BnNodeHandle
+  new_var()
+  {
+    ++ mVarNum;
+    return BnNodeHandle{mVarNum};
+  }
+
+  /// @brief ハンドルに対応する DIMACS のリテラルを返す．
+  ///
+  /// 定数のハンドルは与えられない．
+  static
+  std::int64_t
+  literal(
+    BnNodeHandle handle ///< [in] ハンドル
+  )
+  {
+    ASSERT_COND( handle.is_valid() && !handle.is_const() );
+    std::int64_t var = handle.id();
+    return handle.inv() ? -var : var;
+  }
+
+  /// @brief 節を出力する．
+  void
+  add_clause(
+    const vector<BnNodeHandle>& lit_list ///< [in] リテラルのリスト
+  );
+
+  /// @brief コメント行を出力する．
+  void
+  add_comment(
+    const string& comment ///< [in] 内容
+  );
+
+  /// @brief 変数の数を返す．
+  SizeType
+  var_num() const
+  {
+    return mVarNum;
+  }
+
+  /// @brief 節の数を返す．
+  SizeType
+  clause_num() const
+  {
+    return mClauseNum;
+  }
+
+
+protected:
+  //////////////////////////////////////////////////////////////////////
+  // BitBuilder の仮想関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief AND ゲートを作る．
+  BnNodeHandle
+  _make_and(
+    BnNodeHandle a,
+    BnNodeHandle b
+  ) override;
+
+  /// @brief XOR ゲートを作る．
+  BnNodeHandle
+  _make_xor(
+    BnNodeHandle a,
+    BnNodeHandle b
+  ) override;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // 構造ハッシュのキー
+  struct Key
+  {
+    bool mXor;
+    SizeType mBody0;
+    SizeType mBody1;
+
+    bool
+    operator==(
+      const Key& right
+    ) const
+    {
+      return mXor == right.mXor &&
+	mBody0 == right.mBody0 &&
+	mBody1 == right.mBody1;
+    }
+  };
+
+  // Key のハッシュ関数
+  struct KeyHash
+  {
+    SizeType
+    operator()(
+      const Key& key
+    ) const
+    {
+      return (key.mBody0 * 1048573 + key.mBody1) * 2 +
+	static_cast<SizeType>(key.mXor);
+    }
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 構造ハッシュを探す．
+  ///
+  /// 見つからなければ新しい変数を作って登録する．
+  /// found に見つかったかどうかを返す．
+  BnNodeHandle
+  find_or_new(
+    bool xor_gate,
+    BnNodeHandle a,
+    BnNodeHandle b,
+    bool& found
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 出力先のストリーム
+  ostream* mStreamPtr;
+
+  // 変数の数
+  SizeType mVarNum{0};
+
+  // 節の数
+  SizeType mClauseNum{0};
+
+  // 構造ハッシュ
+  unordered_map<Key, SizeType, KeyHash> mHash;
+
+};
+
+END_NAMESPACE_YM_MVN
+
+#endif // CNFBUILDER_H
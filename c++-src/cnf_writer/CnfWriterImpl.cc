@@ -0,0 +1,173 @@
+﻿
+/// @file CnfWriterImpl.cc
+/// @brief CnfWriterImpl の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "CnfWriterImpl.h"
+#include "CnfBuilder.h"
+#include "MvnLevelizer.h"
+#include "ym/MvnBnMap.h"
+#include "ym/MvnMgr.h"
+#include "ym/MvnNode.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+BEGIN_NONAMESPACE
+
+// 変数の対応を表すコメントを出力する．
+void
+put_comment(
+  CnfBuilder& builder,
+  const char* kind,
+  const MvnNode* node,
+  SizeType b,
+  BnNodeHandle h
+)
+{
+  ostringstream buf;
+  buf << kind << " node" << node->id() << " " << b
+      << " " << CnfBuilder::literal(h);
+  builder.add_comment(buf.str());
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス CnfWriterImpl
+//////////////////////////////////////////////////////////////////////
+
+// @brief 指定されたノードのコーンを出力する．
+void
+CnfWriterImpl::write(
+  ostream& s,
+  const MvnMgr& mgr,
+  const vector<const MvnNode*>& root_list
+)
+{
+  pair<SizeType, SizeType> num_pair;
+  auto hpos{s.tellp()};
+  if ( hpos == std::streampos(-1) ) {
+    // シークできないので先に数だけ求める．
+    // 変換できないノードはここで見つかるので何も出力されない．
+    if ( !encode(nullptr, mgr, root_list, num_pair) ) {
+      s.setstate(std::ios::failbit);
+      return;
+    }
+    s << "p cnf " << num_pair.first << " " << num_pair.second << "\n";
+    encode(&s, mgr, root_list, num_pair);
+  }
+  else {
+    // 数は後で書き込むので十分な幅を空けておく．
+    s << "p cnf " << string(20, ' ') << " " << string(20, ' ') << "\n";
+    if ( !encode(&s, mgr, root_list, num_pair) ) {
+      s.setstate(std::ios::failbit);
+      return;
+    }
+    auto epos{s.tellp()};
+    s.seekp(hpos);
+    s << "p cnf " << num_pair.first << " " << num_pair.second;
+    s.seekp(epos);
+  }
+  s.flush();
+}
+
+// @brief 符号化を行う．
+bool
+CnfWriterImpl::encode(
+  ostream* s,
+  const MvnMgr& mgr,
+  const vector<const MvnNode*>& root_list,
+  pair<SizeType, SizeType>& num_pair
+)
+{
+  num_pair = make_pair(0, 0);
+  if ( root_list.empty() ) {
+    return true;
+  }
+
+  auto module{root_list[0]->parent()};
+  MvnLevelizer lv{mgr, module};
+
+  // 根から入力側にたどれるノードに印をつける．
+  // DFF と LATCH の出力は自由変数とするのでその先はたどらない．
+  vector<bool> mark(mgr.max_node_id(), false);
+  vector<const MvnNode*> queue;
+  for ( auto node: root_list ) {
+    ASSERT_COND( node->parent() == module );
+    queue.push_back(node);
+  }
+  while ( !queue.empty() ) {
+    auto node{queue.back()};
+    queue.pop_back();
+    if ( mark[node->id()] ) {
+      continue;
+    }
+    mark[node->id()] = true;
+    if ( MvnLevelizer::is_source(node) || node->type() == MvnNodeType::LATCH ) {
+      continue;
+    }
+    SizeType ni{MvnLevelizer::fanin_num(node)};
+    for ( SizeType i = 0; i < ni; ++ i ) {
+      auto inode{MvnLevelizer::fanin(node, i)};
+      if ( inode != nullptr && !mark[inode->id()] ) {
+	queue.push_back(inode);
+      }
+    }
+  }
+
+  MvnBnMap nodemap{mgr};
+  CnfBuilder builder{s};
+  for ( auto node: lv.node_list() ) {
+    if ( !mark[node->id()] ) {
+      continue;
+    }
+    auto type{node->type()};
+    if ( type == MvnNodeType::CONSTVALUE ) {
+      if ( !mBnConv.conv_node(node, builder, nodemap) ) {
+	return false;
+      }
+    }
+    else if ( MvnLevelizer::is_source(node) || type == MvnNodeType::LATCH ) {
+      bool state{type == MvnNodeType::DFF || type == MvnNodeType::LATCH};
+      for ( SizeType b = 0; b < node->bit_width(); ++ b ) {
+	auto h{builder.new_var()};
+	nodemap.put(node, b, h);
+	if ( s != nullptr ) {
+	  put_comment(builder, state ? "state" : "input", node, b, h);
+	}
+      }
+    }
+    else if ( !mBnConv.conv_node(node, builder, nodemap) ) {
+      return false;
+    }
+  }
+
+  // 根のビットの変数を出力する．
+  BnNodeHandle const_var;
+  for ( auto node: root_list ) {
+    for ( SizeType b = 0; b < node->bit_width(); ++ b ) {
+      auto h{nodemap.get(node, b)};
+      if ( h.is_const() ) {
+	if ( !const_var.is_valid() ) {
+	  // 定数1に固定した変数
+	  const_var = builder.new_var();
+	  builder.add_clause({const_var});
+	}
+	h = h.is_one() ? const_var : ~const_var;
+      }
+      if ( s != nullptr ) {
+	put_comment(builder, "output", node, b, h);
+      }
+    }
+  }
+
+  num_pair = make_pair(builder.var_num(), builder.clause_num());
+  return true;
+}
+
+END_NAMESPACE_YM_MVN
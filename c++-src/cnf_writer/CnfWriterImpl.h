@@ -0,0 +1,85 @@
+﻿#ifndef CNFWRITERIMPL_H
+#define CNFWRITERIMPL_H
+
+/// @file CnfWriterImpl.h
+/// @brief CnfWriterImpl のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/mvn.h"
+#include "ym/MvnBnConv.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+/// @class CnfWriterImpl CnfWriterImpl.h
+/// @brief MvnCnfWriter の実際の処理を行うクラス
+///
+/// ノードの展開には MvnBnConv の変換器をそのまま用いる．
+//////////////////////////////////////////////////////////////////////
+class CnfWriterImpl
+{
+public:
+
+  /// @brief コンストラクタ
+  CnfWriterImpl() = default;
+
+  /// @brief デストラクタ
+  ~CnfWriterImpl() = default;
+
+
+public:
+
+  /// @brief 算術演算を展開する際の構成を設定する．
+  void
+  set_arith_arch(
+    const MvnArithArch& arch ///< [in] 構成
+  )
+  {
+    mBnConv.set_arith_arch(arch);
+  }
+
+  /// @brief 指定されたノードのコーンを出力する．
+  void
+  write(
+    ostream& s,                             ///< [in] 出力先のストリーム
+    const MvnMgr& mgr,                      ///< [in] MvnMgr
+    const vector<const MvnNode*>& root_list ///< [in] 根のノードのリスト
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で使われる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 符号化を行う．
+  /// @return 変換できないノードがあった場合は false を返す．
+  ///
+  /// s が nullptr の時は数えるだけで何も出力しない．
+  /// 変数の数と節の数を num_pair に設定する．
+  bool
+  encode(
+    ostream* s,
+    const MvnMgr& mgr,
+    const vector<const MvnNode*>& root_list,
+    pair<SizeType, SizeType>& num_pair
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // ノードの変換器
+  MvnBnConv mBnConv;
+
+};
+
+END_NAMESPACE_YM_MVN
+
+#endif // CNFWRITERIMPL_H
@@ -0,0 +1,75 @@
+﻿
+/// @file MvnCnfWriter.cc
+/// @brief MvnCnfWriter の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/MvnCnfWriter.h"
+#include "ym/MvnModule.h"
+#include "CnfWriterImpl.h"
+#include "MvnLevelizer.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+// クラス MvnCnfWriter
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+MvnCnfWriter::MvnCnfWriter(
+) : mImpl{unique_ptr<CnfWriterImpl>{new CnfWriterImpl()}}
+{
+}
+
+// @brief デストラクタ
+MvnCnfWriter::~MvnCnfWriter()
+{
+  // CnfWriterImpl.h を必要とするため
+  // ヘッダ中で = default 宣言はできない．
+}
+
+// @brief 算術演算を展開する際の構成を設定する．
+void
+MvnCnfWriter::set_arith_arch(
+  const MvnArithArch& arch
+)
+{
+  mImpl->set_arith_arch(arch);
+}
+
+// @brief モジュールの全ての出力のコーンを出力する．
+void
+MvnCnfWriter::operator()(
+  ostream& s,
+  const MvnMgr& mgr,
+  const MvnModule* module
+)
+{
+  vector<const MvnNode*> root_list;
+  for ( SizeType i = 0; i < module->output_num(); ++ i ) {
+    root_list.push_back(module->output(i));
+  }
+  for ( SizeType i = 0; i < module->inout_num(); ++ i ) {
+    auto node{module->inout(i)};
+    if ( !MvnLevelizer::is_source(node) ) {
+      root_list.push_back(node);
+    }
+  }
+  mImpl->write(s, mgr, root_list);
+}
+
+// @brief 指定されたノードのコーンを出力する．
+void
+MvnCnfWriter::operator()(
+  ostream& s,
+  const MvnMgr& mgr,
+  const vector<const MvnNode*>& root_list
+)
+{
+  mImpl->write(s, mgr, root_list);
+}
+
+END_NAMESPACE_YM_MVN
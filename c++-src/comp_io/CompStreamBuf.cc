@@ -0,0 +1,247 @@
+﻿
+/// @file CompStreamBuf.cc
+/// @brief CompStreamBuf の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "CompStreamBuf.h"
+#include <cstring>
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+// クラス CompStreamBuf
+//////////////////////////////////////////////////////////////////////
+
+// @brief デストラクタ
+CompStreamBuf::~CompStreamBuf()
+{
+  close();
+}
+
+// @brief ファイルを開く．
+bool
+CompStreamBuf::open(
+  const string& filename,
+  MvnCompType comp_type,
+  int level
+)
+{
+  if ( is_open() ) {
+    return false;
+  }
+
+  ASSERT_COND( comp_type != MvnCompType::Auto );
+
+  mFp = std::fopen(filename.c_str(), "wb");
+  if ( mFp == nullptr ) {
+    return false;
+  }
+
+  mCompType = comp_type;
+  if ( mCompType != MvnCompType::None ) {
+    std::memset(&mZs, 0, sizeof(mZs));
+    // windowBits に 16 を足すと gzip 形式になる．
+    int wbits = mCompType == MvnCompType::Gzip ? 15 + 16 : 15;
+    if ( deflateInit2(&mZs, level, Z_DEFLATED, wbits, 8,
+		      Z_DEFAULT_STRATEGY) != Z_OK ) {
+      std::fclose(mFp);
+      mFp = nullptr;
+      return false;
+    }
+    mOutBuf.resize(BUFF_SIZE);
+  }
+
+  mFillBuf.resize(BUFF_SIZE);
+  mWorkBuf.resize(BUFF_SIZE);
+  setp(mFillBuf.data(), mFillBuf.data() + BUFF_SIZE);
+  mWorkReady = false;
+  mWorkFlush = false;
+  mDone = false;
+  mError = false;
+  mThread = std::thread{[this]() { compressor_main(); }};
+  return true;
+}
+
+// @brief 残りの内容を書き出してファイルを閉じる．
+bool
+CompStreamBuf::close()
+{
+  if ( !is_open() ) {
+    return true;
+  }
+
+  hand_over();
+  {
+    std::unique_lock<std::mutex> lck{mMutex};
+    mDone = true;
+  }
+  mCond.notify_all();
+  mThread.join();
+
+  if ( mCompType != MvnCompType::None ) {
+    deflate_out(nullptr, 0, Z_FINISH);
+    deflateEnd(&mZs);
+  }
+  if ( std::fclose(mFp) != 0 ) {
+    mError = true;
+  }
+  mFp = nullptr;
+  setp(nullptr, nullptr);
+  return !mError;
+}
+
+// @brief バッファが一杯の時に呼ばれる．
+CompStreamBuf::int_type
+CompStreamBuf::overflow(
+  int_type c
+)
+{
+  if ( !is_open() || !hand_over() ) {
+    return traits_type::eof();
+  }
+  if ( !traits_type::eq_int_type(c, traits_type::eof()) ) {
+    *pptr() = traits_type::to_char_type(c);
+    pbump(1);
+  }
+  return traits_type::not_eof(c);
+}
+
+// @brief 文字列を書き込む．
+std::streamsize
+CompStreamBuf::xsputn(
+  const char* s,
+  std::streamsize n
+)
+{
+  if ( !is_open() ) {
+    return 0;
+  }
+  std::streamsize rest = n;
+  while ( rest > 0 ) {
+    std::streamsize avail = epptr() - pptr();
+    if ( avail == 0 ) {
+      if ( !hand_over() ) {
+	// 書き出しに失敗しているので書き込めた分だけを返す．
+	return n - rest;
+      }
+      continue;
+    }
+    std::streamsize m = std::min(avail, rest);
+    std::memcpy(pptr(), s, m);
+    pbump(static_cast<int>(m));
+    s += m;
+    rest -= m;
+  }
+  return n;
+}
+
+// @brief 同期する．
+int
+CompStreamBuf::sync()
+{
+  if ( !is_open() ) {
+    return 0;
+  }
+  return hand_over(true) ? 0 : -1;
+}
+
+// @brief 書き込み用のバッファの内容を圧縮用のスレッドに渡す．
+bool
+CompStreamBuf::hand_over(
+  bool flush
+)
+{
+  if ( mError ) {
+    return false;
+  }
+  SizeType size = pptr() - pbase();
+  if ( size == 0 && !flush ) {
+    return true;
+  }
+  {
+    std::unique_lock<std::mutex> lck{mMutex};
+    mCond.wait(lck, [this]() { return !mWorkReady; });
+    // 圧縮用のスレッドは mWorkReady が true の間しか
+    // mWorkBuf を参照しないので入れ替えても安全
+    std::swap(mFillBuf, mWorkBuf);
+    mWorkSize = size;
+    mWorkFlush = flush;
+    mWorkReady = true;
+  }
+  mCond.notify_all();
+  setp(mFillBuf.data(), mFillBuf.data() + BUFF_SIZE);
+  if ( flush ) {
+    std::unique_lock<std::mutex> lck{mMutex};
+    mCond.wait(lck, [this]() { return !mWorkReady; });
+  }
+  return !mError;
+}
+
+// @brief 圧縮用のスレッドの本体
+void
+CompStreamBuf::compressor_main()
+{
+  for ( ; ; ) {
+    {
+      std::unique_lock<std::mutex> lck{mMutex};
+      mCond.wait(lck, [this]() { return mWorkReady || mDone; });
+      if ( !mWorkReady ) {
+	// 終了の指示があって残りの仕事はない．
+	break;
+      }
+    }
+    deflate_out(mWorkBuf.data(), mWorkSize,
+		mWorkFlush ? Z_SYNC_FLUSH : Z_NO_FLUSH);
+    if ( mWorkFlush && !mError && std::fflush(mFp) != 0 ) {
+      mError = true;
+    }
+    {
+      std::unique_lock<std::mutex> lck{mMutex};
+      mWorkReady = false;
+    }
+    mCond.notify_all();
+  }
+}
+
+// @brief データを圧縮して書き出す．
+void
+CompStreamBuf::deflate_out(
+  const char* data,
+  SizeType size,
+  int flush
+)
+{
+  if ( mError ) {
+    return;
+  }
+
+  if ( mCompType == MvnCompType::None ) {
+    if ( size > 0 && std::fwrite(data, 1, size, mFp) != size ) {
+      mError = true;
+    }
+    return;
+  }
+
+  mZs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+  mZs.avail_in = size;
+  do {
+    mZs.next_out = reinterpret_cast<Bytef*>(mOutBuf.data());
+    mZs.avail_out = mOutBuf.size();
+    int ret = deflate(&mZs, flush);
+    if ( ret == Z_STREAM_ERROR ) {
+      mError = true;
+      return;
+    }
+    SizeType have = mOutBuf.size() - mZs.avail_out;
+    if ( have > 0 && std::fwrite(mOutBuf.data(), 1, have, mFp) != have ) {
+      mError = true;
+      return;
+    }
+  } while ( mZs.avail_out == 0 );
+}
+
+END_NAMESPACE_YM_MVN
@@ -0,0 +1,195 @@
+﻿#ifndef COMPSTREAMBUF_H
+#define COMPSTREAMBUF_H
+
+/// @file CompStreamBuf.h
+/// @brief CompStreamBuf のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/mvn.h"
+#include <zlib.h>
+#include <cstdio>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <streambuf>
+#include <thread>
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+/// @class CompStreamBuf CompStreamBuf.h "CompStreamBuf.h"
+/// @brief 圧縮しながらファイルに書き出す streambuf
+///
+/// 書き込み用と圧縮用の二つのバッファを持ち，
+/// 書き込み用のバッファが一杯になったら二つを入れ替えて
+/// バックグラウンドのスレッドに圧縮と書き出しを行わせる．
+/// 圧縮用のバッファが処理中の場合は終わるまで待つ．
+///
+/// sync() では書き込み用のバッファを渡したうえで
+/// 圧縮の区切り(Z_SYNC_FLUSH)を入れてファイルまで書き出させ，
+/// それが終わるまで待つ．
+/// 書き出しに失敗した後の書き込みは失敗として扱うので
+/// ostream 側ではその時点で badbit が立つ．
+//////////////////////////////////////////////////////////////////////
+class CompStreamBuf :
+  public std::streambuf
+{
+public:
+
+  /// @brief コンストラクタ
+  CompStreamBuf() = default;
+
+  /// @brief デストラクタ
+  ~CompStreamBuf();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ファイルを開く．
+  /// @return 開けた時 true を返す．
+  bool
+  open(
+    const string& filename, ///< [in] ファイル名
+    MvnCompType comp_type,  ///< [in] 圧縮形式
+    int level               ///< [in] 圧縮レベル
+  );
+
+  /// @brief 残りの内容を書き出してファイルを閉じる．
+  /// @return 全ての内容を書き出せた時 true を返す．
+  bool
+  close();
+
+  /// @brief ファイルが開いている時 true を返す．
+  bool
+  is_open() const
+  {
+    return mFp != nullptr;
+  }
+
+  /// @brief 圧縮形式を返す．
+  MvnCompType
+  comp_type() const
+  {
+    return mCompType;
+  }
+
+
+protected:
+  //////////////////////////////////////////////////////////////////////
+  // std::streambuf の仮想関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief バッファが一杯の時に呼ばれる．
+  int_type
+  overflow(
+    int_type c
+  ) override;
+
+  /// @brief 文字列を書き込む．
+  std::streamsize
+  xsputn(
+    const char* s,
+    std::streamsize n
+  ) override;
+
+  /// @brief 同期する．
+  ///
+  /// それまでに書き込まれた内容をファイルまで書き出す．
+  /// 圧縮の区切りが入るので頻繁に呼ぶと圧縮率が落ちる．
+  /// @return 成功した時 0，失敗した時 -1 を返す．
+  int
+  sync() override;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 書き込み用のバッファの内容を圧縮用のスレッドに渡す．
+  ///
+  /// flush が true の時は渡した内容がファイルに書き出されるまで待つ．
+  /// @return それまでの書き出しが全て成功している時 true を返す．
+  bool
+  hand_over(
+    bool flush = false ///< [in] ファイルまで書き出させる時 true にする．
+  );
+
+  /// @brief 圧縮用のスレッドの本体
+  void
+  compressor_main();
+
+  /// @brief データを圧縮して書き出す．
+  void
+  deflate_out(
+    const char* data, ///< [in] データの先頭
+    SizeType size,    ///< [in] データのサイズ
+    int flush         ///< [in] deflate() に渡すフラッシュモード
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // バッファのサイズ
+  static
+  const SizeType BUFF_SIZE{1 << 20};
+
+  // 出力先のファイル
+  FILE* mFp{nullptr};
+
+  // 圧縮形式
+  MvnCompType mCompType{MvnCompType::None};
+
+  // zlib の状態
+  z_stream mZs;
+
+  // 書き込み用のバッファ
+  vector<char> mFillBuf;
+
+  // 圧縮用のバッファ
+  vector<char> mWorkBuf;
+
+  // 圧縮用のバッファの内容のサイズ
+  SizeType mWorkSize{0};
+
+  // 圧縮した結果を書き出すためのバッファ
+  vector<char> mOutBuf;
+
+  // mWorkBuf に処理すべき内容がある時 true にするフラグ
+  bool mWorkReady{false};
+
+  // mWorkBuf の内容をファイルまで書き出させる時 true にするフラグ
+  bool mWorkFlush{false};
+
+  // 終了を指示するフラグ
+  bool mDone{false};
+
+  // 書き出しに失敗した時 true にするフラグ
+  //
+  // 圧縮用のスレッドから書き込まれるので atomic にしておく．
+  std::atomic<bool> mError{false};
+
+  // 排他制御用の mutex
+  std::mutex mMutex;
+
+  // 状態の変化を知らせるための条件変数
+  std::condition_variable mCond;
+
+  // 圧縮用のスレッド
+  std::thread mThread;
+
+};
+
+END_NAMESPACE_YM_MVN
+
+#endif // COMPSTREAMBUF_H
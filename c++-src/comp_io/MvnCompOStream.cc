@@ -0,0 +1,115 @@
+﻿
+/// @file MvnCompOStream.cc
+/// @brief MvnCompOStream の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/MvnCompOStream.h"
+#include "CompStreamBuf.h"
+#include <cstring>
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+// クラス MvnCompOStream
+//////////////////////////////////////////////////////////////////////
+
+// @brief 空のコンストラクタ
+MvnCompOStream::MvnCompOStream(
+) : ostream{nullptr},
+    mBuf{new CompStreamBuf}
+{
+  rdbuf(mBuf.get());
+}
+
+// @brief ファイルを開くコンストラクタ
+MvnCompOStream::MvnCompOStream(
+  const string& filename,
+  MvnCompType comp_type
+) : MvnCompOStream()
+{
+  open(filename, comp_type);
+}
+
+// @brief デストラクタ
+MvnCompOStream::~MvnCompOStream()
+{
+  close();
+}
+
+// @brief ファイルを開く．
+bool
+MvnCompOStream::open(
+  const string& filename,
+  MvnCompType comp_type
+)
+{
+  if ( comp_type == MvnCompType::Auto ) {
+    comp_type = comp_type_from_filename(filename);
+  }
+  if ( !mBuf->open(filename, comp_type, mLevel) ) {
+    setstate(std::ios::failbit);
+    return false;
+  }
+  clear();
+  return true;
+}
+
+// @brief 残りの内容を書き出してファイルを閉じる．
+bool
+MvnCompOStream::close()
+{
+  if ( !mBuf->close() ) {
+    setstate(std::ios::failbit);
+    return false;
+  }
+  return true;
+}
+
+// @brief ファイルが開いている時 true を返す．
+bool
+MvnCompOStream::is_open() const
+{
+  return mBuf->is_open();
+}
+
+// @brief 実際に用いられる圧縮形式を返す．
+MvnCompType
+MvnCompOStream::comp_type() const
+{
+  return mBuf->comp_type();
+}
+
+// @brief 圧縮レベルを設定する．
+void
+MvnCompOStream::set_level(
+  int level
+)
+{
+  mLevel = level;
+}
+
+// @brief ファイル名の拡張子から圧縮形式を決める．
+MvnCompType
+MvnCompOStream::comp_type_from_filename(
+  const string& filename
+)
+{
+  auto has_suffix = [&](const char* suffix) {
+    SizeType n{std::strlen(suffix)};
+    return filename.size() >= n &&
+      filename.compare(filename.size() - n, n, suffix) == 0;
+  };
+  if ( has_suffix(".gz") ) {
+    return MvnCompType::Gzip;
+  }
+  if ( has_suffix(".zz") || has_suffix(".zlib") ) {
+    return MvnCompType::Zlib;
+  }
+  return MvnCompType::None;
+}
+
+END_NAMESPACE_YM_MVN
@@ -0,0 +1,1488 @@
+﻿
+/// @file CxxWriterImpl.cc
+/// @brief CxxWriterImpl の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+/*
+ * アルゴリズム
+ *
+ * - モジュールごとに構造体を一つ出力する．
+ * - DFF とラッチの値は構造体のメンバとし，残りのノードは comb() 内の
+ *   局所変数とする．
+ * - comb() は MvnLevelizer の求めたトポロジカル順にノードの評価コードを
+ *   並べた直線的なコードとなる．
+ * - ビット幅が 64 以下で，ファンインのビット幅も 64 以下のノードは
+ *   mvn_word (uint64_t) の式で評価する．
+ * - それ以外のノードは mvn_word の配列として表し，先頭に出力する
+ *   補助関数で評価する．
+ * - 値の意味は SimNetwork と同一にしている．
+ */
+
+#include "CxxWriterImpl.h"
+#include "MvnLevelizer.h"
+
+#include "ym/MvnMgr.h"
+#include "ym/MvnModule.h"
+#include "ym/MvnNode.h"
+#include "ym/MvnInputPin.h"
+#include "ym/MvnBvConst.h"
+
+#include "ym/ClibCell.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+BEGIN_NONAMESPACE
+
+// 出力ファイルの先頭に置く補助関数
+const char* prelude = R"PRELUDE(#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+typedef std::uint64_t mvn_word;
+
+// 接続されていない入力の代わりに用いる．
+const mvn_word mvn_zero[1] = { 0 };
+
+inline std::size_t
+mvn_nw(std::size_t bw)
+{
+  return (bw + 63) / 64;
+}
+
+inline mvn_word
+mvn_last_mask(std::size_t bw)
+{
+  std::size_t r = bw % 64;
+  return r == 0 ? ~mvn_word(0) : (mvn_word(1) << r) - 1;
+}
+
+inline void
+mvn_normalize(mvn_word* d, std::size_t dw)
+{
+  if ( dw > 0 ) {
+    d[mvn_nw(dw) - 1] &= mvn_last_mask(dw);
+  }
+}
+
+inline mvn_word
+mvn_word_at(const mvn_word* a, std::size_t aw, std::size_t i)
+{
+  return i < mvn_nw(aw) ? a[i] : 0;
+}
+
+inline mvn_word
+mvn_get_bits64(const mvn_word* a, std::size_t aw, mvn_word pos)
+{
+  if ( pos >= aw ) {
+    return 0;
+  }
+  std::size_t b = pos / 64;
+  std::size_t s = pos % 64;
+  mvn_word lo = mvn_word_at(a, aw, b);
+  if ( s == 0 ) {
+    return lo;
+  }
+  return (lo >> s) | (mvn_word_at(a, aw, b + 1) << (64 - s));
+}
+
+inline mvn_word
+mvn_parity(mvn_word x)
+{
+  x ^= x >> 32;
+  x ^= x >> 16;
+  x ^= x >> 8;
+  x ^= x >> 4;
+  x ^= x >> 2;
+  x ^= x >> 1;
+  return x & 1;
+}
+
+inline mvn_word
+mvn_index(const mvn_word* a, std::size_t aw)
+{
+  std::size_t n = mvn_nw(aw);
+  for ( std::size_t i = 1; i < n; ++ i ) {
+    if ( a[i] != 0 ) {
+      return ~mvn_word(0);
+    }
+  }
+  return n > 0 ? a[0] : 0;
+}
+
+inline bool
+mvn_is_zero(const mvn_word* a, std::size_t aw)
+{
+  std::size_t n = mvn_nw(aw);
+  for ( std::size_t i = 0; i < n; ++ i ) {
+    if ( a[i] != 0 ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+inline bool
+mvn_equal(const mvn_word* a, const mvn_word* b, std::size_t bw)
+{
+  return std::memcmp(a, b, mvn_nw(bw) * sizeof(mvn_word)) == 0;
+}
+
+inline void
+mvn_copy(mvn_word* d, std::size_t dw, const mvn_word* a, std::size_t aw)
+{
+  std::size_t n = mvn_nw(dw);
+  for ( std::size_t i = 0; i < n; ++ i ) {
+    d[i] = mvn_word_at(a, aw, i);
+  }
+  mvn_normalize(d, dw);
+}
+
+inline void
+mvn_not(mvn_word* d, std::size_t dw, const mvn_word* a, std::size_t aw)
+{
+  std::size_t n = mvn_nw(dw);
+  for ( std::size_t i = 0; i < n; ++ i ) {
+    d[i] = ~mvn_word_at(a, aw, i);
+  }
+  mvn_normalize(d, dw);
+}
+
+inline void
+mvn_and(mvn_word* d, std::size_t dw, const mvn_word* a, std::size_t aw)
+{
+  std::size_t n = mvn_nw(dw);
+  for ( std::size_t i = 0; i < n; ++ i ) {
+    d[i] &= mvn_word_at(a, aw, i);
+  }
+}
+
+inline void
+mvn_or(mvn_word* d, std::size_t dw, const mvn_word* a, std::size_t aw)
+{
+  std::size_t n = mvn_nw(dw);
+  for ( std::size_t i = 0; i < n; ++ i ) {
+    d[i] |= mvn_word_at(a, aw, i);
+  }
+  mvn_normalize(d, dw);
+}
+
+inline void
+mvn_xor(mvn_word* d, std::size_t dw, const mvn_word* a, std::size_t aw)
+{
+  std::size_t n = mvn_nw(dw);
+  for ( std::size_t i = 0; i < n; ++ i ) {
+    d[i] ^= mvn_word_at(a, aw, i);
+  }
+  mvn_normalize(d, dw);
+}
+
+inline mvn_word
+mvn_rand(const mvn_word* a, std::size_t aw)
+{
+  std::size_t n = mvn_nw(aw);
+  for ( std::size_t i = 0; i + 1 < n; ++ i ) {
+    if ( a[i] != ~mvn_word(0) ) {
+      return 0;
+    }
+  }
+  return (n == 0 || a[n - 1] == mvn_last_mask(aw)) ? 1 : 0;
+}
+
+inline mvn_word
+mvn_ror(const mvn_word* a, std::size_t aw)
+{
+  return mvn_is_zero(a, aw) ? 0 : 1;
+}
+
+inline mvn_word
+mvn_rxor(const mvn_word* a, std::size_t aw)
+{
+  std::size_t n = mvn_nw(aw);
+  mvn_word acc = 0;
+  for ( std::size_t i = 0; i < n; ++ i ) {
+    acc ^= a[i];
+  }
+  return mvn_parity(acc);
+}
+
+inline mvn_word
+mvn_caseeq(const mvn_word* a, std::size_t aw,
+	   const mvn_word* b, std::size_t bw,
+	   const mvn_word* xmask)
+{
+  std::size_t n = mvn_nw(aw > bw ? aw : bw);
+  std::size_t xn = mvn_nw(aw);
+  for ( std::size_t i = 0; i < n; ++ i ) {
+    mvn_word diff = mvn_word_at(a, aw, i) ^ mvn_word_at(b, bw, i);
+    if ( xmask != nullptr && i < xn ) {
+      diff &= ~xmask[i];
+    }
+    if ( diff != 0 ) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+inline mvn_word
+mvn_eq(const mvn_word* a, std::size_t aw,
+       const mvn_word* b, std::size_t bw)
+{
+  return mvn_caseeq(a, aw, b, bw, nullptr);
+}
+
+inline mvn_word
+mvn_lt(const mvn_word* a, std::size_t aw,
+       const mvn_word* b, std::size_t bw)
+{
+  for ( std::size_t i = mvn_nw(aw > bw ? aw : bw); i > 0; -- i ) {
+    mvn_word a1 = mvn_word_at(a, aw, i - 1);
+    mvn_word b1 = mvn_word_at(b, bw, i - 1);
+    if ( a1 != b1 ) {
+      return a1 < b1 ? 1 : 0;
+    }
+  }
+  return 0;
+}
+
+inline mvn_word
+mvn_bit(const mvn_word* a, std::size_t aw, mvn_word pos)
+{
+  if ( pos >= aw ) {
+    return 0;
+  }
+  return (a[pos / 64] >> (pos % 64)) & 1;
+}
+
+inline void
+mvn_select(mvn_word* d, std::size_t dw,
+	   const mvn_word* a, std::size_t aw,
+	   mvn_word pos)
+{
+  std::size_t n = mvn_nw(dw);
+  for ( std::size_t i = 0; i < n; ++ i ) {
+    mvn_word p = pos + i * 64;
+    d[i] = p < pos ? 0 : mvn_get_bits64(a, aw, p);
+  }
+  mvn_normalize(d, dw);
+}
+
+inline void
+mvn_or_bits(mvn_word* d, std::size_t dw, std::size_t pos,
+	    const mvn_word* a, std::size_t aw)
+{
+  std::size_t dn = mvn_nw(dw);
+  std::size_t an = mvn_nw(aw);
+  for ( std::size_t k = 0; k < an; ++ k ) {
+    std::size_t wi = (pos + k * 64) / 64;
+    std::size_t sh = (pos + k * 64) % 64;
+    if ( wi < dn ) {
+      d[wi] |= a[k] << sh;
+    }
+    if ( sh > 0 && wi + 1 < dn ) {
+      d[wi + 1] |= a[k] >> (64 - sh);
+    }
+  }
+}
+
+// 左シフト(ビット幅 max(aw, dw) で計算して dw ビットに切り詰める)
+inline void
+mvn_shl(mvn_word* d, std::size_t dw,
+	const mvn_word* a, std::size_t aw,
+	mvn_word s)
+{
+  std::size_t n = mvn_nw(dw);
+  std::size_t bw = aw > dw ? aw : dw;
+  for ( std::size_t i = 0; i < n; ++ i ) {
+    mvn_word p = i * 64;
+    if ( s >= bw ) {
+      d[i] = 0;
+    }
+    else if ( p >= s ) {
+      d[i] = mvn_get_bits64(a, aw, p - s);
+    }
+    else if ( s - p < 64 ) {
+      d[i] = mvn_word_at(a, aw, 0) << (s - p);
+    }
+    else {
+      d[i] = 0;
+    }
+  }
+  mvn_normalize(d, dw);
+}
+
+// 右シフト(arith が true の時は算術シフト)
+inline void
+mvn_shr(mvn_word* d, std::size_t dw,
+	const mvn_word* a, std::size_t aw,
+	mvn_word s, bool arith)
+{
+  std::size_t n = mvn_nw(dw);
+  std::size_t bw = aw > dw ? aw : dw;
+  bool sign = arith && aw > 0 && mvn_bit(a, aw, aw - 1);
+  for ( std::size_t i = 0; i < n; ++ i ) {
+    d[i] = s >= bw ? 0 : mvn_get_bits64(a, aw, i * 64 + s);
+  }
+  if ( sign ) {
+    // 元の値の MSB より上から来るビットを 1 にする．
+    std::size_t start = (s < aw) ? aw - s : 0;
+    for ( std::size_t i = 0; i < n; ++ i ) {
+      std::size_t lo = i * 64;
+      if ( lo + 64 <= start ) {
+	continue;
+      }
+      d[i] |= lo >= start ? ~mvn_word(0) : ~((mvn_word(1) << (start - lo)) - 1);
+    }
+  }
+  mvn_normalize(d, dw);
+}
+
+inline void
+mvn_add(mvn_word* d, std::size_t dw,
+	const mvn_word* a, std::size_t aw,
+	const mvn_word* b, std::size_t bw)
+{
+  std::size_t n = mvn_nw(dw);
+  mvn_word c = 0;
+  for ( std::size_t i = 0; i < n; ++ i ) {
+    mvn_word a1 = mvn_word_at(a, aw, i);
+    mvn_word s = a1 + mvn_word_at(b, bw, i);
+    mvn_word c1 = s < a1 ? 1 : 0;
+    d[i] = s + c;
+    c = c1 | (d[i] < s ? 1 : 0);
+  }
+  mvn_normalize(d, dw);
+}
+
+inline void
+mvn_sub(mvn_word* d, std::size_t dw,
+	const mvn_word* a, std::size_t aw,
+	const mvn_word* b, std::size_t bw)
+{
+  std::size_t n = mvn_nw(dw);
+  mvn_word br = 0;
+  for ( std::size_t i = 0; i < n; ++ i ) {
+    mvn_word a1 = mvn_word_at(a, aw, i);
+    mvn_word b1 = mvn_word_at(b, bw, i);
+    mvn_word s = a1 - b1;
+    mvn_word br1 = a1 < b1 ? 1 : 0;
+    d[i] = s - br;
+    br = br1 | (s < br ? 1 : 0);
+  }
+  mvn_normalize(d, dw);
+}
+
+inline void
+mvn_cmpl(mvn_word* d, std::size_t dw,
+	 const mvn_word* a, std::size_t aw)
+{
+  mvn_sub(d, dw, mvn_zero, 0, a, aw);
+}
+
+// d は a, b と重なってはいけない．
+inline void
+mvn_mul(mvn_word* d, std::size_t dw,
+	const mvn_word* a, std::size_t aw,
+	const mvn_word* b, std::size_t bw)
+{
+  std::size_t n = mvn_nw(dw);
+  for ( std::size_t i = 0; i < n; ++ i ) {
+    d[i] = 0;
+  }
+  for ( std::size_t i = 0; i < n; ++ i ) {
+    mvn_word a1 = mvn_word_at(a, aw, i);
+    if ( a1 == 0 ) {
+      continue;
+    }
+    mvn_word c = 0;
+    for ( std::size_t j = 0; i + j < n; ++ j ) {
+      unsigned __int128 t = static_cast<unsigned __int128>(a1) * mvn_word_at(b, bw, j);
+      t += d[i + j];
+      t += c;
+      d[i + j] = static_cast<mvn_word>(t);
+      c = static_cast<mvn_word>(t >> 64);
+    }
+  }
+  mvn_normalize(d, dw);
+}
+
+// q, r は mvn_nw(w) ワードの領域を持つ．
+// 0 で割った時は商も余りも 0 とする．
+inline void
+mvn_divmod(mvn_word* q, mvn_word* r, std::size_t w,
+	   const mvn_word* a, std::size_t aw,
+	   const mvn_word* b, std::size_t bw)
+{
+  std::size_t n = mvn_nw(w);
+  for ( std::size_t i = 0; i < n; ++ i ) {
+    q[i] = 0;
+    r[i] = 0;
+  }
+  if ( mvn_is_zero(b, bw) ) {
+    return;
+  }
+  for ( std::size_t pos = aw; pos > 0; -- pos ) {
+    for ( std::size_t i = n; i > 1; -- i ) {
+      r[i - 1] = (r[i - 1] << 1) | (r[i - 2] >> 63);
+    }
+    r[0] = (r[0] << 1) | mvn_bit(a, aw, pos - 1);
+    if ( !mvn_lt(r, w, b, bw) ) {
+      mvn_sub(r, w, r, w, b, bw);
+      q[(pos - 1) / 64] |= mvn_word(1) << ((pos - 1) % 64);
+    }
+  }
+}
+
+// t0, t1, t2 は mvn_nw(dw) ワードの作業領域
+inline void
+mvn_pow(mvn_word* d, std::size_t dw,
+	const mvn_word* a, std::size_t aw,
+	const mvn_word* e, std::size_t ew,
+	mvn_word* t0, mvn_word* t1, mvn_word* t2)
+{
+  std::size_t n = mvn_nw(dw);
+  mvn_copy(t0, dw, a, aw);
+  for ( std::size_t i = 0; i < n; ++ i ) {
+    t1[i] = 0;
+  }
+  if ( n > 0 ) {
+    t1[0] = 1;
+  }
+  std::size_t last = 0;
+  for ( std::size_t b = 0; b < ew; ++ b ) {
+    if ( mvn_bit(e, ew, b) ) {
+      last = b + 1;
+    }
+  }
+  for ( std::size_t b = 0; b < last; ++ b ) {
+    if ( mvn_bit(e, ew, b) ) {
+      mvn_mul(t2, dw, t1, dw, t0, dw);
+      std::memcpy(t1, t2, n * sizeof(mvn_word));
+    }
+    if ( b + 1 < last ) {
+      mvn_mul(t2, dw, t0, dw, t0, dw);
+      std::memcpy(t0, t2, n * sizeof(mvn_word));
+    }
+  }
+  mvn_copy(d, dw, t1, dw);
+}
+
+// 以下は 64 ビット以下の値に対する演算
+// bw は max(入力のビット幅, 出力のビット幅)
+
+inline mvn_word
+mvn_shl64(mvn_word a, mvn_word s, std::size_t bw)
+{
+  return s >= bw ? 0 : a << s;
+}
+
+inline mvn_word
+mvn_shr64(mvn_word a, mvn_word s, std::size_t bw)
+{
+  return s >= bw ? 0 : a >> s;
+}
+
+inline mvn_word
+mvn_sra64(mvn_word a, std::size_t aw, mvn_word s, std::size_t bw)
+{
+  bool sign = aw > 0 && ((a >> (aw - 1)) & 1);
+  mvn_word r = s >= bw ? 0 : a >> s;
+  if ( sign ) {
+    std::size_t start = s < aw ? aw - s : 0;
+    r |= start >= 64 ? 0 : ~((mvn_word(1) << start) - 1);
+  }
+  return r;
+}
+
+inline mvn_word
+mvn_div64(mvn_word a, mvn_word b)
+{
+  return b == 0 ? 0 : a / b;
+}
+
+inline mvn_word
+mvn_mod64(mvn_word a, mvn_word b)
+{
+  return b == 0 ? 0 : a % b;
+}
+
+inline mvn_word
+mvn_pow64(mvn_word a, mvn_word e)
+{
+  mvn_word r = 1;
+  while ( e != 0 ) {
+    if ( e & 1 ) {
+      r *= a;
+    }
+    e >>= 1;
+    a *= a;
+  }
+  return r;
+}
+
+} // namespace
+)PRELUDE";
+
+// ビット幅をワード数に変換する．
+inline
+SizeType
+nwords(
+  SizeType bw
+)
+{
+  return (bw + 63) / 64;
+}
+
+// 出力する構造体名に使えない文字を '_' に置き換える．
+string
+struct_name(
+  const MvnModule* module
+)
+{
+  string name{"mvn_"};
+  string src{module->name()};
+  if ( src == string() ) {
+    ostringstream buf;
+    buf << "module" << module->id();
+    src = buf.str();
+  }
+  for ( auto c: src ) {
+    if ( isalnum(static_cast<unsigned char>(c)) ) {
+      name += c;
+    }
+    else {
+      name += '_';
+    }
+  }
+  return name;
+}
+
+// 定数値を配列の初期化子の形で返す．
+string
+init_str(
+  const MvnBvConst& val,
+  SizeType bw
+)
+{
+  SizeType n{nwords(bw)};
+  vector<std::uint64_t> words(n, 0ULL);
+  for ( SizeType b = 0; b < bw && b < val.size(); ++ b ) {
+    if ( val[b] ) {
+      words[b / 64] |= (1ULL << (b % 64));
+    }
+  }
+  ostringstream buf;
+  buf << "{";
+  for ( SizeType i = 0; i < n; ++ i ) {
+    if ( i > 0 ) {
+      buf << ",";
+    }
+    buf << " UINT64_C(0x" << std::hex << words[i] << std::dec << ")";
+  }
+  buf << " }";
+  return buf.str();
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス CxxWriterImpl
+//////////////////////////////////////////////////////////////////////
+
+// @brief 内容を出力する．
+void
+CxxWriterImpl::dump(
+  ostream& s,
+  const MvnMgr& mgr
+)
+{
+  s << "// generated by MvnCxxWriter" << endl
+    << prelude;
+
+  mStateArray.clear();
+  mStateArray.resize(mgr.max_node_id(), false);
+  bool skipped{false};
+  SizeType n{mgr.max_module_id()};
+  for ( SizeType i = 0; i < n; ++ i ) {
+    auto module{mgr.module(i)};
+    if ( module != nullptr ) {
+      if ( !dump_module(s, module, mgr) ) {
+	skipped = true;
+      }
+    }
+  }
+  if ( skipped ) {
+    s.setstate(std::ios::failbit);
+  }
+}
+
+// @brief モジュールに対応する構造体を出力する．
+bool
+CxxWriterImpl::dump_module(
+  ostream& s,
+  const MvnModule* module,
+  const MvnMgr& mgr
+)
+{
+  MvnLevelizer lvlz{mgr, module};
+  string name{struct_name(module)};
+
+  s << endl;
+  if ( lvlz.has_loop() ) {
+    // 直線的なコードにはできない．
+    s << "// module " << module->name()
+      << " is skipped: combinational loop" << endl;
+    return false;
+  }
+
+  // 状態を持つノードとラッチのリスト
+  vector<const MvnNode*> state_list;
+  for ( auto node: lvlz.node_list() ) {
+    if ( node->type() == MvnNodeType::DFF ||
+	 node->type() == MvnNodeType::LATCH ) {
+      state_list.push_back(node);
+      mStateArray[node->id()] = true;
+    }
+  }
+
+  // 入出力の配置を決める．
+  vector<pair<const MvnNode*, SizeType>> input_list;
+  vector<pair<const MvnNode*, SizeType>> output_list;
+  SizeType in_words = 0;
+  SizeType out_words = 0;
+  for ( SizeType i = 0; i < module->input_num(); ++ i ) {
+    auto node{module->input(i)};
+    input_list.push_back(make_pair(node, in_words));
+    in_words += nwords(node->bit_width());
+  }
+  for ( SizeType i = 0; i < module->inout_num(); ++ i ) {
+    auto node{module->inout(i)};
+    if ( node->input(0)->src_node() == nullptr ) {
+      input_list.push_back(make_pair(node, in_words));
+      in_words += nwords(node->bit_width());
+    }
+  }
+  for ( SizeType i = 0; i < module->output_num(); ++ i ) {
+    auto node{module->output(i)};
+    output_list.push_back(make_pair(node, out_words));
+    out_words += nwords(node->bit_width());
+  }
+  for ( SizeType i = 0; i < module->inout_num(); ++ i ) {
+    auto node{module->inout(i)};
+    output_list.push_back(make_pair(node, out_words));
+    out_words += nwords(node->bit_width());
+  }
+  unordered_map<SizeType, SizeType> in_pos_map;
+  for ( auto& p: input_list ) {
+    in_pos_map.emplace(p.first->id(), p.second);
+  }
+  unordered_map<SizeType, SizeType> out_pos_map;
+  for ( auto& p: output_list ) {
+    out_pos_map.emplace(p.first->id(), p.second);
+  }
+
+  s << "// module " << module->name() << endl;
+  for ( auto& p: input_list ) {
+    s << "//   in[" << p.second << "]: " << node_name(p.first)
+      << " (" << p.first->bit_width() << " bits)" << endl;
+  }
+  for ( auto& p: output_list ) {
+    s << "//   out[" << p.second << "]: " << node_name(p.first)
+      << " (" << p.first->bit_width() << " bits)" << endl;
+  }
+  s << "struct " << name << " {" << endl
+    << "  static const std::size_t input_words = " << in_words << ";" << endl
+    << "  static const std::size_t output_words = " << out_words << ";" << endl
+    << endl;
+
+  // 状態
+  for ( auto node: state_list ) {
+    SizeType n{std::max<SizeType>(nwords(node->bit_width()), 1)};
+    s << "  mvn_word " << node_name(node) << "[" << n << "];" << endl;
+    if ( node->type() == MvnNodeType::DFF ) {
+      s << "  mvn_word " << node_name(node) << "_next[" << n << "];" << endl;
+    }
+  }
+  s << endl;
+
+  // reset()
+  s << "  void reset()" << endl
+    << "  {" << endl;
+  for ( auto node: state_list ) {
+    s << "    std::memset(" << node_name(node) << ", 0, sizeof("
+      << node_name(node) << "));" << endl;
+    if ( node->type() == MvnNodeType::DFF ) {
+      s << "    std::memset(" << node_name(node) << "_next, 0, sizeof("
+	<< node_name(node) << "_next));" << endl;
+    }
+  }
+  s << "  }" << endl
+    << endl;
+
+  // eval()
+  s << "  void eval(const mvn_word* in, mvn_word* out)" << endl
+    << "  {" << endl
+    << "    bool changed = comb(in, out);" << endl
+    << "    for ( std::size_t c = 0; changed && c <= "
+    << lvlz.dff_list().size() << "; ++ c ) {" << endl
+    << "      changed = comb(in, out);" << endl
+    << "    }" << endl
+    << "  }" << endl
+    << endl;
+
+  // step()
+  s << "  void step()" << endl
+    << "  {" << endl;
+  for ( auto node: lvlz.dff_list() ) {
+    s << "    std::memcpy(" << node_name(node) << ", "
+      << node_name(node) << "_next, sizeof("
+      << node_name(node) << "));" << endl;
+  }
+  s << "  }" << endl
+    << endl;
+
+  // comb()
+  // 非同期セット/リセットで状態が変化した時に true を返す．
+  s << "  bool comb(const mvn_word* in, mvn_word* out)" << endl
+    << "  {" << endl
+    << "    (void)in;" << endl
+    << "    (void)out;" << endl
+    << "    bool changed = false;" << endl;
+  for ( auto node: lvlz.node_list() ) {
+    auto type{node->type()};
+    if ( type == MvnNodeType::DFF ) {
+      continue;
+    }
+    SizeType bw{node->bit_width()};
+    if ( in_pos_map.count(node->id()) > 0 ) {
+      SizeType pos{in_pos_map.at(node->id())};
+      if ( bw <= 64 ) {
+	s << "    const mvn_word " << node_name(node) << " = in["
+	  << pos << "] & " << mask_str(bw) << ";" << endl;
+      }
+      else {
+	s << "    mvn_word " << node_name(node) << "[" << nwords(bw) << "];" << endl
+	  << "    mvn_copy(" << node_name(node) << ", " << bw << ", in + "
+	  << pos << ", " << bw << ");" << endl;
+      }
+    }
+    else if ( type == MvnNodeType::CONSTVALUE ) {
+      auto init{init_str(node->const_value(), bw)};
+      if ( bw <= 64 ) {
+	s << "    const mvn_word " << node_name(node) << " = "
+	  << init.substr(2, init.size() - 4) << ";" << endl;
+      }
+      else {
+	s << "    static const mvn_word " << node_name(node) << "["
+	  << nwords(bw) << "] = " << init << ";" << endl;
+      }
+    }
+    else {
+      dump_node(s, node);
+    }
+    if ( out_pos_map.count(node->id()) > 0 ) {
+      SizeType pos{out_pos_map.at(node->id())};
+      if ( bw <= 64 ) {
+	s << "    out[" << pos << "] = " << val_str(node) << ";" << endl;
+      }
+      else {
+	s << "    mvn_copy(out + " << pos << ", " << bw << ", "
+	  << arg_str(node) << ");" << endl;
+      }
+    }
+  }
+  for ( auto node: lvlz.dff_list() ) {
+    dump_dff(s, node);
+  }
+  s << "    return changed;" << endl
+    << "  }" << endl
+    << "};" << endl;
+
+  for ( auto node: state_list ) {
+    mStateArray[node->id()] = false;
+  }
+  return true;
+}
+
+// @brief 組み合わせ回路ノードの評価コードを出力する．
+void
+CxxWriterImpl::dump_node(
+  ostream& s,
+  const MvnNode* node
+)
+{
+  if ( node->type() == MvnNodeType::LATCH ) {
+    // イネーブルが 0 の時は値を保持する．
+    auto src0{node->input(0)->src_node()};
+    auto src1{node->input(1)->src_node()};
+    s << "    if ( " << nz_str(src1) << " ) {" << endl
+      << "      mvn_copy(" << node_name(node) << ", " << node->bit_width()
+      << ", " << arg_str(src0) << ");" << endl
+      << "    }" << endl;
+    return;
+  }
+
+  bool narrow{node->bit_width() <= 64};
+  SizeType ni{MvnLevelizer::fanin_num(node)};
+  for ( SizeType i = 0; i < ni; ++ i ) {
+    if ( width(MvnLevelizer::fanin(node, i)) > 64 ) {
+      narrow = false;
+    }
+  }
+  if ( narrow ) {
+    dump_narrow(s, node);
+  }
+  else {
+    dump_wide(s, node);
+  }
+}
+
+// @brief 64ビット以下の演算のみで済むノードの評価コードを出力する．
+void
+CxxWriterImpl::dump_narrow(
+  ostream& s,
+  const MvnNode* node
+)
+{
+  auto ival = [&](SizeType pos) -> string {
+    return val_str(MvnLevelizer::fanin(node, pos));
+  };
+  auto iwidth = [&](SizeType pos) -> SizeType {
+    return width(MvnLevelizer::fanin(node, pos));
+  };
+  auto nop = [&](const char* opr_str) -> string {
+    string expr{ival(0)};
+    SizeType ni{MvnLevelizer::fanin_num(node)};
+    for ( SizeType i = 1; i < ni; ++ i ) {
+      expr += opr_str + ival(i);
+    }
+    return expr;
+  };
+
+  SizeType ow{node->bit_width()};
+  ostringstream buf;
+  switch ( node->type() ) {
+  case MvnNodeType::OUTPUT:
+  case MvnNodeType::INOUT:
+  case MvnNodeType::THROUGH:
+    buf << ival(0);
+    break;
+
+  case MvnNodeType::NOT:
+    buf << "~" << ival(0);
+    break;
+
+  case MvnNodeType::AND: buf << nop(" & "); break;
+  case MvnNodeType::OR:  buf << nop(" | "); break;
+  case MvnNodeType::XOR: buf << nop(" ^ "); break;
+
+  case MvnNodeType::RAND:
+    buf << "(" << ival(0) << " == " << mask_str(iwidth(0)) << ")";
+    break;
+
+  case MvnNodeType::ROR:
+    buf << "(" << ival(0) << " != 0)";
+    break;
+
+  case MvnNodeType::RXOR:
+    buf << "mvn_parity(" << ival(0) << ")";
+    break;
+
+  case MvnNodeType::EQ:
+    buf << "(" << ival(0) << " == " << ival(1) << ")";
+    break;
+
+  case MvnNodeType::LT:
+    buf << "(" << ival(0) << " < " << ival(1) << ")";
+    break;
+
+  case MvnNodeType::CASEEQ:
+    {
+      auto xmask{node->xmask()};
+      SizeType iw{node->input(0)->bit_width()};
+      std::uint64_t x = 0ULL;
+      for ( SizeType b = 0; b < iw && b < 64; ++ b ) {
+	if ( xmask[b] ) {
+	  x |= (1ULL << b);
+	}
+      }
+      buf << "(((" << ival(0) << " ^ " << ival(1) << ") & ~"
+	  << word_str(x) << ") == 0)";
+    }
+    break;
+
+  case MvnNodeType::SLL:
+  case MvnNodeType::SLA:
+    buf << "mvn_shl64(" << ival(0) << ", " << ival(1) << ", "
+	<< std::max(iwidth(0), ow) << ")";
+    break;
+
+  case MvnNodeType::SRL:
+    buf << "mvn_shr64(" << ival(0) << ", " << ival(1) << ", "
+	<< std::max(iwidth(0), ow) << ")";
+    break;
+
+  case MvnNodeType::SRA:
+    buf << "mvn_sra64(" << ival(0) << ", " << iwidth(0) << ", "
+	<< ival(1) << ", " << std::max(iwidth(0), ow) << ")";
+    break;
+
+  case MvnNodeType::CMPL:
+    buf << "(mvn_word(0) - " << ival(0) << ")";
+    break;
+
+  case MvnNodeType::ADD:
+    buf << ival(0) << " + " << ival(1);
+    break;
+
+  case MvnNodeType::SUB:
+    buf << ival(0) << " - " << ival(1);
+    break;
+
+  case MvnNodeType::MUL:
+    buf << ival(0) << " * " << ival(1);
+    break;
+
+  case MvnNodeType::DIV:
+    buf << "mvn_div64(" << ival(0) << ", " << ival(1) << ")";
+    break;
+
+  case MvnNodeType::MOD:
+    buf << "mvn_mod64(" << ival(0) << ", " << ival(1) << ")";
+    break;
+
+  case MvnNodeType::POW:
+    buf << "mvn_pow64(" << ival(0) << ", " << ival(1) << ")";
+    break;
+
+  case MvnNodeType::ITE:
+    buf << "(" << ival(0) << " != 0 ? " << ival(1) << " : " << ival(2) << ")";
+    break;
+
+  case MvnNodeType::CONCAT:
+    {
+      // 最後の入力が LSB 側になる．
+      SizeType ni{MvnLevelizer::fanin_num(node)};
+      SizeType pos = 0;
+      string expr;
+      for ( SizeType j = ni; j > 0; -- j ) {
+	if ( pos < 64 && iwidth(j - 1) > 0 ) {
+	  if ( expr != string() ) {
+	    expr += " | ";
+	  }
+	  if ( pos == 0 ) {
+	    expr += ival(j - 1);
+	  }
+	  else {
+	    ostringstream buf1;
+	    buf1 << "(" << ival(j - 1) << " << " << pos << ")";
+	    expr += buf1.str();
+	  }
+	}
+	pos += iwidth(j - 1);
+      }
+      if ( expr == string() ) {
+	expr = "mvn_word(0)";
+      }
+      buf << expr;
+    }
+    break;
+
+  case MvnNodeType::CONSTBITSELECT:
+    if ( node->bitpos() < iwidth(0) ) {
+      buf << "(" << ival(0) << " >> " << node->bitpos() << ")";
+    }
+    else {
+      buf << "mvn_word(0)";
+    }
+    break;
+
+  case MvnNodeType::CONSTPARTSELECT:
+    if ( node->lsb() < iwidth(0) ) {
+      buf << "(" << ival(0) << " >> " << node->lsb() << ")";
+    }
+    else {
+      buf << "mvn_word(0)";
+    }
+    break;
+
+  case MvnNodeType::BITSELECT:
+  case MvnNodeType::PARTSELECT:
+    // 2番目の入力を LSB の位置とみなす．
+    buf << "(" << ival(1) << " < " << iwidth(0) << " ? "
+	<< ival(0) << " >> " << ival(1) << " : mvn_word(0))";
+    break;
+
+  case MvnNodeType::CELL:
+    {
+      auto cell{node->cell()};
+      SizeType opos = node->cell_opin_pos();
+      if ( cell.has_logic(opos) ) {
+	buf << expr_str(cell.logic_expr(opos), node);
+      }
+      else {
+	// 論理式を持たないセルの出力は 0 とする．
+	buf << "mvn_word(0)";
+      }
+    }
+    break;
+
+  default:
+    ASSERT_NOT_REACHED;
+    break;
+  }
+  dump_scalar(s, node, buf.str());
+}
+
+// @brief 多倍長演算を用いるノードの評価コードを出力する．
+void
+CxxWriterImpl::dump_wide(
+  ostream& s,
+  const MvnNode* node
+)
+{
+  auto iarg = [&](SizeType pos) -> string {
+    return arg_str(MvnLevelizer::fanin(node, pos));
+  };
+  auto iwidth = [&](SizeType pos) -> SizeType {
+    return width(MvnLevelizer::fanin(node, pos));
+  };
+
+  SizeType ow{node->bit_width()};
+  SizeType on{std::max<SizeType>(nwords(ow), 1)};
+  string name{node_name(node)};
+  string dst{(ow <= 64 ? "&" : "") + name + ", "};
+  {
+    ostringstream buf;
+    buf << ow;
+    dst += buf.str();
+  }
+
+  // 結果が1ワードに収まる演算
+  switch ( node->type() ) {
+  case MvnNodeType::RAND:
+    dump_scalar(s, node, "mvn_rand(" + iarg(0) + ")");
+    return;
+
+  case MvnNodeType::ROR:
+    dump_scalar(s, node, "mvn_ror(" + iarg(0) + ")");
+    return;
+
+  case MvnNodeType::RXOR:
+    dump_scalar(s, node, "mvn_rxor(" + iarg(0) + ")");
+    return;
+
+  case MvnNodeType::EQ:
+    dump_scalar(s, node, "mvn_eq(" + iarg(0) + ", " + iarg(1) + ")");
+    return;
+
+  case MvnNodeType::LT:
+    dump_scalar(s, node, "mvn_lt(" + iarg(0) + ", " + iarg(1) + ")");
+    return;
+
+  case MvnNodeType::CASEEQ:
+    {
+      SizeType iw{node->input(0)->bit_width()};
+      s << "    static const mvn_word " << name << "_x["
+	<< std::max<SizeType>(nwords(iw), 1) << "] = "
+	<< init_str(node->xmask(), iw) << ";" << endl;
+      dump_scalar(s, node, "mvn_caseeq(" + iarg(0) + ", " + iarg(1) +
+		  ", " + name + "_x)");
+    }
+    return;
+
+  case MvnNodeType::CONSTBITSELECT:
+    {
+      ostringstream buf;
+      buf << "mvn_bit(" << iarg(0) << ", " << node->bitpos() << ")";
+      dump_scalar(s, node, buf.str());
+    }
+    return;
+
+  case MvnNodeType::BITSELECT:
+    dump_scalar(s, node, "mvn_bit(" + iarg(0) + ", mvn_index(" + iarg(1) + "))");
+    return;
+
+  default:
+    break;
+  }
+
+  s << "    mvn_word " << name;
+  if ( ow > 64 ) {
+    s << "[" << on << "]";
+  }
+  s << ";" << endl;
+
+  switch ( node->type() ) {
+  case MvnNodeType::OUTPUT:
+  case MvnNodeType::INOUT:
+  case MvnNodeType::THROUGH:
+    s << "    mvn_copy(" << dst << ", " << iarg(0) << ");" << endl;
+    break;
+
+  case MvnNodeType::NOT:
+    s << "    mvn_not(" << dst << ", " << iarg(0) << ");" << endl;
+    break;
+
+  case MvnNodeType::AND:
+  case MvnNodeType::OR:
+  case MvnNodeType::XOR:
+    {
+      const char* func = "mvn_and";
+      if ( node->type() == MvnNodeType::OR ) {
+	func = "mvn_or";
+      }
+      else if ( node->type() == MvnNodeType::XOR ) {
+	func = "mvn_xor";
+      }
+      s << "    mvn_copy(" << dst << ", " << iarg(0) << ");" << endl;
+      SizeType ni{MvnLevelizer::fanin_num(node)};
+      for ( SizeType i = 1; i < ni; ++ i ) {
+	s << "    " << func << "(" << dst << ", " << iarg(i) << ");" << endl;
+      }
+    }
+    break;
+
+  case MvnNodeType::SLL:
+  case MvnNodeType::SLA:
+    s << "    mvn_shl(" << dst << ", " << iarg(0)
+      << ", mvn_index(" << iarg(1) << "));" << endl;
+    break;
+
+  case MvnNodeType::SRL:
+  case MvnNodeType::SRA:
+    s << "    mvn_shr(" << dst << ", " << iarg(0)
+      << ", mvn_index(" << iarg(1) << "), "
+      << (node->type() == MvnNodeType::SRA ? "true" : "false")
+      << ");" << endl;
+    break;
+
+  case MvnNodeType::CMPL:
+    s << "    mvn_cmpl(" << dst << ", " << iarg(0) << ");" << endl;
+    break;
+
+  case MvnNodeType::ADD:
+    s << "    mvn_add(" << dst << ", " << iarg(0) << ", " << iarg(1) << ");" << endl;
+    break;
+
+  case MvnNodeType::SUB:
+    s << "    mvn_sub(" << dst << ", " << iarg(0) << ", " << iarg(1) << ");" << endl;
+    break;
+
+  case MvnNodeType::MUL:
+    s << "    mvn_mul(" << dst << ", " << iarg(0) << ", " << iarg(1) << ");" << endl;
+    break;
+
+  case MvnNodeType::DIV:
+  case MvnNodeType::MOD:
+    {
+      SizeType bw{std::max(std::max(iwidth(0), iwidth(1)), ow)};
+      SizeType bn{std::max<SizeType>(nwords(bw), 1)};
+      s << "    {" << endl
+	<< "      mvn_word q[" << bn << "];" << endl
+	<< "      mvn_word r[" << bn << "];" << endl
+	<< "      mvn_divmod(q, r, " << bw << ", " << iarg(0) << ", "
+	<< iarg(1) << ");" << endl
+	<< "      mvn_copy(" << dst << ", "
+	<< (node->type() == MvnNodeType::DIV ? "q" : "r")
+	<< ", " << bw << ");" << endl
+	<< "    }" << endl;
+    }
+    break;
+
+  case MvnNodeType::POW:
+    s << "    {" << endl
+      << "      mvn_word t0[" << on << "];" << endl
+      << "      mvn_word t1[" << on << "];" << endl
+      << "      mvn_word t2[" << on << "];" << endl
+      << "      mvn_pow(" << dst << ", " << iarg(0) << ", " << iarg(1)
+      << ", t0, t1, t2);" << endl
+      << "    }" << endl;
+    break;
+
+  case MvnNodeType::ITE:
+    s << "    if ( " << nz_str(MvnLevelizer::fanin(node, 0)) << " ) {" << endl
+      << "      mvn_copy(" << dst << ", " << iarg(1) << ");" << endl
+      << "    }" << endl
+      << "    else {" << endl
+      << "      mvn_copy(" << dst << ", " << iarg(2) << ");" << endl
+      << "    }" << endl;
+    break;
+
+  case MvnNodeType::CONCAT:
+    {
+      // 最後の入力が LSB 側になる．
+      s << "    std::memset(" << (ow <= 64 ? "&" : "") << name
+	<< ", 0, sizeof(" << name << "));" << endl;
+      SizeType ni{MvnLevelizer::fanin_num(node)};
+      SizeType pos = 0;
+      for ( SizeType j = ni; j > 0; -- j ) {
+	s << "    mvn_or_bits(" << dst << ", " << pos << ", "
+	  << iarg(j - 1) << ");" << endl;
+	pos += iwidth(j - 1);
+      }
+      s << "    mvn_normalize(" << dst << ");" << endl;
+    }
+    break;
+
+  case MvnNodeType::CONSTPARTSELECT:
+    s << "    mvn_select(" << dst << ", " << iarg(0) << ", "
+      << node->lsb() << ");" << endl;
+    break;
+
+  case MvnNodeType::PARTSELECT:
+    // 2番目の入力を LSB の位置とみなす．
+    s << "    mvn_select(" << dst << ", " << iarg(0)
+      << ", mvn_index(" << iarg(1) << "));" << endl;
+    break;
+
+  case MvnNodeType::CELL:
+    // セルの出力は常に 1 ビットなのでここには来ない．
+    s << "    std::memset(" << (ow <= 64 ? "&" : "") << name
+      << ", 0, sizeof(" << name << "));" << endl;
+    break;
+
+  default:
+    ASSERT_NOT_REACHED;
+    break;
+  }
+}
+
+// @brief DFF の次状態と非同期セット/リセットのコードを出力する．
+void
+CxxWriterImpl::dump_dff(
+  ostream& s,
+  const MvnNode* node
+)
+{
+  string name{node_name(node)};
+  SizeType bw{node->bit_width()};
+  string next{name + "_next"};
+  SizeType nc{node->input_num() - 2};
+
+  s << "    // " << name << " の次状態" << endl;
+  for ( SizeType i = 0; i < nc; ++ i ) {
+    auto ctrl{node->input(i + 2)->src_node()};
+    bool positive{node->control_pol(i) == MvnPolarity::Positive};
+    s << "    " << (i > 0 ? "else if" : "if") << " ( ";
+    if ( ctrl == nullptr ) {
+      s << (positive ? "false" : "true");
+    }
+    else {
+      string bit0{width(ctrl) <= 64 ? val_str(ctrl) : node_name(ctrl) + "[0]"};
+      s << "(" << bit0 << " & 1) == " << (positive ? "1" : "0");
+    }
+    s << " ) {" << endl;
+    auto val_node{node->control_val(i)};
+    if ( val_node == nullptr ) {
+      s << "      std::memset(" << next << ", 0, sizeof(" << next << "));" << endl;
+    }
+    else {
+      SizeType vw{val_node->bit_width()};
+      s << "      static const mvn_word v[" << std::max<SizeType>(nwords(vw), 1)
+	<< "] = " << init_str(val_node->const_value(), vw) << ";" << endl
+	<< "      mvn_copy(" << next << ", " << bw << ", v, " << vw << ");" << endl;
+    }
+    // 非同期の制御信号は現在の値も変える．
+    s << "      if ( !mvn_equal(" << name << ", " << next << ", " << bw << ") ) {" << endl
+      << "        std::memcpy(" << name << ", " << next << ", sizeof("
+      << name << "));" << endl
+      << "        changed = true;" << endl
+      << "      }" << endl
+      << "    }" << endl;
+  }
+  if ( nc > 0 ) {
+    s << "    else {" << endl
+      << "  ";
+  }
+  s << "    mvn_copy(" << next << ", " << bw << ", "
+    << arg_str(node->input(0)->src_node()) << ");" << endl;
+  if ( nc > 0 ) {
+    s << "    }" << endl;
+  }
+}
+
+// @brief 結果が1ワードに収まる式の代入文を出力する．
+void
+CxxWriterImpl::dump_scalar(
+  ostream& s,
+  const MvnNode* node,
+  const string& expr
+)
+{
+  SizeType ow{node->bit_width()};
+  if ( ow <= 64 ) {
+    s << "    const mvn_word " << node_name(node) << " = ";
+    if ( ow == 64 ) {
+      s << expr;
+    }
+    else {
+      s << "(" << expr << ") & " << mask_str(ow);
+    }
+    s << ";" << endl;
+  }
+  else {
+    // 残りのワードは 0 で初期化される．
+    s << "    mvn_word " << node_name(node) << "[" << nwords(ow)
+      << "] = { " << expr << " };" << endl;
+  }
+}
+
+// @brief セルの論理式を C++ の式に変換する．
+string
+CxxWriterImpl::expr_str(
+  const Expr& expr,
+  const MvnNode* node
+)
+{
+  if ( expr.is_zero() ) {
+    return "mvn_word(0)";
+  }
+  if ( expr.is_one() ) {
+    return "mvn_word(1)";
+  }
+  if ( expr.is_posi_literal() || expr.is_nega_literal() ) {
+    SizeType id{static_cast<SizeType>(expr.varid())};
+    auto src{MvnLevelizer::fanin(node, id)};
+    string lit{"(" + val_str(src) + " & 1)"};
+    if ( expr.is_nega_literal() ) {
+      lit = "(" + lit + " ^ 1)";
+    }
+    return lit;
+  }
+  const char* opr_str = nullptr;
+  if ( expr.is_and() ) {
+    opr_str = " & ";
+  }
+  else if ( expr.is_or() ) {
+    opr_str = " | ";
+  }
+  else if ( expr.is_xor() ) {
+    opr_str = " ^ ";
+  }
+  else {
+    ASSERT_NOT_REACHED;
+  }
+  string ans{"("};
+  SizeType n{expr.operand_num()};
+  for ( SizeType i = 0; i < n; ++ i ) {
+    if ( i > 0 ) {
+      ans += opr_str;
+    }
+    ans += expr_str(expr.operand(i), node);
+  }
+  ans += ")";
+  return ans;
+}
+
+// @brief ノードの値を表す 64 ビットの式を返す．
+string
+CxxWriterImpl::val_str(
+  const MvnNode* node
+)
+{
+  if ( node == nullptr ) {
+    return "mvn_word(0)";
+  }
+  ASSERT_COND( node->bit_width() <= 64 );
+  if ( mStateArray[node->id()] ) {
+    return node_name(node) + "[0]";
+  }
+  return node_name(node);
+}
+
+// @brief ノードの値の先頭を指すポインタの式を返す．
+string
+CxxWriterImpl::ptr_str(
+  const MvnNode* node
+)
+{
+  if ( node == nullptr ) {
+    return "mvn_zero";
+  }
+  if ( mStateArray[node->id()] || node->bit_width() > 64 ) {
+    return node_name(node);
+  }
+  return "&" + node_name(node);
+}
+
+// @brief ノードの値が 0 でない時 true となる式を返す．
+string
+CxxWriterImpl::nz_str(
+  const MvnNode* node
+)
+{
+  if ( node == nullptr ) {
+    return "false";
+  }
+  if ( node->bit_width() <= 64 ) {
+    return val_str(node) + " != 0";
+  }
+  return "!mvn_is_zero(" + arg_str(node) + ")";
+}
+
+// @brief ノードの値のポインタとビット幅を ", " で区切った文字列を返す．
+string
+CxxWriterImpl::arg_str(
+  const MvnNode* node
+)
+{
+  ostringstream buf;
+  buf << ptr_str(node) << ", " << width(node);
+  return buf.str();
+}
+
+// @brief ノードの変数名を返す．
+string
+CxxWriterImpl::node_name(
+  const MvnNode* node
+)
+{
+  ostringstream buf;
+  buf << "n" << node->id();
+  return buf.str();
+}
+
+// @brief ファンインのビット幅を返す．
+SizeType
+CxxWriterImpl::width(
+  const MvnNode* node
+)
+{
+  if ( node == nullptr ) {
+    return 0;
+  }
+  return node->bit_width();
+}
+
+// @brief ビット幅 bw のマスクを表すリテラルを返す．
+string
+CxxWriterImpl::mask_str(
+  SizeType bw
+)
+{
+  if ( bw >= 64 ) {
+    return "~mvn_word(0)";
+  }
+  return word_str((1ULL << bw) - 1ULL);
+}
+
+// @brief 64 ビット整数のリテラルを返す．
+string
+CxxWriterImpl::word_str(
+  std::uint64_t val
+)
+{
+  ostringstream buf;
+  buf << "UINT64_C(0x" << std::hex << val << std::dec << ")";
+  return buf.str();
+}
+
+END_NAMESPACE_YM_MVN
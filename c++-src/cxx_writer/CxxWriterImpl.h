@@ -0,0 +1,167 @@
+﻿#ifndef CXXWRITERIMPL_H
+#define CXXWRITERIMPL_H
+
+/// @file CxxWriterImpl.h
+/// @brief CxxWriterImpl のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/mvn.h"
+#include "ym/Expr.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+/// @class CxxWriterImpl CxxWriterImpl.h
+/// @brief MvnCxxWriter の実際の処理を行うクラス
+//////////////////////////////////////////////////////////////////////
+class CxxWriterImpl
+{
+public:
+
+  /// @brief コンストラクタ
+  CxxWriterImpl() = default;
+
+  /// @brief デストラクタ
+  ~CxxWriterImpl() = default;
+
+
+public:
+
+  /// @brief 内容を出力する．
+  void
+  dump(
+    ostream& s,       ///< [in] 出力先のストリーム
+    const MvnMgr& mgr ///< [in] MvnMgr
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で使われる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief モジュールに対応する構造体を出力する．
+  /// @return 組み合わせ回路のループのために出力できなかった時 false を返す．
+  bool
+  dump_module(
+    ostream& s,
+    const MvnModule* module,
+    const MvnMgr& mgr
+  );
+
+  /// @brief 組み合わせ回路ノードの評価コードを出力する．
+  void
+  dump_node(
+    ostream& s,
+    const MvnNode* node
+  );
+
+  /// @brief 64ビット以下の演算のみで済むノードの評価コードを出力する．
+  void
+  dump_narrow(
+    ostream& s,
+    const MvnNode* node
+  );
+
+  /// @brief 多倍長演算を用いるノードの評価コードを出力する．
+  void
+  dump_wide(
+    ostream& s,
+    const MvnNode* node
+  );
+
+  /// @brief DFF の次状態と非同期セット/リセットのコードを出力する．
+  void
+  dump_dff(
+    ostream& s,
+    const MvnNode* node
+  );
+
+  /// @brief 結果が1ワードに収まる式の代入文を出力する．
+  void
+  dump_scalar(
+    ostream& s,
+    const MvnNode* node,
+    const string& expr
+  );
+
+  /// @brief セルの論理式を C++ の式に変換する．
+  string
+  expr_str(
+    const Expr& expr,
+    const MvnNode* node
+  );
+
+  /// @brief ノードの値を表す 64 ビットの式を返す．
+  ///
+  /// node のビット幅は 64 以下でなければならない．
+  string
+  val_str(
+    const MvnNode* node
+  );
+
+  /// @brief ノードの値の先頭を指すポインタの式を返す．
+  string
+  ptr_str(
+    const MvnNode* node
+  );
+
+  /// @brief ノードの値が 0 でない時 true となる式を返す．
+  string
+  nz_str(
+    const MvnNode* node
+  );
+
+  /// @brief ノードの値のポインタとビット幅を ", " で区切った文字列を返す．
+  string
+  arg_str(
+    const MvnNode* node
+  );
+
+  /// @brief ノードの変数名を返す．
+  string
+  node_name(
+    const MvnNode* node
+  );
+
+  /// @brief ファンインのビット幅を返す．
+  ///
+  /// 接続されていない場合は 0 を返す．
+  static
+  SizeType
+  width(
+    const MvnNode* node
+  );
+
+  /// @brief ビット幅 bw のマスクを表すリテラルを返す．
+  static
+  string
+  mask_str(
+    SizeType bw
+  );
+
+  /// @brief 64 ビット整数のリテラルを返す．
+  static
+  string
+  word_str(
+    std::uint64_t val
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // ノード番号をキーにして構造体のメンバ(状態)の時 true を入れる配列
+  vector<bool> mStateArray;
+
+};
+
+END_NAMESPACE_YM_MVN
+
+#endif // CXXWRITERIMPL_H
@@ -0,0 +1,42 @@
+﻿
+/// @file MvnCxxWriter.cc
+/// @brief MvnCxxWriter の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/MvnCxxWriter.h"
+#include "CxxWriterImpl.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+// クラス MvnCxxWriter
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+MvnCxxWriter::MvnCxxWriter(
+) : mImpl{unique_ptr<CxxWriterImpl>{new CxxWriterImpl()}}
+{
+}
+
+// @brief デストラクタ
+MvnCxxWriter::~MvnCxxWriter()
+{
+  // CxxWriterImpl.h を必要とするため
+  // ヘッダ中で = default 宣言はできない．
+}
+
+// @brief 内容を C++ 形式で出力する
+void
+MvnCxxWriter::operator()(
+  ostream& s,
+  const MvnMgr& mgr
+)
+{
+  mImpl->dump(s, mgr);
+}
+
+END_NAMESPACE_YM_MVN
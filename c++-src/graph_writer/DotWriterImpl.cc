@@ -0,0 +1,168 @@
+﻿
+/// @file DotWriterImpl.cc
+/// @brief DotWriterImpl の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "DotWriterImpl.h"
+#include "ym/MvnMgr.h"
+#include "ym/MvnModule.h"
+#include "ym/MvnNode.h"
+#include "ym/MvnInputPin.h"
+#include "ym/MvnBvConst.h"
+#include "ym/MvnVlMap.h"
+#include "ym/ClibCell.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+BEGIN_NONAMESPACE
+
+// 文字列を DOT の文字列リテラルの中身として出力する．
+void
+put_str(
+  ostream& s,
+  const string& str
+)
+{
+  for ( char c: str ) {
+    if ( c == '"' || c == '\\' ) {
+      s << '\\';
+    }
+    s << c;
+  }
+}
+
+// ノードの形を返す．
+const char*
+shape_str(
+  MvnNodeType type
+)
+{
+  switch ( type ) {
+  case MvnNodeType::INPUT:      return "invhouse";
+  case MvnNodeType::OUTPUT:     return "house";
+  case MvnNodeType::INOUT:      return "diamond";
+  case MvnNodeType::DFF:        return "box";
+  case MvnNodeType::LATCH:      return "box";
+  case MvnNodeType::CONSTVALUE: return "plaintext";
+  default:                      break;
+  }
+  return "ellipse";
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス DotWriterImpl
+//////////////////////////////////////////////////////////////////////
+
+// @brief dump() の本体
+void
+DotWriterImpl::dump_sub(
+  ostream& s,
+  const MvnMgr& mgr,
+  const MvnVlMap* node_map
+)
+{
+  mark_cone(mgr);
+
+  // モジュールごとに cluster を作るので
+  // 出力対象のノードをモジュールごとに分けておく．
+  SizeType n{mgr.max_node_id()};
+  SizeType nm{mgr.max_module_id()};
+  vector<vector<const MvnNode*>> node_list_array(nm);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    auto node{mgr.node(i)};
+    if ( node != nullptr && is_selected(node) ) {
+      node_list_array[node->parent()->id()].push_back(node);
+    }
+  }
+
+  s << "digraph mvn {\n"
+    << "  rankdir=LR;\n";
+  for ( SizeType i = 0; i < nm; ++ i ) {
+    auto module{mgr.module(i)};
+    if ( module == nullptr || !is_selected(module) ) {
+      continue;
+    }
+    s << "  subgraph cluster_m" << i << " {\n"
+      << "    label=\"";
+    put_str(s, module->name());
+    s << "\";\n";
+    for ( auto node: node_list_array[i] ) {
+      dump_node(s, node, node_map);
+    }
+    s << "  }\n";
+  }
+
+  for ( SizeType i = 0; i < n; ++ i ) {
+    auto node{mgr.node(i)};
+    if ( node == nullptr || !is_selected(node) ) {
+      continue;
+    }
+    SizeType ni{node->input_num()};
+    for ( SizeType j = 0; j < ni; ++ j ) {
+      auto inode{node->input(j)->src_node()};
+      if ( inode == nullptr || !is_selected(inode) ) {
+	continue;
+      }
+      s << "  n" << inode->id() << " -> n" << node->id();
+      if ( ni > 1 ) {
+	s << " [label=\"" << j << "\"]";
+      }
+      s << ";\n";
+    }
+  }
+  s << "}\n";
+  s.flush();
+}
+
+// @brief ノードの定義を出力する．
+void
+DotWriterImpl::dump_node(
+  ostream& s,
+  const MvnNode* node,
+  const MvnVlMap* node_map
+)
+{
+  s << "    n" << node->id()
+    << " [shape=" << shape_str(node->type())
+    << ", label=\"" << node->id() << ": " << type_str(node->type())
+    << "[" << node->bit_width() << "]";
+  switch ( node->type() ) {
+  case MvnNodeType::CONSTBITSELECT:
+    s << "\\n[" << node->bitpos() << "]";
+    break;
+
+  case MvnNodeType::CONSTPARTSELECT:
+    s << "\\n[" << node->msb() << ":" << node->lsb() << "]";
+    break;
+
+  case MvnNodeType::CONSTVALUE:
+    s << "\\n";
+    put_str(s, node->const_value().to_string());
+    break;
+
+  case MvnNodeType::CELL:
+    s << "\\n";
+    put_str(s, node->cell().name());
+    break;
+
+  default:
+    break;
+  }
+  if ( node_map != nullptr ) {
+    auto name{node_map->get_name(node->id())};
+    if ( name != string{} ) {
+      s << "\\n";
+      put_str(s, name);
+    }
+  }
+  s << "\"];\n";
+}
+
+END_NAMESPACE_YM_MVN
@@ -0,0 +1,174 @@
+﻿
+/// @file GraphWriterImpl.cc
+/// @brief GraphWriterImpl の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "GraphWriterImpl.h"
+#include "ym/MvnMgr.h"
+#include "ym/MvnModule.h"
+#include "ym/MvnNode.h"
+#include "ym/MvnInputPin.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+// クラス GraphWriterImpl
+//////////////////////////////////////////////////////////////////////
+
+// @brief 出力対象のノードに印をつける．
+void
+GraphWriterImpl::mark_cone(
+  const MvnMgr& mgr
+)
+{
+  SizeType n{mgr.max_node_id()};
+  SizeType nm{mgr.max_module_id()};
+  mNodeMark.clear();
+  mModuleMark.clear();
+  if ( mRootList.empty() ) {
+    mNodeMark.resize(n, true);
+    mModuleMark.resize(nm, true);
+    return;
+  }
+
+  mNodeMark.resize(n, false);
+  mModuleMark.resize(nm, false);
+  mark_bfs(mgr, true, mFaninDepth);
+  mark_bfs(mgr, false, mFanoutDepth);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    if ( mNodeMark[i] ) {
+      auto node{mgr.node(i)};
+      mModuleMark[node->parent()->id()] = true;
+    }
+  }
+}
+
+// @brief 幅優先探索でコーンに印をつける．
+void
+GraphWriterImpl::mark_bfs(
+  const MvnMgr& mgr,
+  bool fanin,
+  SizeType depth
+)
+{
+  // ファンインとファンアウトで別々に訪問済みの印を持つ．
+  // mNodeMark を共有するとファンアウト側の探索が
+  // ファンイン側で印のついたノードで止まってしまう．
+  SizeType n{mgr.max_node_id()};
+  vector<bool> visited(n, false);
+  vector<const MvnNode*> cur_list;
+  for ( auto id: mRootList ) {
+    auto node{id < n ? mgr.node(id) : nullptr};
+    if ( node == nullptr ) {
+      if ( fanin ) {
+	cerr << "Node#" << id << ": no such node" << endl;
+      }
+      continue;
+    }
+    if ( !visited[id] ) {
+      visited[id] = true;
+      mNodeMark[id] = true;
+      cur_list.push_back(node);
+    }
+  }
+
+  vector<const MvnNode*> next_list;
+  for ( SizeType d = 0; d < depth && !cur_list.empty(); ++ d ) {
+    next_list.clear();
+    for ( auto node: cur_list ) {
+      if ( fanin ) {
+	SizeType ni{node->input_num()};
+	for ( SizeType i = 0; i < ni; ++ i ) {
+	  auto inode{node->input(i)->src_node()};
+	  if ( inode != nullptr && !visited[inode->id()] ) {
+	    visited[inode->id()] = true;
+	    mNodeMark[inode->id()] = true;
+	    next_list.push_back(inode);
+	  }
+	}
+      }
+      else {
+	for ( auto ipin: node->dst_pin_list() ) {
+	  auto onode{ipin->node()};
+	  if ( !visited[onode->id()] ) {
+	    visited[onode->id()] = true;
+	    mNodeMark[onode->id()] = true;
+	    next_list.push_back(onode);
+	  }
+	}
+      }
+    }
+    cur_list.swap(next_list);
+  }
+}
+
+// @brief ノードが出力対象の時 true を返す．
+bool
+GraphWriterImpl::is_selected(
+  const MvnNode* node
+) const
+{
+  return mNodeMark[node->id()];
+}
+
+// @brief モジュールが出力対象のノードを含む時 true を返す．
+bool
+GraphWriterImpl::is_selected(
+  const MvnModule* module
+) const
+{
+  return mModuleMark[module->id()];
+}
+
+// @brief ノードの型を表す文字列を返す．
+const char*
+GraphWriterImpl::type_str(
+  MvnNodeType type
+)
+{
+  switch ( type ) {
+  case MvnNodeType::INPUT:           return "INPUT";
+  case MvnNodeType::OUTPUT:          return "OUTPUT";
+  case MvnNodeType::INOUT:           return "INOUT";
+  case MvnNodeType::DFF:             return "DFF";
+  case MvnNodeType::LATCH:           return "LATCH";
+  case MvnNodeType::THROUGH:         return "THROUGH";
+  case MvnNodeType::NOT:             return "NOT";
+  case MvnNodeType::AND:             return "AND";
+  case MvnNodeType::OR:              return "OR";
+  case MvnNodeType::XOR:             return "XOR";
+  case MvnNodeType::RAND:            return "RAND";
+  case MvnNodeType::ROR:             return "ROR";
+  case MvnNodeType::RXOR:            return "RXOR";
+  case MvnNodeType::EQ:              return "EQ";
+  case MvnNodeType::LT:              return "LT";
+  case MvnNodeType::CASEEQ:          return "CASEEQ";
+  case MvnNodeType::SLL:             return "SLL";
+  case MvnNodeType::SRL:             return "SRL";
+  case MvnNodeType::SLA:             return "SLA";
+  case MvnNodeType::SRA:             return "SRA";
+  case MvnNodeType::CMPL:            return "CMPL";
+  case MvnNodeType::ADD:             return "ADD";
+  case MvnNodeType::SUB:             return "SUB";
+  case MvnNodeType::MUL:             return "MUL";
+  case MvnNodeType::DIV:             return "DIV";
+  case MvnNodeType::MOD:             return "MOD";
+  case MvnNodeType::POW:             return "POW";
+  case MvnNodeType::ITE:             return "ITE";
+  case MvnNodeType::CONCAT:          return "CONCAT";
+  case MvnNodeType::CONSTBITSELECT:  return "CONSTBITSELECT";
+  case MvnNodeType::CONSTPARTSELECT: return "CONSTPARTSELECT";
+  case MvnNodeType::BITSELECT:       return "BITSELECT";
+  case MvnNodeType::PARTSELECT:      return "PARTSELECT";
+  case MvnNodeType::CONSTVALUE:      return "CONSTVALUE";
+  case MvnNodeType::CELL:            return "CELL";
+  }
+  ASSERT_NOT_REACHED;
+  return "";
+}
+
+END_NAMESPACE_YM_MVN
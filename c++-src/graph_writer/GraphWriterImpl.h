@@ -0,0 +1,134 @@
+﻿#ifndef GRAPHWRITERIMPL_H
+#define GRAPHWRITERIMPL_H
+
+/// @file GraphWriterImpl.h
+/// @brief GraphWriterImpl のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/mvn.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+/// @class GraphWriterImpl GraphWriterImpl.h "GraphWriterImpl.h"
+/// @brief JsonWriterImpl と DotWriterImpl の共通部分
+///
+/// 出力対象をいくつかの根のノードのファンイン/ファンアウトの
+/// コーンに制限する機能を持つ．
+/// コーンは入力ピンの接続のみをたどって求める．
+/// DFF のコントロール値のノードはたどらない．
+//////////////////////////////////////////////////////////////////////
+class GraphWriterImpl
+{
+public:
+
+  /// @brief コンストラクタ
+  GraphWriterImpl() = default;
+
+  /// @brief デストラクタ
+  ~GraphWriterImpl() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 設定を行う関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 出力対象を根のノードのコーンに制限する．
+  void
+  set_cone(
+    const vector<SizeType>& root_list, ///< [in] 根のノード番号のリスト
+    SizeType fanin_depth,              ///< [in] ファンイン方向の深さ
+    SizeType fanout_depth              ///< [in] ファンアウト方向の深さ
+  )
+  {
+    mRootList = root_list;
+    mFaninDepth = fanin_depth;
+    mFanoutDepth = fanout_depth;
+  }
+
+  /// @brief コーンの制限を解除する．
+  void
+  clear_cone()
+  {
+    mRootList.clear();
+  }
+
+
+protected:
+  //////////////////////////////////////////////////////////////////////
+  // 継承クラスから用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 出力対象のノードに印をつける．
+  ///
+  /// 出力の前に呼ぶ．
+  void
+  mark_cone(
+    const MvnMgr& mgr ///< [in] Mvn ネットワーク
+  );
+
+  /// @brief ノードが出力対象の時 true を返す．
+  bool
+  is_selected(
+    const MvnNode* node ///< [in] 対象のノード
+  ) const;
+
+  /// @brief モジュールが出力対象のノードを含む時 true を返す．
+  bool
+  is_selected(
+    const MvnModule* module ///< [in] 対象のモジュール
+  ) const;
+
+  /// @brief ノードの型を表す文字列を返す．
+  static
+  const char*
+  type_str(
+    MvnNodeType type ///< [in] ノードの型
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 幅優先探索でコーンに印をつける．
+  void
+  mark_bfs(
+    const MvnMgr& mgr, ///< [in] Mvn ネットワーク
+    bool fanin,        ///< [in] ファンイン方向の時 true
+    SizeType depth     ///< [in] 深さの上限
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 根のノード番号のリスト
+  // 空の時は全ノードが対象となる．
+  vector<SizeType> mRootList;
+
+  // ファンイン方向の深さ
+  SizeType mFaninDepth{0};
+
+  // ファンアウト方向の深さ
+  SizeType mFanoutDepth{0};
+
+  // ノード番号をキーにして出力対象の印を持つ配列
+  vector<bool> mNodeMark;
+
+  // モジュール番号をキーにして出力対象の印を持つ配列
+  vector<bool> mModuleMark;
+
+};
+
+END_NAMESPACE_YM_MVN
+
+#endif // GRAPHWRITERIMPL_H
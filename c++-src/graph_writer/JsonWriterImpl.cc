@@ -0,0 +1,240 @@
+﻿
+/// @file JsonWriterImpl.cc
+/// @brief JsonWriterImpl の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "JsonWriterImpl.h"
+#include "ym/MvnMgr.h"
+#include "ym/MvnModule.h"
+#include "ym/MvnNode.h"
+#include "ym/MvnInputPin.h"
+#include "ym/MvnBvConst.h"
+#include "ym/MvnVlMap.h"
+#include "ym/ClibCell.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+BEGIN_NONAMESPACE
+
+// 文字列を JSON の文字列リテラルとして出力する．
+void
+put_str(
+  ostream& s,
+  const string& str
+)
+{
+  static const char* hex = "0123456789abcdef";
+  s << '"';
+  for ( unsigned char c: str ) {
+    switch ( c ) {
+    case '"':  s << "\\\""; break;
+    case '\\': s << "\\\\"; break;
+    case '\n': s << "\\n"; break;
+    case '\t': s << "\\t"; break;
+    default:
+      if ( c < 0x20 ) {
+	s << "\\u00" << hex[c >> 4] << hex[c & 15];
+      }
+      else {
+	s << c;
+      }
+      break;
+    }
+  }
+  s << '"';
+}
+
+// 極性を表す文字列を返す．
+const char*
+pol_str(
+  MvnPolarity pol
+)
+{
+  return pol == MvnPolarity::Positive ? "\"posedge\"" : "\"negedge\"";
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス JsonWriterImpl
+//////////////////////////////////////////////////////////////////////
+
+// @brief dump() の本体
+void
+JsonWriterImpl::dump_sub(
+  ostream& s,
+  const MvnMgr& mgr,
+  const MvnVlMap* node_map
+)
+{
+  mark_cone(mgr);
+
+  SizeType nm{mgr.max_module_id()};
+  for ( SizeType i = 0; i < nm; ++ i ) {
+    auto module{mgr.module(i)};
+    if ( module != nullptr && is_selected(module) ) {
+      dump_module(s, module);
+    }
+  }
+
+  SizeType n{mgr.max_node_id()};
+  for ( SizeType i = 0; i < n; ++ i ) {
+    auto node{mgr.node(i)};
+    if ( node != nullptr && is_selected(node) ) {
+      dump_node(s, node, node_map);
+    }
+  }
+  s.flush();
+}
+
+// @brief モジュールのレコードを出力する．
+void
+JsonWriterImpl::dump_module(
+  ostream& s,
+  const MvnModule* module
+)
+{
+  s << "{\"kind\":\"module\",\"id\":" << module->id()
+    << ",\"name\":";
+  put_str(s, module->name());
+  auto pnode{module->parent()};
+  if ( pnode != nullptr ) {
+    s << ",\"parent\":" << pnode->id();
+  }
+  s << ",\"inputs\":[";
+  SizeType ni{module->input_num()};
+  for ( SizeType i = 0; i < ni; ++ i ) {
+    if ( i > 0 ) {
+      s << ',';
+    }
+    s << module->input(i)->id();
+  }
+  s << "],\"outputs\":[";
+  SizeType no{module->output_num()};
+  for ( SizeType i = 0; i < no; ++ i ) {
+    if ( i > 0 ) {
+      s << ',';
+    }
+    s << module->output(i)->id();
+  }
+  s << "],\"inouts\":[";
+  SizeType nio{module->inout_num()};
+  for ( SizeType i = 0; i < nio; ++ i ) {
+    if ( i > 0 ) {
+      s << ',';
+    }
+    s << module->inout(i)->id();
+  }
+  s << "]}\n";
+}
+
+// @brief ノードのレコードとその入力の枝のレコードを出力する．
+void
+JsonWriterImpl::dump_node(
+  ostream& s,
+  const MvnNode* node,
+  const MvnVlMap* node_map
+)
+{
+  s << "{\"kind\":\"node\",\"id\":" << node->id()
+    << ",\"module\":" << node->parent()->id()
+    << ",\"type\":\"" << type_str(node->type()) << '"'
+    << ",\"width\":" << node->bit_width();
+  if ( node_map != nullptr ) {
+    auto name{node_map->get_name(node->id())};
+    if ( name != string{} ) {
+      s << ",\"name\":";
+      put_str(s, name);
+    }
+  }
+  switch ( node->type() ) {
+  case MvnNodeType::DFF:
+    {
+      s << ",\"clock_pol\":" << pol_str(node->clock_pol())
+	<< ",\"control_pol\":[";
+      SizeType nc{node->input_num() - 2};
+      for ( SizeType i = 0; i < nc; ++ i ) {
+	if ( i > 0 ) {
+	  s << ',';
+	}
+	s << pol_str(node->control_pol(i));
+      }
+      s << "],\"control_val\":[";
+      for ( SizeType i = 0; i < nc; ++ i ) {
+	if ( i > 0 ) {
+	  s << ',';
+	}
+	s << node->control_val(i)->id();
+      }
+      s << ']';
+    }
+    break;
+
+  case MvnNodeType::CASEEQ:
+    {
+      // MvnDumper と同じく MSB から順に
+      // ドントケアのビットを '-' で表す．
+      auto xmask{node->xmask()};
+      SizeType bw{node->input(0)->bit_width()};
+      string buf(bw, '1');
+      for ( SizeType i = 0; i < bw; ++ i ) {
+	if ( xmask[bw - i - 1] ) {
+	  buf[i] = '-';
+	}
+      }
+      s << ",\"xmask\":";
+      put_str(s, buf);
+    }
+    break;
+
+  case MvnNodeType::CONSTBITSELECT:
+    s << ",\"bitpos\":" << node->bitpos();
+    break;
+
+  case MvnNodeType::CONSTPARTSELECT:
+    s << ",\"msb\":" << node->msb()
+      << ",\"lsb\":" << node->lsb();
+    break;
+
+  case MvnNodeType::CONSTVALUE:
+    s << ",\"value\":";
+    put_str(s, node->const_value().to_string());
+    break;
+
+  case MvnNodeType::CELL:
+    {
+      s << ",\"cell\":";
+      put_str(s, node->cell().name());
+      auto cnode{node->cell_node()};
+      if ( cnode != node ) {
+	s << ",\"cell_node\":" << cnode->id()
+	  << ",\"cell_opin\":" << node->cell_opin_pos();
+      }
+    }
+    break;
+
+  default:
+    break;
+  }
+  s << "}\n";
+
+  SizeType ni{node->input_num()};
+  for ( SizeType i = 0; i < ni; ++ i ) {
+    auto ipin{node->input(i)};
+    auto inode{ipin->src_node()};
+    if ( inode != nullptr && is_selected(inode) ) {
+      s << "{\"kind\":\"edge\",\"src\":" << inode->id()
+	<< ",\"dst\":" << node->id()
+	<< ",\"pin\":" << i
+	<< ",\"width\":" << ipin->bit_width()
+	<< "}\n";
+    }
+  }
+}
+
+END_NAMESPACE_YM_MVN
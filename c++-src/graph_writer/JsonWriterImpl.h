@@ -0,0 +1,93 @@
+﻿#ifndef JSONWRITERIMPL_H
+#define JSONWRITERIMPL_H
+
+/// @file JsonWriterImpl.h
+/// @brief JsonWriterImpl のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/mvn.h"
+#include "GraphWriterImpl.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+/// @class JsonWriterImpl JsonWriterImpl.h "JsonWriterImpl.h"
+/// @brief MvnJsonWriter の実装クラス
+//////////////////////////////////////////////////////////////////////
+class JsonWriterImpl :
+  public GraphWriterImpl
+{
+public:
+
+  /// @brief コンストラクタ
+  JsonWriterImpl() = default;
+
+  /// @brief デストラクタ
+  ~JsonWriterImpl() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 内容を JSON Lines 形式で出力する．
+  void
+  dump(
+    ostream& s,       ///< [in] 出力先のストリーム
+    const MvnMgr& mgr ///< [in] Mvn ネットワーク
+  )
+  {
+    dump_sub(s, mgr, nullptr);
+  }
+
+  /// @brief 内容を JSON Lines 形式で出力する．
+  void
+  dump(
+    ostream& s,              ///< [in] 出力先のストリーム
+    const MvnMgr& mgr,       ///< [in] Mvn ネットワーク
+    const MvnVlMap& node_map ///< [in] ノードと Verilog 名の対応表
+  )
+  {
+    dump_sub(s, mgr, &node_map);
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief dump() の本体
+  void
+  dump_sub(
+    ostream& s,              ///< [in] 出力先のストリーム
+    const MvnMgr& mgr,       ///< [in] Mvn ネットワーク
+    const MvnVlMap* node_map ///< [in] ノードと Verilog 名の対応表
+                             ///<      (nullptr の場合もある)
+  );
+
+  /// @brief モジュールのレコードを出力する．
+  void
+  dump_module(
+    ostream& s,             ///< [in] 出力先のストリーム
+    const MvnModule* module ///< [in] 対象のモジュール
+  );
+
+  /// @brief ノードのレコードとその入力の枝のレコードを出力する．
+  void
+  dump_node(
+    ostream& s,              ///< [in] 出力先のストリーム
+    const MvnNode* node,     ///< [in] 対象のノード
+    const MvnVlMap* node_map ///< [in] ノードと Verilog 名の対応表
+  );
+
+};
+
+END_NAMESPACE_YM_MVN
+
+#endif // JSONWRITERIMPL_H
@@ -0,0 +1,71 @@
+﻿
+/// @file MvnDotWriter.cc
+/// @brief MvnDotWriter の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/MvnDotWriter.h"
+#include "DotWriterImpl.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+// クラス MvnDotWriter
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+MvnDotWriter::MvnDotWriter(
+) : mImpl{unique_ptr<DotWriterImpl>{new DotWriterImpl()}}
+{
+}
+
+// @brief デストラクタ
+MvnDotWriter::~MvnDotWriter()
+{
+  // DotWriterImpl.h を必要とするため
+  // ヘッダ中で = default 宣言はできない．
+}
+
+// @brief 出力対象を根のノードのコーンに制限する．
+void
+MvnDotWriter::set_cone(
+  const vector<SizeType>& root_list,
+  SizeType fanin_depth,
+  SizeType fanout_depth
+)
+{
+  mImpl->set_cone(root_list, fanin_depth, fanout_depth);
+}
+
+// @brief コーンの制限を解除する．
+void
+MvnDotWriter::clear_cone()
+{
+  mImpl->clear_cone();
+}
+
+// @brief 内容を GraphViz の DOT 形式で出力する
+void
+MvnDotWriter::operator()(
+  ostream& s,
+  const MvnMgr& mgr
+)
+{
+  mImpl->dump(s, mgr);
+}
+
+// @brief 内容を GraphViz の DOT 形式で出力する
+void
+MvnDotWriter::operator()(
+  ostream& s,
+  const MvnMgr& mgr,
+  const MvnVlMap& node_map
+)
+{
+  mImpl->dump(s, mgr, node_map);
+}
+
+END_NAMESPACE_YM_MVN
@@ -0,0 +1,71 @@
+﻿
+/// @file MvnJsonWriter.cc
+/// @brief MvnJsonWriter の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/MvnJsonWriter.h"
+#include "JsonWriterImpl.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+// クラス MvnJsonWriter
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+MvnJsonWriter::MvnJsonWriter(
+) : mImpl{unique_ptr<JsonWriterImpl>{new JsonWriterImpl()}}
+{
+}
+
+// @brief デストラクタ
+MvnJsonWriter::~MvnJsonWriter()
+{
+  // JsonWriterImpl.h を必要とするため
+  // ヘッダ中で = default 宣言はできない．
+}
+
+// @brief 出力対象を根のノードのコーンに制限する．
+void
+MvnJsonWriter::set_cone(
+  const vector<SizeType>& root_list,
+  SizeType fanin_depth,
+  SizeType fanout_depth
+)
+{
+  mImpl->set_cone(root_list, fanin_depth, fanout_depth);
+}
+
+// @brief コーンの制限を解除する．
+void
+MvnJsonWriter::clear_cone()
+{
+  mImpl->clear_cone();
+}
+
+// @brief 内容を JSON Lines 形式で出力する
+void
+MvnJsonWriter::operator()(
+  ostream& s,
+  const MvnMgr& mgr
+)
+{
+  mImpl->dump(s, mgr);
+}
+
+// @brief 内容を JSON Lines 形式で出力する
+void
+MvnJsonWriter::operator()(
+  ostream& s,
+  const MvnMgr& mgr,
+  const MvnVlMap& node_map
+)
+{
+  mImpl->dump(s, mgr, node_map);
+}
+
+END_NAMESPACE_YM_MVN
@@ -7,6 +7,8 @@
 /// All rights reserved.
 
 #include "ym/MvnDumper.h"
+#include "ym/MvnCompOStream.h"
+#include "WriteBuf.h"
 
 #include "ym/MvnMgr.h"
 
@@ -23,55 +25,58 @@ BEGIN_NAMESPACE_YM_MVN
 
 BEGIN_NONAMESPACE
 
-// ノードを表す文字列を返す．
-string
-node_idstr(
+// ノードを表す文字列を出力する．
+void
+put_nodeid(
+  WriteBuf& s,
   const MvnNode* node
 )
 {
-  ostringstream buf;
-  buf << "Node[" << node->id() << "]";
-  return buf.str();
+  s << "Node[" << node->id() << "]";
 }
 
 // MvnInputPin の内容を出力する．
+//
+// ピン名は呼び出し側で出力しておく．
 void
 dump_inputpin(
-  ostream& s,
-  const MvnInputPin* pin,
-  const string& pin_name
+  WriteBuf& s,
+  const MvnInputPin* pin
 )
 {
-  s << "  " << pin_name
-    << "(" << pin->bit_width() << ")" << endl;
+  s << "(" << pin->bit_width() << ")\n";
   auto onode = pin->src_node();
   if ( onode ) {
-    s << "    <== Output@" << node_idstr(onode) << endl;
+    s << "    <== Output@";
+    put_nodeid(s, onode);
+    s << '\n';
   }
 }
 
-// MvnInputPin の内容を出力する．
+// 極性を出力する．
 void
-dump_inputpin(
-  ostream& s,
-  const MvnInputPin* pin
+dump_pol(
+  WriteBuf& s,
+  MvnPolarity pol
 )
 {
-  ostringstream buf;
-  buf << "InputPin#" << pin->pos();
-  string pin_name = buf.str();
-  dump_inputpin(s, pin, pin_name);
+  if ( pol == MvnPolarity::Positive ) {
+    s << "    posedge\n";
+  }
+  else {
+    s << "    negedge\n";
+  }
 }
 
 // MvnNode の内容を出力する．
 void
 dump_node(
-  ostream& s,
-  const MvnNode* node,
-  const MvnMgr& mgr
+  WriteBuf& s,
+  const MvnNode* node
 )
 {
-  s << node_idstr(node) << " : ";
+  put_nodeid(s, node);
+  s << " : ";
   switch ( node->type() ) {
   case MvnNodeType::INPUT:      s << "Input"; break;
   case MvnNodeType::INOUT:      s << "Inout"; break;
@@ -96,10 +101,10 @@ dump_node(
       for ( SizeType i = 0; i < bw; ++ i ) {
 	SizeType bitpos = bw - i - 1;
 	if ( xmask[bitpos] ) {
-	  s << "-";
+	  s << '-';
 	}
 	else {
-	  s << "1";
+	  s << '1';
 	}
       }
       s << "]";
@@ -109,6 +114,7 @@ dump_node(
   case MvnNodeType::SRL:        s << "Srl"; break;
   case MvnNodeType::SLA:        s << "Sla"; break;
   case MvnNodeType::SRA:        s << "Sra"; break;
+  case MvnNodeType::CMPL:       s << "Cmpl"; break;
   case MvnNodeType::ADD:        s << "Add"; break;
   case MvnNodeType::SUB:        s << "Sub"; break;
   case MvnNodeType::MUL:        s << "Mult"; break;
@@ -134,7 +140,7 @@ dump_node(
   case MvnNodeType::CONSTVALUE:
     {
       auto val = node->const_value();
-      s << "Const(" << val << ")";
+      s << "Const(" << val.to_string() << ")";
     }
     break;
   case MvnNodeType::CELL:
@@ -146,39 +152,23 @@ dump_node(
   default:
     ASSERT_NOT_REACHED;
   }
-  s << endl;
+  s << '\n';
 
   if ( node->type() == MvnNodeType::DFF ) {
-    const MvnInputPin* input = node->input(0);
-    dump_inputpin(s, input, "DataInput");
-    const MvnInputPin* clock = node->input(1);
-    dump_inputpin(s, clock, "Clock");
-    s << "    ";
-    if ( node->clock_pol() == MvnPolarity::Positive ) {
-      s << "posedge";
-    }
-    else {
-      s << "negedge";
-    }
-    s << endl;
+    s << "  DataInput";
+    dump_inputpin(s, node->input(0));
+    s << "  Clock";
+    dump_inputpin(s, node->input(1));
+    dump_pol(s, node->clock_pol());
     SizeType ni{node->input_num()};
     SizeType nc{ni - 2};
     for ( SizeType i = 0; i < nc; ++ i ) {
-      auto cpin{node->input(i + 2)};
-      ostringstream buf;
-      buf << "Control#" << i;
-      string pin_name = buf.str();
-      dump_inputpin(s, cpin, pin_name);
-      s << "    ";
-      if ( node->control_pol(i) == MvnPolarity::Positive ) {
-	s << "posedge";
-      }
-      else {
-	s << "negedge";
-      }
-      s << endl;
-      const MvnNode* dnode = node->control_val(i);
-      s << "  Data#" << i << " <== " << node_idstr(dnode) << endl;
+      s << "  Control#" << i;
+      dump_inputpin(s, node->input(i + 2));
+      dump_pol(s, node->control_pol(i));
+      s << "  Data#" << i << " <== ";
+      put_nodeid(s, node->control_val(i));
+      s << '\n';
     }
   }
   else if ( node->type() == MvnNodeType::LATCH ) {
@@ -188,15 +178,17 @@ dump_node(
     SizeType ni{node->input_num()};
     for ( SizeType i = 0; i < ni; ++ i ) {
       auto pin{node->input(i)};
+      s << "  InputPin#" << pin->pos();
       dump_inputpin(s, pin);
     }
-    s << "  Output(" << node->bit_width() << ")" << endl;
+    s << "  Output(" << node->bit_width() << ")\n";
     for ( auto ipin: node->dst_pin_list() ) {
-      s << "    ==> InputPin#" << ipin->pos()
-	<< "@" << node_idstr(ipin->node()) << endl;
+      s << "    ==> InputPin#" << ipin->pos() << "@";
+      put_nodeid(s, ipin->node());
+      s << '\n';
     }
   }
-  s << endl;
+  s << '\n';
 }
 
 END_NONAMESPACE
@@ -216,6 +208,23 @@ MvnDumper::~MvnDumper()
 {
 }
 
+// @brief 出力するノードの型を設定する．
+void
+MvnDumper::set_type_filter(
+  const vector<MvnNodeType>& type_list
+)
+{
+  mTypeFilter.clear();
+  if ( type_list.empty() ) {
+    return;
+  }
+  SizeType n{static_cast<SizeType>(MvnNodeType::CELL) + 1};
+  mTypeFilter.resize(n, false);
+  for ( auto type: type_list ) {
+    mTypeFilter[static_cast<SizeType>(type)] = true;
+  }
+}
+
 // @brief 内容を出力する
 // @param[in] s 出力先のストリーム
 // @param[in] mgr MvnMgr
@@ -225,57 +234,134 @@ MvnDumper::operator()(
   const MvnMgr& mgr
 )
 {
+  WriteBuf buf{s, mBuffer};
+
+  // 上限を超えていたら打ち切りを表す行を出力して true を返す．
+  auto over_limit = [&]() -> bool {
+    if ( mLimit > 0 && buf.count() >= mLimit ) {
+      buf << "*** output truncated at " << buf.count() << " bytes ***\n";
+      return true;
+    }
+    return false;
+  };
+
   SizeType n = mgr.max_module_id();
   for ( SizeType i = 0; i < n; ++ i ) {
     auto module = mgr.module(i);
-    if ( module == nullptr ) continue;
+    if ( module == nullptr || !is_selected(module) ) continue;
 
-    s << "Module#" << module->id() << "(" << module->name() << ")" << endl;
+    buf << "Module#" << module->id() << "(" << module->name() << ")\n";
     auto pnode = module->parent();
     if ( pnode ) {
-      s << "  parent node: Module#" << pnode->parent()->id()
-	<< ":" << node_idstr(pnode) << endl;
+      buf << "  parent node: Module#" << pnode->parent()->id() << ":";
+      put_nodeid(buf, pnode);
+      buf << '\n';
     }
     else {
-      s << "  toplevel module" << endl;
+      buf << "  toplevel module\n";
     }
 
     SizeType np{module->port_num()};
     for ( SizeType j = 0; j < np; ++ j ) {
       auto port{module->port(j)};
-      s << "  Port#" << j << "(" << port->name() << ")" << endl;
+      buf << "  Port#" << j << "(" << port->name() << ")\n";
       SizeType n{port->port_ref_num()};
       for ( SizeType k = 0; k < n; ++ k ) {
 	const auto& port_ref{port->port_ref(k)};
-	s << "    " << node_idstr(port_ref.node());
+	buf << "    ";
+	put_nodeid(buf, port_ref.node());
 	if ( port_ref.has_bitselect() ) {
-	  s << "[" << port_ref.bitpos() << "]";
+	  buf << "[" << port_ref.bitpos() << "]";
 	}
 	else if ( port_ref.has_partselect() ) {
-	  s << "[" << port_ref.msb() << ":" << port_ref.lsb() << "]";
+	  buf << "[" << port_ref.msb() << ":" << port_ref.lsb() << "]";
 	}
-	s << endl;
+	buf << '\n';
       }
     }
+    if ( over_limit() ) {
+      return;
+    }
 
+    auto dump_sub = [&](const MvnNode* node) -> bool {
+      if ( is_selected(node) ) {
+	dump_node(buf, node);
+	return over_limit();
+      }
+      return false;
+    };
     SizeType ni{module->input_num()};
     for ( SizeType j = 0; j < ni; ++ j ) {
-      dump_node(s, module->input(j), mgr);
+      if ( dump_sub(module->input(j)) ) {
+	return;
+      }
     }
     SizeType no{module->output_num()};
     for ( SizeType j = 0;j < no; ++ j ) {
-      dump_node(s, module->output(j), mgr);
+      if ( dump_sub(module->output(j)) ) {
+	return;
+      }
     }
     SizeType nio{module->inout_num()};
     for ( SizeType j = 0; j < nio; ++ j ) {
-      dump_node(s, module->inout(j), mgr);
+      if ( dump_sub(module->inout(j)) ) {
+	return;
+      }
     }
     for ( auto node: module->node_list() ) {
-      dump_node(s, node, mgr);
+      if ( dump_sub(node) ) {
+	return;
+      }
     }
 
-    s << endl;
+    buf << '\n';
+  }
+}
+
+// @brief 内容をファイルに出力する
+bool
+MvnDumper::operator()(
+  const string& filename,
+  const MvnMgr& mgr,
+  MvnCompType comp_type
+)
+{
+  MvnCompOStream s{filename, comp_type};
+  if ( !s.is_open() ) {
+    cerr << filename << ": could not open" << endl;
+    return false;
+  }
+  operator()(s, mgr);
+  return s.close();
+}
+
+// @brief モジュールが出力対象の時 true を返す．
+bool
+MvnDumper::is_selected(
+  const MvnModule* module
+) const
+{
+  if ( mModuleFilter.empty() ) {
+    return true;
+  }
+  for ( auto& name: mModuleFilter ) {
+    if ( module->name() == name ) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// @brief ノードが出力対象の時 true を返す．
+bool
+MvnDumper::is_selected(
+  const MvnNode* node
+) const
+{
+  if ( mTypeFilter.empty() ) {
+    return true;
   }
+  return mTypeFilter[static_cast<SizeType>(node->type())];
 }
 
 END_NAMESPACE_YM_MVN
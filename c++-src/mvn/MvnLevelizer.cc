@@ -0,0 +1,168 @@
+﻿
+/// @file MvnLevelizer.cc
+/// @brief MvnLevelizer の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "MvnLevelizer.h"
+#include "ym/MvnMgr.h"
+#include "ym/MvnModule.h"
+#include "ym/MvnNode.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+// クラス MvnLevelizer
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+MvnLevelizer::MvnLevelizer(
+  const MvnMgr& mgr,
+  const MvnModule* module
+) : mLevelArray(mgr.max_node_id(), 0)
+{
+  SizeType n{mgr.max_node_id()};
+
+  // module->node_list() は削除されたノードを含んでいる可能性があるので
+  // MvnMgr のノード配列から拾い直す．
+  vector<const MvnNode*> all_list;
+  all_list.reserve(n);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    auto node{mgr.node(i)};
+    if ( node != nullptr && node->parent() == module ) {
+      all_list.push_back(node);
+    }
+  }
+
+  // ファンアウト数を数えて CSR 形式のファンアウト表を作る．
+  vector<SizeType> fo_begin(n + 1, 0);
+  vector<SizeType> ref_count(n, 0);
+  for ( auto node: all_list ) {
+    if ( is_source(node) ) {
+      continue;
+    }
+    SizeType ni{fanin_num(node)};
+    for ( SizeType i = 0; i < ni; ++ i ) {
+      auto inode{fanin(node, i)};
+      if ( inode != nullptr ) {
+	++ fo_begin[inode->id() + 1];
+	++ ref_count[node->id()];
+      }
+    }
+  }
+  for ( SizeType i = 0; i < n; ++ i ) {
+    fo_begin[i + 1] += fo_begin[i];
+  }
+  vector<const MvnNode*> fo_array(fo_begin[n]);
+  {
+    vector<SizeType> pos_array(fo_begin.begin(), fo_begin.end() - 1);
+    for ( auto node: all_list ) {
+      if ( is_source(node) ) {
+	continue;
+      }
+      SizeType ni{fanin_num(node)};
+      for ( SizeType i = 0; i < ni; ++ i ) {
+	auto inode{fanin(node, i)};
+	if ( inode != nullptr ) {
+	  fo_array[pos_array[inode->id()] ++] = node;
+	}
+      }
+    }
+  }
+
+  // ソースノードとファンインを持たないノードから始めて
+  // トポロジカル順に並べる．
+  mNodeList.reserve(all_list.size());
+  for ( auto node: all_list ) {
+    if ( is_source(node) || ref_count[node->id()] == 0 ) {
+      mNodeList.push_back(node);
+    }
+    if ( node->type() == MvnNodeType::DFF ) {
+      mDffList.push_back(node);
+    }
+  }
+  for ( SizeType rpos = 0; rpos < mNodeList.size(); ++ rpos ) {
+    auto node{mNodeList[rpos]};
+    SizeType id{static_cast<SizeType>(node->id())};
+    SizeType olevel{mLevelArray[id] + 1};
+    for ( SizeType j = fo_begin[id]; j < fo_begin[id + 1]; ++ j ) {
+      auto onode{fo_array[j]};
+      SizeType oid{static_cast<SizeType>(onode->id())};
+      if ( mLevelArray[oid] < olevel ) {
+	mLevelArray[oid] = olevel;
+      }
+      -- ref_count[oid];
+      if ( ref_count[oid] == 0 ) {
+	mNodeList.push_back(onode);
+      }
+    }
+    if ( mMaxLevel < mLevelArray[id] ) {
+      mMaxLevel = mLevelArray[id];
+    }
+  }
+
+  if ( mNodeList.size() < all_list.size() ) {
+    // 組み合わせ回路のループがある．
+    // 報告するかどうかは呼び出し側が決める．
+    mHasLoop = true;
+    for ( auto node: all_list ) {
+      if ( ref_count[node->id()] > 0 ) {
+	mLevelArray[node->id()] = mMaxLevel + 1;
+	mNodeList.push_back(node);
+	mLoopList.push_back(node);
+      }
+    }
+    mMaxLevel = mMaxLevel + 1;
+  }
+}
+
+// @brief ソースノードの時 true を返す．
+bool
+MvnLevelizer::is_source(
+  const MvnNode* node
+)
+{
+  switch ( node->type() ) {
+  case MvnNodeType::INPUT:
+  case MvnNodeType::CONSTVALUE:
+  case MvnNodeType::DFF:
+    return true;
+
+  case MvnNodeType::INOUT:
+    return node->input(0)->src_node() == nullptr;
+
+  default:
+    break;
+  }
+  return false;
+}
+
+// @brief 評価の際に参照するファンインのノードを返す．
+const MvnNode*
+MvnLevelizer::fanin(
+  const MvnNode* node,
+  SizeType pos
+)
+{
+  if ( node->type() == MvnNodeType::CELL ) {
+    node = node->cell_node();
+  }
+  return node->input(pos)->src_node();
+}
+
+// @brief 評価の際に参照するファンイン数を返す．
+SizeType
+MvnLevelizer::fanin_num(
+  const MvnNode* node
+)
+{
+  if ( node->type() == MvnNodeType::CELL ) {
+    node = node->cell_node();
+  }
+  return node->input_num();
+}
+
+END_NAMESPACE_YM_MVN
@@ -10,6 +10,7 @@
 
 #include "ym/MvnModule.h"
 #include "ym/MvnPort.h"
+#include <algorithm>
 
 
 BEGIN_NAMESPACE_YM_MVN
@@ -301,7 +302,13 @@ MvnMgr::delete_node(
     return;
   }
   unreg_node(node);
-  delete node;
+  if ( mDeferUnlink ) {
+    // sweep() の最後にまとめてモジュールのノードリストから取り除く．
+    mGarbageList.push_back(node);
+  }
+  else {
+    delete node;
+  }
 }
 
 bool
@@ -319,6 +326,10 @@ no_fanouts(
 void
 MvnMgr::sweep()
 {
+  // 削除するノードをモジュールのノードリストから一つずつ取り除くと
+  // ノード数の2乗の時間がかかるので最後にまとめて取り除く．
+  mDeferUnlink = true;
+
   SizeType n{max_node_id()};
   // ビット/部分選択と接続している連結演算の削除を行う．
   vector<MvnNode*> node_list;
@@ -356,6 +367,7 @@ MvnMgr::sweep()
   vector<bool> marks(n, false);
   for ( int i = 0; i < n; ++ i ) {
     auto node = _node(i);
+    if ( node == nullptr ) continue;
     if ( node->type() == MvnNodeType::DFF ) {
       SizeType nc{node->input_num() - 2};
       for ( SizeType j = 0; j < nc; ++ j ) {
@@ -384,6 +396,9 @@ MvnMgr::sweep()
       auto src_node = node->input(i)->src_node();
       if ( src_node ) {
 	disconnect(src_node, 0, node, i);
+	if ( src_node->type() == MvnNodeType::INPUT ||
+	     src_node->type() == MvnNodeType::INOUT ) continue;
+	if ( marks[src_node->id()] ) continue;
 	if ( no_fanouts(src_node) ) {
 	  node_queue.push_back(src_node);
 	}
@@ -391,6 +406,37 @@ MvnMgr::sweep()
     }
     delete_node(node);
   }
+
+  mDeferUnlink = false;
+  flush_garbage();
+}
+
+// @brief 削除を遅らせたノードをノードリストから取り除いて解放する．
+void
+MvnMgr::flush_garbage()
+{
+  if ( mGarbageList.empty() ) {
+    return;
+  }
+  // 削除したノードは mNodeArray から取り除かれている．
+  // sweep() の間は新たなノードは作られないので ID 番号は再利用されていない．
+  auto is_dead = [&](MvnNode* node) {
+    return mNodeArray[node->id()] != node;
+  };
+  SizeType nm{mModuleArray.size()};
+  for ( SizeType i = 0; i < nm; ++ i ) {
+    auto module{mModuleArray[i]};
+    if ( module == nullptr ) {
+      continue;
+    }
+    auto& node_list{module->mNodeList};
+    node_list.erase(std::remove_if(node_list.begin(), node_list.end(), is_dead),
+		    node_list.end());
+  }
+  for ( auto node: mGarbageList ) {
+    delete node;
+  }
+  mGarbageList.clear();
 }
 
 // @brief 連結演算からビットを抜き出す．
@@ -534,7 +580,10 @@ MvnMgr::disconnect(
   auto dst_pin = dst_node->_input(dst_pin_pos);
   ASSERT_COND( dst_pin->mSrcNode == src_node );
   dst_pin->mSrcNode = nullptr;
-  #warning "src_node の mDstPinList から dst_pin を取り除く"
+  auto& fo_list{src_node->mDstPinList};
+  auto p = std::find(fo_list.begin(), fo_list.end(), dst_pin);
+  ASSERT_COND( p != fo_list.end() );
+  fo_list.erase(p);
 }
 
 // @brief 接続を切り替える．
@@ -559,8 +608,8 @@ MvnMgr::reconnect(
   for ( auto ipin: fo_list ) {
     tmp_list.push_back(ipin);
   }
+  old_node->mDstPinList.clear();
   for ( auto ipin: tmp_list ) {
-#warning "old_node->mDstPinList から ipin を取り除く"
     ipin->mSrcNode = new_node;
     new_node->mDstPinList.push_back(ipin);
   }
@@ -607,8 +656,15 @@ MvnMgr::unreg_node(
   if ( node->type() != MvnNodeType::INPUT &&
        node->type() != MvnNodeType::OUTPUT &&
        node->type() != MvnNodeType::INOUT ) {
+    if ( mDeferUnlink ) {
+      return;
+    }
     MvnModule* module = node->mParent;
-    #warning "module->mNodeList から node を取り除く"
+    auto& node_list{module->mNodeList};
+    auto p = std::find(node_list.begin(), node_list.end(), node);
+    if ( p != node_list.end() ) {
+      node_list.erase(p);
+    }
   }
 }
 
@@ -64,7 +64,7 @@ MvnNodeBase::input(
   SizeType pos
 ) const
 {
-  ASSERT_COND( 0 < pos && pos < mInputNum );
+  ASSERT_COND( 0 <= pos && pos < mInputNum );
   return mInputArray + pos;
 }
 
@@ -0,0 +1,35 @@
+﻿
+/// @file WriteBuf.cc
+/// @brief WriteBuf の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "WriteBuf.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+// クラス WriteBuf
+//////////////////////////////////////////////////////////////////////
+
+// @brief 符号なし整数を10進数で書き込む．
+void
+WriteBuf::put_num(
+  std::uint64_t val
+)
+{
+  // 下の桁から作業領域の末尾に向かって詰める．
+  char tmp[20];
+  SizeType pos{sizeof(tmp)};
+  do {
+    -- pos;
+    tmp[pos] = static_cast<char>('0' + val % 10);
+    val /= 10;
+  } while ( val > 0 );
+  put(tmp + pos, sizeof(tmp) - pos);
+}
+
+END_NAMESPACE_YM_MVN
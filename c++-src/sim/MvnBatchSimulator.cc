@@ -0,0 +1,209 @@
+﻿
+/// @file MvnBatchSimulator.cc
+/// @brief MvnBatchSimulator の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/MvnBatchSimulator.h"
+#include "SimNetwork.h"
+#include <deque>
+#include <mutex>
+#include <thread>
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+BEGIN_NONAMESPACE
+
+// スレッドごとの仕事のキュー
+//
+// 持ち主は先頭から取り出し，他のスレッドは末尾から盗む．
+class WorkQueue
+{
+public:
+
+  // 仕事を追加する．
+  void
+  push(
+    SizeType id
+  )
+  {
+    std::lock_guard<std::mutex> lock{mMutex};
+    mQueue.push_back(id);
+  }
+
+  // 先頭から仕事を取り出す．
+  bool
+  pop_front(
+    SizeType& id
+  )
+  {
+    std::lock_guard<std::mutex> lock{mMutex};
+    if ( mQueue.empty() ) {
+      return false;
+    }
+    id = mQueue.front();
+    mQueue.pop_front();
+    return true;
+  }
+
+  // 末尾から仕事を取り出す．
+  bool
+  pop_back(
+    SizeType& id
+  )
+  {
+    std::lock_guard<std::mutex> lock{mMutex};
+    if ( mQueue.empty() ) {
+      return false;
+    }
+    id = mQueue.back();
+    mQueue.pop_back();
+    return true;
+  }
+
+
+private:
+
+  // 排他制御用のミューテックス
+  std::mutex mMutex;
+
+  // 仕事(入力系列番号)のキュー
+  std::deque<SizeType> mQueue;
+
+};
+
+// 一つの入力系列をシミュレーションする．
+//
+// 出力系列の領域は out_row を雛形にして最初にまとめて確保し，
+// 各サイクルの出力値はその中に直接書き込む．
+MvnResponse
+simulate(
+  const SimNetwork& network,
+  const MvnStimulus& stim,
+  const vector<MvnBvConst>& out_row,
+  vector<std::uint64_t>& val_array,
+  vector<std::uint64_t>& next_array,
+  vector<std::uint64_t>& work_array,
+  vector<std::uint64_t>& cell_array
+)
+{
+  auto vals{val_array.data()};
+  network.init_values(vals);
+  auto& input_list{network.input_list()};
+  auto& output_list{network.output_list()};
+  SizeType ni{input_list.size()};
+  SizeType no{output_list.size()};
+  MvnResponse resp(stim.size(), out_row);
+  for ( SizeType c = 0; c < stim.size(); ++ c ) {
+    auto& ivals{stim[c]};
+    SizeType n{std::min(ni, ivals.size())};
+    for ( SizeType i = 0; i < n; ++ i ) {
+      network.set_value(vals, input_list[i], ivals[i]);
+    }
+    network.eval(vals, work_array.data(), cell_array);
+    auto& ovals{resp[c]};
+    for ( SizeType i = 0; i < no; ++ i ) {
+      network.get_value(vals, output_list[i], ovals[i]);
+    }
+    network.calc_next_state(vals, next_array.data());
+    network.update_state(vals, next_array.data());
+  }
+  return resp;
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス MvnBatchSimulator
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+MvnBatchSimulator::MvnBatchSimulator(
+  const MvnMgr& mgr,
+  const MvnModule* module,
+  SizeType thread_num
+) : mNetwork{new SimNetwork{mgr, module}},
+    mThreadNum{thread_num}
+{
+  if ( mThreadNum == 0 ) {
+    mThreadNum = std::thread::hardware_concurrency();
+    if ( mThreadNum == 0 ) {
+      mThreadNum = 1;
+    }
+  }
+}
+
+// @brief デストラクタ
+MvnBatchSimulator::~MvnBatchSimulator()
+{
+}
+
+// @brief 入力系列のリストをシミュレーションする．
+vector<MvnResponse>
+MvnBatchSimulator::run(
+  const vector<MvnStimulus>& stim_list
+)
+{
+  SizeType n{stim_list.size()};
+  vector<MvnResponse> resp_list(n);
+  if ( n == 0 ) {
+    return resp_list;
+  }
+
+  SizeType nt{std::min(mThreadNum, n)};
+
+  // 連続した塊ごとに各スレッドのキューに割り振る．
+  vector<WorkQueue> queue_array(nt);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    queue_array[i * nt / n].push(i);
+  }
+
+  const SimNetwork& network{*mNetwork};
+  auto worker = [&](SizeType tid) {
+    vector<std::uint64_t> val_array(network.value_size());
+    vector<std::uint64_t> next_array(network.next_size());
+    vector<std::uint64_t> work_array(network.work_size());
+    vector<std::uint64_t> cell_array(network.cell_input_size());
+    vector<MvnBvConst> out_row;
+    out_row.reserve(network.output_list().size());
+    for ( auto id: network.output_list() ) {
+      out_row.push_back(MvnBvConst{network.bit_width(id)});
+    }
+    for ( ; ; ) {
+      SizeType id;
+      bool found = queue_array[tid].pop_front(id);
+      for ( SizeType d = 1; !found && d < nt; ++ d ) {
+	found = queue_array[(tid + d) % nt].pop_back(id);
+      }
+      if ( !found ) {
+	// 実行中に仕事が増えることはないので全てのキューが空なら終わり
+	break;
+      }
+      resp_list[id] = simulate(network, stim_list[id], out_row,
+			       val_array, next_array, work_array, cell_array);
+    }
+  };
+
+  if ( nt == 1 ) {
+    worker(0);
+  }
+  else {
+    vector<std::thread> thread_list;
+    thread_list.reserve(nt - 1);
+    for ( SizeType tid = 1; tid < nt; ++ tid ) {
+      thread_list.push_back(std::thread{worker, tid});
+    }
+    worker(0);
+    for ( auto& th: thread_list ) {
+      th.join();
+    }
+  }
+
+  return resp_list;
+}
+
+END_NAMESPACE_YM_MVN
@@ -0,0 +1,797 @@
+﻿
+/// @file MvnPatternSimulator.cc
+/// @brief MvnPatternSimulator の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/MvnPatternSimulator.h"
+#include "ym/MvnModule.h"
+#include "ym/MvnNode.h"
+#include "SimNetwork.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+BEGIN_NONAMESPACE
+
+// dst = src
+inline
+void
+copy_slice(
+  std::uint64_t* dst,
+  const std::uint64_t* src,
+  SizeType pw
+)
+{
+  for ( SizeType k = 0; k < pw; ++ k ) {
+    dst[k] = src[k];
+  }
+}
+
+// dst の全ワードを val にする．
+inline
+void
+fill_slice(
+  std::uint64_t* dst,
+  std::uint64_t val,
+  SizeType pw
+)
+{
+  for ( SizeType k = 0; k < pw; ++ k ) {
+    dst[k] = val;
+  }
+}
+
+// dst = sel ? t : e
+inline
+void
+mux_slice(
+  std::uint64_t* dst,
+  const std::uint64_t* sel,
+  const std::uint64_t* t,
+  const std::uint64_t* e,
+  SizeType pw
+)
+{
+  for ( SizeType k = 0; k < pw; ++ k ) {
+    dst[k] = (sel[k] & t[k]) | (~sel[k] & e[k]);
+  }
+}
+
+// リプルキャリー加算を行う．
+// dst[0:n) = a[0:n) + (inv_b ? ~b : b)[0:n) + c
+// c はキャリーの初期値で，終了時には最上位からのキャリーが入る．
+// dst は a, b と同じ領域でもよい．
+void
+add_slices(
+  std::uint64_t* dst,
+  const std::uint64_t* a,
+  const std::uint64_t* b,
+  SizeType n,
+  std::uint64_t* c,
+  bool inv_b,
+  SizeType pw
+)
+{
+  std::uint64_t bmask = inv_b ? ~0ULL : 0ULL;
+  for ( SizeType i = 0; i < n; ++ i ) {
+    auto a1{a + i * pw};
+    auto b1{b + i * pw};
+    auto d1{dst + i * pw};
+    for ( SizeType k = 0; k < pw; ++ k ) {
+      std::uint64_t x = a1[k];
+      std::uint64_t y = b1[k] ^ bmask;
+      std::uint64_t p = x ^ y;
+      d1[k] = p ^ c[k];
+      c[k] = (x & y) | (c[k] & p);
+    }
+  }
+}
+
+// シフト加算による乗算を行う．
+// dst[0:n) = a[0:n) * b[0:n)
+// dst は a, b と異なる領域でなければならない．
+void
+mul_slices(
+  std::uint64_t* dst,
+  const std::uint64_t* a,
+  const std::uint64_t* b,
+  SizeType n,
+  std::uint64_t* c,
+  SizeType pw
+)
+{
+  fill_slice(dst, 0ULL, n * pw);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    auto bi{b + i * pw};
+    fill_slice(c, 0ULL, pw);
+    for ( SizeType j = i; j < n; ++ j ) {
+      auto aj{a + (j - i) * pw};
+      auto dj{dst + j * pw};
+      for ( SizeType k = 0; k < pw; ++ k ) {
+	std::uint64_t x = dj[k];
+	std::uint64_t y = bi[k] & aj[k];
+	std::uint64_t p = x ^ y;
+	dj[k] = p ^ c[k];
+	c[k] = (x & y) | (c[k] & p);
+      }
+    }
+  }
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス MvnPatternSimulator
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+MvnPatternSimulator::MvnPatternSimulator(
+  const MvnMgr& mgr,
+  const MvnModule* module,
+  SizeType pat_words
+) : mNetwork{new SimNetwork{mgr, module}},
+    mPatWords{pat_words}
+{
+  ASSERT_COND( mPatWords > 0 );
+
+  // 値の配置をビット単位で決める．
+  // 末尾の要素(未接続を表すダミー)は常に 0 の領域を指す．
+  SizeType n{mNetwork->max_node_id()};
+  mWidthArray.resize(n + 1, 0);
+  mOffsetArray.resize(n + 1, 0);
+  SizeType nbits = 0;
+  SizeType max_bits = 0;
+  for ( SizeType id = 0; id < n; ++ id ) {
+    SizeType bw{mNetwork->bit_width(id)};
+    mWidthArray[id] = bw;
+    mOffsetArray[id] = nbits;
+    nbits += bw;
+    max_bits = std::max(max_bits, bw);
+  }
+  mOffsetArray[n] = nbits;
+  ++ nbits;
+  mValArray.resize(nbits * mPatWords, 0ULL);
+
+  // 定数の値を設定する．
+  for ( auto id: mNetwork->const_list() ) {
+    auto src{mNetwork->const_value(id)};
+    auto dst{_value_ptr(id)};
+    for ( SizeType b = 0; b < mWidthArray[id]; ++ b ) {
+      bool v = static_cast<bool>((src[b / 64] >> (b % 64)) & 1ULL);
+      fill_slice(dst + b * mPatWords, v ? ~0ULL : 0ULL, mPatWords);
+    }
+  }
+
+  mInputList = mNetwork->input_list();
+  SizeType nnext = 0;
+  for ( auto& dff: mNetwork->dff_list() ) {
+    mDffIdList.push_back(dff.mId);
+    mNextOffsetArray.push_back(nnext);
+    nnext += mWidthArray[dff.mId];
+  }
+  mNextArray.resize(nnext * mPatWords);
+
+  // 除算で1ビット余分に使うので + 1 しておく．
+  mWorkSize = (max_bits + 1) * mPatWords;
+  mWorkArray.resize(mWorkSize * 5);
+  mCarryArray.resize(mPatWords);
+  mCellInputArray.resize(mNetwork->cell_input_size());
+}
+
+// @brief デストラクタ
+MvnPatternSimulator::~MvnPatternSimulator()
+{
+}
+
+// @brief 入力の値を設定する．
+void
+MvnPatternSimulator::set_input(
+  SizeType pos,
+  const vector<std::uint64_t>& val
+)
+{
+  ASSERT_COND( 0 <= pos && pos < mInputList.size() );
+  _set_value(mInputList[pos], val);
+}
+
+// @brief ノードの値を設定する．
+void
+MvnPatternSimulator::set_value(
+  const MvnNode* node,
+  const vector<std::uint64_t>& val
+)
+{
+  ASSERT_COND( node != nullptr );
+  ASSERT_COND( node->parent() == mNetwork->module() );
+  switch ( node->type() ) {
+  case MvnNodeType::INPUT:
+  case MvnNodeType::DFF:
+    break;
+
+  case MvnNodeType::INOUT:
+    ASSERT_COND( node->input(0)->src_node() == nullptr );
+    break;
+
+  default:
+    ASSERT_NOT_REACHED;
+    break;
+  }
+  _set_value(node->id(), val);
+}
+
+// @brief 全ての DFF の状態を 0 にする．
+void
+MvnPatternSimulator::reset_state()
+{
+  for ( auto id: mDffIdList ) {
+    fill_slice(_value_ptr(id), 0ULL, mWidthArray[id] * mPatWords);
+  }
+  mDirty = true;
+}
+
+// @brief 現在の入力と状態で組み合わせ回路部分を評価する．
+void
+MvnPatternSimulator::eval()
+{
+  for ( auto& op: mNetwork->op_list() ) {
+    _eval_op(op);
+  }
+  SizeType limit{mDffIdList.size()};
+  for ( SizeType c = 0; c <= limit; ++ c ) {
+    if ( !_apply_async() ) {
+      break;
+    }
+    for ( auto& op: mNetwork->op_list() ) {
+      _eval_op(op);
+    }
+  }
+  mDirty = false;
+}
+
+// @brief クロックを進める．
+void
+MvnPatternSimulator::step(
+  SizeType n
+)
+{
+  SizeType pw = mPatWords;
+  auto& dff_list{mNetwork->dff_list()};
+  SizeType nd{dff_list.size()};
+  auto done{mCarryArray.data()};
+  auto act{mWorkArray.data()};
+  for ( SizeType c = 0; c < n; ++ c ) {
+    _update();
+    for ( SizeType i = 0; i < nd; ++ i ) {
+      auto& dff{dff_list[i]};
+      SizeType bw{mWidthArray[dff.mId]};
+      auto next{&mNextArray[mNextOffsetArray[i] * pw]};
+      auto data{_value_ptr(dff.mDataId)};
+      SizeType dw{mWidthArray[dff.mDataId]};
+      for ( SizeType b = 0; b < bw; ++ b ) {
+	if ( b < dw ) {
+	  copy_slice(next + b * pw, data + b * pw, pw);
+	}
+	else {
+	  fill_slice(next + b * pw, 0ULL, pw);
+	}
+      }
+      // 非同期制御信号は先頭のものほど優先される．
+      fill_slice(done, 0ULL, pw);
+      for ( SizeType j = 0; j < dff.mControlNum; ++ j ) {
+	auto& ctrl{mNetwork->control(dff, j)};
+	auto cv{_value_ptr(ctrl.mId)};
+	std::uint64_t pmask = ctrl.mPositive ? 0ULL : ~0ULL;
+	for ( SizeType k = 0; k < pw; ++ k ) {
+	  act[k] = (cv[k] ^ pmask) & ~done[k];
+	  done[k] |= act[k];
+	}
+	auto vv{_value_ptr(ctrl.mValId)};
+	SizeType vw{mWidthArray[ctrl.mValId]};
+	for ( SizeType b = 0; b < bw; ++ b ) {
+	  auto dst{next + b * pw};
+	  for ( SizeType k = 0; k < pw; ++ k ) {
+	    std::uint64_t v = b < vw ? vv[b * pw + k] : 0ULL;
+	    dst[k] = (act[k] & v) | (~act[k] & dst[k]);
+	  }
+	}
+      }
+    }
+    for ( SizeType i = 0; i < nd; ++ i ) {
+      SizeType id{dff_list[i].mId};
+      auto next{&mNextArray[mNextOffsetArray[i] * pw]};
+      copy_slice(_value_ptr(id), next, mWidthArray[id] * pw);
+    }
+    mDirty = true;
+  }
+}
+
+// @brief 出力の値を返す．
+vector<std::uint64_t>
+MvnPatternSimulator::output(
+  SizeType pos
+)
+{
+  ASSERT_COND( 0 <= pos && pos < mNetwork->output_list().size() );
+  return _value(mNetwork->output_list()[pos]);
+}
+
+// @brief ノードの値を返す．
+vector<std::uint64_t>
+MvnPatternSimulator::value(
+  const MvnNode* node
+)
+{
+  ASSERT_COND( node != nullptr );
+  ASSERT_COND( node->parent() == mNetwork->module() );
+  return _value(node->id());
+}
+
+// @brief ノードの1ビット分の値を返す．
+const std::uint64_t*
+MvnPatternSimulator::bit_value(
+  const MvnNode* node,
+  SizeType bit
+)
+{
+  ASSERT_COND( node != nullptr );
+  ASSERT_COND( node->parent() == mNetwork->module() );
+  ASSERT_COND( 0 <= bit && bit < mWidthArray[node->id()] );
+  _update();
+  return _value_ptr(node->id()) + bit * mPatWords;
+}
+
+// @brief ノード番号を指定して値を設定する．
+void
+MvnPatternSimulator::_set_value(
+  SizeType id,
+  const vector<std::uint64_t>& val
+)
+{
+  SizeType n{mWidthArray[id] * mPatWords};
+  auto dst{_value_ptr(id)};
+  for ( SizeType i = 0; i < n; ++ i ) {
+    dst[i] = i < val.size() ? val[i] : 0ULL;
+  }
+  mDirty = true;
+}
+
+// @brief ノード番号を指定して値を取り出す．
+vector<std::uint64_t>
+MvnPatternSimulator::_value(
+  SizeType id
+)
+{
+  _update();
+  auto src{_value_ptr(id)};
+  return vector<std::uint64_t>(src, src + mWidthArray[id] * mPatWords);
+}
+
+// @brief 非同期制御信号を反映させる．
+bool
+MvnPatternSimulator::_apply_async()
+{
+  SizeType pw = mPatWords;
+  auto done{mCarryArray.data()};
+  auto act{mWorkArray.data()};
+  bool changed = false;
+  for ( auto& dff: mNetwork->dff_list() ) {
+    if ( dff.mControlNum == 0 ) {
+      continue;
+    }
+    SizeType bw{mWidthArray[dff.mId]};
+    auto dst{_value_ptr(dff.mId)};
+    fill_slice(done, 0ULL, pw);
+    for ( SizeType j = 0; j < dff.mControlNum; ++ j ) {
+      auto& ctrl{mNetwork->control(dff, j)};
+      auto cv{_value_ptr(ctrl.mId)};
+      std::uint64_t pmask = ctrl.mPositive ? 0ULL : ~0ULL;
+      for ( SizeType k = 0; k < pw; ++ k ) {
+	act[k] = (cv[k] ^ pmask) & ~done[k];
+	done[k] |= act[k];
+      }
+      auto vv{_value_ptr(ctrl.mValId)};
+      SizeType vw{mWidthArray[ctrl.mValId]};
+      for ( SizeType b = 0; b < bw; ++ b ) {
+	auto d1{dst + b * pw};
+	for ( SizeType k = 0; k < pw; ++ k ) {
+	  std::uint64_t v = b < vw ? vv[b * pw + k] : 0ULL;
+	  std::uint64_t nv = (act[k] & v) | (~act[k] & d1[k]);
+	  if ( nv != d1[k] ) {
+	    d1[k] = nv;
+	    changed = true;
+	  }
+	}
+      }
+    }
+  }
+  return changed;
+}
+
+// @brief 組み合わせ回路ノードを一つ評価する．
+void
+MvnPatternSimulator::_eval_op(
+  const SimOp& op
+)
+{
+  SizeType pw = mPatWords;
+  SizeType ow{mWidthArray[op.mId]};
+  auto dst{_value_ptr(op.mId)};
+  auto zero{&mValArray[mOffsetArray.back() * pw]};
+
+  // pos 番目のファンインのビット幅
+  auto iwidth = [&](SizeType pos) -> SizeType {
+    return mWidthArray[mNetwork->fanin(op, pos)];
+  };
+  // pos 番目のファンインの b ビット目
+  // ビット幅を超えた部分は 0 となる．
+  auto ival = [&](SizeType pos, SizeType b) -> const std::uint64_t* {
+    SizeType id{mNetwork->fanin(op, pos)};
+    if ( b < mWidthArray[id] ) {
+      return &mValArray[(mOffsetArray[id] + b) * pw];
+    }
+    return zero;
+  };
+  // pos 番目のファンインを bw ビットに拡張して dst にコピーする．
+  auto load = [&](std::uint64_t* dst, SizeType pos, SizeType bw) {
+    for ( SizeType b = 0; b < bw; ++ b ) {
+      copy_slice(dst + b * pw, ival(pos, b), pw);
+    }
+  };
+  // pos 番目のファンインの全ビットの OR を dst に入れる．
+  auto any = [&](std::uint64_t* dst, SizeType pos) {
+    fill_slice(dst, 0ULL, pw);
+    SizeType iw{iwidth(pos)};
+    for ( SizeType b = 0; b < iw; ++ b ) {
+      auto src{ival(pos, b)};
+      for ( SizeType k = 0; k < pw; ++ k ) {
+	dst[k] |= src[k];
+      }
+    }
+  };
+
+  auto tmp0{&mWorkArray[0]};
+  auto tmp1{&mWorkArray[mWorkSize]};
+  auto tmp2{&mWorkArray[mWorkSize * 2]};
+  auto tmp3{&mWorkArray[mWorkSize * 3]};
+  auto tmp4{&mWorkArray[mWorkSize * 4]};
+  auto carry{mCarryArray.data()};
+
+  switch ( op.mType ) {
+  case MvnNodeType::OUTPUT:
+  case MvnNodeType::INOUT:
+  case MvnNodeType::THROUGH:
+    load(dst, 0, ow);
+    break;
+
+  case MvnNodeType::LATCH:
+    any(tmp0, 1);
+    for ( SizeType b = 0; b < ow; ++ b ) {
+      auto d1{dst + b * pw};
+      mux_slice(d1, tmp0, ival(0, b), d1, pw);
+    }
+    break;
+
+  case MvnNodeType::NOT:
+    for ( SizeType b = 0; b < ow; ++ b ) {
+      auto src{ival(0, b)};
+      auto d1{dst + b * pw};
+      for ( SizeType k = 0; k < pw; ++ k ) {
+	d1[k] = ~src[k];
+      }
+    }
+    break;
+
+  case MvnNodeType::AND:
+  case MvnNodeType::OR:
+  case MvnNodeType::XOR:
+    load(dst, 0, ow);
+    for ( SizeType j = 1; j < op.mFaninNum; ++ j ) {
+      for ( SizeType b = 0; b < ow; ++ b ) {
+	auto src{ival(j, b)};
+	auto d1{dst + b * pw};
+	if ( op.mType == MvnNodeType::AND ) {
+	  for ( SizeType k = 0; k < pw; ++ k ) {
+	    d1[k] &= src[k];
+	  }
+	}
+	else if ( op.mType == MvnNodeType::OR ) {
+	  for ( SizeType k = 0; k < pw; ++ k ) {
+	    d1[k] |= src[k];
+	  }
+	}
+	else {
+	  for ( SizeType k = 0; k < pw; ++ k ) {
+	    d1[k] ^= src[k];
+	  }
+	}
+      }
+    }
+    break;
+
+  case MvnNodeType::RAND:
+    {
+      fill_slice(dst, ~0ULL, pw);
+      SizeType iw{iwidth(0)};
+      for ( SizeType b = 0; b < iw; ++ b ) {
+	auto src{ival(0, b)};
+	for ( SizeType k = 0; k < pw; ++ k ) {
+	  dst[k] &= src[k];
+	}
+      }
+    }
+    break;
+
+  case MvnNodeType::ROR:
+    any(dst, 0);
+    break;
+
+  case MvnNodeType::RXOR:
+    {
+      fill_slice(dst, 0ULL, pw);
+      SizeType iw{iwidth(0)};
+      for ( SizeType b = 0; b < iw; ++ b ) {
+	auto src{ival(0, b)};
+	for ( SizeType k = 0; k < pw; ++ k ) {
+	  dst[k] ^= src[k];
+	}
+      }
+    }
+    break;
+
+  case MvnNodeType::EQ:
+  case MvnNodeType::CASEEQ:
+    {
+      SizeType bw{std::max(iwidth(0), iwidth(1))};
+      SizeType xw{op.mType == MvnNodeType::CASEEQ ? iwidth(0) : 0};
+      fill_slice(dst, ~0ULL, pw);
+      for ( SizeType b = 0; b < bw; ++ b ) {
+	if ( b < xw ) {
+	  auto xmask{mNetwork->pool(op.mAux)};
+	  if ( (xmask[b / 64] >> (b % 64)) & 1ULL ) {
+	    continue;
+	  }
+	}
+	auto a1{ival(0, b)};
+	auto b1{ival(1, b)};
+	for ( SizeType k = 0; k < pw; ++ k ) {
+	  dst[k] &= ~(a1[k] ^ b1[k]);
+	}
+      }
+    }
+    break;
+
+  case MvnNodeType::LT:
+    {
+      // LSB から順に比較結果を更新していく．
+      SizeType bw{std::max(iwidth(0), iwidth(1))};
+      fill_slice(dst, 0ULL, pw);
+      for ( SizeType b = 0; b < bw; ++ b ) {
+	auto a1{ival(0, b)};
+	auto b1{ival(1, b)};
+	for ( SizeType k = 0; k < pw; ++ k ) {
+	  dst[k] = (~a1[k] & b1[k]) | (~(a1[k] ^ b1[k]) & dst[k]);
+	}
+      }
+    }
+    break;
+
+  case MvnNodeType::SLL:
+  case MvnNodeType::SLA:
+  case MvnNodeType::SRL:
+  case MvnNodeType::SRA:
+  case MvnNodeType::PARTSELECT:
+    {
+      // シフト量の各ビットごとに 2^k ビットシフトしたものを選ぶ
+      // バレルシフタで評価する．
+      // PARTSELECT は2番目の入力だけ右にシフトしたものとみなす．
+      SizeType iw{iwidth(0)};
+      SizeType bw{std::max(iw, ow)};
+      bool left = op.mType == MvnNodeType::SLL || op.mType == MvnNodeType::SLA;
+      load(tmp0, 0, iw);
+      // 上位ビットを埋める値
+      if ( op.mType == MvnNodeType::SRA && iw > 0 ) {
+	copy_slice(tmp2, ival(0, iw - 1), pw);
+      }
+      else {
+	fill_slice(tmp2, 0ULL, pw);
+      }
+      for ( SizeType b = iw; b < bw; ++ b ) {
+	copy_slice(tmp0 + b * pw, tmp2, pw);
+      }
+      SizeType sw{iwidth(1)};
+      for ( SizeType j = 0; j < sw; ++ j ) {
+	SizeType s = j < 64 ? (1ULL << j) : bw;
+	for ( SizeType b = 0; b < bw; ++ b ) {
+	  const std::uint64_t* src;
+	  if ( left ) {
+	    src = (s < bw && b >= s) ? tmp0 + (b - s) * pw : zero;
+	  }
+	  else {
+	    src = (s < bw && b + s < bw) ? tmp0 + (b + s) * pw : tmp2;
+	  }
+	  copy_slice(tmp1 + b * pw, src, pw);
+	}
+	auto sel{ival(1, j)};
+	for ( SizeType b = 0; b < bw; ++ b ) {
+	  auto d1{tmp0 + b * pw};
+	  mux_slice(d1, sel, tmp1 + b * pw, d1, pw);
+	}
+      }
+      copy_slice(dst, tmp0, ow * pw);
+    }
+    break;
+
+  case MvnNodeType::CMPL:
+    fill_slice(tmp0, 0ULL, ow * pw);
+    load(tmp1, 0, ow);
+    fill_slice(carry, ~0ULL, pw);
+    add_slices(dst, tmp0, tmp1, ow, carry, true, pw);
+    break;
+
+  case MvnNodeType::ADD:
+  case MvnNodeType::SUB:
+    {
+      bool sub = op.mType == MvnNodeType::SUB;
+      load(tmp0, 0, ow);
+      load(tmp1, 1, ow);
+      fill_slice(carry, sub ? ~0ULL : 0ULL, pw);
+      add_slices(dst, tmp0, tmp1, ow, carry, sub, pw);
+    }
+    break;
+
+  case MvnNodeType::MUL:
+    load(tmp0, 0, ow);
+    load(tmp1, 1, ow);
+    mul_slices(dst, tmp0, tmp1, ow, carry, pw);
+    break;
+
+  case MvnNodeType::DIV:
+  case MvnNodeType::MOD:
+    {
+      // 回復法による除算
+      // tmp0: 被除数, tmp1: 除数, tmp2: 部分剰余, tmp3: 商, tmp4: 差
+      // 部分剰余と除数は1ビット余分に持つ．
+      SizeType bw{std::max(std::max(iwidth(0), iwidth(1)), ow)};
+      load(tmp0, 0, bw);
+      load(tmp1, 1, bw + 1);
+      fill_slice(tmp2, 0ULL, (bw + 1) * pw);
+      fill_slice(tmp3, 0ULL, bw * pw);
+      for ( SizeType i = bw; i > 0; -- i ) {
+	SizeType pos = i - 1;
+	for ( SizeType b = bw; b > 0; -- b ) {
+	  copy_slice(tmp2 + b * pw, tmp2 + (b - 1) * pw, pw);
+	}
+	copy_slice(tmp2, tmp0 + pos * pw, pw);
+	fill_slice(carry, ~0ULL, pw);
+	add_slices(tmp4, tmp2, tmp1, bw + 1, carry, true, pw);
+	// キャリーが 1 なら部分剰余 >= 除数
+	for ( SizeType b = 0; b <= bw; ++ b ) {
+	  auto d1{tmp2 + b * pw};
+	  mux_slice(d1, carry, tmp4 + b * pw, d1, pw);
+	}
+	copy_slice(tmp3 + pos * pw, carry, pw);
+      }
+      // 0 除算の結果は 0 とする．
+      any(carry, 1);
+      auto res{op.mType == MvnNodeType::DIV ? tmp3 : tmp2};
+      for ( SizeType b = 0; b < ow; ++ b ) {
+	auto s1{res + b * pw};
+	auto d1{dst + b * pw};
+	for ( SizeType k = 0; k < pw; ++ k ) {
+	  d1[k] = s1[k] & carry[k];
+	}
+      }
+    }
+    break;
+
+  case MvnNodeType::POW:
+    {
+      // tmp0: 結果, tmp1: 底の 2^k 乗, tmp2: 積
+      fill_slice(tmp0, 0ULL, ow * pw);
+      if ( ow > 0 ) {
+	fill_slice(tmp0, ~0ULL, pw);
+      }
+      load(tmp1, 0, ow);
+      SizeType ew{iwidth(1)};
+      for ( SizeType j = 0; j < ew; ++ j ) {
+	mul_slices(tmp2, tmp0, tmp1, ow, carry, pw);
+	auto sel{ival(1, j)};
+	for ( SizeType b = 0; b < ow; ++ b ) {
+	  auto d1{tmp0 + b * pw};
+	  mux_slice(d1, sel, tmp2 + b * pw, d1, pw);
+	}
+	if ( j + 1 < ew ) {
+	  mul_slices(tmp2, tmp1, tmp1, ow, carry, pw);
+	  copy_slice(tmp1, tmp2, ow * pw);
+	}
+      }
+      copy_slice(dst, tmp0, ow * pw);
+    }
+    break;
+
+  case MvnNodeType::ITE:
+    any(tmp0, 0);
+    for ( SizeType b = 0; b < ow; ++ b ) {
+      mux_slice(dst + b * pw, tmp0, ival(1, b), ival(2, b), pw);
+    }
+    break;
+
+  case MvnNodeType::CONCAT:
+    {
+      // 最後の入力が LSB 側になる．
+      fill_slice(dst, 0ULL, ow * pw);
+      SizeType pos = 0;
+      for ( SizeType j = op.mFaninNum; j > 0; -- j ) {
+	SizeType iw{iwidth(j - 1)};
+	for ( SizeType b = 0; b < iw && pos + b < ow; ++ b ) {
+	  copy_slice(dst + (pos + b) * pw, ival(j - 1, b), pw);
+	}
+	pos += iw;
+      }
+    }
+    break;
+
+  case MvnNodeType::CONSTBITSELECT:
+    copy_slice(dst, ival(0, op.mAux), pw);
+    break;
+
+  case MvnNodeType::CONSTPARTSELECT:
+    for ( SizeType b = 0; b < ow; ++ b ) {
+      copy_slice(dst + b * pw, ival(0, op.mAux + b), pw);
+    }
+    break;
+
+  case MvnNodeType::BITSELECT:
+    {
+      // 各ビット位置ごとに選択信号との一致を調べる．
+      SizeType iw{iwidth(0)};
+      SizeType sw{iwidth(1)};
+      fill_slice(dst, 0ULL, pw);
+      for ( SizeType p = 0; p < iw; ++ p ) {
+	if ( sw < 64 && (p >> sw) != 0 ) {
+	  break;
+	}
+	fill_slice(tmp0, ~0ULL, pw);
+	for ( SizeType j = 0; j < sw; ++ j ) {
+	  bool bit = j < 64 && ((p >> j) & 1ULL);
+	  std::uint64_t pmask = bit ? 0ULL : ~0ULL;
+	  auto sel{ival(1, j)};
+	  for ( SizeType k = 0; k < pw; ++ k ) {
+	    tmp0[k] &= sel[k] ^ pmask;
+	  }
+	}
+	auto src{ival(0, p)};
+	for ( SizeType k = 0; k < pw; ++ k ) {
+	  dst[k] |= tmp0[k] & src[k];
+	}
+      }
+    }
+    break;
+
+  case MvnNodeType::CELL:
+    if ( op.mAux == static_cast<SizeType>(-1) ) {
+      fill_slice(dst, 0ULL, pw);
+    }
+    else {
+      // 論理式の評価はもともとビット並列で行われる．
+      auto& expr{mNetwork->expr(op.mAux)};
+      for ( SizeType k = 0; k < pw; ++ k ) {
+	for ( SizeType i = 0; i < op.mFaninNum; ++ i ) {
+	  mCellInputArray[i] = ival(i, 0)[k];
+	}
+	dst[k] = expr.eval(mCellInputArray, ~0ULL);
+      }
+    }
+    break;
+
+  default:
+    ASSERT_NOT_REACHED;
+    break;
+  }
+}
+
+END_NAMESPACE_YM_MVN
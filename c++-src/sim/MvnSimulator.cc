@@ -0,0 +1,277 @@
+﻿
+/// @file MvnSimulator.cc
+/// @brief MvnSimulator の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/MvnSimulator.h"
+#include "ym/MvnMgr.h"
+#include "ym/MvnModule.h"
+#include "ym/MvnNode.h"
+#include "SimNetwork.h"
+#include "SimEventQueue.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+// クラス MvnSimulator
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+MvnSimulator::MvnSimulator(
+  const MvnMgr& mgr,
+  const MvnModule* module
+) : mMgr{mgr},
+    mNetwork{new SimNetwork{mgr, module}}
+{
+  mValArray.resize(mNetwork->value_size());
+  mNextArray.resize(mNetwork->next_size());
+  mWorkArray.resize(mNetwork->work_size());
+  mCellInputArray.resize(mNetwork->cell_input_size());
+  mNetwork->init_values(mValArray.data());
+  mPrevArray = mValArray;
+  mQueue.reset(new SimEventQueue{mNetwork->max_node_id(),
+				 mNetwork->max_level()});
+}
+
+// @brief デストラクタ
+MvnSimulator::~MvnSimulator()
+{
+}
+
+// @brief 入力の値を設定する．
+void
+MvnSimulator::set_input(
+  SizeType pos,
+  const MvnBvConst& val
+)
+{
+  ASSERT_COND( 0 <= pos && pos < mNetwork->input_list().size() );
+  _set_value(mNetwork->input_list()[pos], val);
+}
+
+// @brief 入力の値を設定する．
+void
+MvnSimulator::set_input(
+  SizeType pos,
+  std::uint64_t val
+)
+{
+  ASSERT_COND( 0 <= pos && pos < mNetwork->input_list().size() );
+  SizeType id{mNetwork->input_list()[pos]};
+  SizeType bw{mNetwork->bit_width(id)};
+  if ( bw == 0 ) {
+    return;
+  }
+  auto dst{&mValArray[mNetwork->offset(id)]};
+  SizeType nw{(bw + 63) / 64};
+  if ( bw < 64 ) {
+    val &= (1ULL << bw) - 1ULL;
+  }
+  bool changed = false;
+  for ( SizeType i = 0; i < nw; ++ i ) {
+    std::uint64_t v = i == 0 ? val : 0ULL;
+    if ( dst[i] != v ) {
+      dst[i] = v;
+      changed = true;
+    }
+  }
+  if ( changed ) {
+    _add_event(id);
+  }
+}
+
+// @brief ノードの値を設定する．
+void
+MvnSimulator::set_value(
+  const MvnNode* node,
+  const MvnBvConst& val
+)
+{
+  ASSERT_COND( node != nullptr );
+  ASSERT_COND( node->parent() == mNetwork->module() );
+  switch ( node->type() ) {
+  case MvnNodeType::INPUT:
+  case MvnNodeType::DFF:
+    break;
+
+  case MvnNodeType::INOUT:
+    ASSERT_COND( node->input(0)->src_node() == nullptr );
+    break;
+
+  default:
+    ASSERT_NOT_REACHED;
+    break;
+  }
+  _set_value(node->id(), val);
+}
+
+// @brief 全ての DFF の状態を 0 にする．
+void
+MvnSimulator::reset_state()
+{
+  for ( auto& dff: mNetwork->dff_list() ) {
+    _set_value(dff.mId, MvnBvConst{});
+  }
+}
+
+// @brief 現在の入力と状態で組み合わせ回路部分を評価する．
+//
+// 最初の評価と組み合わせ回路のループがある場合は全てのノードを評価する．
+// それ以外は値の変化したノードのファンアウトのみをレベル順に評価する．
+void
+MvnSimulator::eval()
+{
+  auto vals{mValArray.data()};
+  auto work{mWorkArray.data()};
+  if ( mFullEval || mNetwork->has_loop() ) {
+    // キューに残っているノードは全体の評価で処理される．
+    SizeType id;
+    while ( mQueue->get(id) ) {
+      ;
+    }
+    mNetwork->eval(vals, work, mCellInputArray);
+    SizeType n{mNetwork->max_node_id()};
+    for ( SizeType id = 0; id < n; ++ id ) {
+      mQueue->add_changed(id);
+    }
+    mFullEval = false;
+  }
+  else {
+    mNetwork->eval_event(vals, work, mCellInputArray, *mQueue);
+  }
+
+  // 途中で変化して元に戻ったノードもあるので前回の値と比較する．
+  mChangedList.clear();
+  for ( auto id: mQueue->changed_list() ) {
+    SizeType nw{(mNetwork->bit_width(id) + 63) / 64};
+    SizeType offset{mNetwork->offset(id)};
+    auto src{vals + offset};
+    auto dst{&mPrevArray[offset]};
+    if ( !std::equal(src, src + nw, dst) ) {
+      mChangedList.push_back(id);
+      std::copy(src, src + nw, dst);
+    }
+  }
+  mQueue->clear_changed();
+  mDirty = false;
+}
+
+// @brief クロックを進める．
+void
+MvnSimulator::step(
+  SizeType n
+)
+{
+  for ( SizeType c = 0; c < n; ++ c ) {
+    _update();
+    mNetwork->calc_next_state(mValArray.data(), mNextArray.data());
+    mNetwork->update_state(mValArray.data(), mNextArray.data(), mQueue.get());
+    mDirty = true;
+  }
+}
+
+// @brief 出力の値を返す．
+MvnBvConst
+MvnSimulator::output(
+  SizeType pos
+)
+{
+  ASSERT_COND( 0 <= pos && pos < mNetwork->output_list().size() );
+  return _value(mNetwork->output_list()[pos]);
+}
+
+// @brief 出力の値の下位64ビットを返す．
+std::uint64_t
+MvnSimulator::output_uint(
+  SizeType pos
+)
+{
+  ASSERT_COND( 0 <= pos && pos < mNetwork->output_list().size() );
+  _update();
+  SizeType id{mNetwork->output_list()[pos]};
+  if ( mNetwork->bit_width(id) == 0 ) {
+    return 0ULL;
+  }
+  return mValArray[mNetwork->offset(id)];
+}
+
+// @brief ノードの値を返す．
+MvnBvConst
+MvnSimulator::value(
+  const MvnNode* node
+)
+{
+  ASSERT_COND( node != nullptr );
+  ASSERT_COND( node->parent() == mNetwork->module() );
+  return _value(node->id());
+}
+
+// @brief 直前の eval() で値が変化したノードのリストを返す．
+vector<const MvnNode*>
+MvnSimulator::changed_node_list() const
+{
+  vector<const MvnNode*> node_list;
+  node_list.reserve(mChangedList.size());
+  for ( auto id: mChangedList ) {
+    node_list.push_back(mMgr.node(id));
+  }
+  return node_list;
+}
+
+// @brief 組み合わせ回路のループがある時 true を返す．
+bool
+MvnSimulator::has_loop() const
+{
+  return mNetwork->has_loop();
+}
+
+// @brief ループのために順序づけられなかったノードのリストを返す．
+vector<const MvnNode*>
+MvnSimulator::loop_node_list() const
+{
+  vector<const MvnNode*> node_list;
+  node_list.reserve(mNetwork->loop_id_list().size());
+  for ( auto id: mNetwork->loop_id_list() ) {
+    node_list.push_back(mMgr.node(id));
+  }
+  return node_list;
+}
+
+// @brief ノード番号を指定して値を設定する．
+void
+MvnSimulator::_set_value(
+  SizeType id,
+  const MvnBvConst& val
+)
+{
+  if ( mNetwork->set_value(mValArray.data(), id, val) ) {
+    _add_event(id);
+  }
+}
+
+// @brief 値が変化したノードを記録する．
+void
+MvnSimulator::_add_event(
+  SizeType id
+)
+{
+  mQueue->add_changed(id);
+  mNetwork->put_fanouts(id, *mQueue);
+  mDirty = true;
+}
+
+// @brief ノード番号を指定して値を取り出す．
+MvnBvConst
+MvnSimulator::_value(
+  SizeType id
+)
+{
+  _update();
+  return mNetwork->get_value(mValArray.data(), id);
+}
+
+END_NAMESPACE_YM_MVN
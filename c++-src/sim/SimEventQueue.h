@@ -0,0 +1,136 @@
+﻿#ifndef SIMEVENTQUEUE_H
+#define SIMEVENTQUEUE_H
+
+/// @file SimEventQueue.h
+/// @brief SimEventQueue のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/mvn.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+/// @class SimEventQueue SimEventQueue.h "SimEventQueue.h"
+/// @brief イベントドリブンシミュレーション用のレベル付きキュー
+///
+/// ノードはレベルごとのバケツに入れられ，レベルの小さい順に取り出される．
+/// 同じノードは一度しか入らない．
+/// 値が変化したノードの記録もここで行う．
+//////////////////////////////////////////////////////////////////////
+class SimEventQueue
+{
+public:
+
+  /// @brief コンストラクタ
+  SimEventQueue(
+    SizeType max_node_id, ///< [in] ノード番号の最大値 + 1
+    SizeType max_level    ///< [in] レベルの最大値
+  ) : mLevelArray(max_level + 1),
+      mQueuedArray(max_node_id, false),
+      mChangedArray(max_node_id, false)
+  {
+  }
+
+  /// @brief デストラクタ
+  ~SimEventQueue() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ノードを追加する．
+  void
+  put(
+    SizeType id,   ///< [in] ノード番号
+    SizeType level ///< [in] レベル
+  )
+  {
+    if ( !mQueuedArray[id] ) {
+      mQueuedArray[id] = true;
+      mLevelArray[level].push_back(id);
+      if ( mCurLevel > level ) {
+	mCurLevel = level;
+      }
+    }
+  }
+
+  /// @brief 最もレベルの小さいノードを取り出す．
+  /// @return 空の時は false を返す．
+  bool
+  get(
+    SizeType& id ///< [out] 取り出したノード番号
+  )
+  {
+    for ( ; mCurLevel < mLevelArray.size(); ++ mCurLevel ) {
+      auto& bucket{mLevelArray[mCurLevel]};
+      if ( !bucket.empty() ) {
+	id = bucket.back();
+	bucket.pop_back();
+	mQueuedArray[id] = false;
+	return true;
+      }
+    }
+    return false;
+  }
+
+  /// @brief 値が変化したノードを記録する．
+  void
+  add_changed(
+    SizeType id ///< [in] ノード番号
+  )
+  {
+    if ( !mChangedArray[id] ) {
+      mChangedArray[id] = true;
+      mChangedList.push_back(id);
+    }
+  }
+
+  /// @brief 値が変化したノードのリストを返す．
+  const vector<SizeType>&
+  changed_list() const
+  {
+    return mChangedList;
+  }
+
+  /// @brief 値が変化したノードの記録を消す．
+  void
+  clear_changed()
+  {
+    for ( auto id: mChangedList ) {
+      mChangedArray[id] = false;
+    }
+    mChangedList.clear();
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // レベルごとのバケツ
+  vector<vector<SizeType>> mLevelArray;
+
+  // 次に調べるレベル
+  SizeType mCurLevel{0};
+
+  // キューに入っている時 true にするフラグの配列
+  vector<bool> mQueuedArray;
+
+  // 値が変化したノードのリスト
+  vector<SizeType> mChangedList;
+
+  // mChangedList に入っている時 true にするフラグの配列
+  vector<bool> mChangedArray;
+
+};
+
+END_NAMESPACE_YM_MVN
+
+#endif // SIMEVENTQUEUE_H
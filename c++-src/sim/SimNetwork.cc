@@ -0,0 +1,1148 @@
+﻿
+/// @file SimNetwork.cc
+/// @brief SimNetwork の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "SimNetwork.h"
+#include "MvnLevelizer.h"
+#include "ym/MvnMgr.h"
+#include "ym/MvnModule.h"
+#include "ym/MvnNode.h"
+#include "ym/MvnInputPin.h"
+#include "ym/MvnBvConst.h"
+#include "ym/ClibCell.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+BEGIN_NONAMESPACE
+
+// ビット幅からワード数を求める．
+inline
+SizeType
+nwords(
+  SizeType bw
+)
+{
+  return (bw + 63) / 64;
+}
+
+// 最上位ワードの有効ビットのマスクを求める．
+inline
+std::uint64_t
+last_mask(
+  SizeType bw
+)
+{
+  SizeType r = bw % 64;
+  if ( r == 0 ) {
+    return ~0ULL;
+  }
+  return (1ULL << r) - 1ULL;
+}
+
+// src の pos ビット目から 64 ビット分を取り出す．
+// sw ビット目以降は 0 とみなす．
+inline
+std::uint64_t
+get_bits64(
+  const std::uint64_t* src,
+  SizeType sw,
+  SizeType pos
+)
+{
+  SizeType nw = nwords(sw);
+  SizeType b = pos / 64;
+  SizeType s = pos % 64;
+  std::uint64_t lo = b < nw ? src[b] : 0ULL;
+  if ( s == 0 ) {
+    return lo;
+  }
+  std::uint64_t hi = (b + 1) < nw ? src[b + 1] : 0ULL;
+  return (lo >> s) | (hi << (64 - s));
+}
+
+// src (sw ビット) を dst (dw ビット) に拡張/切り詰めてコピーする．
+inline
+void
+copy_ext(
+  std::uint64_t* dst,
+  SizeType dw,
+  const std::uint64_t* src,
+  SizeType sw
+)
+{
+  SizeType dn = nwords(dw);
+  SizeType sn = nwords(sw);
+  for ( SizeType i = 0; i < dn; ++ i ) {
+    dst[i] = i < sn ? src[i] : 0ULL;
+  }
+  if ( dn > 0 ) {
+    dst[dn - 1] &= last_mask(dw);
+  }
+}
+
+// 最上位ワードを正規化する．
+inline
+void
+normalize(
+  std::uint64_t* dst,
+  SizeType bw
+)
+{
+  SizeType dn = nwords(bw);
+  if ( dn > 0 ) {
+    dst[dn - 1] &= last_mask(bw);
+  }
+}
+
+// 全てのビットが 0 の時 true を返す．
+inline
+bool
+is_zero(
+  const std::uint64_t* src,
+  SizeType bw
+)
+{
+  SizeType n = nwords(bw);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    if ( src[i] != 0ULL ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// ビットを取り出す．
+inline
+bool
+get_bit(
+  const std::uint64_t* src,
+  SizeType pos
+)
+{
+  return static_cast<bool>((src[pos / 64] >> (pos % 64)) & 1ULL);
+}
+
+// 値を非負整数として取り出す．
+// 64ビットに収まらない場合には false を返す．
+inline
+bool
+get_uint(
+  const std::uint64_t* src,
+  SizeType bw,
+  SizeType& val
+)
+{
+  SizeType n = nwords(bw);
+  for ( SizeType i = 1; i < n; ++ i ) {
+    if ( src[i] != 0ULL ) {
+      return false;
+    }
+  }
+  val = n > 0 ? src[0] : 0ULL;
+  return true;
+}
+
+// dst = a + b + cin (n ワード)
+inline
+void
+add_words(
+  std::uint64_t* dst,
+  const std::uint64_t* a,
+  const std::uint64_t* b,
+  SizeType n,
+  std::uint64_t cin
+)
+{
+  std::uint64_t c = cin;
+  for ( SizeType i = 0; i < n; ++ i ) {
+    std::uint64_t s = a[i] + c;
+    std::uint64_t c1 = s < c ? 1ULL : 0ULL;
+    std::uint64_t s2 = s + b[i];
+    std::uint64_t c2 = s2 < s ? 1ULL : 0ULL;
+    dst[i] = s2;
+    c = c1 | c2;
+  }
+}
+
+// dst = a - b (n ワード)
+inline
+void
+sub_words(
+  std::uint64_t* dst,
+  const std::uint64_t* a,
+  const std::uint64_t* b,
+  SizeType n
+)
+{
+  std::uint64_t borrow = 0ULL;
+  for ( SizeType i = 0; i < n; ++ i ) {
+    std::uint64_t d = a[i] - b[i];
+    std::uint64_t b1 = a[i] < b[i] ? 1ULL : 0ULL;
+    std::uint64_t d2 = d - borrow;
+    std::uint64_t b2 = d < borrow ? 1ULL : 0ULL;
+    dst[i] = d2;
+    borrow = b1 | b2;
+  }
+}
+
+// dst = a * b (n ワードで切り詰め)
+// dst は a, b と重なってはいけない．
+inline
+void
+mul_words(
+  std::uint64_t* dst,
+  const std::uint64_t* a,
+  const std::uint64_t* b,
+  SizeType n
+)
+{
+  for ( SizeType i = 0; i < n; ++ i ) {
+    dst[i] = 0ULL;
+  }
+  for ( SizeType i = 0; i < n; ++ i ) {
+    if ( a[i] == 0ULL ) {
+      continue;
+    }
+    unsigned __int128 carry = 0;
+    for ( SizeType j = 0; i + j < n; ++ j ) {
+      unsigned __int128 t = static_cast<unsigned __int128>(a[i]) * b[j];
+      t += dst[i + j];
+      t += carry;
+      dst[i + j] = static_cast<std::uint64_t>(t);
+      carry = t >> 64;
+    }
+  }
+}
+
+// a < b の時 true を返す．(n ワード)
+inline
+bool
+lt_words(
+  const std::uint64_t* a,
+  const std::uint64_t* b,
+  SizeType n
+)
+{
+  for ( SizeType i = n; i > 0; -- i ) {
+    if ( a[i - 1] != b[i - 1] ) {
+      return a[i - 1] < b[i - 1];
+    }
+  }
+  return false;
+}
+
+// dst = src << sft (n ワード)
+inline
+void
+shl_words(
+  std::uint64_t* dst,
+  const std::uint64_t* src,
+  SizeType n,
+  SizeType sft
+)
+{
+  SizeType wsft = sft / 64;
+  SizeType bsft = sft % 64;
+  for ( SizeType i = n; i > 0; -- i ) {
+    SizeType d = i - 1;
+    std::uint64_t v = 0ULL;
+    if ( d >= wsft ) {
+      v = src[d - wsft] << bsft;
+      if ( bsft > 0 && d > wsft ) {
+	v |= src[d - wsft - 1] >> (64 - bsft);
+      }
+    }
+    dst[d] = v;
+  }
+}
+
+// dst = src >> sft (n ワード)
+inline
+void
+shr_words(
+  std::uint64_t* dst,
+  const std::uint64_t* src,
+  SizeType n,
+  SizeType sft
+)
+{
+  SizeType wsft = sft / 64;
+  SizeType bsft = sft % 64;
+  for ( SizeType d = 0; d < n; ++ d ) {
+    std::uint64_t v = 0ULL;
+    if ( d + wsft < n ) {
+      v = src[d + wsft] >> bsft;
+      if ( bsft > 0 && d + wsft + 1 < n ) {
+	v |= src[d + wsft + 1] << (64 - bsft);
+      }
+    }
+    dst[d] = v;
+  }
+}
+
+// 符号なし除算を行う．
+// q = a / b, r = a % b (bw ビット)
+// b が 0 の時は q = r = 0 とする．
+void
+divmod_words(
+  std::uint64_t* q,
+  std::uint64_t* r,
+  const std::uint64_t* a,
+  const std::uint64_t* b,
+  SizeType bw
+)
+{
+  SizeType n = nwords(bw);
+  if ( is_zero(b, bw) ) {
+    for ( SizeType i = 0; i < n; ++ i ) {
+      q[i] = 0ULL;
+      r[i] = 0ULL;
+    }
+    return;
+  }
+  if ( n == 1 ) {
+    q[0] = a[0] / b[0];
+    r[0] = a[0] % b[0];
+    return;
+  }
+  for ( SizeType i = 0; i < n; ++ i ) {
+    q[i] = 0ULL;
+    r[i] = 0ULL;
+  }
+  for ( SizeType i = bw; i > 0; -- i ) {
+    SizeType pos = i - 1;
+    // r = (r << 1) | a[pos]
+    shl_words(r, r, n, 1);
+    if ( get_bit(a, pos) ) {
+      r[0] |= 1ULL;
+    }
+    if ( !lt_words(r, b, n) ) {
+      sub_words(r, r, b, n);
+      q[pos / 64] |= (1ULL << (pos % 64));
+    }
+  }
+}
+
+// dst の dpos ビット目から src (sw ビット) を OR する．
+inline
+void
+or_bits(
+  std::uint64_t* dst,
+  SizeType dn,
+  SizeType dpos,
+  const std::uint64_t* src,
+  SizeType sw
+)
+{
+  SizeType sn = nwords(sw);
+  SizeType b = dpos / 64;
+  SizeType s = dpos % 64;
+  for ( SizeType j = 0; j < sn; ++ j ) {
+    std::uint64_t v = src[j];
+    if ( b + j < dn ) {
+      dst[b + j] |= v << s;
+    }
+    if ( s > 0 && b + j + 1 < dn ) {
+      dst[b + j + 1] |= v >> (64 - s);
+    }
+  }
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス SimNetwork
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+SimNetwork::SimNetwork(
+  const MvnMgr& mgr,
+  const MvnModule* module
+) : mModule{module}
+{
+  MvnLevelizer lvlz{mgr, module};
+
+  SizeType n{mgr.max_node_id()};
+  // 末尾の要素は未接続のファンインを表すダミー
+  mWidthArray.resize(n + 1, 0);
+  mOffsetArray.resize(n + 1, 0);
+  mLevelArray.resize(n + 1, 0);
+
+  // 値の配置を決める．
+  SizeType size = 0;
+  for ( auto node: lvlz.node_list() ) {
+    SizeType id{static_cast<SizeType>(node->id())};
+    SizeType bw{node->bit_width()};
+    mWidthArray[id] = bw;
+    mOffsetArray[id] = size;
+    mLevelArray[id] = lvlz.level(id);
+    size += nwords(bw);
+    mMaxWords = std::max(mMaxWords, nwords(bw));
+    SizeType ni{node->input_num()};
+    for ( SizeType i = 0; i < ni; ++ i ) {
+      mMaxWords = std::max(mMaxWords, nwords(node->input(i)->bit_width()));
+    }
+  }
+  mOffsetArray[n] = size;
+  // ダミー用に 1 ワード確保しておく．
+  ++ size;
+  mInitArray.resize(size, 0ULL);
+  mMaxLevel = lvlz.max_level();
+
+  // 入出力のリスト
+  SizeType ni{module->input_num()};
+  mInputList.reserve(ni);
+  for ( SizeType i = 0; i < ni; ++ i ) {
+    mInputList.push_back(module->input(i)->id());
+  }
+  SizeType no{module->output_num()};
+  mOutputList.reserve(no);
+  for ( SizeType i = 0; i < no; ++ i ) {
+    mOutputList.push_back(module->output(i)->id());
+  }
+  SizeType nio{module->inout_num()};
+  mInoutList.reserve(nio);
+  for ( SizeType i = 0; i < nio; ++ i ) {
+    mInoutList.push_back(module->inout(i)->id());
+  }
+
+  // 評価情報を作る．
+  auto fanin_id = [n](const MvnNode* inode) -> SizeType {
+    if ( inode == nullptr ) {
+      return n;
+    }
+    return inode->id();
+  };
+  mOpPosArray.resize(n + 1, lvlz.node_list().size());
+  for ( auto node: lvlz.node_list() ) {
+    SizeType id{static_cast<SizeType>(node->id())};
+    auto type{node->type()};
+    if ( type == MvnNodeType::CONSTVALUE ) {
+      auto val{node->const_value()};
+      auto dst{&mInitArray[mOffsetArray[id]]};
+      SizeType bw{node->bit_width()};
+      for ( SizeType b = 0; b < bw; ++ b ) {
+	if ( val[b] ) {
+	  dst[b / 64] |= (1ULL << (b % 64));
+	}
+      }
+      mConstList.push_back(id);
+      continue;
+    }
+    if ( type == MvnNodeType::DFF ) {
+      SizeType nc{node->input_num() - 2};
+      SimDff dff;
+      dff.mId = id;
+      dff.mDataId = fanin_id(node->input(0)->src_node());
+      dff.mControlBegin = mControlArray.size();
+      dff.mControlNum = nc;
+      dff.mNextOffset = mNextSize;
+      for ( SizeType i = 0; i < nc; ++ i ) {
+	auto cnode{node->input(i + 2)->src_node()};
+	if ( cnode == nullptr ) {
+	  // 接続されていない制御信号は常に非アクティブとみなす．
+	  -- dff.mControlNum;
+	  continue;
+	}
+	SimControl ctrl;
+	ctrl.mId = cnode->id();
+	ctrl.mPositive = node->control_pol(i) == MvnPolarity::Positive;
+	ctrl.mValId = fanin_id(node->control_val(i));
+	mControlArray.push_back(ctrl);
+      }
+      mNextSize += nwords(node->bit_width());
+      mDffList.push_back(dff);
+      continue;
+    }
+    if ( MvnLevelizer::is_source(node) ) {
+      continue;
+    }
+
+    SimOp op;
+    op.mType = type;
+    op.mId = id;
+    op.mFaninBegin = mFaninArray.size();
+    op.mFaninNum = MvnLevelizer::fanin_num(node);
+    for ( SizeType i = 0; i < op.mFaninNum; ++ i ) {
+      mFaninArray.push_back(fanin_id(MvnLevelizer::fanin(node, i)));
+    }
+    switch ( type ) {
+    case MvnNodeType::CONSTBITSELECT:
+      op.mAux = node->bitpos();
+      break;
+
+    case MvnNodeType::CONSTPARTSELECT:
+      op.mAux = node->lsb();
+      break;
+
+    case MvnNodeType::CASEEQ:
+      {
+	auto xmask{node->xmask()};
+	SizeType bw{node->input(0)->bit_width()};
+	op.mAux = mPoolArray.size();
+	mPoolArray.resize(mPoolArray.size() + nwords(bw), 0ULL);
+	auto dst{&mPoolArray[op.mAux]};
+	for ( SizeType b = 0; b < bw; ++ b ) {
+	  if ( xmask[b] ) {
+	    dst[b / 64] |= (1ULL << (b % 64));
+	  }
+	}
+      }
+      break;
+
+    case MvnNodeType::CELL:
+      {
+	auto cell{node->cell()};
+	SizeType opos = node->cell_opin_pos();
+	if ( cell.has_logic(opos) ) {
+	  op.mAux = mExprArray.size();
+	  mExprArray.push_back(cell.logic_expr(opos));
+	  mMaxCellInput = std::max(mMaxCellInput, op.mFaninNum);
+	}
+	else {
+	  // 論理式を持たないセルの出力は 0 とする．
+	  op.mAux = static_cast<SizeType>(-1);
+	}
+      }
+      break;
+
+    default:
+      break;
+    }
+    mOpPosArray[id] = mOpList.size();
+    mOpList.push_back(op);
+  }
+  SizeType nop{mOpList.size()};
+  for ( auto& pos: mOpPosArray ) {
+    if ( pos == lvlz.node_list().size() ) {
+      pos = nop;
+    }
+  }
+
+  // dst_pin_list() からファンアウト表を作る．
+  // 多出力セルの残りの出力ノードは代表ノードと同じ入力を参照するので
+  // 代表ノードと一緒にファンアウトに加える．
+  mHasLoop = lvlz.has_loop();
+  for ( auto node: lvlz.loop_node_list() ) {
+    mLoopIdList.push_back(node->id());
+  }
+  unordered_map<SizeType, vector<SizeType>> ext_cell_map;
+  for ( auto node: lvlz.node_list() ) {
+    if ( node->type() == MvnNodeType::CELL && node->cell_node() != node ) {
+      ext_cell_map[node->cell_node()->id()].push_back(node->id());
+    }
+  }
+  vector<vector<SizeType>> fo_list_array(n);
+  for ( auto node: lvlz.node_list() ) {
+    auto& fo_list{fo_list_array[node->id()]};
+    for ( auto ipin: node->dst_pin_list() ) {
+      SizeType oid{static_cast<SizeType>(ipin->node()->id())};
+      if ( mOpPosArray[oid] == nop ) {
+	// DFF など
+	continue;
+      }
+      fo_list.push_back(oid);
+      if ( ext_cell_map.count(oid) > 0 ) {
+	for ( auto eid: ext_cell_map.at(oid) ) {
+	  fo_list.push_back(eid);
+	}
+      }
+    }
+  }
+  mFanoutBegin.resize(n + 2, 0);
+  for ( SizeType id = 0; id < n; ++ id ) {
+    mFanoutBegin[id] = mFanoutArray.size();
+    auto& fo_list{fo_list_array[id]};
+    mFanoutArray.insert(mFanoutArray.end(), fo_list.begin(), fo_list.end());
+  }
+  mFanoutBegin[n] = mFanoutArray.size();
+  mFanoutBegin[n + 1] = mFanoutArray.size();
+}
+
+// @brief 値バッファを初期化する．
+void
+SimNetwork::init_values(
+  std::uint64_t* vals
+) const
+{
+  std::copy(mInitArray.begin(), mInitArray.end(), vals);
+}
+
+// @brief 組み合わせ回路ノードを一つ評価する．
+void
+SimNetwork::eval_op(
+  const SimOp& op,
+  std::uint64_t* vals,
+  std::uint64_t* work,
+  vector<std::uint64_t>& cell_ivals
+) const
+{
+  SizeType ow{mWidthArray[op.mId]};
+  SizeType on{nwords(ow)};
+  auto dst{vals + mOffsetArray[op.mId]};
+
+  // pos 番目のファンインの値
+  auto ival = [&](SizeType pos) -> const std::uint64_t* {
+    return vals + mOffsetArray[mFaninArray[op.mFaninBegin + pos]];
+  };
+  // pos 番目のファンインのビット幅
+  auto iwidth = [&](SizeType pos) -> SizeType {
+    return mWidthArray[mFaninArray[op.mFaninBegin + pos]];
+  };
+
+  // 作業領域
+  SizeType mw = mMaxWords;
+  auto tmp0{work};
+  auto tmp1{work + mw};
+  auto tmp2{work + mw * 2};
+  auto tmp3{work + mw * 3};
+
+  switch ( op.mType ) {
+  case MvnNodeType::OUTPUT:
+  case MvnNodeType::INOUT:
+  case MvnNodeType::THROUGH:
+    copy_ext(dst, ow, ival(0), iwidth(0));
+    break;
+
+  case MvnNodeType::LATCH:
+    // イネーブルが 0 の時は値を保持する．
+    if ( !is_zero(ival(1), iwidth(1)) ) {
+      copy_ext(dst, ow, ival(0), iwidth(0));
+    }
+    break;
+
+  case MvnNodeType::NOT:
+    copy_ext(dst, ow, ival(0), iwidth(0));
+    for ( SizeType i = 0; i < on; ++ i ) {
+      dst[i] = ~dst[i];
+    }
+    normalize(dst, ow);
+    break;
+
+  case MvnNodeType::AND:
+    copy_ext(dst, ow, ival(0), iwidth(0));
+    for ( SizeType j = 1; j < op.mFaninNum; ++ j ) {
+      copy_ext(tmp0, ow, ival(j), iwidth(j));
+      for ( SizeType i = 0; i < on; ++ i ) {
+	dst[i] &= tmp0[i];
+      }
+    }
+    break;
+
+  case MvnNodeType::OR:
+    copy_ext(dst, ow, ival(0), iwidth(0));
+    for ( SizeType j = 1; j < op.mFaninNum; ++ j ) {
+      copy_ext(tmp0, ow, ival(j), iwidth(j));
+      for ( SizeType i = 0; i < on; ++ i ) {
+	dst[i] |= tmp0[i];
+      }
+    }
+    break;
+
+  case MvnNodeType::XOR:
+    copy_ext(dst, ow, ival(0), iwidth(0));
+    for ( SizeType j = 1; j < op.mFaninNum; ++ j ) {
+      copy_ext(tmp0, ow, ival(j), iwidth(j));
+      for ( SizeType i = 0; i < on; ++ i ) {
+	dst[i] ^= tmp0[i];
+      }
+    }
+    break;
+
+  case MvnNodeType::RAND:
+    {
+      auto src{ival(0)};
+      SizeType iw{iwidth(0)};
+      SizeType in{nwords(iw)};
+      bool val = true;
+      for ( SizeType i = 0; i + 1 < in && val; ++ i ) {
+	if ( src[i] != ~0ULL ) {
+	  val = false;
+	}
+      }
+      if ( val && in > 0 && src[in - 1] != last_mask(iw) ) {
+	val = false;
+      }
+      dst[0] = val ? 1ULL : 0ULL;
+    }
+    break;
+
+  case MvnNodeType::ROR:
+    dst[0] = is_zero(ival(0), iwidth(0)) ? 0ULL : 1ULL;
+    break;
+
+  case MvnNodeType::RXOR:
+    {
+      auto src{ival(0)};
+      SizeType in{nwords(iwidth(0))};
+      std::uint64_t acc = 0ULL;
+      for ( SizeType i = 0; i < in; ++ i ) {
+	acc ^= src[i];
+      }
+      dst[0] = __builtin_parityll(acc);
+    }
+    break;
+
+  case MvnNodeType::EQ:
+  case MvnNodeType::LT:
+  case MvnNodeType::CASEEQ:
+    {
+      SizeType bw{std::max(iwidth(0), iwidth(1))};
+      SizeType n{nwords(bw)};
+      copy_ext(tmp0, bw, ival(0), iwidth(0));
+      copy_ext(tmp1, bw, ival(1), iwidth(1));
+      bool val;
+      if ( op.mType == MvnNodeType::LT ) {
+	val = lt_words(tmp0, tmp1, n);
+      }
+      else {
+	val = true;
+	SizeType xn{nwords(iwidth(0))};
+	for ( SizeType i = 0; i < n; ++ i ) {
+	  std::uint64_t diff = tmp0[i] ^ tmp1[i];
+	  if ( op.mType == MvnNodeType::CASEEQ && i < xn ) {
+	    diff &= ~mPoolArray[op.mAux + i];
+	  }
+	  if ( diff != 0ULL ) {
+	    val = false;
+	    break;
+	  }
+	}
+      }
+      dst[0] = val ? 1ULL : 0ULL;
+    }
+    break;
+
+  case MvnNodeType::SLL:
+  case MvnNodeType::SLA:
+  case MvnNodeType::SRL:
+  case MvnNodeType::SRA:
+    {
+      SizeType iw{iwidth(0)};
+      SizeType bw{std::max(iw, ow)};
+      SizeType n{nwords(bw)};
+      copy_ext(tmp0, bw, ival(0), iw);
+      bool neg = false;
+      if ( op.mType == MvnNodeType::SRA && iw > 0 && get_bit(ival(0), iw - 1) ) {
+	// 符号拡張した値を反転しておけば論理シフトで済む．
+	// 符号拡張された上位ビットは反転後 0 になる．
+	neg = true;
+	for ( SizeType i = 0; i < n; ++ i ) {
+	  tmp0[i] = ~tmp0[i];
+	}
+	for ( SizeType i = nwords(iw); i < n; ++ i ) {
+	  tmp0[i] = 0ULL;
+	}
+	normalize(tmp0, iw);
+      }
+      SizeType sft;
+      if ( !get_uint(ival(1), iwidth(1), sft) || sft >= bw ) {
+	for ( SizeType i = 0; i < n; ++ i ) {
+	  tmp1[i] = 0ULL;
+	}
+      }
+      else if ( op.mType == MvnNodeType::SLL || op.mType == MvnNodeType::SLA ) {
+	shl_words(tmp1, tmp0, n, sft);
+      }
+      else {
+	shr_words(tmp1, tmp0, n, sft);
+      }
+      if ( neg ) {
+	for ( SizeType i = 0; i < n; ++ i ) {
+	  tmp1[i] = ~tmp1[i];
+	}
+      }
+      normalize(tmp1, bw);
+      copy_ext(dst, ow, tmp1, bw);
+    }
+    break;
+
+  case MvnNodeType::CMPL:
+    copy_ext(tmp0, ow, ival(0), iwidth(0));
+    for ( SizeType i = 0; i < on; ++ i ) {
+      tmp0[i] = ~tmp0[i];
+      tmp1[i] = 0ULL;
+    }
+    add_words(dst, tmp0, tmp1, on, 1ULL);
+    normalize(dst, ow);
+    break;
+
+  case MvnNodeType::ADD:
+    copy_ext(tmp0, ow, ival(0), iwidth(0));
+    copy_ext(tmp1, ow, ival(1), iwidth(1));
+    add_words(dst, tmp0, tmp1, on, 0ULL);
+    normalize(dst, ow);
+    break;
+
+  case MvnNodeType::SUB:
+    copy_ext(tmp0, ow, ival(0), iwidth(0));
+    copy_ext(tmp1, ow, ival(1), iwidth(1));
+    sub_words(dst, tmp0, tmp1, on);
+    normalize(dst, ow);
+    break;
+
+  case MvnNodeType::MUL:
+    copy_ext(tmp0, ow, ival(0), iwidth(0));
+    copy_ext(tmp1, ow, ival(1), iwidth(1));
+    mul_words(dst, tmp0, tmp1, on);
+    normalize(dst, ow);
+    break;
+
+  case MvnNodeType::DIV:
+  case MvnNodeType::MOD:
+    {
+      SizeType bw{std::max(std::max(iwidth(0), iwidth(1)), ow)};
+      copy_ext(tmp0, bw, ival(0), iwidth(0));
+      copy_ext(tmp1, bw, ival(1), iwidth(1));
+      divmod_words(tmp2, tmp3, tmp0, tmp1, bw);
+      if ( op.mType == MvnNodeType::DIV ) {
+	copy_ext(dst, ow, tmp2, bw);
+      }
+      else {
+	copy_ext(dst, ow, tmp3, bw);
+      }
+    }
+    break;
+
+  case MvnNodeType::POW:
+    {
+      // 二乗と乗算を繰り返す．
+      copy_ext(tmp0, ow, ival(0), iwidth(0));
+      for ( SizeType i = 0; i < on; ++ i ) {
+	tmp1[i] = 0ULL;
+      }
+      tmp1[0] = 1ULL;
+      auto ev{ival(1)};
+      SizeType ew{iwidth(1)};
+      SizeType last = 0;
+      for ( SizeType b = 0; b < ew; ++ b ) {
+	if ( get_bit(ev, b) ) {
+	  last = b + 1;
+	}
+      }
+      for ( SizeType b = 0; b < last; ++ b ) {
+	if ( get_bit(ev, b) ) {
+	  mul_words(tmp2, tmp1, tmp0, on);
+	  std::copy(tmp2, tmp2 + on, tmp1);
+	}
+	if ( b + 1 < last ) {
+	  mul_words(tmp2, tmp0, tmp0, on);
+	  std::copy(tmp2, tmp2 + on, tmp0);
+	}
+      }
+      copy_ext(dst, ow, tmp1, ow);
+    }
+    break;
+
+  case MvnNodeType::ITE:
+    if ( !is_zero(ival(0), iwidth(0)) ) {
+      copy_ext(dst, ow, ival(1), iwidth(1));
+    }
+    else {
+      copy_ext(dst, ow, ival(2), iwidth(2));
+    }
+    break;
+
+  case MvnNodeType::CONCAT:
+    {
+      // 最後の入力が LSB 側になる．
+      for ( SizeType i = 0; i < on; ++ i ) {
+	dst[i] = 0ULL;
+      }
+      SizeType pos = 0;
+      for ( SizeType j = op.mFaninNum; j > 0; -- j ) {
+	SizeType iw{iwidth(j - 1)};
+	or_bits(dst, on, pos, ival(j - 1), iw);
+	// 未接続の入力はビット幅 0 として扱われるので
+	// 本来のビット幅は出力から逆算できない．
+	// ここではファンインのビット幅を用いる．
+	pos += iw;
+      }
+      normalize(dst, ow);
+    }
+    break;
+
+  case MvnNodeType::CONSTBITSELECT:
+    {
+      SizeType iw{iwidth(0)};
+      if ( op.mAux < iw && get_bit(ival(0), op.mAux) ) {
+	dst[0] = 1ULL;
+      }
+      else {
+	dst[0] = 0ULL;
+      }
+    }
+    break;
+
+  case MvnNodeType::CONSTPARTSELECT:
+    {
+      auto src{ival(0)};
+      SizeType iw{iwidth(0)};
+      for ( SizeType i = 0; i < on; ++ i ) {
+	dst[i] = get_bits64(src, iw, op.mAux + i * 64);
+      }
+      normalize(dst, ow);
+    }
+    break;
+
+  case MvnNodeType::BITSELECT:
+    {
+      SizeType iw{iwidth(0)};
+      SizeType pos;
+      if ( get_uint(ival(1), iwidth(1), pos) && pos < iw ) {
+	dst[0] = get_bit(ival(0), pos) ? 1ULL : 0ULL;
+      }
+      else {
+	dst[0] = 0ULL;
+      }
+    }
+    break;
+
+  case MvnNodeType::PARTSELECT:
+    {
+      // 2番目の入力を LSB の位置とみなす．
+      auto src{ival(0)};
+      SizeType iw{iwidth(0)};
+      SizeType pos;
+      if ( get_uint(ival(1), iwidth(1), pos) && pos < iw ) {
+	for ( SizeType i = 0; i < on; ++ i ) {
+	  dst[i] = get_bits64(src, iw, pos + i * 64);
+	}
+	normalize(dst, ow);
+      }
+      else {
+	for ( SizeType i = 0; i < on; ++ i ) {
+	  dst[i] = 0ULL;
+	}
+      }
+    }
+    break;
+
+  case MvnNodeType::CELL:
+    if ( op.mAux == static_cast<SizeType>(-1) ) {
+      dst[0] = 0ULL;
+    }
+    else {
+      for ( SizeType i = 0; i < op.mFaninNum; ++ i ) {
+	cell_ivals[i] = ival(i)[0] & 1ULL;
+      }
+      dst[0] = mExprArray[op.mAux].eval(cell_ivals, 1ULL) & 1ULL;
+    }
+    break;
+
+  default:
+    ASSERT_NOT_REACHED;
+    break;
+  }
+}
+
+// @brief 非同期制御信号を反映させながら組み合わせ回路ノードを評価する．
+void
+SimNetwork::eval(
+  std::uint64_t* vals,
+  std::uint64_t* work,
+  vector<std::uint64_t>& cell_ivals
+) const
+{
+  eval_all(vals, work, cell_ivals);
+  SizeType limit{mDffList.size()};
+  for ( SizeType c = 0; c <= limit; ++ c ) {
+    if ( !apply_async(vals) ) {
+      break;
+    }
+    eval_all(vals, work, cell_ivals);
+  }
+}
+
+// @brief 値の変化したノードからイベントドリブンで評価する．
+void
+SimNetwork::eval_event(
+  std::uint64_t* vals,
+  std::uint64_t* work,
+  vector<std::uint64_t>& cell_ivals,
+  SimEventQueue& queue
+) const
+{
+  ASSERT_COND( !mHasLoop );
+
+  // eval_op() は作業領域の先頭 4 * mMaxWords ワードしか使わない．
+  auto old_val{work + mMaxWords * 5};
+  SizeType limit{mDffList.size()};
+  for ( SizeType c = 0; ; ++ c ) {
+    SizeType id;
+    while ( queue.get(id) ) {
+      auto& op{mOpList[mOpPosArray[id]]};
+      auto dst{vals + mOffsetArray[id]};
+      SizeType n{nwords(mWidthArray[id])};
+      std::copy(dst, dst + n, old_val);
+      eval_op(op, vals, work, cell_ivals);
+      if ( !std::equal(dst, dst + n, old_val) ) {
+	queue.add_changed(id);
+	put_fanouts(id, queue);
+      }
+    }
+    if ( c >= limit || !apply_async(vals, &queue) ) {
+      break;
+    }
+  }
+}
+
+// @brief アクティブな非同期制御信号を探す．
+const SimControl*
+SimNetwork::active_control(
+  const SimDff& dff,
+  const std::uint64_t* vals
+) const
+{
+  for ( SizeType i = 0; i < dff.mControlNum; ++ i ) {
+    auto& ctrl{mControlArray[dff.mControlBegin + i]};
+    bool val = (vals[mOffsetArray[ctrl.mId]] & 1ULL) != 0ULL;
+    if ( val == ctrl.mPositive ) {
+      return &ctrl;
+    }
+  }
+  return nullptr;
+}
+
+// @brief 非同期制御信号がアクティブな DFF の値を設定する．
+bool
+SimNetwork::apply_async(
+  std::uint64_t* vals,
+  SimEventQueue* queue
+) const
+{
+  bool changed = false;
+  for ( auto& dff: mDffList ) {
+    bool changed1 = false;
+    auto ctrl{active_control(dff, vals)};
+    if ( ctrl == nullptr ) {
+      continue;
+    }
+    SizeType bw{mWidthArray[dff.mId]};
+    SizeType n{nwords(bw)};
+    auto dst{vals + mOffsetArray[dff.mId]};
+    auto src{vals + mOffsetArray[ctrl->mValId]};
+    SizeType sw{mWidthArray[ctrl->mValId]};
+    SizeType sn{nwords(sw)};
+    for ( SizeType i = 0; i < n; ++ i ) {
+      std::uint64_t v = i < sn ? src[i] : 0ULL;
+      if ( i == n - 1 ) {
+	v &= last_mask(bw);
+      }
+      if ( dst[i] != v ) {
+	dst[i] = v;
+	changed1 = true;
+      }
+    }
+    if ( changed1 ) {
+      changed = true;
+      if ( queue != nullptr ) {
+	queue->add_changed(dff.mId);
+	put_fanouts(dff.mId, *queue);
+      }
+    }
+  }
+  return changed;
+}
+
+// @brief DFF の次状態を計算する．
+void
+SimNetwork::calc_next_state(
+  const std::uint64_t* vals,
+  std::uint64_t* next
+) const
+{
+  for ( auto& dff: mDffList ) {
+    SizeType bw{mWidthArray[dff.mId]};
+    auto ctrl{active_control(dff, vals)};
+    SizeType src_id = ctrl != nullptr ? ctrl->mValId : dff.mDataId;
+    copy_ext(next + dff.mNextOffset, bw,
+	     vals + mOffsetArray[src_id], mWidthArray[src_id]);
+  }
+}
+
+// @brief DFF の状態を次状態で置き換える．
+void
+SimNetwork::update_state(
+  std::uint64_t* vals,
+  const std::uint64_t* next,
+  SimEventQueue* queue
+) const
+{
+  for ( auto& dff: mDffList ) {
+    SizeType n{nwords(mWidthArray[dff.mId])};
+    auto src{next + dff.mNextOffset};
+    auto dst{vals + mOffsetArray[dff.mId]};
+    if ( queue != nullptr && !std::equal(src, src + n, dst) ) {
+      queue->add_changed(dff.mId);
+      put_fanouts(dff.mId, *queue);
+    }
+    std::copy(src, src + n, dst);
+  }
+}
+
+// @brief ノードの値を設定する．
+bool
+SimNetwork::set_value(
+  std::uint64_t* vals,
+  SizeType id,
+  const MvnBvConst& val
+) const
+{
+  SizeType bw{mWidthArray[id]};
+  auto dst{vals + mOffsetArray[id]};
+  SizeType n{nwords(bw)};
+  SizeType vw{std::min(bw, val.size())};
+  bool changed = false;
+  for ( SizeType i = 0; i < n; ++ i ) {
+    std::uint64_t v = 0ULL;
+    for ( SizeType b = i * 64; b < vw && b < (i + 1) * 64; ++ b ) {
+      if ( val[b] ) {
+	v |= (1ULL << (b % 64));
+      }
+    }
+    if ( dst[i] != v ) {
+      dst[i] = v;
+      changed = true;
+    }
+  }
+  return changed;
+}
+
+// @brief ノードの値を取り出す．
+MvnBvConst
+SimNetwork::get_value(
+  const std::uint64_t* vals,
+  SizeType id
+) const
+{
+  MvnBvConst val{mWidthArray[id]};
+  get_value(vals, id, val);
+  return val;
+}
+
+// @brief ノードの値を既存の MvnBvConst に取り出す．
+void
+SimNetwork::get_value(
+  const std::uint64_t* vals,
+  SizeType id,
+  MvnBvConst& val
+) const
+{
+  SizeType bw{mWidthArray[id]};
+  if ( val.size() != bw ) {
+    val = MvnBvConst{bw};
+  }
+  auto src{vals + mOffsetArray[id]};
+  for ( SizeType b = 0; b < bw; ++ b ) {
+    val.set_val(b, get_bit(src, b));
+  }
+}
+
+END_NAMESPACE_YM_MVN
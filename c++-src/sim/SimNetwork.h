@@ -0,0 +1,580 @@
+﻿#ifndef SIMNETWORK_H
+#define SIMNETWORK_H
+
+/// @file SimNetwork.h
+/// @brief SimNetwork のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/mvn.h"
+#include "ym/Expr.h"
+#include "SimEventQueue.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+/// @class SimOp SimNetwork.h "SimNetwork.h"
+/// @brief 組み合わせ回路ノード１つ分の評価情報
+//////////////////////////////////////////////////////////////////////
+struct SimOp
+{
+  // ノードの種類
+  MvnNodeType mType;
+
+  // 出力のノード番号
+  SizeType mId;
+
+  // ファンインの先頭位置 ( mFaninArray 上の位置 )
+  SizeType mFaninBegin;
+
+  // ファンイン数
+  SizeType mFaninNum;
+
+  // 補助情報1
+  // - CONSTBITSELECT: ビット位置
+  // - CONSTPARTSELECT: LSB
+  // - CASEEQ: Xマスクの mPoolArray 上の位置
+  // - CELL: 論理式の mExprArray 上の位置
+  SizeType mAux{0};
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class SimControl SimNetwork.h "SimNetwork.h"
+/// @brief DFF の非同期セット/リセット信号の情報
+//////////////////////////////////////////////////////////////////////
+struct SimControl
+{
+  // 制御信号のノード番号
+  SizeType mId;
+
+  // 正極性の時 true
+  bool mPositive;
+
+  // セットする値を表すノードの番号
+  SizeType mValId;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class SimDff SimNetwork.h "SimNetwork.h"
+/// @brief DFF １つ分の評価情報
+//////////////////////////////////////////////////////////////////////
+struct SimDff
+{
+  // DFF のノード番号
+  SizeType mId;
+
+  // データ入力のノード番号
+  SizeType mDataId;
+
+  // 非同期制御信号の先頭位置 ( mControlArray 上の位置 )
+  SizeType mControlBegin;
+
+  // 非同期制御信号の数
+  SizeType mControlNum;
+
+  // 次状態を格納する領域の先頭位置
+  SizeType mNextOffset;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class SimNetwork SimNetwork.h "SimNetwork.h"
+/// @brief MvnModule をシミュレーション用にコンパイルしたもの
+///
+/// ノードの値は 64 ビットワードの配列上に置かれ，ノード番号から
+/// 先頭位置を引く．この配列(値バッファ)は SimNetwork の外に置かれるので，
+/// 一つの SimNetwork を複数の値バッファで共有することができる．
+/// SimNetwork 自体は構築後に変更されない．
+///
+/// 値は常に正規化されており，ビット幅を超える上位ビットは 0 となっている．
+/// X/Z は扱わない(0 とみなす)．
+/// 0 除算の結果は 0 とする．
+//////////////////////////////////////////////////////////////////////
+class SimNetwork
+{
+public:
+
+  /// @brief コンストラクタ
+  SimNetwork(
+    const MvnMgr& mgr,      ///< [in] MvnMgr
+    const MvnModule* module ///< [in] 対象のモジュール
+  );
+
+  /// @brief デストラクタ
+  ~SimNetwork() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 構造に関する情報を取得する関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 対象のモジュールを返す．
+  const MvnModule*
+  module() const
+  {
+    return mModule;
+  }
+
+  /// @brief ノード番号の最大値 + 1 を返す．
+  SizeType
+  max_node_id() const
+  {
+    return mWidthArray.size() - 1;
+  }
+
+  /// @brief ノードのビット幅を返す．
+  SizeType
+  bit_width(
+    SizeType id ///< [in] ノード番号
+  ) const
+  {
+    return mWidthArray[id];
+  }
+
+  /// @brief ノードの値の先頭位置を返す．
+  SizeType
+  offset(
+    SizeType id ///< [in] ノード番号
+  ) const
+  {
+    return mOffsetArray[id];
+  }
+
+  /// @brief 値バッファのサイズ(ワード数)を返す．
+  SizeType
+  value_size() const
+  {
+    return mInitArray.size();
+  }
+
+  /// @brief 次状態バッファのサイズ(ワード数)を返す．
+  SizeType
+  next_size() const
+  {
+    return mNextSize;
+  }
+
+  /// @brief 作業領域のサイズ(ワード数)を返す．
+  SizeType
+  work_size() const
+  {
+    return mMaxWords * 6;
+  }
+
+  /// @brief セルの入力値用の作業領域のサイズ(要素数)を返す．
+  ///
+  /// セルノードのファンイン数の最大値となる．
+  SizeType
+  cell_input_size() const
+  {
+    return mMaxCellInput;
+  }
+
+  /// @brief 入力ノード番号のリストを返す．
+  const vector<SizeType>&
+  input_list() const
+  {
+    return mInputList;
+  }
+
+  /// @brief 出力ノード番号のリストを返す．
+  const vector<SizeType>&
+  output_list() const
+  {
+    return mOutputList;
+  }
+
+  /// @brief 入出力ノード番号のリストを返す．
+  const vector<SizeType>&
+  inout_list() const
+  {
+    return mInoutList;
+  }
+
+  /// @brief 定数ノード番号のリストを返す．
+  const vector<SizeType>&
+  const_list() const
+  {
+    return mConstList;
+  }
+
+  /// @brief 定数ノードの値を返す．
+  ///
+  /// 値バッファの初期値と同じ形式で bit_width(id) ビット分並んでいる．
+  const std::uint64_t*
+  const_value(
+    SizeType id ///< [in] ノード番号
+  ) const
+  {
+    return &mInitArray[mOffsetArray[id]];
+  }
+
+  /// @brief 組み合わせ回路ノードの評価情報のリストを返す．
+  ///
+  /// レベル順に並んでいる．
+  const vector<SimOp>&
+  op_list() const
+  {
+    return mOpList;
+  }
+
+  /// @brief DFF の評価情報のリストを返す．
+  const vector<SimDff>&
+  dff_list() const
+  {
+    return mDffList;
+  }
+
+  /// @brief ファンインのノード番号を返す．
+  ///
+  /// 接続されていない場合には max_node_id() を返す．
+  /// このノードのビット幅は 0 で，値は 0 として扱われる．
+  SizeType
+  fanin(
+    const SimOp& op, ///< [in] 対象の評価情報
+    SizeType pos     ///< [in] ファンイン番号
+  ) const
+  {
+    return mFaninArray[op.mFaninBegin + pos];
+  }
+
+  /// @brief 非同期制御信号の情報を返す．
+  const SimControl&
+  control(
+    const SimDff& dff, ///< [in] 対象の DFF
+    SizeType pos       ///< [in] 位置 ( 0 <= pos < dff.mControlNum )
+  ) const
+  {
+    return mControlArray[dff.mControlBegin + pos];
+  }
+
+  /// @brief ファンアウト数を返す．
+  ///
+  /// ファンアウトは dst_pin_list() から作られ，組み合わせ回路ノードのみを含む．
+  /// 多出力セルの場合，代表ノードと一緒に残りの出力ノードも含まれる．
+  SizeType
+  fanout_num(
+    SizeType id ///< [in] ノード番号
+  ) const
+  {
+    return mFanoutBegin[id + 1] - mFanoutBegin[id];
+  }
+
+  /// @brief ファンアウトのノード番号を返す．
+  SizeType
+  fanout(
+    SizeType id, ///< [in] ノード番号
+    SizeType pos ///< [in] 位置 ( 0 <= pos < fanout_num(id) )
+  ) const
+  {
+    return mFanoutArray[mFanoutBegin[id] + pos];
+  }
+
+  /// @brief 組み合わせ回路のループがある時 true を返す．
+  bool
+  has_loop() const
+  {
+    return mHasLoop;
+  }
+
+  /// @brief ループのために順序づけられなかったノード番号のリストを返す．
+  const vector<SizeType>&
+  loop_id_list() const
+  {
+    return mLoopIdList;
+  }
+
+  /// @brief ノードのレベルを返す．
+  SizeType
+  level(
+    SizeType id ///< [in] ノード番号
+  ) const
+  {
+    return mLevelArray[id];
+  }
+
+  /// @brief レベルの最大値を返す．
+  SizeType
+  max_level() const
+  {
+    return mMaxLevel;
+  }
+
+  /// @brief ノード番号から評価情報の位置を返す．
+  ///
+  /// 組み合わせ回路ノードでない場合は op_list().size() を返す．
+  SizeType
+  op_pos(
+    SizeType id ///< [in] ノード番号
+  ) const
+  {
+    return mOpPosArray[id];
+  }
+
+  /// @brief Xマスクなどの定数領域を返す．
+  const std::uint64_t*
+  pool(
+    SizeType pos ///< [in] 位置
+  ) const
+  {
+    return &mPoolArray[pos];
+  }
+
+  /// @brief セルの論理式を返す．
+  const Expr&
+  expr(
+    SizeType pos ///< [in] 位置
+  ) const
+  {
+    return mExprArray[pos];
+  }
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 値の評価を行う関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 値バッファを初期化する．
+  ///
+  /// 定数ノードの値を設定し，それ以外は 0 にする．
+  void
+  init_values(
+    std::uint64_t* vals ///< [in] 値バッファ
+  ) const;
+
+  /// @brief 組み合わせ回路ノードを一つ評価する．
+  void
+  eval_op(
+    const SimOp& op,                  ///< [in] 評価情報
+    std::uint64_t* vals,              ///< [in] 値バッファ
+    std::uint64_t* work,              ///< [in] 作業領域 ( work_size() ワード )
+    vector<std::uint64_t>& cell_ivals ///< [in] セルの入力値用の作業領域
+                                      ///<      ( cell_input_size() 要素 )
+  ) const;
+
+  /// @brief 組み合わせ回路ノードを全て評価する．
+  void
+  eval_all(
+    std::uint64_t* vals,              ///< [in] 値バッファ
+    std::uint64_t* work,              ///< [in] 作業領域 ( work_size() ワード )
+    vector<std::uint64_t>& cell_ivals ///< [in] セルの入力値用の作業領域
+                                      ///<      ( cell_input_size() 要素 )
+  ) const
+  {
+    for ( auto& op: mOpList ) {
+      eval_op(op, vals, work, cell_ivals);
+    }
+  }
+
+  /// @brief 非同期制御信号を反映させながら組み合わせ回路ノードを評価する．
+  ///
+  /// 非同期制御信号が DFF の出力に依存している場合に備えて
+  /// 値が落ち着くまで繰り返す．
+  void
+  eval(
+    std::uint64_t* vals,              ///< [in] 値バッファ
+    std::uint64_t* work,              ///< [in] 作業領域 ( work_size() ワード )
+    vector<std::uint64_t>& cell_ivals ///< [in] セルの入力値用の作業領域
+                                      ///<      ( cell_input_size() 要素 )
+  ) const;
+
+  /// @brief 値の変化したノードからイベントドリブンで評価する．
+  ///
+  /// queue に入っているノードをレベル順に評価し，
+  /// 値が変化したらファンアウトをキューに積む．
+  /// 値が変化したノードは queue に記録される．
+  /// 組み合わせ回路のループがある場合には用いてはいけない．
+  void
+  eval_event(
+    std::uint64_t* vals,               ///< [in] 値バッファ
+    std::uint64_t* work,               ///< [in] 作業領域 ( work_size() ワード )
+    vector<std::uint64_t>& cell_ivals, ///< [in] セルの入力値用の作業領域
+                                       ///<      ( cell_input_size() 要素 )
+    SimEventQueue& queue               ///< [in] イベントキュー
+  ) const;
+
+  /// @brief ノードのファンアウトをキューに積む．
+  void
+  put_fanouts(
+    SizeType id,         ///< [in] ノード番号
+    SimEventQueue& queue ///< [in] イベントキュー
+  ) const
+  {
+    SizeType end{mFanoutBegin[id + 1]};
+    for ( SizeType i = mFanoutBegin[id]; i < end; ++ i ) {
+      SizeType oid{mFanoutArray[i]};
+      queue.put(oid, mLevelArray[oid]);
+    }
+  }
+
+  /// @brief 非同期制御信号がアクティブな DFF の値を設定する．
+  /// @return 値が変化した DFF があったら true を返す．
+  ///
+  /// queue が nullptr でない場合は値が変化した DFF を記録して
+  /// そのファンアウトをキューに積む．
+  bool
+  apply_async(
+    std::uint64_t* vals,            ///< [in] 値バッファ
+    SimEventQueue* queue = nullptr  ///< [in] イベントキュー
+  ) const;
+
+  /// @brief DFF の次状態を計算する．
+  void
+  calc_next_state(
+    const std::uint64_t* vals, ///< [in] 値バッファ
+    std::uint64_t* next        ///< [in] 次状態バッファ ( next_size() ワード )
+  ) const;
+
+  /// @brief DFF の状態を次状態で置き換える．
+  ///
+  /// queue が nullptr でない場合は値が変化した DFF を記録して
+  /// そのファンアウトをキューに積む．
+  void
+  update_state(
+    std::uint64_t* vals,           ///< [in] 値バッファ
+    const std::uint64_t* next,     ///< [in] 次状態バッファ
+    SimEventQueue* queue = nullptr ///< [in] イベントキュー
+  ) const;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 値バッファと MvnBvConst の変換を行う関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ノードの値を設定する．
+  /// @return 値が変化した時 true を返す．
+  ///
+  /// val のビット幅が異なる場合は切り詰めるか 0 で拡張する．
+  bool
+  set_value(
+    std::uint64_t* vals,  ///< [in] 値バッファ
+    SizeType id,          ///< [in] ノード番号
+    const MvnBvConst& val ///< [in] 値
+  ) const;
+
+  /// @brief ノードの値を取り出す．
+  MvnBvConst
+  get_value(
+    const std::uint64_t* vals, ///< [in] 値バッファ
+    SizeType id                ///< [in] ノード番号
+  ) const;
+
+  /// @brief ノードの値を既存の MvnBvConst に取り出す．
+  ///
+  /// val のビット幅がノードと等しければ領域を再利用する．
+  void
+  get_value(
+    const std::uint64_t* vals, ///< [in] 値バッファ
+    SizeType id,               ///< [in] ノード番号
+    MvnBvConst& val            ///< [out] 値を格納する変数
+  ) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief アクティブな非同期制御信号を探す．
+  /// @return 見つからなかったら nullptr を返す．
+  const SimControl*
+  active_control(
+    const SimDff& dff,        ///< [in] 対象の DFF
+    const std::uint64_t* vals ///< [in] 値バッファ
+  ) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 対象のモジュール
+  const MvnModule* mModule;
+
+  // ノード番号をキーにしてビット幅を格納する配列
+  // 末尾の要素は未接続を表すダミー
+  vector<SizeType> mWidthArray;
+
+  // ノード番号をキーにして値の先頭位置を格納する配列
+  vector<SizeType> mOffsetArray;
+
+  // ノード番号をキーにしてレベルを格納する配列
+  vector<SizeType> mLevelArray;
+
+  // ノード番号をキーにして mOpList 上の位置を格納する配列
+  vector<SizeType> mOpPosArray;
+
+  // ノード番号をキーにしてファンアウトの先頭位置を格納する配列
+  vector<SizeType> mFanoutBegin;
+
+  // ファンアウトのノード番号の配列
+  vector<SizeType> mFanoutArray;
+
+  // 組み合わせ回路のループがある時 true にするフラグ
+  bool mHasLoop{false};
+
+  // ループのために順序づけられなかったノード番号のリスト
+  vector<SizeType> mLoopIdList;
+
+  // レベルの最大値
+  SizeType mMaxLevel{0};
+
+  // ノードのワード数の最大値
+  SizeType mMaxWords{1};
+
+  // セルノードのファンイン数の最大値
+  SizeType mMaxCellInput{0};
+
+  // 値バッファの初期値
+  vector<std::uint64_t> mInitArray;
+
+  // 入力ノード番号のリスト
+  vector<SizeType> mInputList;
+
+  // 出力ノード番号のリスト
+  vector<SizeType> mOutputList;
+
+  // 入出力ノード番号のリスト
+  vector<SizeType> mInoutList;
+
+  // 定数ノード番号のリスト
+  vector<SizeType> mConstList;
+
+  // 組み合わせ回路ノードの評価情報のリスト
+  vector<SimOp> mOpList;
+
+  // ファンインのノード番号の配列
+  vector<SizeType> mFaninArray;
+
+  // DFF の評価情報のリスト
+  vector<SimDff> mDffList;
+
+  // 非同期制御信号の配列
+  vector<SimControl> mControlArray;
+
+  // 次状態バッファのサイズ
+  SizeType mNextSize{0};
+
+  // Xマスクなどの定数領域
+  vector<std::uint64_t> mPoolArray;
+
+  // セルの論理式の配列
+  vector<Expr> mExprArray;
+
+};
+
+END_NAMESPACE_YM_MVN
+
+#endif // SIMNETWORK_H
@@ -0,0 +1,150 @@
+﻿
+/// @file BufferDir.cc
+/// @brief BufferDir の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "BufferDir.h"
+#include <fstream>
+#include <cstdlib>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+BEGIN_NAMESPACE_YM_MVN_VERILOG
+
+BEGIN_NONAMESPACE
+
+// 一時ディレクトリを作る場所を返す．
+string
+tmp_root()
+{
+  struct stat sbuf;
+  if ( stat("/dev/shm", &sbuf) == 0 && S_ISDIR(sbuf.st_mode) &&
+       access("/dev/shm", W_OK) == 0 ) {
+    return "/dev/shm";
+  }
+  auto tmpdir = getenv("TMPDIR");
+  if ( tmpdir != nullptr && tmpdir[0] != '\0' ) {
+    return tmpdir;
+  }
+  return "/tmp";
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス BufferDir
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+BufferDir::BufferDir()
+{
+  string tmpl{tmp_root() + "/mvn_vl_XXXXXX"};
+  vector<char> buf(tmpl.begin(), tmpl.end());
+  buf.push_back('\0');
+  if ( mkdtemp(buf.data()) == nullptr ) {
+    cerr << tmpl << ": could not create a temporary directory" << endl;
+    return;
+  }
+  // 開いたファイルのパスと比べられるように実際のパスにしておく．
+  auto real = realpath(buf.data(), nullptr);
+  if ( real != nullptr ) {
+    mDirName = real;
+    free(real);
+  }
+  else {
+    mDirName = buf.data();
+  }
+}
+
+// @brief デストラクタ
+BufferDir::~BufferDir()
+{
+  for ( auto p = mEntryList.rbegin(); p != mEntryList.rend(); ++ p ) {
+    const auto& path = p->first;
+    if ( p->second ) {
+      rmdir(path.c_str());
+    }
+    else {
+      unlink(path.c_str());
+    }
+  }
+  if ( is_valid() ) {
+    rmdir(mDirName.c_str());
+  }
+}
+
+// @brief ファイルを置く．
+bool
+BufferDir::put(
+  const string& name,
+  const string& text
+)
+{
+  if ( !is_valid() ) {
+    return false;
+  }
+  if ( !is_valid_name(name) ) {
+    cerr << name << ": illegal buffer name" << endl;
+    return false;
+  }
+
+  // 途中のディレクトリを作る．
+  SizeType start{0};
+  for ( ; ; ) {
+    auto pos = name.find('/', start);
+    if ( pos == string::npos ) {
+      break;
+    }
+    auto dir = path(name.substr(0, pos));
+    if ( mkdir(dir.c_str(), 0700) == 0 ) {
+      mEntryList.push_back({dir, true});
+    }
+    start = pos + 1;
+  }
+
+  auto filename = path(name);
+  std::ofstream s{filename, std::ios::binary};
+  if ( !s ) {
+    cerr << filename << ": could not create" << endl;
+    return false;
+  }
+  mEntryList.push_back({filename, false});
+  s.write(text.data(), text.size());
+  s.close();
+  if ( !s ) {
+    cerr << filename << ": could not write" << endl;
+    return false;
+  }
+  return true;
+}
+
+// @brief put() に与えられる名前の時 true を返す．
+bool
+BufferDir::is_valid_name(
+  const string& name
+)
+{
+  if ( name == string{} || name[0] == '/' ) {
+    return false;
+  }
+  SizeType start{0};
+  for ( ; ; ) {
+    auto pos = name.find('/', start);
+    auto elem = name.substr(start, pos == string::npos ? string::npos : pos - start);
+    if ( elem == ".." ) {
+      return false;
+    }
+    if ( pos == string::npos ) {
+      break;
+    }
+    start = pos + 1;
+  }
+  return true;
+}
+
+END_NAMESPACE_YM_MVN_VERILOG
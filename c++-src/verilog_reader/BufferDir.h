@@ -0,0 +1,109 @@
+﻿#ifndef BUFFERDIR_H
+#define BUFFERDIR_H
+
+/// @file BufferDir.h
+/// @brief BufferDir のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/mvn.h"
+
+
+BEGIN_NAMESPACE_YM_MVN_VERILOG
+
+//////////////////////////////////////////////////////////////////////
+/// @class BufferDir BufferDir.h "BufferDir.h"
+/// @brief メモリ上の内容をファイルとして見せるための一時ディレクトリ
+///
+/// VlMgr はファイル名からしか読み込めないので，
+/// メモリ上の内容を一時ディレクトリの中のファイルとして置く．
+/// つまり一時ファイルへの書き出しと読み戻しは避けられていない．
+/// 字句解析器に直接バッファを渡す API が ym-verilog に用意されれば
+/// このクラスは不要になる．
+/// 一時ディレクトリはメモリ上のファイルシステム(/dev/shm)があれば
+/// その中に作り，なければ $TMPDIR か /tmp の中に作る．
+/// デストラクタでディレクトリごと削除する．
+//////////////////////////////////////////////////////////////////////
+class BufferDir
+{
+public:
+
+  /// @brief コンストラクタ
+  ///
+  /// 一時ディレクトリを作る．
+  BufferDir();
+
+  /// @brief デストラクタ
+  ///
+  /// 作ったファイルと一時ディレクトリを削除する．
+  ~BufferDir();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 一時ディレクトリが作れた時 true を返す．
+  bool
+  is_valid() const
+  {
+    return mDirName != string{};
+  }
+
+  /// @brief 一時ディレクトリのパスを返す．
+  ///
+  /// シンボリックリンクを含まない絶対パスとなる．
+  const string&
+  dirname() const
+  {
+    return mDirName;
+  }
+
+  /// @brief ファイルを置く．
+  /// @return 置けた時 true を返す．
+  ///
+  /// name は一時ディレクトリからの相対パスで，'/' を含んでいてもよい．
+  /// 絶対パスや ".." を含むものはエラーとなる．
+  bool
+  put(
+    const string& name, ///< [in] ファイル名
+    const string& text  ///< [in] 内容
+  );
+
+  /// @brief put() に与えられる名前の時 true を返す．
+  static
+  bool
+  is_valid_name(
+    const string& name ///< [in] ファイル名
+  );
+
+  /// @brief ファイルのパスを返す．
+  string
+  path(
+    const string& name ///< [in] ファイル名
+  ) const
+  {
+    return mDirName + '/' + name;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 一時ディレクトリのパス
+  string mDirName;
+
+  // 作ったファイルとディレクトリのリスト
+  // 削除は逆順に行う．
+  vector<pair<string, bool>> mEntryList;
+
+};
+
+END_NAMESPACE_YM_MVN_VERILOG
+
+#endif // BUFFERDIR_H
@@ -0,0 +1,91 @@
+﻿
+/// @file FilePrefetcher.cc
+/// @brief FilePrefetcher の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "FilePrefetcher.h"
+#include <fstream>
+
+
+BEGIN_NAMESPACE_YM_MVN_VERILOG
+
+//////////////////////////////////////////////////////////////////////
+// クラス FilePrefetcher
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+FilePrefetcher::FilePrefetcher(
+  const vector<string>& filename_list,
+  const SearchPathList& searchpath,
+  SizeType thread_num,
+  SizeType lookahead
+) : mFilenameList{filename_list},
+    mSearchPath{searchpath},
+    mLookahead{lookahead}
+{
+  mThreadList.reserve(thread_num);
+  for ( SizeType i = 0; i < thread_num; ++ i ) {
+    mThreadList.push_back(std::thread{[this]() { worker(); }});
+  }
+}
+
+// @brief デストラクタ
+FilePrefetcher::~FilePrefetcher()
+{
+  {
+    std::lock_guard<std::mutex> lock{mMutex};
+    mStop = true;
+  }
+  mCond.notify_all();
+  for ( auto& th: mThreadList ) {
+    th.join();
+  }
+}
+
+// @brief 呼び出し側の読み込み位置を設定する．
+void
+FilePrefetcher::set_pos(
+  SizeType pos
+)
+{
+  {
+    std::lock_guard<std::mutex> lock{mMutex};
+    mPos = pos;
+  }
+  mCond.notify_all();
+}
+
+// @brief スレッドの本体
+void
+FilePrefetcher::worker()
+{
+  const SizeType BUFF_SIZE{1 << 16};
+  vector<char> buff(BUFF_SIZE);
+  SizeType n{mFilenameList.size()};
+  for ( ; ; ) {
+    SizeType idx;
+    {
+      std::unique_lock<std::mutex> lock{mMutex};
+      mCond.wait(lock, [&]() {
+	return mStop || mNext >= n || mNext < mPos + mLookahead;
+      });
+      if ( mStop || mNext >= n ) {
+	break;
+      }
+      idx = mNext;
+      ++ mNext;
+    }
+    // VlMgr と同じくサーチパス上のファイルを優先する．
+    auto& filename = mFilenameList[idx];
+    auto path = mSearchPath.search(PathName{filename});
+    std::ifstream s{path.is_valid() ? path.str() : filename, std::ios::binary};
+    while ( s ) {
+      s.read(buff.data(), BUFF_SIZE);
+    }
+  }
+}
+
+END_NAMESPACE_YM_MVN_VERILOG
@@ -0,0 +1,109 @@
+﻿#ifndef FILEPREFETCHER_H
+#define FILEPREFETCHER_H
+
+/// @file FilePrefetcher.h
+/// @brief FilePrefetcher のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/mvn.h"
+#include "ym/File.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+
+BEGIN_NAMESPACE_YM_MVN_VERILOG
+
+//////////////////////////////////////////////////////////////////////
+/// @class FilePrefetcher FilePrefetcher.h "FilePrefetcher.h"
+/// @brief ファイルの内容を先読みするクラス
+///
+/// バックグラウンドのスレッドでこれから読み込むファイルを読んでおき，
+/// OS のページキャッシュに載せておく．
+/// 読んだ内容は捨てるので，構文解析自体は呼び出し側で行う．
+/// 先読みは呼び出し側の位置から lookahead 個先のファイルまでに留める．
+/// ファイル名は VlMgr と同じくサーチパスから探す．
+/// 見つからないファイルや開けなかったファイルは無視する．
+//////////////////////////////////////////////////////////////////////
+class FilePrefetcher
+{
+public:
+
+  /// @brief コンストラクタ
+  ///
+  /// この時点で先読みを開始する．
+  FilePrefetcher(
+    const vector<string>& filename_list, ///< [in] ファイル名のリスト
+    const SearchPathList& searchpath,    ///< [in] サーチパス
+    SizeType thread_num,                 ///< [in] 先読みに用いるスレッド数
+    SizeType lookahead                   ///< [in] 先読みするファイル数の上限
+  );
+
+  /// @brief デストラクタ
+  ///
+  /// 先読みを中止してスレッドの終了を待つ．
+  ~FilePrefetcher();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 呼び出し側の読み込み位置を設定する．
+  void
+  set_pos(
+    SizeType pos ///< [in] これから読み込むファイルの位置
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief スレッドの本体
+  void
+  worker();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // ファイル名のリスト
+  const vector<string>& mFilenameList;
+
+  // サーチパス
+  const SearchPathList& mSearchPath;
+
+  // 先読みするファイル数の上限
+  SizeType mLookahead;
+
+  // 次に先読みするファイルの位置
+  SizeType mNext{0};
+
+  // 呼び出し側の読み込み位置
+  SizeType mPos{0};
+
+  // 中止フラグ
+  bool mStop{false};
+
+  // 排他制御用の mutex
+  std::mutex mMutex;
+
+  // 位置の変化を待つための条件変数
+  std::condition_variable mCond;
+
+  // スレッドのリスト
+  vector<std::thread> mThreadList;
+
+};
+
+END_NAMESPACE_YM_MVN_VERILOG
+
+#endif // FILEPREFETCHER_H
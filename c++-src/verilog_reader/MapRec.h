@@ -59,6 +59,13 @@ public:
   int
   get_array_offset() const = 0;
 
+  /// @brief 名前を返す．
+  ///
+  /// 配列要素の場合はインデックスを付けた名前を返す．
+  virtual
+  string
+  get_name() const = 0;
+
 };
 
 
@@ -112,6 +119,10 @@ public:
   int
   get_array_offset() const override;
 
+  /// @brief 名前を返す．
+  string
+  get_name() const override;
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -176,6 +187,10 @@ public:
   int
   get_array_offset() const override;
 
+  /// @brief 名前を返す．
+  string
+  get_name() const override;
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -190,6 +205,73 @@ private:
 
 };
 
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class NameMapRec MapRec.h "MapRec.h"
+/// @brief 名前のみを持つ MapRec
+//////////////////////////////////////////////////////////////////////
+class NameMapRec :
+  public MapRec
+{
+  friend class MvnVlMap;
+
+private:
+
+  /// @brief コンストラクタ
+  NameMapRec(
+    const string& name ///< [in] 名前
+  ) : mName{name}
+  {
+  }
+
+  /// @brief デストラクタ
+  ~NameMapRec() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // MapRec の仮想関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 宣言要素が単一要素の時に true を返す．
+  bool
+  is_single_elem() const override;
+
+  /// @brief 宣言要素が配列要素の時に true を返す．
+  bool
+  is_array_elem() const override;
+
+  /// @brief 宣言要素を返す．(単一要素版)
+  /// @note 常に nullptr が返される．
+  const VlDecl*
+  get_single_elem() const override;
+
+  /// @brief 宣言要素を返す．(配列要素版)
+  /// @note 常に nullptr が返される．
+  const VlDeclArray*
+  get_array_elem() const override;
+
+  /// @brief 宣言要素のオフセットを返す．(配列要素版)
+  /// @note 常に 0 が返される．
+  int
+  get_array_offset() const override;
+
+  /// @brief 名前を返す．
+  string
+  get_name() const override;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 名前
+  string mName;
+
+};
+
 END_NAMESPACE_YM_MVN
 
 #endif // MAPREC_H
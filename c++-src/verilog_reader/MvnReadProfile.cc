@@ -0,0 +1,84 @@
+﻿
+/// @file MvnReadProfile.cc
+/// @brief MvnReadProfile の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/MvnReadProfile.h"
+#include <iomanip>
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+// クラス MvnReadProfile
+//////////////////////////////////////////////////////////////////////
+
+// @brief 段階の開始を記録する．
+SizeType
+MvnReadProfile::begin_phase(
+  const string& name,
+  const string& module_name
+)
+{
+  SizeType pos{mRecList.size()};
+  mRecList.push_back(Rec{name, module_name, mLevel});
+  ++ mLevel;
+  return pos;
+}
+
+// @brief 段階の終了を記録する．
+void
+MvnReadProfile::end_phase(
+  SizeType pos,
+  double wall_time,
+  double cpu_time,
+  SizeType node_num,
+  std::int64_t rss_delta
+)
+{
+  ASSERT_COND( 0 <= pos && pos < phase_num() );
+  auto& rec = mRecList[pos];
+  rec.mWallTime = wall_time;
+  rec.mCpuTime = cpu_time;
+  rec.mNodeNum = node_num;
+  rec.mRssDelta = rss_delta;
+  -- mLevel;
+}
+
+// @brief 内容を表形式で出力する．
+void
+MvnReadProfile::print(
+  ostream& s
+) const
+{
+  using std::setw;
+  using std::left;
+  using std::right;
+  using std::fixed;
+  using std::setprecision;
+
+  s << left << setw(24) << "phase"
+    << setw(24) << "module"
+    << right << setw(12) << "wall(s)"
+    << setw(14) << "thread_cpu(s)"
+    << setw(12) << "nodes"
+    << setw(14) << "rss_diff(KB)" << endl;
+  for ( auto& rec: mRecList ) {
+    string name(rec.mLevel * 2, ' ');
+    name += rec.mName;
+    s << left << setw(24) << name
+      << setw(24) << rec.mModuleName
+      << right << fixed << setprecision(3)
+      << setw(12) << rec.mWallTime
+      << setw(14) << rec.mCpuTime
+      << setw(12) << rec.mNodeNum
+      << setw(14) << rec.mRssDelta << endl;
+  }
+  s.unsetf(std::ios::floatfield);
+  s << setprecision(6);
+}
+
+END_NAMESPACE_YM_MVN
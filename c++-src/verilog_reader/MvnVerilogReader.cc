@@ -46,6 +46,85 @@ MvnVerilogReader::read(
   return mImpl->read(filename, searchpath, watcher_list);
 }
 
+// @brief 複数の verilog 形式のファイルを読み込む．
+bool
+MvnVerilogReader::read(
+  const vector<string>& filename_list,
+  const SearchPathList& searchpath,
+  const vector<VlLineWatcher*> watcher_list
+)
+{
+  return mImpl->read(filename_list, searchpath, watcher_list);
+}
+
+// @brief メモリ上の verilog 記述を読み込む．
+bool
+MvnVerilogReader::read_buffer(
+  const string& name,
+  const string& text,
+  const vector<pair<string, string>>& include_list,
+  const SearchPathList& searchpath,
+  const vector<VlLineWatcher*> watcher_list
+)
+{
+  return mImpl->read_buffer(name, text, include_list, searchpath, watcher_list);
+}
+
+// @brief 先読みに用いるスレッド数を設定する．
+void
+MvnVerilogReader::set_prefetch_num(
+  SizeType prefetch_num
+)
+{
+  mImpl->set_prefetch_num(prefetch_num);
+}
+
+// @brief 先読みに用いるスレッド数を返す．
+SizeType
+MvnVerilogReader::prefetch_num() const
+{
+  return mImpl->prefetch_num();
+}
+
+// @brief 読み込み結果のキャッシュを置くディレクトリを設定する．
+void
+MvnVerilogReader::set_cache_dir(
+  const string& dirname
+)
+{
+  mImpl->set_cache_dir(dirname);
+}
+
+// @brief 読み込み結果のキャッシュを置くディレクトリを返す．
+const string&
+MvnVerilogReader::cache_dir() const
+{
+  return mImpl->cache_dir();
+}
+
+// @brief モジュールごとの計測を行うかどうかを設定する．
+void
+MvnVerilogReader::set_module_profile(
+  bool flag
+)
+{
+  mImpl->set_module_profile(flag);
+}
+
+// @brief モジュールごとの計測を行う時 true を返す．
+bool
+MvnVerilogReader::module_profile() const
+{
+  return mImpl->module_profile();
+}
+
+// @brief 直前の gen_network() の処理段階ごとの計測結果を返す．
+const MvnReadProfile&
+MvnVerilogReader::profile() const
+{
+  return mImpl->profile();
+}
+
 // @brief 今まで読み込んだ情報からネットワークを生成する．
 // @param[in] mgr ネットワーク生成用のマネージャ
 // @retval true 正常に処理を行った．
@@ -8,6 +8,9 @@
 
 #include "ym/MvnVlMap.h"
 #include "MapRec.h"
+#include "ym/vl/VlDecl.h"
+#include "ym/vl/VlDeclArray.h"
+#include "ym/vl/VlRange.h"
 
 
 BEGIN_NAMESPACE_YM_MVN
@@ -33,9 +36,12 @@ MvnVlMap::MvnVlMap(
       if ( src_rec->is_single_elem() ) {
 	reg_node(i, src_rec->get_single_elem());
       }
-      else {
+      else if ( src_rec->is_array_elem() ) {
 	reg_node(i, src_rec->get_array_elem(), src_rec->get_array_offset());
       }
+      else {
+	reg_node(i, src_rec->get_name());
+      }
     }
   }
 }
@@ -57,9 +63,12 @@ MvnVlMap::operator=(
 	if ( src_rec->is_single_elem() ) {
 	  reg_node(i, src_rec->get_single_elem());
 	}
-	else {
+	else if ( src_rec->is_array_elem() ) {
 	  reg_node(i, src_rec->get_array_elem(), src_rec->get_array_offset());
 	}
+	else {
+	  reg_node(i, src_rec->get_name());
+	}
       }
     }
   }
@@ -101,6 +110,17 @@ MvnVlMap::reg_node(
   put(id, unique_ptr<MapRec>{rec});
 }
 
+// @brief 名前のみを登録する．
+void
+MvnVlMap::reg_node(
+  SizeType id,
+  const string& name
+)
+{
+  auto rec{new NameMapRec(name)};
+  put(id, unique_ptr<MapRec>{rec});
+}
+
 // @brief src_id の内容を dst_id にコピーする．
 void
 MvnVlMap::move(
@@ -175,6 +195,19 @@ MvnVlMap::get_array_offset(
   return rec->get_array_offset();
 }
 
+// @brief id に対応する名前を返す．
+string
+MvnVlMap::get_name(
+  SizeType id
+) const
+{
+  auto rec{get(id)};
+  if ( rec == nullptr ) {
+    return string();
+  }
+  return rec->get_name();
+}
+
 // @brief 要素を設定する．
 void
 MvnVlMap::put(
@@ -182,10 +215,10 @@ MvnVlMap::put(
   unique_ptr<MapRec>&& elem
 )
 {
-  while ( mArray.size() < id ) {
-    mArray.push_back(nullptr);
+  if ( mArray.size() <= id ) {
+    mArray.resize(id + 1);
   }
-  mArray.push_back(std::move(elem));
+  mArray[id] = std::move(elem);
 }
 
 // @brief 要素を取り出す．
@@ -243,6 +276,13 @@ SingleMapRec::get_array_offset() const
   return 0;
 }
 
+// @brief 名前を返す．
+string
+SingleMapRec::get_name() const
+{
+  return mDecl->full_name();
+}
+
 
 //////////////////////////////////////////////////////////////////////
 // クラス ArrayMapRec
@@ -286,4 +326,72 @@ ArrayMapRec::get_array_offset() const
   return mOffset;
 }
 
+// @brief 名前を返す．
+string
+ArrayMapRec::get_name() const
+{
+  SizeType offset{mOffset};
+  SizeType d{mDeclArray->dimension()};
+  vector<int> index_array(d);
+  for ( SizeType i = 0; i < d; ++ i ) {
+    auto range{mDeclArray->range(i)};
+    SizeType n{range->size()};
+    index_array[i] = offset % n;
+    offset /= n;
+  }
+  ostringstream buf;
+  buf << mDeclArray->full_name();
+  for ( SizeType i = 0; i < d; ++ i ) {
+    buf << "[" << index_array[d - i - 1] << "]";
+  }
+  return buf.str();
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス NameMapRec
+//////////////////////////////////////////////////////////////////////
+
+// @brief 宣言要素が単一要素の時に true を返す．
+bool
+NameMapRec::is_single_elem() const
+{
+  return false;
+}
+
+// @brief 宣言要素が配列要素の時に true を返す．
+bool
+NameMapRec::is_array_elem() const
+{
+  return false;
+}
+
+// @brief 宣言要素を返す．(単一要素版)
+const VlDecl*
+NameMapRec::get_single_elem() const
+{
+  return nullptr;
+}
+
+// @brief 宣言要素を返す．(配列要素版)
+const VlDeclArray*
+NameMapRec::get_array_elem() const
+{
+  return nullptr;
+}
+
+// @brief 宣言要素のオフセットを返す．(配列要素版)
+int
+NameMapRec::get_array_offset() const
+{
+  return 0;
+}
+
+// @brief 名前を返す．
+string
+NameMapRec::get_name() const
+{
+  return mName;
+}
+
 END_NAMESPACE_YM_MVN
@@ -0,0 +1,99 @@
+﻿
+/// @file OpenFileWatcher.cc
+/// @brief OpenFileWatcher の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "OpenFileWatcher.h"
+#include <fstream>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+BEGIN_NAMESPACE_YM_MVN_VERILOG
+
+BEGIN_NONAMESPACE
+
+// fd が読み込み専用で開かれている時 true を返す．
+bool
+is_read_only(
+  const string& fd_name
+)
+{
+  std::ifstream s{"/proc/self/fdinfo/" + fd_name};
+  string key;
+  while ( s >> key ) {
+    if ( key == "flags:" ) {
+      int flags;
+      s >> std::oct >> flags;
+      return (flags & O_ACCMODE) == O_RDONLY;
+    }
+  }
+  return false;
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス OpenFileWatcher
+//////////////////////////////////////////////////////////////////////
+
+// @brief 新しい行に移った時に呼ばれる関数
+void
+OpenFileWatcher::event_proc(
+  int line
+)
+{
+  // 同じファイルの中では行番号は増え続けるので，
+  // 増えなかった時は別のファイルに移っている．
+  if ( line <= mLastLine || mLastLine == 0 ) {
+    scan();
+  }
+  mLastLine = line;
+}
+
+// @brief 開いているファイルを調べる．
+void
+OpenFileWatcher::scan()
+{
+  if ( !mValid ) {
+    return;
+  }
+  auto dir = opendir("/proc/self/fd");
+  if ( dir == nullptr ) {
+    mValid = false;
+    return;
+  }
+  char buf[4096];
+  for ( auto ent = readdir(dir); ent != nullptr; ent = readdir(dir) ) {
+    string fd_name{ent->d_name};
+    if ( fd_name == "." || fd_name == ".." ) {
+      continue;
+    }
+    auto link = "/proc/self/fd/" + fd_name;
+    auto n = readlink(link.c_str(), buf, sizeof(buf) - 1);
+    if ( n <= 0 || buf[0] != '/' ) {
+      continue;
+    }
+    string path{buf, static_cast<SizeType>(n)};
+    if ( mPathSet.count(path) > 0 ) {
+      continue;
+    }
+    struct stat sbuf;
+    if ( stat(link.c_str(), &sbuf) != 0 || !S_ISREG(sbuf.st_mode) ) {
+      continue;
+    }
+    if ( !is_read_only(fd_name) ) {
+      continue;
+    }
+    mPathSet.insert(path);
+  }
+  closedir(dir);
+}
+
+END_NAMESPACE_YM_MVN_VERILOG
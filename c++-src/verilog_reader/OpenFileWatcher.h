@@ -0,0 +1,105 @@
+﻿#ifndef OPENFILEWATCHER_H
+#define OPENFILEWATCHER_H
+
+/// @file OpenFileWatcher.h
+/// @brief OpenFileWatcher のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/mvn.h"
+#include "ym/VlLineWatcher.h"
+#include <set>
+
+
+BEGIN_NAMESPACE_YM_MVN_VERILOG
+
+//////////////////////////////////////////////////////////////////////
+/// @class OpenFileWatcher OpenFileWatcher.h "OpenFileWatcher.h"
+/// @brief VlMgr が実際に開いたファイルを記録する行番号ウォッチャー
+///
+/// VlMgr は開いたファイルの一覧を返す API を持たないので，
+/// 字句解析器が新しいファイルに移った時(行番号が増えなかった時)に
+/// /proc/self/fd を調べて読み込み専用で開かれている通常ファイルを記録する．
+/// `include の解決は `define や `ifdef，インクルード元からの相対パスを
+/// 含めて VlMgr 自身が行うので，その結果がそのまま得られる．
+/// 空のファイルは行が読まれないので記録されない．
+/// また，同じプロセスが他に開いているファイルが混ざることがあるが，
+/// 余分なファイルはキャッシュが使われにくくなるだけで結果は変わらない．
+/// パスは readlink() で得られる絶対パスとなる．
+/// /proc が使えない時は is_valid() が false になる．
+//////////////////////////////////////////////////////////////////////
+class OpenFileWatcher :
+  public VlLineWatcher
+{
+public:
+
+  /// @brief コンストラクタ
+  OpenFileWatcher() = default;
+
+  /// @brief デストラクタ
+  ~OpenFileWatcher() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 記録が有効な時 true を返す．
+  bool
+  is_valid() const
+  {
+    return mValid;
+  }
+
+  /// @brief 記録したファイルのパスのリストを返す．
+  const std::set<string>&
+  path_set() const
+  {
+    return mPathSet;
+  }
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // VlLineWatcher の仮想関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 新しい行に移った時に呼ばれる関数
+  void
+  event_proc(
+    int line ///< [in] 行番号
+  ) override;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 開いているファイルを調べる．
+  void
+  scan();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 直前の行番号
+  int mLastLine{0};
+
+  // 記録が有効な時 true にするフラグ
+  bool mValid{true};
+
+  // 記録したファイルのパスの集合
+  std::set<string> mPathSet;
+
+};
+
+END_NAMESPACE_YM_MVN_VERILOG
+
+#endif // OPENFILEWATCHER_H
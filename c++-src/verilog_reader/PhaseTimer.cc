@@ -0,0 +1,91 @@
+﻿
+/// @file PhaseTimer.cc
+/// @brief PhaseTimer の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "PhaseTimer.h"
+#include "ym/MvnReadProfile.h"
+#include "ym/MvnMgr.h"
+#include <fstream>
+#include <sys/resource.h>
+#include <unistd.h>
+
+
+BEGIN_NAMESPACE_YM_MVN_VERILOG
+
+//////////////////////////////////////////////////////////////////////
+// クラス PhaseTimer
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+PhaseTimer::PhaseTimer(
+  MvnReadProfile* profile,
+  const string& name,
+  const string& module_name,
+  const MvnMgr* mgr
+) : mProfile{profile},
+    mMgr{mgr}
+{
+  if ( mProfile == nullptr ) {
+    return;
+  }
+  mPos = mProfile->begin_phase(name, module_name);
+  if ( mMgr != nullptr ) {
+    mStartNode = mMgr->max_node_id();
+  }
+  mStartRss = current_rss();
+  mStartCpu = cpu_time();
+  mStartTime = std::chrono::steady_clock::now();
+}
+
+// @brief 計測を終了して記録する．
+void
+PhaseTimer::stop()
+{
+  if ( mProfile == nullptr ) {
+    return;
+  }
+  auto end_time = std::chrono::steady_clock::now();
+  double wall_time{std::chrono::duration<double>(end_time - mStartTime).count()};
+  double cpu{cpu_time() - mStartCpu};
+  SizeType node_num{0};
+  if ( mMgr != nullptr ) {
+    node_num = mMgr->max_node_id() - mStartNode;
+  }
+  mProfile->end_phase(mPos, wall_time, cpu, node_num,
+		      current_rss() - mStartRss);
+  mProfile = nullptr;
+}
+
+// @brief 呼び出したスレッドの現在の CPU 時間(秒)を返す．
+double
+PhaseTimer::cpu_time()
+{
+  struct rusage ru;
+#if defined(RUSAGE_THREAD)
+  getrusage(RUSAGE_THREAD, &ru);
+#else
+  getrusage(RUSAGE_SELF, &ru);
+#endif
+  return ru.ru_utime.tv_sec + ru.ru_stime.tv_sec +
+    (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) * 1.0e-6;
+}
+
+// @brief プロセスの現在の常駐メモリ量(KB)を返す．
+std::int64_t
+PhaseTimer::current_rss()
+{
+  // 2番目の値が常駐しているページ数
+  std::ifstream s{"/proc/self/statm"};
+  std::int64_t size;
+  std::int64_t resident;
+  if ( !(s >> size >> resident) ) {
+    return 0;
+  }
+  return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+END_NAMESPACE_YM_MVN_VERILOG
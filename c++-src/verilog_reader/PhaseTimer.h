@@ -0,0 +1,107 @@
+﻿#ifndef PHASETIMER_H
+#define PHASETIMER_H
+
+/// @file PhaseTimer.h
+/// @brief PhaseTimer のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/mvn.h"
+#include <chrono>
+
+
+BEGIN_NAMESPACE_YM_MVN_VERILOG
+
+//////////////////////////////////////////////////////////////////////
+/// @class PhaseTimer PhaseTimer.h "PhaseTimer.h"
+/// @brief 処理段階の計測を行って MvnReadProfile に記録するクラス
+///
+/// コンストラクタで計測を開始し，stop() かデストラクタで終了する．
+/// 途中で return した場合もデストラクタで記録される．
+/// profile に nullptr を与えた場合は何もしない．
+//////////////////////////////////////////////////////////////////////
+class PhaseTimer
+{
+public:
+
+  /// @brief コンストラクタ
+  PhaseTimer(
+    MvnReadProfile* profile,   ///< [in] 記録先
+    const string& name,        ///< [in] 段階名
+    const string& module_name, ///< [in] モジュール名
+    const MvnMgr* mgr          ///< [in] ノード数を数える対象
+                               ///<      (nullptr の場合もある)
+  );
+
+  /// @brief デストラクタ
+  ~PhaseTimer()
+  {
+    stop();
+  }
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 計測を終了して記録する．
+  ///
+  /// 2回目以降は何もしない．
+  void
+  stop();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 呼び出したスレッドの現在の CPU 時間(秒)を返す．
+  ///
+  /// 先読みなどの他のスレッドの分を含めないために RUSAGE_THREAD を用いる．
+  static
+  double
+  cpu_time();
+
+  /// @brief プロセスの現在の常駐メモリ量(KB)を返す．
+  ///
+  /// /proc/self/statm が読めない時は 0 を返す．
+  static
+  std::int64_t
+  current_rss();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 記録先
+  MvnReadProfile* mProfile;
+
+  // ノード数を数える対象
+  const MvnMgr* mMgr;
+
+  // 記録の位置番号
+  SizeType mPos{0};
+
+  // 開始時刻
+  std::chrono::steady_clock::time_point mStartTime;
+
+  // 開始時の CPU 時間
+  double mStartCpu{0.0};
+
+  // 開始時のノード数
+  SizeType mStartNode{0};
+
+  // 開始時の常駐メモリ量
+  std::int64_t mStartRss{0};
+
+};
+
+END_NAMESPACE_YM_MVN_VERILOG
+
+#endif // PHASETIMER_H
@@ -0,0 +1,276 @@
+﻿
+/// @file ReadCache.cc
+/// @brief ReadCache の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ReadCache.h"
+#include "ym/ClibCellLibrary.h"
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <unistd.h>
+
+
+BEGIN_NAMESPACE_YM_MVN_VERILOG
+
+BEGIN_NONAMESPACE
+
+// キーやエントリの形式が変わった時に変える．
+const char* CACHE_VERSION = "mvn_read_cache 2";
+
+// ファイルの内容を読み込む．
+bool
+read_text(
+  const string& filename,
+  string& text
+)
+{
+  std::ifstream s{filename, std::ios::binary};
+  if ( !s ) {
+    return false;
+  }
+  ostringstream buf;
+  buf << s.rdbuf();
+  text = buf.str();
+  return true;
+}
+
+// ファイルの内容のハッシュ値を計算する．
+bool
+file_digest(
+  const string& filename,
+  string& digest
+)
+{
+  std::ifstream s{filename, std::ios::binary};
+  if ( !s ) {
+    return false;
+  }
+  Sha256 h;
+  char buf[1 << 16];
+  while ( s ) {
+    s.read(buf, sizeof(buf));
+    h.update(buf, s.gcount());
+  }
+  if ( s.bad() ) {
+    return false;
+  }
+  digest = h.hex_digest();
+  return true;
+}
+
+// 一時ファイルに書き出してから名前を変える．
+//
+// 他のプロセスが書きかけのファイルを読まないようにするため．
+bool
+write_file(
+  const string& filename,
+  const string& text
+)
+{
+  ostringstream buf;
+  buf << filename << ".tmp" << getpid();
+  auto tmp_path = buf.str();
+  bool ok = false;
+  {
+    std::ofstream s{tmp_path, std::ios::binary};
+    if ( s ) {
+      s.write(text.data(), text.size());
+      s.close();
+      ok = static_cast<bool>(s);
+    }
+  }
+  if ( !ok || std::rename(tmp_path.c_str(), filename.c_str()) != 0 ) {
+    std::remove(tmp_path.c_str());
+    return false;
+  }
+  return true;
+}
+
+// ファイルを探す．
+//
+// VlMgr と同じくサーチパス上のファイルを優先する．
+// 見つからない時は空文字列を返す．
+string
+find_file(
+  const string& name,
+  const SearchPathList& searchpath
+)
+{
+  auto path = searchpath.search(PathName{name});
+  if ( path.is_valid() ) {
+    return path.str();
+  }
+  std::ifstream s{name};
+  if ( s ) {
+    return name;
+  }
+  return string{};
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス ReadCache
+//////////////////////////////////////////////////////////////////////
+
+// @brief キーの内容をクリアする．
+void
+ReadCache::clear()
+{
+  mHash = Sha256{};
+}
+
+// @brief ファイルの内容をキーに加える．
+bool
+ReadCache::add_file(
+  const string& filename,
+  const SearchPathList& searchpath
+)
+{
+  auto path = find_file(filename, searchpath);
+  string text;
+  if ( path == string{} || !read_text(path, text) ) {
+    return false;
+  }
+  add_str("file");
+  add_str(filename);
+  add_str(searchpath.to_string());
+  add_str(path);
+  add_str(text);
+  return true;
+}
+
+// @brief バッファの内容をキーに加える．
+void
+ReadCache::add_buffer(
+  const string& name,
+  const string& text,
+  const vector<pair<string, string>>& include_list,
+  const SearchPathList& searchpath
+)
+{
+  add_str("buffer");
+  add_str(name);
+  add_str(searchpath.to_string());
+  add_str(text);
+  for ( auto& p: include_list ) {
+    add_str("include_buffer");
+    add_str(p.first);
+    add_str(p.second);
+  }
+}
+
+// @brief キーを返す．
+string
+ReadCache::key(
+  const string& lib_digest
+) const
+{
+  if ( !is_enabled() ) {
+    return string{};
+  }
+
+  Sha256 h{mHash};
+  h.update(string{CACHE_VERSION} + '\n' + lib_digest);
+  return h.hex_digest();
+}
+
+// @brief キーに対応する有効なエントリを探す．
+string
+ReadCache::lookup(
+  const string& key
+) const
+{
+  if ( key == string{} ) {
+    return string{};
+  }
+
+  std::ifstream s{entry_path(key, ".deps")};
+  if ( !s ) {
+    return string{};
+  }
+  string line;
+  if ( !getline(s, line) || line != CACHE_VERSION ) {
+    return string{};
+  }
+  if ( !getline(s, line) || line != "key " + key ) {
+    return string{};
+  }
+  auto data_path = entry_path(key, ".mvnbin");
+  string digest;
+  if ( !getline(s, line) || !file_digest(data_path, digest) ||
+       line != "data " + digest ) {
+    return string{};
+  }
+  // 依存ファイルの行は "dep <ハッシュ値> <パス>" の形式
+  while ( getline(s, line) ) {
+    if ( line.size() < 4 + 64 + 1 + 1 || line.compare(0, 4, "dep ") != 0 ) {
+      return string{};
+    }
+    auto path = line.substr(4 + 64 + 1);
+    if ( !file_digest(path, digest) || line.compare(4, 64, digest) != 0 ) {
+      return string{};
+    }
+  }
+  return data_path;
+}
+
+// @brief エントリを保存する．
+bool
+ReadCache::save(
+  const string& key,
+  const string& data,
+  const std::set<string>& dep_set
+) const
+{
+  if ( key == string{} ) {
+    return false;
+  }
+
+  ostringstream buf;
+  buf << CACHE_VERSION << '\n'
+      << "key " << key << '\n'
+      << "data " << Sha256::digest(data) << '\n';
+  for ( auto& path: dep_set ) {
+    string digest;
+    if ( !file_digest(path, digest) ) {
+      return false;
+    }
+    buf << "dep " << digest << ' ' << path << '\n';
+  }
+
+  // 結果を先に置いておけば .deps が読めた時には結果も揃っている．
+  return write_file(entry_path(key, ".mvnbin"), data) &&
+    write_file(entry_path(key, ".deps"), buf.str());
+}
+
+// @brief セルライブラリの内容のハッシュ値を返す．
+string
+ReadCache::library_digest(
+  const ClibCellLibrary& library
+)
+{
+  ostringstream buf;
+  library.dump(buf);
+  return Sha256::digest(buf.str());
+}
+
+// @brief 文字列をキーに加える．
+void
+ReadCache::add_str(
+  const string& str
+)
+{
+  // 長さを先に加えて区切りを曖昧にしない．
+  ostringstream buf;
+  buf << str.size() << ':';
+  mHash.update(buf.str());
+  mHash.update(str);
+}
+
+END_NAMESPACE_YM_MVN_VERILOG
@@ -0,0 +1,177 @@
+﻿#ifndef READCACHE_H
+#define READCACHE_H
+
+/// @file ReadCache.h
+/// @brief ReadCache のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/mvn.h"
+#include "ym/File.h"
+#include "ym/clib.h"
+#include "Sha256.h"
+#include <set>
+
+
+BEGIN_NAMESPACE_YM_MVN_VERILOG
+
+//////////////////////////////////////////////////////////////////////
+/// @class ReadCache ReadCache.h "ReadCache.h"
+/// @brief 読み込み結果のキャッシュを管理するクラス
+///
+/// キーは読み込んだファイルとバッファの名前と内容，サーチパス，
+/// およびセルライブラリの内容(ClibCellLibrary::dump() の結果)から
+/// SHA-256 で計算する．
+/// `include で参照されるファイルはキーには含めず，
+/// 構文解析の際に VlMgr が実際に開いたファイル(OpenFileWatcher)を
+/// 内容のハッシュ値とともにキャッシュのエントリに記録しておく．
+/// キャッシュを用いる時にはキーが一致することに加えて
+/// 記録したファイルと結果のファイルのハッシュ値が一致することを確かめる．
+///
+/// エントリはキャッシュディレクトリ中の二つのファイルからなる．
+/// - <キー>.mvnbin: MvnBinWriter の形式の結果
+/// - <キー>.deps: キー，結果のハッシュ値，依存ファイルのリスト
+//////////////////////////////////////////////////////////////////////
+class ReadCache
+{
+public:
+
+  /// @brief コンストラクタ
+  ReadCache() = default;
+
+  /// @brief デストラクタ
+  ~ReadCache() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief キャッシュディレクトリを設定する．
+  ///
+  /// 空文字列の時はキャッシュを用いない．
+  void
+  set_dir(
+    const string& dirname ///< [in] ディレクトリ名
+  )
+  {
+    mDirName = dirname;
+  }
+
+  /// @brief キャッシュディレクトリを返す．
+  const string&
+  dir() const
+  {
+    return mDirName;
+  }
+
+  /// @brief キャッシュを用いる時 true を返す．
+  bool
+  is_enabled() const
+  {
+    return mDirName != string{};
+  }
+
+  /// @brief キーの内容をクリアする．
+  void
+  clear();
+
+  /// @brief ファイルの内容をキーに加える．
+  /// @return ファイルが見つかって読めた時 true を返す．
+  ///
+  /// ファイルはサーチパス上で探す．
+  bool
+  add_file(
+    const string& filename,          ///< [in] ファイル名
+    const SearchPathList& searchpath ///< [in] サーチパス
+  );
+
+  /// @brief バッファの内容をキーに加える．
+  void
+  add_buffer(
+    const string& name,                               ///< [in] 名前
+    const string& text,                               ///< [in] 内容
+    const vector<pair<string, string>>& include_list, ///< [in] `include で参照される
+                                                      ///<      (名前, 内容) のリスト
+    const SearchPathList& searchpath                  ///< [in] サーチパス
+  );
+
+  /// @brief キーを返す．
+  ///
+  /// キャッシュを用いない時は空文字列を返す．
+  string
+  key(
+    const string& lib_digest ///< [in] セルライブラリのハッシュ値
+                             ///<      (library_digest() の結果)
+  ) const;
+
+  /// @brief キーに対応する有効なエントリを探す．
+  /// @return 結果のファイルのパスを返す．
+  ///
+  /// エントリがないか，記録されたハッシュ値が一致しない時は
+  /// 空文字列を返す．
+  string
+  lookup(
+    const string& key ///< [in] キー
+  ) const;
+
+  /// @brief エントリを保存する．
+  /// @return 保存できた時 true を返す．
+  ///
+  /// 依存ファイルが読めなかった場合にはエントリを作らない．
+  bool
+  save(
+    const string& key,               ///< [in] キー
+    const string& data,              ///< [in] MvnBinWriter の形式の結果
+    const std::set<string>& dep_set  ///< [in] 依存ファイルのパスの集合
+  ) const;
+
+  /// @brief セルライブラリの内容のハッシュ値を返す．
+  static
+  string
+  library_digest(
+    const ClibCellLibrary& library ///< [in] セルライブラリ
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 文字列をキーに加える．
+  void
+  add_str(
+    const string& str ///< [in] 文字列
+  );
+
+  /// @brief エントリのファイルのパスを返す．
+  string
+  entry_path(
+    const string& key,   ///< [in] キー
+    const string& suffix ///< [in] 拡張子
+  ) const
+  {
+    return mDirName + "/" + key + suffix;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // キャッシュディレクトリ
+  string mDirName;
+
+  // キーを計算するためのハッシュ
+  Sha256 mHash;
+
+};
+
+END_NAMESPACE_YM_MVN_VERILOG
+
+#endif // READCACHE_H
@@ -10,6 +10,11 @@
 #include "DeclMap.h"
 #include "Driver.h"
 #include "Env.h"
+#include "FilePrefetcher.h"
+#include "OpenFileWatcher.h"
+#include "PhaseTimer.h"
+#include "ym/MvnBinReader.h"
+#include "ym/MvnBinWriter.h"
 #include "ym/MvnMgr.h"
 #include "ym/MvnModule.h"
 #include "ym/MvnPort.h"
@@ -55,6 +60,12 @@ void
 ReaderImpl::clear()
 {
   mVlMgr.clear();
+  mCache.clear();
+  mReadList.clear();
+  mParsedNum = 0;
+  mDepSet.clear();
+  mDepValid = true;
+  mBufferDirList.clear();
 }
 
 // @brief verilog 形式のファイルを読み込む．
@@ -70,9 +81,119 @@ ReaderImpl::read(
   const vector<VlLineWatcher*> watcher_list
 )
 {
+  if ( mCache.is_enabled() ) {
+    // キャッシュを用いる時は構文解析を gen_network() まで遅らせる．
+    // ファイルが見つからない場合はキャッシュを用いない場合と同じく
+    // ここでエラーとする．
+    if ( !mCache.add_file(filename, searchpath) ) {
+      MsgMgr::put_msg(__FILE__, __LINE__,
+		      FileRegion(),
+		      MsgType::Failure,
+		      "MVN_VL",
+		      filename + ": No such file.");
+      return false;
+    }
+    mReadList.push_back(ReadRec{false, filename, string{}, {},
+				searchpath, watcher_list});
+    return true;
+  }
   return mVlMgr.read_file(filename, searchpath, watcher_list);
 }
 
+// @brief 複数の verilog 形式のファイルを読み込む．
+bool
+ReaderImpl::read(
+  const vector<string>& filename_list,
+  const SearchPathList& searchpath,
+  const vector<VlLineWatcher*> watcher_list
+)
+{
+  if ( mCache.is_enabled() ) {
+    for ( auto& filename: filename_list ) {
+      if ( !read(filename, searchpath, watcher_list) ) {
+	return false;
+      }
+    }
+    return true;
+  }
+
+  // VlMgr は構文解析の結果を内部で共有しているので
+  // 構文解析自体はこのスレッドで順に行う．
+  // 先読み用のスレッドでは後続のファイルを読んでページキャッシュに載せておき，
+  // ファイルの読み込み待ちと構文解析を重ねる．
+  SizeType n{filename_list.size()};
+  SizeType nt{std::min(mPrefetchNum, n)};
+  FilePrefetcher prefetcher{filename_list, searchpath, nt, nt * 4};
+  for ( SizeType i = 0; i < n; ++ i ) {
+    prefetcher.set_pos(i);
+    if ( !mVlMgr.read_file(filename_list[i], searchpath, watcher_list) ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// @brief メモリ上の verilog 記述を読み込む．
+bool
+ReaderImpl::read_buffer(
+  const string& name,
+  const string& text,
+  const vector<pair<string, string>>& include_list,
+  const SearchPathList& searchpath,
+  const vector<VlLineWatcher*> watcher_list
+)
+{
+  if ( mCache.is_enabled() ) {
+    // 一時ファイルを作れない名前はここでエラーとする．
+    if ( !BufferDir::is_valid_name(name) ) {
+      cerr << name << ": illegal buffer name" << endl;
+      return false;
+    }
+    for ( auto& p: include_list ) {
+      if ( !BufferDir::is_valid_name(p.first) ) {
+	cerr << p.first << ": illegal buffer name" << endl;
+	return false;
+      }
+    }
+    mCache.add_buffer(name, text, include_list, searchpath);
+    mReadList.push_back(ReadRec{true, name, text, include_list,
+				searchpath, watcher_list});
+    return true;
+  }
+  return read_buffer_sub(name, text, include_list, searchpath, watcher_list);
+}
+
+// @brief read_buffer() の本体
+bool
+ReaderImpl::read_buffer_sub(
+  const string& name,
+  const string& text,
+  const vector<pair<string, string>>& include_list,
+  const SearchPathList& searchpath,
+  const vector<VlLineWatcher*> watcher_list
+)
+{
+  // VlMgr はファイル名からしか読み込めないので
+  // メモリ上の一時ディレクトリに置いてから読み込む．
+  // メッセージ中のファイル名がこのディレクトリを指すので
+  // ディレクトリは clear() かデストラクタまで残しておく．
+  mBufferDirList.push_back(unique_ptr<BufferDir>{new BufferDir});
+  auto& dir = *mBufferDirList.back();
+  if ( !dir.put(name, text) ) {
+    return false;
+  }
+  for ( auto& p: include_list ) {
+    if ( !dir.put(p.first, p.second) ) {
+      return false;
+    }
+  }
+  // `include の名前が一時ディレクトリから見つかるように
+  // サーチパスの先頭に加える．
+  SearchPathList searchpath1{searchpath};
+  searchpath1.add_top(dir.dirname());
+  return mVlMgr.read_file(dir.path(name), searchpath1, watcher_list);
+}
+
 // @brief 今まで読み込んだ情報からネットワークを生成する．
 // @param[in] mgr ネットワーク生成用のマネージャ
 // @retval true 正常に処理を行った．
@@ -83,12 +204,126 @@ ReaderImpl::gen_network(
   const ClibCellLibrary& cell_library,
   MvnVlMap& node_map
 )
+{
+  mProfile.clear();
+  PhaseTimer total_timer{&mProfile, "gen_network", string{}, &mgr};
+
+  if ( !mCache.is_enabled() ) {
+    return gen_network_sub(mgr, cell_library, node_map);
+  }
+
+  // キャッシュを用いない場合と同じく，それまでにエラーがあれば失敗とする．
+  if ( MsgMgr::error_num() > 0 ) {
+    return false;
+  }
+
+  // キャッシュの結果のセルは mgr のセルライブラリから探されるので
+  // それが cell_library と同じ内容の時のみキャッシュを用いる．
+  auto lib_digest = ReadCache::library_digest(cell_library);
+  auto key = mCache.key(lib_digest);
+  auto cache_path = mCache.lookup(key);
+  if ( cache_path != string{} &&
+       ReadCache::library_digest(mgr.library()) == lib_digest ) {
+    SizeType nm{mgr.max_module_id()};
+    PhaseTimer load_timer{&mProfile, "cache_load", string{}, &mgr};
+    MvnBinReader bin_reader;
+    if ( bin_reader.read(cache_path, mgr, node_map) ) {
+      return true;
+    }
+    load_timer.stop();
+    cerr << cache_path << ": broken cache file" << endl;
+    if ( mgr.max_module_id() != nm ) {
+      // 途中まで読み込んでしまった．
+      return false;
+    }
+  }
+
+  // まだ VlMgr に渡していない読み込みを行う．
+  // その際に VlMgr が実際に開いたファイルを記録しておく．
+  PhaseTimer parse_timer{&mProfile, "parse", string{}, nullptr};
+  OpenFileWatcher file_watcher;
+  for ( ; mParsedNum < mReadList.size(); ++ mParsedNum ) {
+    auto& rec = mReadList[mParsedNum];
+    auto watcher_list{rec.mWatcherList};
+    watcher_list.push_back(&file_watcher);
+    bool stat;
+    if ( rec.mIsBuffer ) {
+      stat = read_buffer_sub(rec.mName, rec.mText, rec.mIncludeList,
+			     rec.mSearchPath, watcher_list);
+    }
+    else {
+      stat = mVlMgr.read_file(rec.mName, rec.mSearchPath, watcher_list);
+    }
+    if ( !stat ) {
+      ++ mParsedNum;
+      return false;
+    }
+  }
+  parse_timer.stop();
+  if ( file_watcher.is_valid() ) {
+    // バッファの一時ファイルの内容はキーに含まれているので除く．
+    for ( auto& path: file_watcher.path_set() ) {
+      bool buffer = false;
+      for ( auto& dir: mBufferDirList ) {
+	auto& dirname = dir->dirname();
+	if ( path.compare(0, dirname.size(), dirname) == 0 &&
+	     path.size() > dirname.size() && path[dirname.size()] == '/' ) {
+	  buffer = true;
+	  break;
+	}
+      }
+      if ( !buffer ) {
+	mDepSet.insert(path);
+      }
+    }
+  }
+  else {
+    mDepValid = false;
+  }
+
+  if ( !gen_network_sub(mgr, cell_library, node_map) ) {
+    return false;
+  }
+
+  // キャッシュから読み込んだ場合と同じ結果になるように
+  // node_map を名前のみの対応表にする．
+  MvnVlMap name_map;
+  SizeType n{mgr.max_node_id()};
+  for ( SizeType id = 0; id < n; ++ id ) {
+    auto name = node_map.get_name(id);
+    if ( name != string{} ) {
+      name_map.reg_node(id, name);
+    }
+  }
+  node_map = name_map;
+
+  if ( mDepValid ) {
+    PhaseTimer save_timer{&mProfile, "cache_save", string{}, nullptr};
+    ostringstream buf;
+    MvnBinWriter bin_writer;
+    bin_writer(buf, mgr, node_map);
+    if ( !mCache.save(key, buf.str(), mDepSet) ) {
+      cerr << mCache.dir() << ": could not write the cache entry" << endl;
+    }
+  }
+  return true;
+}
+
+// @brief キャッシュを用いない場合の gen_network() の本体
+bool
+ReaderImpl::gen_network_sub(
+  MvnMgr& mgr,
+  const ClibCellLibrary& cell_library,
+  MvnVlMap& node_map
+)
 {
   if ( MsgMgr::error_num() > 0 ) {
     return false;
   }
 
+  PhaseTimer elab_timer{&mProfile, "elaborate", string{}, nullptr};
   mVlMgr.elaborate(cell_library);
+  elab_timer.stop();
 
   if ( MsgMgr::error_num() > 0 ) {
     return false;
@@ -102,6 +337,7 @@ ReaderImpl::gen_network(
   mNodeMap.clear();
   mDriverList.clear();
 
+  PhaseTimer gen_timer{&mProfile, "gen_module", string{}, mMvnMgr};
   MvnModule* module0 = nullptr;
   const auto& tmp_list(mVlMgr.topmodule_list());
   for ( auto& vl_module: tmp_list ) {
@@ -125,7 +361,10 @@ ReaderImpl::gen_network(
     }
   }
 
+  gen_timer.stop();
+
   // 結線を行う．
+  PhaseTimer connect_timer{&mProfile, "connect", string{}, mMvnMgr};
   SizeType n{mMvnMgr->max_node_id()};
   for ( SizeType i = 0; i < n; ++ i ) {
     auto node = mMvnMgr->_node(i);
@@ -237,8 +476,12 @@ ReaderImpl::gen_network(
     }
   }
 
+  connect_timer.stop();
+
   // 冗長な through ノードを削除する．
+  PhaseTimer sweep_timer{&mProfile, "sweep", string{}, mMvnMgr};
   mMvnMgr->sweep();
+  sweep_timer.stop();
 
   node_map = mNodeMap;
 
@@ -324,16 +567,22 @@ ReaderImpl::gen_module(
   }
 
   // 宣言要素を生成する．
+  PhaseTimer decl_timer{module_profile_target(), "decl",
+			vl_module->full_name(), mMvnMgr};
   bool stat = gen_decl(module, vl_module);
   if ( !stat ) {
     return nullptr;
   }
+  decl_timer.stop();
 
   // 要素を生成する．
+  PhaseTimer item_timer{module_profile_target(), "item",
+			vl_module->full_name(), mMvnMgr};
   stat = gen_item(module, vl_module);
   if ( !stat ) {
     return nullptr;
   }
+  item_timer.stop();
 
   // ポートの接続を行う．
   for ( SizeType i = 0; i < np; ++ i ) {
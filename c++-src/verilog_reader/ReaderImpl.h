@@ -10,12 +10,15 @@
 
 #include "ym/mvn.h"
 #include "ym/MvnVlMap.h"
+#include "ym/MvnReadProfile.h"
 #include "ym/VlMgr.h"
 #include "ym/vl/VlFwd.h"
 #include "DeclHash.h"
 #include "DeclMap.h"
 #include "Driver.h"
 #include "Env.h"
+#include "BufferDir.h"
+#include "ReadCache.h"
 
 
 BEGIN_NAMESPACE_YM_MVN_VERILOG
@@ -56,6 +59,95 @@ public:
     const vector<VlLineWatcher*> watcher_list = vector<VlLineWatcher*>()
   );
 
+  /// @brief 複数の verilog 形式のファイルを読み込む．
+  /// @retval true 正常に読み込めた．
+  /// @retval false 読込中にエラーが起こった．
+  ///
+  /// ファイルはリストの順に読み込み，エラーが起きた時点で中断する．
+  /// 先読み用のスレッドが指定されている時は後続のファイルを先読みする．
+  bool
+  read(
+    const vector<string>& filename_list,      ///< [in] ファイル名のリスト
+    const SearchPathList& searchpath          ///< [in] サーチパス
+    = SearchPathList(),
+    const vector<VlLineWatcher*> watcher_list ///< [in] 行番号ウォッチャーのリスト
+    = vector<VlLineWatcher*>()
+  );
+
+  /// @brief メモリ上の verilog 記述を読み込む．
+  /// @retval true 正常に読み込めた．
+  /// @retval false 読込中にエラーが起こった．
+  bool
+  read_buffer(
+    const string& name,                               ///< [in] 名前
+    const string& text,                               ///< [in] verilog 記述
+    const vector<pair<string, string>>& include_list, ///< [in] `include で参照される
+                                                      ///<      (名前, 内容) のリスト
+    const SearchPathList& searchpath,                 ///< [in] サーチパス
+    const vector<VlLineWatcher*> watcher_list         ///< [in] 行番号ウォッチャーのリスト
+  );
+
+  /// @brief 先読みに用いるスレッド数を設定する．
+  ///
+  /// 0 の時は先読みを行わない．
+  void
+  set_prefetch_num(
+    SizeType prefetch_num ///< [in] スレッド数
+  )
+  {
+    mPrefetchNum = prefetch_num;
+  }
+
+  /// @brief 先読みに用いるスレッド数を返す．
+  SizeType
+  prefetch_num() const
+  {
+    return mPrefetchNum;
+  }
+
+  /// @brief キャッシュディレクトリを設定する．
+  ///
+  /// 空文字列の時はキャッシュを用いない．
+  /// 設定した時点で読み込み済みの内容はキーに含まれないので
+  /// 読み込みの前に設定する必要がある．
+  void
+  set_cache_dir(
+    const string& dirname ///< [in] ディレクトリ名
+  )
+  {
+    mCache.set_dir(dirname);
+  }
+
+  /// @brief キャッシュディレクトリを返す．
+  const string&
+  cache_dir() const
+  {
+    return mCache.dir();
+  }
+
+  /// @brief モジュールごとの計測を行うかどうかを設定する．
+  void
+  set_module_profile(
+    bool flag ///< [in] true の時モジュールごとの計測を行う．
+  )
+  {
+    mModuleProfile = flag;
+  }
+
+  /// @brief モジュールごとの計測を行う時 true を返す．
+  bool
+  module_profile() const
+  {
+    return mModuleProfile;
+  }
+
+  /// @brief 直前の gen_network() の計測結果を返す．
+  const MvnReadProfile&
+  profile() const
+  {
+    return mProfile;
+  }
+
   /// @brief 今まで読み込んだ情報からネットワークを生成する．
   /// @param[in] mgr ネットワーク生成用のマネージャ
   /// @param[in] cell_library セルライブラリ
@@ -75,6 +167,34 @@ private:
   // 内部で用いられる下請け関数
   //////////////////////////////////////////////////////////////////////
 
+  /// @brief read_buffer() の本体
+  bool
+  read_buffer_sub(
+    const string& name,                               ///< [in] 名前
+    const string& text,                               ///< [in] verilog 記述
+    const vector<pair<string, string>>& include_list, ///< [in] `include で参照される
+                                                      ///<      (名前, 内容) のリスト
+    const SearchPathList& searchpath,                 ///< [in] サーチパス
+    const vector<VlLineWatcher*> watcher_list         ///< [in] 行番号ウォッチャーのリスト
+  );
+
+  /// @brief キャッシュを用いない場合の gen_network() の本体
+  bool
+  gen_network_sub(
+    MvnMgr& mgr,                         ///< [in] ネットワーク生成用のマネージャ
+    const ClibCellLibrary& cell_library, ///< [in] セルライブラリ
+    MvnVlMap& node_map                   ///< [out] MvnNode と宣言要素の対応付けを保持する配列
+  );
+
+  /// @brief モジュールごとの計測結果の記録先を返す．
+  ///
+  /// 計測を行わない場合は nullptr を返す．
+  MvnReadProfile*
+  module_profile_target()
+  {
+    return mModuleProfile ? &mProfile : nullptr;
+  }
+
   /// @brief module を生成する．
   /// @param[in] vl_module 対象のモジュール
   MvnModule*
@@ -460,6 +580,61 @@ private:
   // VlDecl のドライバーのリスト
   vector<vector<Driver> > mDriverList;
 
+  // 先読みに用いるスレッド数
+  SizeType mPrefetchNum{0};
+
+  // キャッシュを用いる時の読み込みの記録
+  struct ReadRec
+  {
+    // バッファの時 true
+    bool mIsBuffer;
+
+    // ファイル名かバッファの名前
+    string mName;
+
+    // バッファの内容
+    string mText;
+
+    // `include で参照されるバッファのリスト
+    vector<pair<string, string>> mIncludeList;
+
+    // サーチパス
+    SearchPathList mSearchPath;
+
+    // 行番号ウォッチャーのリスト
+    vector<VlLineWatcher*> mWatcherList;
+  };
+
+  // 読み込み結果のキャッシュ
+  ReadCache mCache;
+
+  // キャッシュを用いる時の clear() 以降の読み込みのリスト
+  vector<ReadRec> mReadList;
+
+  // mReadList のうち VlMgr に渡した読み込みの数
+  //
+  // キャッシュから読み込んだ場合には VlMgr には何も渡さないので
+  // 後でキャッシュが使えなかった時にはここから続けて読み込む．
+  SizeType mParsedNum{0};
+
+  // VlMgr が実際に開いたファイルのパスの集合
+  std::set<string> mDepSet;
+
+  // mDepSet が正しく記録できている時 true にするフラグ
+  bool mDepValid{true};
+
+  // read_buffer() で作った一時ディレクトリのリスト
+  //
+  // VlMgr の持つファイル位置情報から参照されるので
+  // clear() かデストラクタまで残しておく．
+  vector<unique_ptr<BufferDir>> mBufferDirList;
+
+  // gen_network() の計測結果
+  MvnReadProfile mProfile;
+
+  // モジュールごとの計測を行う時 true にするフラグ
+  bool mModuleProfile{false};
+
 };
 
 END_NAMESPACE_YM_MVN_VERILOG
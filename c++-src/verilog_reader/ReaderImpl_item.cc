@@ -12,6 +12,7 @@
 #include "Env.h"
 #include "EnvMerger.h"
 #include "AsyncControl.h"
+#include "PhaseTimer.h"
 #include "ym/MvnMgr.h"
 #include "ym/MvnNode.h"
 #include "ym/BitVector.h"
@@ -501,16 +502,22 @@ ReaderImpl::gen_moduleinst(
 )
 {
   // 宣言要素を生成する．
+  PhaseTimer decl_timer{module_profile_target(), "decl",
+			vl_module->full_name(), mMvnMgr};
   bool stat = gen_decl(parent_module, vl_module);
   if ( !stat ) {
     return;
   }
+  decl_timer.stop();
 
   // 要素を生成する．
+  PhaseTimer item_timer{module_profile_target(), "item",
+			vl_module->full_name(), mMvnMgr};
   stat = gen_item(parent_module, vl_module);
   if ( !stat ) {
     return;
   }
+  item_timer.stop();
 
   // ポートの接続を行う．
   SizeType np{vl_module->port_num()};
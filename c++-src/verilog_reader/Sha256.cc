@@ -0,0 +1,172 @@
+﻿
+/// @file Sha256.cc
+/// @brief Sha256 の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "Sha256.h"
+#include <cstring>
+
+
+BEGIN_NAMESPACE_YM_MVN_VERILOG
+
+BEGIN_NONAMESPACE
+
+// ラウンド定数
+const std::uint32_t K[64] = {
+  0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+  0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+  0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+  0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+  0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+  0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+  0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+  0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+  0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+  0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+  0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+  0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+  0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+  0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+  0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+  0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+inline
+std::uint32_t
+rotr(
+  std::uint32_t x,
+  int n
+)
+{
+  return (x >> n) | (x << (32 - n));
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス Sha256
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+Sha256::Sha256() :
+  mState{0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+	 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19}
+{
+}
+
+// @brief データを加える．
+void
+Sha256::update(
+  const char* data,
+  SizeType size
+)
+{
+  auto p = reinterpret_cast<const std::uint8_t*>(data);
+  mTotalSize += size;
+  if ( mBlockSize > 0 ) {
+    SizeType n = std::min(size, 64 - mBlockSize);
+    std::memcpy(mBlock + mBlockSize, p, n);
+    mBlockSize += n;
+    p += n;
+    size -= n;
+    if ( mBlockSize < 64 ) {
+      return;
+    }
+    process_block(mBlock);
+    mBlockSize = 0;
+  }
+  for ( ; size >= 64; p += 64, size -= 64 ) {
+    process_block(p);
+  }
+  std::memcpy(mBlock, p, size);
+  mBlockSize = size;
+}
+
+// @brief ハッシュ値を 16 進数の文字列(64文字)で返す．
+string
+Sha256::hex_digest() const
+{
+  // 終端処理はコピーに対して行う．
+  Sha256 tmp{*this};
+  std::uint64_t nbits = mTotalSize * 8;
+  tmp.mBlock[tmp.mBlockSize ++] = 0x80;
+  if ( tmp.mBlockSize > 56 ) {
+    std::memset(tmp.mBlock + tmp.mBlockSize, 0, 64 - tmp.mBlockSize);
+    tmp.process_block(tmp.mBlock);
+    tmp.mBlockSize = 0;
+  }
+  std::memset(tmp.mBlock + tmp.mBlockSize, 0, 56 - tmp.mBlockSize);
+  for ( SizeType i = 0; i < 8; ++ i ) {
+    tmp.mBlock[63 - i] = static_cast<std::uint8_t>(nbits >> (i * 8));
+  }
+  tmp.process_block(tmp.mBlock);
+
+  static const char* hex = "0123456789abcdef";
+  string ans(64, '0');
+  for ( SizeType i = 0; i < 8; ++ i ) {
+    auto w = tmp.mState[i];
+    for ( SizeType j = 0; j < 8; ++ j ) {
+      ans[i * 8 + 7 - j] = hex[(w >> (j * 4)) & 15];
+    }
+  }
+  return ans;
+}
+
+// @brief 64 バイトのブロックを処理する．
+void
+Sha256::process_block(
+  const std::uint8_t* block
+)
+{
+  std::uint32_t w[64];
+  for ( SizeType i = 0; i < 16; ++ i ) {
+    w[i] = (static_cast<std::uint32_t>(block[i * 4 + 0]) << 24) |
+      (static_cast<std::uint32_t>(block[i * 4 + 1]) << 16) |
+      (static_cast<std::uint32_t>(block[i * 4 + 2]) << 8) |
+      static_cast<std::uint32_t>(block[i * 4 + 3]);
+  }
+  for ( SizeType i = 16; i < 64; ++ i ) {
+    auto s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+    auto s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+    w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+  }
+
+  auto a = mState[0];
+  auto b = mState[1];
+  auto c = mState[2];
+  auto d = mState[3];
+  auto e = mState[4];
+  auto f = mState[5];
+  auto g = mState[6];
+  auto h = mState[7];
+  for ( SizeType i = 0; i < 64; ++ i ) {
+    auto s1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+    auto ch = (e & f) ^ (~e & g);
+    auto t1 = h + s1 + ch + K[i] + w[i];
+    auto s0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+    auto maj = (a & b) ^ (a & c) ^ (b & c);
+    auto t2 = s0 + maj;
+    h = g;
+    g = f;
+    f = e;
+    e = d + t1;
+    d = c;
+    c = b;
+    b = a;
+    a = t1 + t2;
+  }
+  mState[0] += a;
+  mState[1] += b;
+  mState[2] += c;
+  mState[3] += d;
+  mState[4] += e;
+  mState[5] += f;
+  mState[6] += g;
+  mState[7] += h;
+}
+
+END_NAMESPACE_YM_MVN_VERILOG
@@ -0,0 +1,108 @@
+﻿#ifndef SHA256_H
+#define SHA256_H
+
+/// @file Sha256.h
+/// @brief Sha256 のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/mvn.h"
+
+
+BEGIN_NAMESPACE_YM_MVN_VERILOG
+
+//////////////////////////////////////////////////////////////////////
+/// @class Sha256 Sha256.h "Sha256.h"
+/// @brief SHA-256 (FIPS 180-4) のハッシュ値を計算するクラス
+///
+/// update() でデータを順に加え，hex_digest() で結果を得る．
+/// 値としてコピーできるので，途中の状態を保存しておいて
+/// 別のデータを加えることもできる．
+//////////////////////////////////////////////////////////////////////
+class Sha256
+{
+public:
+
+  /// @brief コンストラクタ
+  Sha256();
+
+  /// @brief デストラクタ
+  ~Sha256() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief データを加える．
+  void
+  update(
+    const char* data, ///< [in] データの先頭
+    SizeType size     ///< [in] データのサイズ
+  );
+
+  /// @brief 文字列を加える．
+  void
+  update(
+    const string& str ///< [in] 文字列
+  )
+  {
+    update(str.data(), str.size());
+  }
+
+  /// @brief ハッシュ値を 16 進数の文字列(64文字)で返す．
+  ///
+  /// 自身の状態は変えない．
+  string
+  hex_digest() const;
+
+  /// @brief 文字列のハッシュ値を 16 進数の文字列で返す．
+  static
+  string
+  digest(
+    const string& str ///< [in] 文字列
+  )
+  {
+    Sha256 h;
+    h.update(str);
+    return h.hex_digest();
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 64 バイトのブロックを処理する．
+  void
+  process_block(
+    const std::uint8_t* block ///< [in] ブロックの先頭
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 中間ハッシュ値
+  std::uint32_t mState[8];
+
+  // 未処理のデータ
+  std::uint8_t mBlock[64];
+
+  // mBlock 中のデータのサイズ
+  SizeType mBlockSize{0};
+
+  // これまでに加えたデータの総バイト数
+  std::uint64_t mTotalSize{0};
+
+};
+
+END_NAMESPACE_YM_MVN_VERILOG
+
+#endif // SHA256_H
@@ -7,6 +7,7 @@
 /// All rights reserved.
 
 #include "ym/MvnVerilogWriter.h"
+#include "ym/MvnCompOStream.h"
 #include "VerilogWriterImpl.h"
 
 
@@ -29,6 +30,38 @@ MvnVerilogWriter::~MvnVerilogWriter()
   // ヘッダ中で = default 宣言はできない．
 }
 
+// @brief 式の埋め込みを行うかどうかを設定する．
+void
+MvnVerilogWriter::set_inline_expr(
+  bool flag
+)
+{
+  mImpl->set_inline_expr(flag);
+}
+
+// @brief 式の埋め込みを行う時 true を返す．
+bool
+MvnVerilogWriter::inline_expr() const
+{
+  return mImpl->inline_expr();
+}
+
+// @brief 出力に用いるスレッド数を設定する．
+void
+MvnVerilogWriter::set_thread_num(
+  SizeType thread_num
+)
+{
+  mImpl->set_thread_num(thread_num);
+}
+
+// @brief 出力に用いるスレッド数を返す．
+SizeType
+MvnVerilogWriter::thread_num() const
+{
+  return mImpl->thread_num();
+}
+
 // @brief 内容を Verilog-HDL 形式で出力する
 // @param[in] s 出力先のストリーム
 // @param[in] mgr MvnMgr
@@ -55,4 +88,39 @@ MvnVerilogWriter::operator()(
   mImpl->dump(s, mgr, node_map);
 }
 
+// @brief 内容を Verilog-HDL 形式でファイルに出力する
+bool
+MvnVerilogWriter::operator()(
+  const string& filename,
+  const MvnMgr& mgr,
+  MvnCompType comp_type
+)
+{
+  MvnCompOStream s{filename, comp_type};
+  if ( !s.is_open() ) {
+    cerr << filename << ": could not open" << endl;
+    return false;
+  }
+  mImpl->dump(s, mgr);
+  return s.close();
+}
+
+// @brief 内容を Verilog-HDL 形式でファイルに出力する
+bool
+MvnVerilogWriter::operator()(
+  const string& filename,
+  const MvnMgr& mgr,
+  const MvnVlMap& node_map,
+  MvnCompType comp_type
+)
+{
+  MvnCompOStream s{filename, comp_type};
+  if ( !s.is_open() ) {
+    cerr << filename << ": could not open" << endl;
+    return false;
+  }
+  mImpl->dump(s, mgr, node_map);
+  return s.close();
+}
+
 END_NAMESPACE_YM_MVN
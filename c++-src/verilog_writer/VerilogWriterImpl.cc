@@ -28,18 +28,347 @@
 
 #include "ym/ClibCell.h"
 #include "ym/ClibPin.h"
-
-#include "ym/vl/VlDecl.h"
-#include "ym/vl/VlDeclArray.h"
-#include "ym/vl/VlRange.h"
+#include <atomic>
+#include <thread>
 
 
 BEGIN_NAMESPACE_YM_MVN
 
+BEGIN_NONAMESPACE
+
+// 並列出力の際に一つの仕事で扱うノード数
+const SizeType CHUNK_SIZE = 4096;
+
+// 並列出力の仕事
+struct WriteTask
+{
+  // 仕事の種類
+  enum Type {
+    HEAD, // モジュールのヘッダとポートの宣言
+    DECL, // 内部ノードの宣言
+    IO,   // 入出力ノードの内容
+    BODY, // 内部ノードの内容
+    TAIL  // モジュールの末尾
+  };
+
+  // 仕事の種類
+  Type mType;
+
+  // モジュール番号
+  SizeType mModule;
+
+  // ノードリスト上の開始位置
+  SizeType mBegin;
+
+  // ノードリスト上の終了位置
+  SizeType mEnd;
+};
+
+// 0 から n - 1 までの番号について func を並列に実行する．
+template<typename F>
+void
+run_parallel(
+  SizeType thread_num,
+  SizeType n,
+  F func
+)
+{
+  std::atomic<SizeType> next_pos{0};
+  auto worker = [&]() {
+    for ( ; ; ) {
+      SizeType pos{next_pos ++};
+      if ( pos >= n ) {
+	break;
+      }
+      func(pos);
+    }
+  };
+  SizeType nt{std::min(thread_num, n)};
+  if ( nt <= 1 ) {
+    worker();
+  }
+  else {
+    vector<std::thread> thread_list;
+    thread_list.reserve(nt - 1);
+    for ( SizeType tid = 1; tid < nt; ++ tid ) {
+      thread_list.push_back(std::thread{worker});
+    }
+    worker();
+    for ( auto& th: thread_list ) {
+      th.join();
+    }
+  }
+}
+
+// 式の優先順位
+// 値の大きいものほど強く結合する．
+const int PREC_NONE    = 0;
+const int PREC_COND    = 1;  // ?:
+const int PREC_OR      = 4;  // |
+const int PREC_XOR     = 5;  // ^
+const int PREC_AND     = 6;  // &
+const int PREC_EQ      = 7;  // == ===
+const int PREC_REL     = 8;  // <
+const int PREC_SHIFT   = 9;  // << >> <<< >>>
+const int PREC_ADD     = 10; // + -
+const int PREC_MUL     = 11; // * / %
+const int PREC_POW     = 12; // **
+const int PREC_UNARY   = 13; // 単項演算子
+const int PREC_PRIMARY = 14; // 名前，定数，連結，括弧で囲まれた式
+
+// 埋め込みの深さの最大値
+const SizeType MAX_INLINE_DEPTH = 64;
+
+// 式として埋め込めるノードの種類
+enum class ExprKind {
+  None,    // 埋め込めない
+  Self,    // ビット幅が自分自身で決まる式
+  Context  // ビット幅が文脈で決まる式
+};
+
+// ノードを式として埋め込む時の種類を返す．
+ExprKind
+expr_kind(
+  const MvnNode* node
+)
+{
+  switch ( node->type() ) {
+  case MvnNodeType::RAND:
+  case MvnNodeType::ROR:
+  case MvnNodeType::RXOR:
+  case MvnNodeType::EQ:
+  case MvnNodeType::LT:
+  case MvnNodeType::CASEEQ:
+  case MvnNodeType::CONCAT:
+  case MvnNodeType::CONSTBITSELECT:
+  case MvnNodeType::CONSTPARTSELECT:
+  case MvnNodeType::BITSELECT:
+  case MvnNodeType::CONSTVALUE:
+    return ExprKind::Self;
+
+  case MvnNodeType::THROUGH:
+  case MvnNodeType::NOT:
+  case MvnNodeType::CMPL:
+  case MvnNodeType::AND:
+  case MvnNodeType::OR:
+  case MvnNodeType::XOR:
+  case MvnNodeType::SLL:
+  case MvnNodeType::SRL:
+  case MvnNodeType::SLA:
+  case MvnNodeType::SRA:
+  case MvnNodeType::ADD:
+  case MvnNodeType::SUB:
+  case MvnNodeType::MUL:
+  case MvnNodeType::DIV:
+  case MvnNodeType::MOD:
+  case MvnNodeType::POW:
+  case MvnNodeType::ITE:
+    return ExprKind::Context;
+
+  default:
+    break;
+  }
+  return ExprKind::None;
+}
+
+// 埋め込まれた時の式の優先順位を返す．
+int
+expr_prec(
+  const MvnNode* node
+)
+{
+  switch ( node->type() ) {
+  case MvnNodeType::NOT:
+  case MvnNodeType::CMPL:
+  case MvnNodeType::RAND:
+  case MvnNodeType::ROR:
+  case MvnNodeType::RXOR:
+    return PREC_UNARY;
+
+  case MvnNodeType::AND:
+    return PREC_AND;
+
+  case MvnNodeType::OR:
+    return PREC_OR;
+
+  case MvnNodeType::XOR:
+    return PREC_XOR;
+
+  case MvnNodeType::SLL:
+  case MvnNodeType::SRL:
+  case MvnNodeType::SLA:
+  case MvnNodeType::SRA:
+    return PREC_SHIFT;
+
+  case MvnNodeType::ADD:
+  case MvnNodeType::SUB:
+    return PREC_ADD;
+
+  case MvnNodeType::MUL:
+  case MvnNodeType::DIV:
+  case MvnNodeType::MOD:
+    return PREC_MUL;
+
+  case MvnNodeType::POW:
+    return PREC_POW;
+
+  case MvnNodeType::ITE:
+    return PREC_COND;
+
+  default:
+    // THROUGH は被演算子を括弧で囲む．
+    // EQ, LT, CASEEQ は全体を括弧で囲む．
+    break;
+  }
+  return PREC_PRIMARY;
+}
+
+// pos 番目の入力が埋め込まれた式を受け付ける時 true を返す．
+//
+// 部分選択の対象は名前でなければならない．
+// DFF と LATCH はデータ入力のみ受け付ける．
+bool
+accept_expr(
+  const MvnNode* node,
+  SizeType pos
+)
+{
+  switch ( node->type() ) {
+  case MvnNodeType::OUTPUT:
+  case MvnNodeType::INOUT:
+  case MvnNodeType::DFF:
+  case MvnNodeType::LATCH:
+    return pos == 0;
+
+  case MvnNodeType::CONSTBITSELECT:
+  case MvnNodeType::CONSTPARTSELECT:
+    return false;
+
+  case MvnNodeType::BITSELECT:
+    return pos == 1;
+
+  case MvnNodeType::PARTSELECT:
+    return false;
+
+  default:
+    break;
+  }
+  return expr_kind(node) != ExprKind::None;
+}
+
+// pos 番目の入力のビット幅が文脈で決まる時 true を返す．
+bool
+is_context_pin(
+  const MvnNode* node,
+  SizeType pos
+)
+{
+  switch ( node->type() ) {
+  case MvnNodeType::OUTPUT:
+  case MvnNodeType::INOUT:
+  case MvnNodeType::DFF:
+  case MvnNodeType::LATCH:
+  case MvnNodeType::SLL:
+  case MvnNodeType::SRL:
+  case MvnNodeType::SLA:
+  case MvnNodeType::SRA:
+  case MvnNodeType::POW:
+    return pos == 0;
+
+  case MvnNodeType::THROUGH:
+  case MvnNodeType::NOT:
+  case MvnNodeType::CMPL:
+  case MvnNodeType::AND:
+  case MvnNodeType::OR:
+  case MvnNodeType::XOR:
+  case MvnNodeType::ADD:
+  case MvnNodeType::SUB:
+  case MvnNodeType::MUL:
+  case MvnNodeType::DIV:
+  case MvnNodeType::MOD:
+    return true;
+
+  case MvnNodeType::EQ:
+  case MvnNodeType::LT:
+  case MvnNodeType::CASEEQ:
+    return pos == 0 || pos == 1;
+
+  case MvnNodeType::ITE:
+    return pos == 1 || pos == 2;
+
+  default:
+    break;
+  }
+  return false;
+}
+
+// 文脈で決まる入力を評価する時のビット幅を返す．
+SizeType
+context_width(
+  const MvnNode* node
+)
+{
+  SizeType w{0};
+  switch ( node->type() ) {
+  case MvnNodeType::EQ:
+  case MvnNodeType::LT:
+  case MvnNodeType::CASEEQ:
+    // 結果は1ビットで入力どうしでビット幅が決まる．
+    break;
+
+  default:
+    w = node->bit_width();
+    break;
+  }
+  SizeType ni{node->input_num()};
+  for ( SizeType i = 0; i < ni; ++ i ) {
+    if ( is_context_pin(node, i) ) {
+      w = std::max(w, node->input(i)->bit_width());
+    }
+  }
+  return w;
+}
+
+// 文脈で決まる入力のビット幅が全て出力と等しい時 true を返す．
+//
+// この時，式は出力のビット幅で評価されるので
+// 同じビット幅の文脈に埋め込んでも値は変わらない．
+bool
+is_homogeneous(
+  const MvnNode* node
+)
+{
+  SizeType bw{node->bit_width()};
+  SizeType ni{node->input_num()};
+  for ( SizeType i = 0; i < ni; ++ i ) {
+    if ( is_context_pin(node, i) && node->input(i)->bit_width() != bw ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+END_NONAMESPACE
+
 //////////////////////////////////////////////////////////////////////
 // クラス VerilogWriterImpl
 //////////////////////////////////////////////////////////////////////
 
+// @brief 出力に用いるスレッド数を設定する．
+void
+VerilogWriterImpl::set_thread_num(
+  SizeType thread_num
+)
+{
+  mThreadNum = thread_num;
+  if ( mThreadNum == 0 ) {
+    mThreadNum = std::thread::hardware_concurrency();
+    if ( mThreadNum == 0 ) {
+      mThreadNum = 1;
+    }
+  }
+}
+
 // @brief 内容を Verilog-HDL 形式で出力する
 // @param[in] s 出力先のストリーム
 // @param[in] mgr MvnMgr
@@ -51,11 +380,122 @@ VerilogWriterImpl::dump(
 {
   mNameArray.clear();
   mNameArray.resize(mgr.max_node_id(), string());
+  mark_inline(mgr);
+  if ( mThreadNum > 1 ) {
+    dump_parallel(s, mgr);
+  }
+  else {
+    WriteBuf buf{s, mBuffer};
+    SizeType n{mgr.max_module_id()};
+    for ( SizeType i = 0; i < n; ++ i ) {
+      auto module{mgr.module(i)};
+      if ( module != nullptr ) {
+	dump_module(buf, module, mgr);
+      }
+    }
+  }
+  s.flush();
+}
+
+// @brief 内容を複数のスレッドで出力する．
+void
+VerilogWriterImpl::dump_parallel(
+  ostream& s,
+  const MvnMgr& mgr
+)
+{
+  vector<const MvnModule*> module_list;
   SizeType n{mgr.max_module_id()};
   for ( SizeType i = 0; i < n; ++ i ) {
     auto module{mgr.module(i)};
     if ( module != nullptr ) {
-      dump_module(s, module, mgr);
+      module_list.push_back(module);
+    }
+  }
+  SizeType nm{module_list.size()};
+
+  // まずモジュールの先頭部分を作る．
+  // ここでポートに接続したノードの名前が決まるので，
+  // 残りの部分はこれが終わってから作る．
+  // ノードは一つのモジュールにしか属さないので
+  // 異なるモジュールの名前の設定は互いに干渉しない．
+  vector<vector<char>> head_list(nm);
+  vector<SizeType> head_size(nm, 0);
+  run_parallel(mThreadNum, nm, [&](SizeType pos) {
+    WriteBuf buf{head_list[pos]};
+    dump_module_head(buf, module_list[pos]);
+    head_size[pos] = buf.size();
+  });
+
+  // 出力順に仕事を並べる．
+  vector<WriteTask> task_list;
+  for ( SizeType mpos = 0; mpos < nm; ++ mpos ) {
+    auto module{module_list[mpos]};
+    SizeType nn{module->node_num()};
+    task_list.push_back(WriteTask{WriteTask::HEAD, mpos, 0, 0});
+    for ( SizeType b = 0; b < nn; b += CHUNK_SIZE ) {
+      SizeType e{std::min(b + CHUNK_SIZE, nn)};
+      task_list.push_back(WriteTask{WriteTask::DECL, mpos, b, e});
+    }
+    task_list.push_back(WriteTask{WriteTask::IO, mpos, 0, 0});
+    for ( SizeType b = 0; b < nn; b += CHUNK_SIZE ) {
+      SizeType e{std::min(b + CHUNK_SIZE, nn)};
+      task_list.push_back(WriteTask{WriteTask::BODY, mpos, b, e});
+    }
+    task_list.push_back(WriteTask{WriteTask::TAIL, mpos, 0, 0});
+  }
+
+  // 一度に作る仕事の数を制限して，メモリ使用量を抑える．
+  // 作った内容は仕事の順に書き出すので出力はスレッド数によらない．
+  SizeType nt{task_list.size()};
+  SizeType window{mThreadNum * 4};
+  vector<vector<char>> buf_list(window);
+  vector<SizeType> size_list(window, 0);
+  WriteBuf buf{s, mBuffer};
+  for ( SizeType base = 0; base < nt; base += window ) {
+    SizeType wn{std::min(window, nt - base)};
+    run_parallel(mThreadNum, wn, [&](SizeType pos) {
+      auto& task{task_list[base + pos]};
+      auto module{module_list[task.mModule]};
+      auto& node_list{module->node_list()};
+      WriteBuf tmp{buf_list[pos]};
+      switch ( task.mType ) {
+      case WriteTask::DECL:
+	for ( SizeType i = task.mBegin; i < task.mEnd; ++ i ) {
+	  dump_decl(tmp, node_list[i]);
+	}
+	break;
+
+      case WriteTask::IO:
+	dump_module_io(tmp, module, mgr);
+	break;
+
+      case WriteTask::BODY:
+	for ( SizeType i = task.mBegin; i < task.mEnd; ++ i ) {
+	  dump_node(tmp, node_list[i], mgr);
+	}
+	break;
+
+      default:
+	break;
+      }
+      size_list[pos] = tmp.size();
+    });
+    for ( SizeType pos = 0; pos < wn; ++ pos ) {
+      auto& task{task_list[base + pos]};
+      switch ( task.mType ) {
+      case WriteTask::HEAD:
+	buf.put(head_list[task.mModule].data(), head_size[task.mModule]);
+	break;
+
+      case WriteTask::TAIL:
+	dump_module_tail(buf);
+	break;
+
+      default:
+	buf.put(buf_list[pos].data(), size_list[pos]);
+	break;
+      }
     }
   }
 }
@@ -73,44 +513,51 @@ VerilogWriterImpl::dump(
 {
   dump(s, mgr);
 
-  SizeType node_num{mgr.max_node_id()};
-  for ( SizeType i = 0; i < node_num; ++ i ) {
-    auto node = mgr.node(i);
-    if ( node == nullptr ) continue;
-
-    s << "// node" << node->id() << " : ";
-    if ( node_map.is_single_elem(i) ) {
-      auto decl{node_map.get_single_elem(i)};
-      ASSERT_COND( decl != nullptr );
-      s << decl->full_name();
-    }
-    else if ( node_map.is_array_elem(i) ) {
-      auto declarray{node_map.get_array_elem(i)};
-      ASSERT_COND( declarray != nullptr );
-      SizeType offset{node_map.get_array_offset(i)};
-      SizeType d = declarray->dimension();
-      vector<int> index_array(d);
-      for ( SizeType i = 0; i < d; ++ i ) {
-	auto range = declarray->range(i);
-	SizeType n = range->size();
-	index_array[i] = offset % n;
-	offset /= n;
-      }
-      s << declarray->full_name();
-      for ( SizeType i = 0; i < d; ++ i ) {
-	s << "[" << index_array[d - i - 1] << "]";
-      }
+  {
+    WriteBuf buf{s, mBuffer};
+    SizeType node_num{mgr.max_node_id()};
+    for ( SizeType i = 0; i < node_num; ++ i ) {
+      auto node = mgr.node(i);
+      if ( node == nullptr ) continue;
+
+      buf << "// node" << node->id() << " : "
+	  << node_map.get_name(i) << '\n';
     }
-    s << endl;
   }
+  s.flush();
 }
 
 void
 VerilogWriterImpl::dump_module(
-  ostream& s,
+  WriteBuf& s,
   const MvnModule* module,
   const MvnMgr& mgr
 )
+{
+  dump_module_head(s, module);
+
+  auto& node_list{module->node_list()};
+  for ( auto node: node_list ) {
+    dump_decl(s, node);
+  }
+
+  dump_module_io(s, module, mgr);
+
+  for ( auto node: node_list ) {
+    dump_node(s, node, mgr);
+  }
+
+  dump_module_tail(s);
+}
+
+// @brief モジュールのヘッダとポートの宣言を出力する．
+//
+// ポートに接続したノードの名前もここで設定する．
+void
+VerilogWriterImpl::dump_module_head(
+  WriteBuf& s,
+  const MvnModule* module
+)
 {
   s << "module " << module->name() << "(";
 
@@ -123,7 +570,7 @@ VerilogWriterImpl::dump_module(
     dump_port(s, port);
   }
 
-  s << ");" << endl;
+  s << ");\n";
 
   SizeType ni{module->input_num()};
   for ( SizeType i = 0; i < ni; ++ i ) {
@@ -136,7 +583,7 @@ VerilogWriterImpl::dump_module(
     else {
       s << "  input [" << bw - 1 << ":0] ";
     }
-    s << node_name(node) << ";" << endl;
+    s << node_name(node) << ";\n";
   }
 
   SizeType no{module->output_num()};
@@ -150,7 +597,7 @@ VerilogWriterImpl::dump_module(
     else {
       s << "  output [" << bw - 1 << ":0] ";
     }
-    s << node_name(node) << ";" << endl;
+    s << node_name(node) << ";\n";
   }
 
   SizeType nio{module->inout_num()};
@@ -164,53 +611,79 @@ VerilogWriterImpl::dump_module(
     else {
       s << "  inout [" << bw - 1 << ":0] ";
     }
-    s << node_name(node) << ";" << endl;
+    s << node_name(node) << ";\n";
   }
-  s << endl;
+  s << '\n';
+}
 
-  auto& node_list{module->node_list()};
-  for ( auto node: node_list ) {
-    SizeType bw{node->bit_width()};
-    if ( node->type() == MvnNodeType::DFF || node->type() == MvnNodeType::LATCH ) {
-      s << "  reg  ";
-      if ( bw > 1 ) {
-	s << "[" << bw - 1 << ":" << "0]";
-      }
-      s << " " << node_name(node) << ";" << endl;
+// @brief 内部ノードの宣言を出力する．
+void
+VerilogWriterImpl::dump_decl(
+  WriteBuf& s,
+  const MvnNode* node
+)
+{
+  if ( is_inlined(node) ) {
+    return;
+  }
+
+  SizeType bw{node->bit_width()};
+  if ( node->type() == MvnNodeType::DFF || node->type() == MvnNodeType::LATCH ) {
+    s << "  reg  ";
+    if ( bw > 1 ) {
+      s << "[" << bw - 1 << ":" << "0]";
     }
-    else {
-      s << "  wire ";
-      if ( bw > 1 ) {
-	s << "[" << bw - 1 << ":" << "0]";
-      }
-      s << " " << node_name(node) << ";" << endl;
+    s << " " << node_name(node) << ";\n";
+  }
+  else {
+    s << "  wire ";
+    if ( bw > 1 ) {
+      s << "[" << bw - 1 << ":" << "0]";
     }
+    s << " " << node_name(node) << ";\n";
   }
-  s << endl;
+}
 
+// @brief 入出力ノードの内容を出力する．
+void
+VerilogWriterImpl::dump_module_io(
+  WriteBuf& s,
+  const MvnModule* module,
+  const MvnMgr& mgr
+)
+{
+  s << '\n';
+
+  SizeType ni{module->input_num()};
   for ( SizeType i = 0; i < ni; ++ i ) {
     auto node{module->input(i)};
     dump_node(s, node, mgr);
   }
+  SizeType no{module->output_num()};
   for ( SizeType i = 0; i < no; ++ i ) {
     auto node{module->output(i)};
     dump_node(s, node, mgr);
   }
+  SizeType nio{module->inout_num()};
   for ( SizeType i = 0; i < nio; ++ i ) {
     auto node{module->inout(i)};
     dump_node(s, node, mgr);
   }
-  for ( auto node: node_list ) {
-    dump_node(s, node, mgr);
-  }
+}
 
-  s << "endmodule" << endl
-    << endl;
+// @brief モジュールの末尾を出力する．
+void
+VerilogWriterImpl::dump_module_tail(
+  WriteBuf& s
+)
+{
+  s << "endmodule\n"
+    << "\n";
 }
 
 void
 VerilogWriterImpl::dump_port(
-  ostream& s,
+  WriteBuf& s,
   const MvnPort* port
 )
 {
@@ -246,7 +719,7 @@ VerilogWriterImpl::dump_port(
 
 void
 VerilogWriterImpl::dump_port_ref(
-  ostream& s,
+  WriteBuf& s,
   const MvnPortRef& port_ref
 )
 {
@@ -261,11 +734,16 @@ VerilogWriterImpl::dump_port_ref(
 
 void
 VerilogWriterImpl::dump_node(
-  ostream& s,
+  WriteBuf& s,
   const MvnNode* node,
   const MvnMgr& mgr
 )
 {
+  if ( is_inlined(node) ) {
+    // 参照先の式の中に埋め込まれている．
+    return;
+  }
+
   switch ( node->type() ) {
   case MvnNodeType::INPUT:
     {
@@ -283,8 +761,9 @@ VerilogWriterImpl::dump_node(
       auto src_node{ipin->src_node()};
       if ( src_node ) {
 	s << "  assign " << node_name(node)
-	  << " = " << node_name(src_node)
-	  << ";" << endl;
+	  << " = ";
+	dump_operand(s, src_node, PREC_NONE);
+	s << ";\n";
       }
     }
     break;
@@ -298,8 +777,9 @@ VerilogWriterImpl::dump_node(
       auto src_node{ipin->src_node()};
       if ( src_node ) {
 	s << "  assign " << node_name(node)
-	  << " = " << node_name(src_node)
-	  << ";" << endl;
+	  << " = ";
+	dump_operand(s, src_node, PREC_NONE);
+	s << ";\n";
       }
     }
     break;
@@ -331,7 +811,7 @@ VerilogWriterImpl::dump_node(
 	auto polstr{node->control_pol(i) == MvnPolarity::Positive? "posedge" : "negedge"};
 	s << " or " << polstr << " " << node_name(src_node2);
       }
-      s << " )" << endl;
+      s << " )\n";
       auto elif{"if"};
       for ( SizeType i = 0; i < nc; ++ i ) {
 	auto not_str{""};
@@ -342,18 +822,18 @@ VerilogWriterImpl::dump_node(
 	auto src_node2{ipin2->src_node()};
 	auto src_node3{node->control_val(i)};
 	s << "    " << elif << " ( "
-	  << not_str << node_name(src_node2) << " )" << endl
+	  << not_str << node_name(src_node2) << " )\n"
 	  << "      " << node_name(node) << " <= "
-	  << node_name(src_node3) << ";" << endl;
+	  << node_name(src_node3) << ";\n";
 	elif = "else if";
       }
       if ( nc > 0 ) {
-	s << "    else" << endl
+	s << "    else\n"
 	  << "  ";
       }
-      s << "    " << node_name(node) << " <= "
-	<< node_name(src_node0) << ";" << endl
-	<< endl;
+      s << "    " << node_name(node) << " <= ";
+      dump_operand(s, src_node0, PREC_NONE);
+      s << ";\n\n";
     }
     break;
 
@@ -369,14 +849,92 @@ VerilogWriterImpl::dump_node(
       auto src_node1{ipin1->src_node()};
       ASSERT_COND( src_node1 != nullptr );
 
-      s << "  always @ ( * )" << endl
-	<< "    if ( " << node_name(src_node1) << " )" << endl
-	<< "      " << node_name(node) << " <= "
-	<< node_name(src_node0) << ";" << endl
-	<< endl;
+      s << "  always @ ( * )\n"
+	<< "    if ( " << node_name(src_node1) << " )\n"
+	<< "      " << node_name(node) << " <= ";
+      dump_operand(s, src_node0, PREC_NONE);
+      s << ";\n\n";
     }
     break;
 
+  case MvnNodeType::THROUGH:
+  case MvnNodeType::NOT:
+  case MvnNodeType::CMPL:
+  case MvnNodeType::AND:
+  case MvnNodeType::OR:
+  case MvnNodeType::XOR:
+  case MvnNodeType::RAND:
+  case MvnNodeType::ROR:
+  case MvnNodeType::RXOR:
+  case MvnNodeType::EQ:
+  case MvnNodeType::LT:
+  case MvnNodeType::CASEEQ:
+  case MvnNodeType::SLL:
+  case MvnNodeType::SRL:
+  case MvnNodeType::SLA:
+  case MvnNodeType::SRA:
+  case MvnNodeType::ADD:
+  case MvnNodeType::SUB:
+  case MvnNodeType::MUL:
+  case MvnNodeType::DIV:
+  case MvnNodeType::MOD:
+  case MvnNodeType::POW:
+  case MvnNodeType::ITE:
+  case MvnNodeType::CONCAT:
+  case MvnNodeType::CONSTBITSELECT:
+  case MvnNodeType::CONSTPARTSELECT:
+  case MvnNodeType::BITSELECT:
+  case MvnNodeType::PARTSELECT:
+  case MvnNodeType::CONSTVALUE:
+    s << "  assign " << node_name(node)
+      << " = ";
+    dump_expr(s, node);
+    s << ";\n";
+    break;
+
+  case MvnNodeType::CELL:
+    {
+      auto cell = node->cell();
+      SizeType ni{cell.input_num()};
+      SizeType no{cell.output_num()};
+      SizeType nio{cell.inout_num()};
+      ASSERT_COND( no == 1 );
+      ASSERT_COND( nio == 0 );
+
+      s << cell.name() << " " << node_name(node)
+	<< " (";
+
+      // 出力
+      s << "." << cell.output(0).name()
+	<< "(" << node_name(node) << ")";
+
+      // 入力
+      for ( SizeType i = 0; i < ni; ++ i ) {
+	auto pin = cell.input(i);
+	auto ipin = node->input(i);
+	auto src_node = ipin->src_node();
+
+	s << ", ." << pin.name()
+	  << "(" << node_name(src_node) << ")";
+      }
+
+      s << ");\n";
+    }
+    break;
+
+  default:
+    break;
+  }
+}
+
+// @brief 組み合わせ回路のノードの値を表す式を出力する．
+void
+VerilogWriterImpl::dump_expr(
+  WriteBuf& s,
+  const MvnNode* node
+)
+{
+  switch ( node->type() ) {
   case MvnNodeType::THROUGH:
     dump_uop(s, node, "");
     break;
@@ -385,16 +943,20 @@ VerilogWriterImpl::dump_node(
     dump_uop(s, node, "~");
     break;
 
+  case MvnNodeType::CMPL:
+    dump_uop(s, node, "-");
+    break;
+
   case MvnNodeType::AND:
-    dump_nop(s, node, "&");
+    dump_nop(s, node, "&", PREC_AND);
     break;
 
   case MvnNodeType::OR:
-    dump_nop(s, node, "|");
+    dump_nop(s, node, "|", PREC_OR);
     break;
 
   case MvnNodeType::XOR:
-    dump_nop(s, node, "^");
+    dump_nop(s, node, "^", PREC_XOR);
     break;
 
   case MvnNodeType::RAND:
@@ -410,11 +972,11 @@ VerilogWriterImpl::dump_node(
     break;
 
   case MvnNodeType::EQ:
-    dump_binop(s, node, "==", true);
+    dump_binop(s, node, "==", PREC_EQ, true);
     break;
 
   case MvnNodeType::LT:
-    dump_binop(s, node, "<", true);
+    dump_binop(s, node, "<", PREC_REL, true);
     break;
 
   case MvnNodeType::CASEEQ:
@@ -430,64 +992,64 @@ VerilogWriterImpl::dump_node(
 
       auto xmask{node->xmask()};
       SizeType bw{ipin0->bit_width()};
-      string mask_str;
+      s << "(";
+      dump_operand(s, src_node0, PREC_EQ);
+      s << " === ";
+      // マスクとの XOR の方が強く結合する．
+      dump_operand(s, src_node1, PREC_XOR);
+      s << " ^ " << bw << "'b";
       for ( SizeType i = 0; i < bw; ++ i ) {
 	SizeType bitpos = bw - i - 1;
-	SizeType blk = bitpos / 32;
-	SizeType sft = bitpos % 32;
-	if ( xmask[blk] & (1U << sft) ) {
-	  mask_str += "?";
+	if ( xmask[bitpos] ) {
+	  s << '?';
 	}
 	else {
-	  mask_str += "0";
+	  s << '0';
 	}
       }
-      s << "  assign " << node_name(node)
-	<< " = (" << node_name(src_node0)
-	<< " === " << node_name(src_node1)
-	<< " ^ " << bw << "'b" << mask_str
-	<< ");" << endl;
+      s << ")";
     }
     break;
 
   case MvnNodeType::SLL:
-    dump_binop(s, node, "<<");
+    dump_binop(s, node, "<<", PREC_SHIFT);
     break;
 
   case MvnNodeType::SRL:
-    dump_binop(s, node, ">>");
+    dump_binop(s, node, ">>", PREC_SHIFT);
     break;
 
   case MvnNodeType::SLA:
-    dump_binop(s, node, "<<<");
+    dump_binop(s, node, "<<<", PREC_SHIFT);
     break;
 
   case MvnNodeType::SRA:
-    dump_binop(s, node, ">>>");
+    dump_binop(s, node, ">>>", PREC_SHIFT);
     break;
 
   case MvnNodeType::ADD:
-    dump_binop(s, node, "+");
+    dump_binop(s, node, "+", PREC_ADD);
     break;
 
   case MvnNodeType::SUB:
-    dump_binop(s, node, "-");
+    dump_binop(s, node, "-", PREC_ADD);
     break;
 
   case MvnNodeType::MUL:
-    dump_binop(s, node, "*");
+    dump_binop(s, node, "*", PREC_MUL);
     break;
 
   case MvnNodeType::DIV:
-    dump_binop(s, node, "/");
+    dump_binop(s, node, "/", PREC_MUL);
     break;
 
   case MvnNodeType::MOD:
-    dump_binop(s, node, "%");
+    dump_binop(s, node, "%", PREC_MUL);
     break;
 
   case MvnNodeType::POW:
-    dump_binop(s, node, "**");
+    // 結合規則の解釈の違いを避けるため左側も括弧で囲む．
+    dump_binop(s, node, "**", PREC_POW + 1);
     break;
 
   case MvnNodeType::ITE:
@@ -504,27 +1066,27 @@ VerilogWriterImpl::dump_node(
       auto ipin2{node->input(2)};
       auto src_node2{ipin2->src_node()};
 
-      s << "  assign " << node_name(node)
-	<< " = " << node_name(src_node0)
-	<< " ? " << node_name(src_node1)
-	<< " : " << node_name(src_node2)
-	<< ";" << endl;
+      dump_operand(s, src_node0, PREC_COND + 1);
+      s << " ? ";
+      dump_operand(s, src_node1, PREC_COND + 1);
+      s << " : ";
+      dump_operand(s, src_node2, PREC_COND + 1);
     }
     break;
 
   case MvnNodeType::CONCAT:
     {
-      s << "  assign " << node_name(node)
-	<< " = {";
+      s << "{";
       const char* comma = "";
       SizeType ni{node->input_num()};
       for ( SizeType i = 0; i < ni; ++ i ) {
 	auto ipin{node->input(i)};
 	auto src_node{ipin->src_node()};
-	s << comma << node_name(src_node);
+	s << comma;
+	dump_operand(s, src_node, PREC_NONE);
 	comma = ", ";
       }
-      s << "};" << endl;
+      s << "}";
     }
     break;
 
@@ -535,9 +1097,8 @@ VerilogWriterImpl::dump_node(
 
       auto ipin{node->input(0)};
       auto src_node{ipin->src_node()};
-      s << "  assign " << node_name(node)
-	<< " = " << node_name(src_node)
-	<< "[" << node->bitpos() << "];" << endl;
+      s << node_name(src_node)
+	<< "[" << node->bitpos() << "]";
     }
     break;
 
@@ -548,11 +1109,10 @@ VerilogWriterImpl::dump_node(
 
       auto ipin{node->input(0)};
       auto src_node{ipin->src_node()};
-      s << "  assign " << node_name(node)
-	<< " = " << node_name(src_node)
+      s << node_name(src_node)
 	<< "[" << node->msb()
 	<< ":" << node->lsb()
-	<< "];" << endl;
+	<< "]";
     }
     break;
 
@@ -567,32 +1127,18 @@ VerilogWriterImpl::dump_node(
       auto ipin1{node->input(1)};
       auto src_node1{ipin1->src_node()};
 
-      s << "  assign " << node_name(node)
-	<< " = " << node_name(src_node)
-	<< "[" << node_name(src_node1) << "];" << endl;
+      s << node_name(src_node) << "[";
+      dump_operand(s, src_node1, PREC_NONE);
+      s << "]";
     }
     break;
 
   case MvnNodeType::PARTSELECT:
-    {
-      SizeType ni{node->input_num()};
-      ASSERT_COND( ni == 2 );
-
-      auto ipin{node->input(0)};
-      auto src_node{ipin->src_node()};
-
-      auto ipin1{node->input(1)};
-      auto src_node1{ipin1->src_node()};
-
-      auto ipin2{node->input(2)};
-      auto src_node2{ipin2->src_node()};
-
-      s << "  assign " << node_name(node)
-	<< " = " << node_name(src_node)
-	<< "[" << node_name(src_node1)
-	<< ":" << node_name(src_node2)
-	<< "];" << endl;
-    }
+    // 2番目の入力は LSB の位置で，範囲外の時の値は 0 なので
+    // 右シフトの結果を出力のビット幅で受けるのと同じになる．
+    // (MvnVerilogReader は可変範囲選択を読み込めない)
+    // 文脈でビット幅が変わるので埋め込みは行わない．
+    dump_binop(s, node, ">>", PREC_SHIFT);
     break;
 
   case MvnNodeType::CONSTVALUE:
@@ -601,62 +1147,56 @@ VerilogWriterImpl::dump_node(
       ASSERT_COND( ni == 0 );
 
       SizeType bw{node->bit_width()};
-      s << "  assign " << node_name(node)
-	<< " = " << bw << "'b";
+      s << bw << "'b";
       auto cv{node->const_value()};
       for ( SizeType i = 0; i < bw; ++ i ) {
 	SizeType idx = bw - i - 1;
-	SizeType blk = idx / 32;
-	SizeType sft = idx % 32;
-	if ( (cv[blk] >> sft) & 1 ) {
-	  s << "1";
+	if ( cv[idx] ) {
+	  s << '1';
 	}
 	else {
-	  s << "0";
+	  s << '0';
 	}
       }
-      s << ";" << endl;
-    }
-    break;
-
-  case MvnNodeType::CELL:
-    {
-      auto cell = node->cell();
-      SizeType ni{cell.input_num()};
-      SizeType no{cell.output_num()};
-      SizeType nio{cell.inout_num()};
-      ASSERT_COND( no == 1 );
-      ASSERT_COND( nio == 0 );
-
-      s << cell.name() << " " << node_name(node)
-	<< " (";
-
-      // 出力
-      s << "." << cell.output(0).name()
-	<< "(" << node_name(node) << ")";
-
-      // 入力
-      for ( SizeType i = 0; i < ni; ++ i ) {
-	auto pin = cell.input(i);
-	auto ipin = node->input(i);
-	auto src_node = ipin->src_node();
-
-	s << ", ." << pin.name()
-	  << "(" << node_name(src_node) << ")";
-      }
-
-      s << ");" << endl;
     }
     break;
 
   default:
+    ASSERT_NOT_REACHED;
     break;
   }
 }
 
+// @brief 演算子の被演算子を出力する．
+//
+// 埋め込まれたノードの場合は式を出力し，
+// その優先順位が min_prec 未満なら括弧で囲む．
+// それ以外はノード名を出力する．
+void
+VerilogWriterImpl::dump_operand(
+  WriteBuf& s,
+  const MvnNode* node,
+  int min_prec
+)
+{
+  if ( !is_inlined(node) ) {
+    s << node_name(node);
+    return;
+  }
+
+  bool need_paren{expr_prec(node) < min_prec};
+  if ( need_paren ) {
+    s << "(";
+  }
+  dump_expr(s, node);
+  if ( need_paren ) {
+    s << ")";
+  }
+}
+
 void
 VerilogWriterImpl::dump_uop(
-  ostream& s,
+  WriteBuf& s,
   const MvnNode* node,
   const char* opr_str
 )
@@ -666,16 +1206,18 @@ VerilogWriterImpl::dump_uop(
 
   auto ipin{node->input(0)};
   auto src_node{ipin->src_node()};
-  s << "  assign " << node_name(node)
-    << " = " << opr_str << node_name(src_node)
-    << ";" << endl;
+  s << opr_str;
+  // "~&" などの別の演算子と解釈されないように
+  // 名前以外は常に括弧で囲む．
+  dump_operand(s, src_node, PREC_PRIMARY);
 }
 
 void
 VerilogWriterImpl::dump_binop(
-  ostream& s,
+  WriteBuf& s,
   const MvnNode* node,
   const char* opr_str,
+  int prec,
   bool need_paren
 )
 {
@@ -688,24 +1230,24 @@ VerilogWriterImpl::dump_binop(
   auto ipin1{node->input(1)};
   auto src_node1{ipin1->src_node()};
 
-  const char* lp = "";
-  const char* rp = "";
   if ( need_paren ) {
-    lp = "(";
-    rp = ")";
+    s << "(";
+  }
+  // 左結合なので右側は同じ優先順位でも括弧で囲む．
+  dump_operand(s, src_node0, prec);
+  s << " " << opr_str << " ";
+  dump_operand(s, src_node1, prec + 1);
+  if ( need_paren ) {
+    s << ")";
   }
-
-  s << "  assign " << node_name(node) << " = "
-    << lp << node_name(src_node0)
-    << " " << opr_str << " " << node_name(src_node1)
-    << rp << ";" << endl;
 }
 
 void
 VerilogWriterImpl::dump_nop(
-  ostream& s,
+  WriteBuf& s,
   const MvnNode* node,
-  const char* opr_str
+  const char* opr_str,
+  int prec
 )
 {
   SizeType ni{node->input_num()};
@@ -714,28 +1256,143 @@ VerilogWriterImpl::dump_nop(
   auto ipin0{node->input(0)};
   auto src_node0{ipin0->src_node()};
 
-  s << "  assign " << node_name(node)
-    << " = " << node_name(src_node0);
+  dump_operand(s, src_node0, prec);
   for ( SizeType i = 1; i < ni; ++ i ) {
     auto ipin1{node->input(i)};
     auto src_node1{ipin1->src_node()};
-    s << " " << opr_str << " " << node_name(src_node1);
+    s << " " << opr_str << " ";
+    dump_operand(s, src_node1, prec + 1);
+  }
+}
+
+// @brief 式として埋め込むノードに印をつける．
+void
+VerilogWriterImpl::mark_inline(
+  const MvnMgr& mgr
+)
+{
+  SizeType n{mgr.max_node_id()};
+  mInlineArray.clear();
+  mInlineArray.resize(n, false);
+  if ( !mInlineExpr ) {
+    return;
+  }
+
+  // DFF の非同期セット/リセットの値は名前で参照する．
+  vector<bool> fixed(n, false);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    auto node{mgr.node(i)};
+    if ( node == nullptr || node->type() != MvnNodeType::DFF ) {
+      continue;
+    }
+    SizeType nc{node->input_num() - 2};
+    for ( SizeType j = 0; j < nc; ++ j ) {
+      auto val{node->control_val(j)};
+      if ( val != nullptr ) {
+	fixed[val->id()] = true;
+      }
+    }
+  }
+
+  for ( SizeType i = 0; i < n; ++ i ) {
+    auto node{mgr.node(i)};
+    if ( node == nullptr || fixed[i] ) {
+      continue;
+    }
+    auto kind{expr_kind(node)};
+    if ( kind == ExprKind::None ) {
+      continue;
+    }
+    auto& dst_list{node->dst_pin_list()};
+    if ( dst_list.size() != 1 ) {
+      continue;
+    }
+    auto dst_pin{dst_list[0]};
+    auto onode{dst_pin->node()};
+    SizeType pos{dst_pin->pos()};
+    if ( onode->parent() != node->parent() ) {
+      continue;
+    }
+    if ( !accept_expr(onode, pos) ) {
+      continue;
+    }
+    if ( kind == ExprKind::Context ) {
+      // 文脈によってビット幅の決まる式は
+      // 埋め込んだ先で同じビット幅で評価される時のみ埋め込む．
+      if ( !is_homogeneous(node) ) {
+	continue;
+      }
+      if ( is_context_pin(onode, pos) &&
+	   context_width(onode) != node->bit_width() ) {
+	continue;
+      }
+    }
+    mInlineArray[i] = true;
   }
-  s << ";" << endl;
+
+  // 埋め込み先をたどってループを切り，埋め込みの深さを制限する．
+  // depth[id] は埋め込み先をたどって名前のあるノードに至るまでの段数
+  vector<SizeType> depth(n, 0);
+  vector<std::uint8_t> state(n, 0);
+  vector<const MvnNode*> path;
+  auto consumer = [](const MvnNode* node) {
+    return node->dst_pin_list()[0]->node();
+  };
+  for ( SizeType i = 0; i < n; ++ i ) {
+    if ( !mInlineArray[i] || state[i] != 0 ) {
+      continue;
+    }
+    path.clear();
+    auto node{mgr.node(i)};
+    for ( ; ; ) {
+      state[node->id()] = 1;
+      path.push_back(node);
+      auto onode{consumer(node)};
+      SizeType oid{static_cast<SizeType>(onode->id())};
+      if ( !mInlineArray[oid] || state[oid] == 2 ) {
+	break;
+      }
+      if ( state[oid] == 1 ) {
+	// ループになっているのでここで切る．
+	mInlineArray[oid] = false;
+	break;
+      }
+      node = onode;
+    }
+    for ( SizeType k = path.size(); k > 0; -- k ) {
+      auto node1{path[k - 1]};
+      SizeType id{static_cast<SizeType>(node1->id())};
+      state[id] = 2;
+      if ( !mInlineArray[id] ) {
+	depth[id] = 0;
+	continue;
+      }
+      auto onode{consumer(node1)};
+      SizeType oid{static_cast<SizeType>(onode->id())};
+      SizeType d{mInlineArray[oid] ? depth[oid] + 1 : 1};
+      if ( d > MAX_INLINE_DEPTH ) {
+	mInlineArray[id] = false;
+	d = 0;
+      }
+      depth[id] = d;
+    }
+  }
+}
+
+bool
+VerilogWriterImpl::is_inlined(
+  const MvnNode* node
+) const
+{
+  return mInlineArray[node->id()];
 }
 
-string
+NodeNameRef
 VerilogWriterImpl::node_name(
   const MvnNode* node
 )
 {
-  auto name{mNameArray[node->id()]};
-  if ( name == string() ) {
-    ostringstream buf;
-    buf << "node" << node->id();
-    name = buf.str();
-  }
-  return name;
+  return NodeNameRef{mNameArray[node->id()], static_cast<SizeType>(node->id())};
 }
 
 void
@@ -9,10 +9,44 @@
 /// All rights reserved.
 
 #include "ym/mvn.h"
+#include "WriteBuf.h"
 
 
 BEGIN_NAMESPACE_YM_MVN
 
+//////////////////////////////////////////////////////////////////////
+/// @brief ノード名を WriteBuf に書き込むための参照
+///
+/// 名前が設定されていない場合は "node<ID番号>" の形で書き込む．
+/// 文字列を作らずに直接書き込むためのもの．
+//////////////////////////////////////////////////////////////////////
+struct NodeNameRef
+{
+  // 設定されている名前
+  const string& mName;
+
+  // ID番号
+  SizeType mId;
+};
+
+/// @brief ノード名を書き込む．
+inline
+WriteBuf&
+operator<<(
+  WriteBuf& s,            ///< [in] 出力先のバッファ
+  const NodeNameRef& name ///< [in] ノード名
+)
+{
+  if ( name.mName.empty() ) {
+    s << "node" << name.mId;
+  }
+  else {
+    s << name.mName;
+  }
+  return s;
+}
+
+
 //////////////////////////////////////////////////////////////////////
 /// @class VerilogWriterImpl VerilogWriterImpl.h
 /// @brief MvnVerilogWriter の実際の処理を行うクラス
@@ -30,6 +64,37 @@ public:
 
 public:
 
+  /// @brief 出力に用いるスレッド数を設定する．
+  ///
+  /// 0 の時はハードウェアのスレッド数を用いる．
+  void
+  set_thread_num(
+    SizeType thread_num ///< [in] スレッド数
+  );
+
+  /// @brief 出力に用いるスレッド数を返す．
+  SizeType
+  thread_num() const
+  {
+    return mThreadNum;
+  }
+
+  /// @brief 式の埋め込みを行うかどうかを設定する．
+  void
+  set_inline_expr(
+    bool flag ///< [in] 埋め込みを行う時 true にするフラグ
+  )
+  {
+    mInlineExpr = flag;
+  }
+
+  /// @brief 式の埋め込みを行う時 true を返す．
+  bool
+  inline_expr() const
+  {
+    return mInlineExpr;
+  }
+
   /// @brief 内容を出力する．
   void
   dump(
@@ -52,54 +117,109 @@ private:
   //////////////////////////////////////////////////////////////////////
 
   void
-  dump_module(
+  dump_parallel(
     ostream& s,
+    const MvnMgr& mgr
+  );
+
+  void
+  dump_module(
+    WriteBuf& s,
+    const MvnModule* module,
+    const MvnMgr& mgr
+  );
+
+  void
+  dump_module_head(
+    WriteBuf& s,
+    const MvnModule* module
+  );
+
+  void
+  dump_decl(
+    WriteBuf& s,
+    const MvnNode* node
+  );
+
+  void
+  dump_module_io(
+    WriteBuf& s,
     const MvnModule* module,
     const MvnMgr& mgr
   );
 
+  void
+  dump_module_tail(
+    WriteBuf& s
+  );
+
   void
   dump_port(
-    ostream& s,
+    WriteBuf& s,
     const MvnPort* port
   );
 
   void
   dump_port_ref(
-    ostream& s,
+    WriteBuf& s,
     const MvnPortRef& port_ref
   );
 
   void
   dump_node(
-    ostream& s,
+    WriteBuf& s,
     const MvnNode* node,
     const MvnMgr& mgr
   );
 
+  void
+  dump_expr(
+    WriteBuf& s,
+    const MvnNode* node
+  );
+
+  void
+  dump_operand(
+    WriteBuf& s,
+    const MvnNode* node,
+    int min_prec
+  );
+
   void
   dump_uop(
-    ostream& s,
+    WriteBuf& s,
     const MvnNode* node,
     const char* opr_str
   );
 
   void
   dump_binop(
-    ostream& s,
+    WriteBuf& s,
     const MvnNode* node,
     const char* opr_str,
+    int prec,
     bool need_paren = false
   );
 
   void
   dump_nop(
-    ostream& s,
+    WriteBuf& s,
     const MvnNode* node,
-    const char* opr_str
+    const char* opr_str,
+    int prec
+  );
+
+  void
+  mark_inline(
+    const MvnMgr& mgr
   );
 
-  string
+  bool
+  is_inlined(
+    const MvnNode* node
+  ) const;
+
+  NodeNameRef
   node_name(
     const MvnNode* node
   );
@@ -119,6 +239,18 @@ private:
   // ノードのID をキーにして名前を格納する配列
   vector<string> mNameArray;
 
+  // WriteBuf 用の領域
+  vector<char> mBuffer;
+
+  // スレッド数
+  SizeType mThreadNum{1};
+
+  // 式の埋め込みを行う時 true にするフラグ
+  bool mInlineExpr{false};
+
+  // ノードのID をキーにして式として埋め込まれているかを格納する配列
+  vector<bool> mInlineArray;
+
 };
 
 END_NAMESPACE_YM_MVN
@@ -0,0 +1,224 @@
+﻿#ifndef YM_BNNODEHANDLE_H
+#define YM_BNNODEHANDLE_H
+
+/// @file ym/BnNodeHandle.h
+/// @brief BnNodeHandle のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/mvn.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+/// @class BnNodeHandle BnNodeHandle.h "ym/BnNodeHandle.h"
+/// @brief ビットレベルのノードと極性の組を表すクラス
+///
+/// 定数0と定数1も表すことができる．
+/// 内部では ((ノード番号 + 2) * 2 + 極性) の形で符号化しており，
+/// 0 は不正値，2 と 3 はそれぞれ定数0と定数1を表す．
+///
+/// ym-bnet の BnNode は反転属性を持たないので，
+/// 変換途中のビットはこのクラスで表し，実際のノードは
+/// 必要になった時点で NOT ゲートや定数ノードとして作る．
+//////////////////////////////////////////////////////////////////////
+class BnNodeHandle
+{
+public:
+
+  /// @brief 空のコンストラクタ
+  ///
+  /// 不正値となる．
+  BnNodeHandle() = default;
+
+  /// @brief ノード番号と極性を指定したコンストラクタ
+  explicit
+  BnNodeHandle(
+    SizeType id,      ///< [in] ノード番号
+    bool inv = false  ///< [in] 反転属性
+  ) : mBody{((id + 2) << 1) | static_cast<SizeType>(inv)}
+  {
+  }
+
+  /// @brief デストラクタ
+  ~BnNodeHandle() = default;
+
+  /// @brief 定数0を返す．
+  static
+  BnNodeHandle
+  zero()
+  {
+    return BnNodeHandle{2, BodyTag{}};
+  }
+
+  /// @brief 定数1を返す．
+  static
+  BnNodeHandle
+  one()
+  {
+    return BnNodeHandle{3, BodyTag{}};
+  }
+
+  /// @brief 符号化された値から作る．
+  static
+  BnNodeHandle
+  from_body(
+    SizeType body ///< [in] body() の返した値
+  )
+  {
+    return BnNodeHandle{body, BodyTag{}};
+  }
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 適正な値の時 true を返す．
+  bool
+  is_valid() const
+  {
+    return mBody != 0;
+  }
+
+  /// @brief 定数0の時 true を返す．
+  bool
+  is_zero() const
+  {
+    return mBody == 2;
+  }
+
+  /// @brief 定数1の時 true を返す．
+  bool
+  is_one() const
+  {
+    return mBody == 3;
+  }
+
+  /// @brief 定数の時 true を返す．
+  bool
+  is_const() const
+  {
+    return (mBody >> 1) == 1;
+  }
+
+  /// @brief ノード番号を返す．
+  ///
+  /// is_valid() && !is_const() の時のみ意味を持つ．
+  SizeType
+  id() const
+  {
+    return (mBody >> 1) - 2;
+  }
+
+  /// @brief 反転属性を返す．
+  bool
+  inv() const
+  {
+    return static_cast<bool>(mBody & 1);
+  }
+
+  /// @brief 極性を反転させたハンドルを返す．
+  ///
+  /// 不正値の場合はそのまま返す．
+  BnNodeHandle
+  operator~() const
+  {
+    return is_valid() ? BnNodeHandle{mBody ^ 1, BodyTag{}} : *this;
+  }
+
+  /// @brief 極性が正のハンドルを返す．
+  BnNodeHandle
+  posi() const
+  {
+    return is_valid() ? BnNodeHandle{mBody & ~static_cast<SizeType>(1), BodyTag{}} : *this;
+  }
+
+  /// @brief 符号化された値を返す．
+  SizeType
+  body() const
+  {
+    return mBody;
+  }
+
+  /// @brief 等価比較演算子
+  bool
+  operator==(
+    const BnNodeHandle& right
+  ) const
+  {
+    return mBody == right.mBody;
+  }
+
+  /// @brief 非等価比較演算子
+  bool
+  operator!=(
+    const BnNodeHandle& right
+  ) const
+  {
+    return !operator==(right);
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 符号化された値を指定したコンストラクタ
+  struct BodyTag {};
+
+  BnNodeHandle(
+    SizeType body,
+    BodyTag
+  ) : mBody{body}
+  {
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 符号化された値
+  SizeType mBody{0};
+
+};
+
+/// @brief BnNodeHandle の内容を出力する．
+///
+/// 定数は "0"/"1" で，それ以外は "N<ノード番号>" で表し，
+/// 反転している場合は先頭に "~" を付ける．
+inline
+ostream&
+operator<<(
+  ostream& s,
+  const BnNodeHandle& handle
+)
+{
+  if ( !handle.is_valid() ) {
+    s << "---";
+  }
+  else if ( handle.is_zero() ) {
+    s << "0";
+  }
+  else if ( handle.is_one() ) {
+    s << "1";
+  }
+  else {
+    if ( handle.inv() ) {
+      s << "~";
+    }
+    s << "N" << handle.id();
+  }
+  return s;
+}
+
+END_NAMESPACE_YM_MVN
+
+#endif // YM_BNNODEHANDLE_H
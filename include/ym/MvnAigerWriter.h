@@ -0,0 +1,88 @@
+﻿#ifndef YM_MVNAIGERWRITER_H
+#define YM_MVNAIGERWRITER_H
+
+/// @file ym/MvnAigerWriter.h
+/// @brief MvnAigerWriter のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/mvn.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+class AigerWriterImpl;
+struct MvnArithArch;
+
+//////////////////////////////////////////////////////////////////////
+/// @class MvnAigerWriter MvnAigerWriter.h "ym/MvnAigerWriter.h"
+/// @brief Mvn の内容をバイナリ形式の AIGER (.aig) で出力するクラス
+///
+/// 全てのトップモジュールをビットレベルに展開して一つの AIG にする．
+/// 展開の規則は MvnBnConv と同一で，値の意味は MvnSimulator と同じになる．
+/// 同じ入力を持つ AND ノードは一つにまとめられる(構造ハッシュ)．
+///
+/// - 入力ノードと入力の接続されていない入出力ノードの各ビットが
+///   AIGER の入力になる．
+/// - 出力ノードと入力の接続された入出力ノードの各ビットが
+///   AIGER の出力になる．
+/// - DFF の各ビットは AIGER のラッチ(初期値 0)になる．
+///   AIGER は単一の暗黙のクロックを仮定するのでクロック入力は無視する．
+/// - DFF の非同期セット/リセットは同期化して次状態関数に組み込む．
+///   すなわち，制御信号がアクティブなサイクルの次のサイクルで値が変わる．
+///   複数の制御信号がアクティブな場合は番号の若いものが優先される．
+/// - LATCH の各ビットもラッチ(初期値 0)で値を保持し，
+///   イネーブルが 1 の時はデータ入力をそのまま出力する透過型として扱う．
+///
+/// 入出力とラッチには「名前[ビット位置]」の形のシンボルを付ける．
+///
+/// 実際には AigerWriterImpl に丸投げする facade パタン
+//////////////////////////////////////////////////////////////////////
+class MvnAigerWriter
+{
+public:
+
+  /// @brief コンストラクタ
+  MvnAigerWriter();
+
+  /// @brief デストラクタ
+  ~MvnAigerWriter();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // メインの関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 算術演算を展開する際の構成を設定する．
+  void
+  set_arith_arch(
+    const MvnArithArch& arch ///< [in] 構成
+  );
+
+  /// @brief 内容を AIGER 形式で出力する
+  ///
+  /// 変換できないノードがあった場合は何も出力せずに
+  /// s に failbit を立てる．
+  void
+  operator()(
+    ostream& s,       ///< [in] 出力先のストリーム
+    const MvnMgr& mgr ///< [in] Mvn ネットワーク
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 実際に処理を行う実装クラス
+  unique_ptr<AigerWriterImpl> mImpl;
+
+};
+
+END_NAMESPACE_YM_MVN
+
+#endif // YM_MVNAIGERWRITER_H
@@ -0,0 +1,94 @@
+﻿#ifndef YM_MVNBATCHSIMULATOR_H
+#define YM_MVNBATCHSIMULATOR_H
+
+/// @file ym/MvnBatchSimulator.h
+/// @brief MvnBatchSimulator のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/mvn.h"
+#include "ym/MvnBvConst.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+class SimNetwork;
+
+/// @brief 入力系列を表す型
+///
+/// [サイクル番号][入力番号] の順に値を持つ．
+using MvnStimulus = vector<vector<MvnBvConst>>;
+
+/// @brief 出力系列を表す型
+///
+/// [サイクル番号][出力番号] の順に値を持つ．
+using MvnResponse = vector<vector<MvnBvConst>>;
+
+//////////////////////////////////////////////////////////////////////
+/// @class MvnBatchSimulator MvnBatchSimulator.h "ym/MvnBatchSimulator.h"
+/// @brief 複数の入力系列を並列にシミュレーションするクラス
+///
+/// 評価用のネットワークは一つだけ作り，全てのスレッドで読み出し専用で
+/// 共有する．値バッファはスレッドごとに持つ．
+/// 入力系列はスレッドごとのキューに連続した塊で割り振り，
+/// 自分のキューが空になったスレッドは他のスレッドのキューの末尾から
+/// 仕事を盗む．
+///
+/// 各入力系列は全ての DFF の状態が 0 の状態から始まる．
+/// 1サイクルごとに入力を設定して評価し，出力を記録してから
+/// クロックを進める．
+//////////////////////////////////////////////////////////////////////
+class MvnBatchSimulator
+{
+public:
+
+  /// @brief コンストラクタ
+  MvnBatchSimulator(
+    const MvnMgr& mgr,       ///< [in] MvnMgr
+    const MvnModule* module, ///< [in] 対象のモジュール
+    SizeType thread_num = 0  ///< [in] スレッド数
+                             ///< 0 の時はハードウェアのスレッド数を用いる．
+  );
+
+  /// @brief デストラクタ
+  ~MvnBatchSimulator();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief スレッド数を返す．
+  SizeType
+  thread_num() const
+  {
+    return mThreadNum;
+  }
+
+  /// @brief 入力系列のリストをシミュレーションする．
+  /// @return 入力系列ごとの出力系列のリストを返す．
+  vector<MvnResponse>
+  run(
+    const vector<MvnStimulus>& stim_list ///< [in] 入力系列のリスト
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // コンパイル済みのネットワーク
+  std::shared_ptr<const SimNetwork> mNetwork;
+
+  // スレッド数
+  SizeType mThreadNum;
+
+};
+
+END_NAMESPACE_YM_MVN
+
+#endif // YM_MVNBATCHSIMULATOR_H
@@ -0,0 +1,101 @@
+﻿#ifndef YM_MVNBINREADER_H
+#define YM_MVNBINREADER_H
+
+/// @file ym/MvnBinReader.h
+/// @brief MvnBinReader のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/mvn.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+/// @class MvnBinReader MvnBinReader.h "ym/MvnBinReader.h"
+/// @brief MvnBinWriter の出力したバイナリ形式のファイルを読み込むクラス
+///
+/// ファイルは mmap() でメモリ上に写像し，
+/// 固定長のレコードをそのまま参照してネットワークを構築する．
+/// セルは mgr のセルライブラリからセル名で探す．
+//////////////////////////////////////////////////////////////////////
+class MvnBinReader
+{
+public:
+
+  /// @brief コンストラクタ
+  MvnBinReader();
+
+  /// @brief デストラクタ
+  ~MvnBinReader();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // メインの関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ファイルを読み込む．
+  /// @retval true 正常に読み込めた．
+  /// @retval false 読み込み中にエラーが起こった．
+  ///
+  /// 読み込んだモジュールは mgr に追加される．
+  bool
+  read(
+    const string& filename, ///< [in] ファイル名
+    MvnMgr& mgr             ///< [in] 結果を格納する Mvn ネットワーク
+  );
+
+  /// @brief ノードの名前とともにファイルを読み込む．
+  /// @retval true 正常に読み込めた．
+  /// @retval false 読み込み中にエラーが起こった．
+  ///
+  /// ファイル中に名前が記録されていない場合は node_map は変化しない．
+  bool
+  read(
+    const string& filename, ///< [in] ファイル名
+    MvnMgr& mgr,            ///< [in] 結果を格納する Mvn ネットワーク
+    MvnVlMap& node_map      ///< [out] ノードと Verilog 名の対応表
+  );
+
+  /// @brief 指定された出力のファンインコーンのみを読み込む．
+  /// @retval true 正常に読み込めた．
+  /// @retval false 読み込み中にエラーが起こった．
+  ///
+  /// 入力元をたどって到達できるノード(DFF の先も含む)のみを生成する．
+  /// 生成されるモジュールはコーンに含まれる入出力ノードのみを持ち，
+  /// ポートは入出力ノードごとに一つずつ作られる．
+  /// コーンに含まれないノードのレコードは参照しないので，
+  /// 小さなコーンの読み込みは全体の読み込みよりはるかに速い．
+  bool
+  read_cone(
+    const string& filename,              ///< [in] ファイル名
+    const string& module_name,           ///< [in] モジュール名
+    const vector<SizeType>& output_list, ///< [in] 出力番号のリスト
+    MvnMgr& mgr,                         ///< [in] 結果を格納する Mvn ネットワーク
+    MvnVlMap& node_map                   ///< [out] ノードと Verilog 名の対応表
+  );
+
+  /// @brief 指定された名前のノードのファンインコーンのみを読み込む．
+  /// @retval true 正常に読み込めた．
+  /// @retval false 読み込み中にエラーが起こった．
+  ///
+  /// 名前は MvnBinWriter に与えた MvnVlMap の名前で，
+  /// ファイル中の名前索引を用いて探す．
+  /// 入出力ノードでないノードには出力ノードが付け加えられる．
+  /// それ以外は出力番号を指定する場合と同様
+  bool
+  read_cone(
+    const string& filename,          ///< [in] ファイル名
+    const vector<string>& name_list, ///< [in] ノード名のリスト
+    MvnMgr& mgr,                     ///< [in] 結果を格納する Mvn ネットワーク
+    MvnVlMap& node_map               ///< [out] ノードと Verilog 名の対応表
+  );
+
+};
+
+END_NAMESPACE_YM_MVN
+
+#endif // YM_MVNBINREADER_H
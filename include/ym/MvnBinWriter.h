@@ -0,0 +1,63 @@
+﻿#ifndef YM_MVNBINWRITER_H
+#define YM_MVNBINWRITER_H
+
+/// @file ym/MvnBinWriter.h
+/// @brief MvnBinWriter のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/mvn.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+/// @class MvnBinWriter MvnBinWriter.h "ym/MvnBinWriter.h"
+/// @brief MvnMgr の内容をバイナリ形式で出力するクラス
+///
+/// 出力したファイルは MvnBinReader で読み込むことができる．
+/// モジュールとノードの ID 番号は保存されず，
+/// 読み込んだ時には詰めた番号が振り直される．
+/// 読み込んだ結果を書き出したものは元の出力と同じ内容になる．
+/// セルはセル名で記録される．
+//////////////////////////////////////////////////////////////////////
+class MvnBinWriter
+{
+public:
+
+  /// @brief コンストラクタ
+  MvnBinWriter();
+
+  /// @brief デストラクタ
+  ~MvnBinWriter();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // メインの関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 内容をバイナリ形式で出力する．
+  void
+  operator()(
+    ostream& s,       ///< [in] 出力先のストリーム
+    const MvnMgr& mgr ///< [in] Mvn ネットワーク
+  );
+
+  /// @brief ノードの名前とともに内容をバイナリ形式で出力する．
+  ///
+  /// node_map の内容は名前として記録される．
+  void
+  operator()(
+    ostream& s,              ///< [in] 出力先のストリーム
+    const MvnMgr& mgr,       ///< [in] Mvn ネットワーク
+    const MvnVlMap& node_map ///< [in] ノードと Verilog 名の対応表
+  );
+
+};
+
+END_NAMESPACE_YM_MVN
+
+#endif // YM_MVNBINWRITER_H
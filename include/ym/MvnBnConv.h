@@ -12,16 +12,68 @@
 #include "ym/ym_bnet.h"
 
 
-BEGIN_NAMESPACE_YM_NETWORKSBDNCONV
+BEGIN_NAMESPACE_YM_MVN
 
 class MvnConv;
+class MvnLevelizer;
+class BitBuilder;
 
 //////////////////////////////////////////////////////////////////////
-/// @class MvnBdnConv MvnBdnConv.h "MvnBdnConv.h"
+/// @brief 加算器の構成
+//////////////////////////////////////////////////////////////////////
+enum class MvnAdderArch {
+  /// @brief リップルキャリー加算器
+  RippleCarry,
+  /// @brief Kogge-Stone 型の並列プレフィックス加算器
+  KoggeStone,
+  /// @brief Brent-Kung 型の並列プレフィックス加算器
+  BrentKung
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @brief 乗算器の構成
+//////////////////////////////////////////////////////////////////////
+enum class MvnMultArch {
+  /// @brief 部分積を順に足していくアレイ乗算器
+  Array,
+  /// @brief Wallace tree 乗算器
+  Wallace,
+  /// @brief Dadda tree 乗算器
+  Dadda
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @struct MvnArithArch MvnBnConv.h "ym/MvnBnConv.h"
+/// @brief 算術演算をビットレベルに変換する際の構成
+///
+/// mAdder は ADD, SUB, CMPL, LT, DIV, MOD と乗算器の最終段の加算に用いられる．
+/// mMult は MUL と POW に用いられる．
+/// mBooth が true の時は乗算器の部分積を radix-4 の Booth 符号化で作る．
+//////////////////////////////////////////////////////////////////////
+struct MvnArithArch
+{
+  /// @brief 加算器の構成
+  MvnAdderArch mAdder{MvnAdderArch::RippleCarry};
+
+  /// @brief 乗算器の構成
+  MvnMultArch mMult{MvnMultArch::Array};
+
+  /// @brief Booth 符号化を用いる時 true
+  bool mBooth{false};
+
+};
+
+//////////////////////////////////////////////////////////////////////
+/// @class MvnBnConv MvnBnConv.h "ym/MvnBnConv.h"
 /// @brief Mvn から BnNetwork に変換するクラス
 //////////////////////////////////////////////////////////////////////
 class MvnBnConv
 {
+  friend class AigerWriterImpl;
+  friend class CnfWriterImpl;
+
 public:
 
   /// @brief コンストラクタ
@@ -31,19 +83,202 @@ public:
   ~MvnBnConv();
 
 
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 算術演算の構成を指定する関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief デフォルトの構成を設定する．
+  void
+  set_arith_arch(
+    const MvnArithArch& arch ///< [in] 構成
+  )
+  {
+    mDefaultArch = arch;
+  }
+
+  /// @brief ビット幅ごとの構成を設定する．
+  ///
+  /// ビット幅が min_width 以上のノードに適用される．
+  /// 同じ min_width で設定した場合は上書きされる．
+  /// 複数の設定が該当する場合は min_width の最も大きいものが用いられる．
+  void
+  set_arith_arch(
+    SizeType min_width,      ///< [in] ビット幅の下限
+    const MvnArithArch& arch ///< [in] 構成
+  );
+
+  /// @brief ノードごとの構成を設定する．
+  ///
+  /// ビット幅ごとの設定よりも優先される．
+  void
+  set_arith_arch(
+    const MvnNode* node,     ///< [in] 対象のノード
+    const MvnArithArch& arch ///< [in] 構成
+  );
+
+  /// @brief ノードに適用される構成を返す．
+  ///
+  /// ビット幅ごとの設定を探す際には，比較演算(LT)の場合は
+  /// 入力のビット幅を，それ以外はノードのビット幅を用いる．
+  const MvnArithArch&
+  arith_arch(
+    const MvnNode* node ///< [in] 対象のノード
+  ) const;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 並列変換の設定
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 変換に用いるスレッド数を設定する．
+  ///
+  /// 1 の時(デフォルト)はノードを一つずつ順に変換する．
+  /// 2 以上の時はモジュールをレベル分けして，同じレベルのノードを
+  /// スレッドごとに別々のバッファへ並列に変換した後，
+  /// ノードの順にバッファの内容を変換先のネットワークに併合する．
+  /// 併合の順序はスレッドの実行順によらないので，
+  /// スレッド数が 2 以上ならばスレッド数によらず同じネットワークが作られる．
+  /// 0 の時はハードウェアのスレッド数を用いる．
+  ///
+  /// 組み合わせ回路のループがあるモジュールと update() は常に順に変換する．
+  void
+  set_thread_num(
+    SizeType thread_num ///< [in] スレッド数
+  );
+
+  /// @brief 変換に用いるスレッド数を返す．
+  SizeType
+  thread_num() const
+  {
+    return mThreadNum;
+  }
+
+
 public:
   //////////////////////////////////////////////////////////////////////
   // メインの関数
   //////////////////////////////////////////////////////////////////////
 
   /// @brief MvnMgr の内容を BnNetwork に変換する．
-  void
+  /// @return 変換できないノードがあった場合は false を返す．
+  ///
+  /// BnModifier 上に作ったネットワークで bnetwork の内容を置き換える．
+  /// false を返した場合，bnetwork と mvnode_map は変更されない．
+  bool
   operator()(
     const MvnMgr& mvmgr, ///< [in] 対象の MvNetwork
     BnNetwork& bnetwork, ///< [out] 変換先の BnNetwork
     MvnBnMap& mvnode_map ///< [out] 対応関係を格納するオブジェクト
   );
 
+  /// @brief 前回の変換結果を再利用して変換し直す．
+  /// @return 変換できないノードがあった場合は false を返す．
+  ///
+  /// 直前の operator() もしくは update() で作った bnetwork に対して
+  /// 変更のあったノードとその推移的ファンアウトだけを変換し直す．
+  ///
+  /// ノードごとに型，ビット幅，属性，ファンインのノード番号，
+  /// 算術演算の構成を記録しておき，それが前回と一致しないノードを
+  /// 変更されたノードとみなす．比較はハッシュ値ではなく記録そのもので行う．
+  /// 変換し直したノードのビットが前回と同じならそこで伝搬を打ち切る．
+  ///
+  /// ゲートはいったん内部の影のネットワークに作り，bnetwork は
+  /// 現在のノードと DFF/ラッチの入力から参照されているゲートだけで
+  /// 作り直す．そのため置き換えられた古いゲートは bnetwork に残らないが，
+  /// ノード番号は前回と変わることがある．
+  ///
+  /// 以下の場合は全体を変換し直す．
+  /// - 前回の変換結果がない，もしくは bnetwork が前回と異なる．
+  /// - 入出力ノード，DFF，ラッチの構成が変わった．
+  ///
+  /// mvnode_map は変更後の mvmgr から作ったものを渡すこと．
+  /// false を返した場合，bnetwork と mvnode_map は変更されない．
+  /// 変換し直したノード数は last_conv_num() で得られる．
+  bool
+  update(
+    const MvnMgr& mvmgr, ///< [in] 対象の MvNetwork
+    BnNetwork& bnetwork, ///< [inout] 前回の変換先の BnNetwork
+    MvnBnMap& mvnode_map ///< [out] 対応関係を格納するオブジェクト
+  );
+
+  /// @brief 直前の変換で変換した組み合わせ回路のノード数を返す．
+  SizeType
+  last_conv_num() const
+  {
+    return mConvNum;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // ノードの構造の記録
+  struct NodeRec;
+
+  // 差分変換用に前回の変換結果を保持する構造体
+  struct IncData;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 全体を変換する．
+  /// @return 変換できないノードがあった場合は false を返す．
+  ///
+  /// 次回の update() のために変換結果を mIncData に記録する．
+  bool
+  conv_all(
+    const MvnMgr& mvmgr, ///< [in] 対象の MvNetwork
+    BnNetwork& bnetwork, ///< [out] 変換先の BnNetwork
+    MvnBnMap& mvnode_map ///< [out] 対応関係を格納するオブジェクト
+  );
+
+  /// @brief 組み合わせ回路部分をレベルごとに並列に変換する．
+  /// @return 変換できないノードがあった場合は false を返す．
+  bool
+  conv_parallel(
+    const MvnLevelizer& lv, ///< [in] 対象のモジュールのレベル化の結果
+    BitBuilder& builder,    ///< [in] ゲートを作るオブジェクト
+    MvnBnMap& nodemap       ///< [inout] ノードの対応関係を表すマップ
+  ) const;
+
+  /// @brief 組み合わせ回路のノードをビットレベルのゲートに変換する．
+  /// @return 変換できなかった場合は false を返す．
+  ///
+  /// false を返した場合，nodemap にそのノードは登録されない．
+  bool
+  conv_node(
+    const MvnNode* node,  ///< [in] 対象のノード
+    BitBuilder& builder,  ///< [in] ゲートを作るオブジェクト
+    MvnBnMap& nodemap     ///< [inout] ノードの対応関係を表すマップ
+  ) const;
+
+  /// @brief 影のネットワークから BnNetwork を作る．
+  ///
+  /// 参照されないゲートが多くなった場合は影のネットワークも詰める．
+  void
+  emit(
+    const MvnMgr& mvmgr,  ///< [in] 対象の MvNetwork
+    IncData& data,        ///< [inout] 変換結果
+    BnNetwork& bnetwork,  ///< [out] 変換先の BnNetwork
+    MvnBnMap& mvnode_map  ///< [out] 対応関係を格納するオブジェクト
+  ) const;
+
+  /// @brief ノードの構造を記録する．
+  ///
+  /// 型，ビット幅，型ごとの属性，各入力のビット幅とファンインのノード番号，
+  /// 算術演算の構成を記録する．
+  NodeRec
+  node_rec(
+    const MvnNode* node ///< [in] 対象のノード
+  ) const;
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -53,8 +288,27 @@ private:
   // MvNode の変換関数のリスト
   vector<unique_ptr<MvnConv>> mConvList;
 
+  // デフォルトの算術演算の構成
+  MvnArithArch mDefaultArch;
+
+  // ビット幅の下限と構成の組のリスト
+  // ビット幅の昇順に並んでいる．
+  vector<pair<SizeType, MvnArithArch>> mWidthArchList;
+
+  // ノード番号をキーにして構成を格納するハッシュ表
+  unordered_map<SizeType, MvnArithArch> mNodeArchMap;
+
+  // スレッド数
+  SizeType mThreadNum{1};
+
+  // 直前の変換で変換したノード数
+  SizeType mConvNum{0};
+
+  // 前回の変換結果
+  unique_ptr<IncData> mIncData;
+
 };
 
-END_NAMESPACE_YM_NETWORKSBDNCONV
+END_NAMESPACE_YM_MVN
 
-#endif // YM_MVNBDNCONV_H
+#endif // YM_MVNBNCONV_H
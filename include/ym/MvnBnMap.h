@@ -9,22 +9,34 @@
 /// All rights reserved.
 
 #include "ym/mvn.h"
-#include "ym/ym_bnet.h"
+#include "ym/BnNodeHandle.h"
 
 
-BEGIN_NAMESPACE_YM_NETWORKSBDNCONV
+BEGIN_NAMESPACE_YM_MVN
 
 //////////////////////////////////////////////////////////////////////
 /// @class MvnBnMap MvnBnMap.h "MvnBnMap.h"
 /// @brief MvnNode と BnNode の対応を記録するクラス
+///
+/// ノードごとに配列を持つのではなく，ビット幅の累積和で求めた
+/// オフセットの表と全ビット分のハンドルを連続して格納する配列を持つ．
+/// node の b ビット目のハンドルは
+/// mHandleArray[mOffsetArray[node->id()] + b] に格納される．
+/// コンストラクタの呼び出し後に作られたノードや，番号を再利用して
+/// ビット幅の変わったノードを put() した場合は表を作り直す．
+/// その際，以前にその番号に登録されていたハンドルは捨てられる．
+/// get() では登録時とビット幅の異なるノードは登録されていないものとみなす．
 //////////////////////////////////////////////////////////////////////
 class MvnBnMap
 {
 public:
 
   /// @brief コンストラクタ
+  ///
+  /// mgr の各ノードのビット幅からオフセットの表を作る．
+  /// ハンドルは全て不正値で初期化される．
   MvnBnMap(
-    int n ///< [in] MvnNode の ID の最大値
+    const MvnMgr& mgr ///< [in] 対象の MvnMgr
   );
 
   /// @brief デストラクタ
@@ -64,12 +76,41 @@ public:
   ) const;
 
 
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ノードの格納領域の大きさを返す．
+  ///
+  /// 表の範囲外のノード番号の場合は 0 を返す．
+  SizeType
+  slot_size(
+    SizeType id ///< [in] ノード番号
+  ) const;
+
+  /// @brief ノードの格納領域の大きさを変える．
+  ///
+  /// 必要に応じて表を伸ばす．
+  /// 他のノードのハンドルは保たれる．
+  void
+  resize_slot(
+    SizeType id, ///< [in] ノード番号
+    SizeType bw  ///< [in] 新しいビット幅
+  );
+
+
 private:
   //////////////////////////////////////////////////////////////////////
   // データメンバ
   //////////////////////////////////////////////////////////////////////
 
-  vector<vector<BnNodeHandle> > mArray;
+  // ノード番号をキーにしてハンドルの格納位置の先頭を保持する配列
+  // サイズはノード番号の最大値 + 1 で末尾は全ビット数となる．
+  vector<SizeType> mOffsetArray;
+
+  // 全ノードのハンドルを連続して格納する配列
+  vector<BnNodeHandle> mHandleArray;
 
 };
 
@@ -83,6 +124,6 @@ dump_mvnode_map(
   const MvnBnMap& mvnode_map  ///< [in] 対応関係のマップ
 );
 
-END_NAMESPACE_YM_NETWORKSBDNCONV
+END_NAMESPACE_YM_MVN
 
-#endif // YM_MVNBDNMAP_H
+#endif // YM_MVNBNMAP_H
@@ -0,0 +1,77 @@
+﻿#ifndef YM_MVNBTORWRITER_H
+#define YM_MVNBTORWRITER_H
+
+/// @file ym/MvnBtorWriter.h
+/// @brief MvnBtorWriter のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/mvn.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+class BtorWriterImpl;
+
+//////////////////////////////////////////////////////////////////////
+/// @class MvnBtorWriter MvnBtorWriter.h "ym/MvnBtorWriter.h"
+/// @brief Mvn の内容をワードレベルのまま BTOR2 形式で出力するクラス
+///
+/// 全てのトップモジュールをトポロジカル順に一度だけたどって
+/// 各ノードを BTOR2 の演算に対応させて出力する．
+/// ビット幅の違いは uext/slice で吸収し，値の意味は MvnSimulator と同じになる．
+///
+/// - 入力ノードと入力の接続されていない入出力ノードは input になる．
+/// - 出力ノードと入力の接続された入出力ノードは output になる．
+/// - DFF は state (初期値 0)になり，クロック入力は無視する．
+///   非同期セット/リセットは同期化して next の式に組み込む．
+///   複数の制御信号がアクティブな場合は番号の若いものが優先される．
+/// - LATCH は値を保持する state を持ち，イネーブルが 1 の時は
+///   データ入力をそのまま出力する透過型として扱う．
+/// - BTOR2 に対応する演算のない POW は乗算の繰り返しに展開する．
+/// - 0 による除算は商も余りも 0 となるように ite で補正する．
+///
+/// bad や constraint は出力しないので，検証する性質は
+/// 出力を用いて利用者が追加する必要がある．
+///
+/// 実際には BtorWriterImpl に丸投げする facade パタン
+//////////////////////////////////////////////////////////////////////
+class MvnBtorWriter
+{
+public:
+
+  /// @brief コンストラクタ
+  MvnBtorWriter();
+
+  /// @brief デストラクタ
+  ~MvnBtorWriter();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // メインの関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 内容を BTOR2 形式で出力する
+  void
+  operator()(
+    ostream& s,       ///< [in] 出力先のストリーム
+    const MvnMgr& mgr ///< [in] Mvn ネットワーク
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 実際に処理を行う実装クラス
+  unique_ptr<BtorWriterImpl> mImpl;
+
+};
+
+END_NAMESPACE_YM_MVN
+
+#endif // YM_MVNBTORWRITER_H
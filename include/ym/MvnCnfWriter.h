@@ -0,0 +1,100 @@
+﻿#ifndef YM_MVNCNFWRITER_H
+#define YM_MVNCNFWRITER_H
+
+/// @file ym/MvnCnfWriter.h
+/// @brief MvnCnfWriter のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/mvn.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+class CnfWriterImpl;
+struct MvnArithArch;
+
+//////////////////////////////////////////////////////////////////////
+/// @class MvnCnfWriter MvnCnfWriter.h "ym/MvnCnfWriter.h"
+/// @brief MvnModule の論理コーンを DIMACS 形式の CNF で出力するクラス
+///
+/// 指定されたノード(根)から入力側にたどれる組み合わせ回路部分を
+/// ビットレベルに展開し，各ゲートを Tseitin 符号化した節を
+/// 作られた順にそのまま出力する．
+/// そのため節の集合をメモリ上に保持することはない．
+/// 展開の規則は MvnBnConv と同一である．
+///
+/// - 入力ノード，入力の接続されていない入出力ノード，DFF，LATCH の
+///   各ビットは自由変数となる．
+/// - 定数は符号化の際に伝搬させて取り除く．
+///   根のビットが定数になった場合のみ単位節で固定した変数を用いる．
+/// - 自由変数と根のビットの変数との対応は
+///   "c input node<ID> <ビット位置> <リテラル>" と
+///   "c output node<ID> <ビット位置> <リテラル>" の形のコメント行で出力する．
+///   (DFF と LATCH の場合は input の代わりに state となる)
+///
+/// ヘッダ行の変数と節の数は最後にシークして書き込む．
+/// 出力先がシークできない場合は数えるためだけに一度余分に展開を行う．
+///
+/// 実際には CnfWriterImpl に丸投げする facade パタン
+//////////////////////////////////////////////////////////////////////
+class MvnCnfWriter
+{
+public:
+
+  /// @brief コンストラクタ
+  MvnCnfWriter();
+
+  /// @brief デストラクタ
+  ~MvnCnfWriter();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // メインの関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 算術演算を展開する際の構成を設定する．
+  void
+  set_arith_arch(
+    const MvnArithArch& arch ///< [in] 構成
+  );
+
+  /// @brief モジュールの全ての出力のコーンを出力する．
+  ///
+  /// 出力ノードと入力の接続された入出力ノードが根となる．
+  /// 変換できないノードがあった場合は s に failbit を立てる．
+  void
+  operator()(
+    ostream& s,               ///< [in] 出力先のストリーム
+    const MvnMgr& mgr,        ///< [in] Mvn ネットワーク
+    const MvnModule* module   ///< [in] 対象のモジュール
+  );
+
+  /// @brief 指定されたノードのコーンを出力する．
+  ///
+  /// root_list のノードは全て同じモジュールに属していなければならない．
+  /// 変換できないノードがあった場合は s に failbit を立てる．
+  void
+  operator()(
+    ostream& s,                             ///< [in] 出力先のストリーム
+    const MvnMgr& mgr,                      ///< [in] Mvn ネットワーク
+    const vector<const MvnNode*>& root_list ///< [in] 根のノードのリスト
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 実際に処理を行う実装クラス
+  unique_ptr<CnfWriterImpl> mImpl;
+
+};
+
+END_NAMESPACE_YM_MVN
+
+#endif // YM_MVNCNFWRITER_H
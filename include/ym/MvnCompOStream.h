@@ -0,0 +1,125 @@
+﻿#ifndef YM_MVNCOMPOSTREAM_H
+#define YM_MVNCOMPOSTREAM_H
+
+/// @file ym/MvnCompOStream.h
+/// @brief MvnCompOStream のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/mvn.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+class CompStreamBuf;
+
+//////////////////////////////////////////////////////////////////////
+/// @class MvnCompOStream MvnCompOStream.h "ym/MvnCompOStream.h"
+/// @brief 圧縮しながらファイルに書き出す出力ストリーム
+///
+/// 書き込まれた内容は大きなバッファに貯めておき，
+/// 一杯になったらバックグラウンドのスレッドに渡して
+/// 圧縮とファイルへの書き出しを行う．
+/// その間に次のバッファへの書き込みを続けることができる．
+///
+/// ostream として振る舞うので MvnVerilogWriter や MvnDumper，
+/// dump_node_map() などの出力先としてそのまま用いることができる．
+///
+/// flush() を呼ぶとそれまでの内容を圧縮の区切りを入れて
+/// ファイルまで書き出す．圧縮率が落ちるので endl の多用は避けること．
+/// 書き出しに失敗するとそれ以降の書き込みで badbit が立つ．
+/// 残りの内容は close() かデストラクタで書き出される．
+//////////////////////////////////////////////////////////////////////
+class MvnCompOStream :
+  public ostream
+{
+public:
+
+  /// @brief 空のコンストラクタ
+  ///
+  /// open() でファイルを開く必要がある．
+  MvnCompOStream();
+
+  /// @brief ファイルを開くコンストラクタ
+  ///
+  /// 開けなかった場合には failbit が立つ．
+  explicit
+  MvnCompOStream(
+    const string& filename,                   ///< [in] ファイル名
+    MvnCompType comp_type = MvnCompType::Auto ///< [in] 圧縮形式
+  );
+
+  /// @brief デストラクタ
+  ///
+  /// 開いている場合は close() を呼ぶ．
+  ~MvnCompOStream();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ファイルを開く．
+  /// @return 開けた時 true を返す．
+  ///
+  /// 開けなかった場合には failbit が立つ．
+  bool
+  open(
+    const string& filename,                   ///< [in] ファイル名
+    MvnCompType comp_type = MvnCompType::Auto ///< [in] 圧縮形式
+  );
+
+  /// @brief 残りの内容を書き出してファイルを閉じる．
+  /// @return 全ての内容を書き出せた時 true を返す．
+  ///
+  /// 書き込みに失敗していた場合には failbit が立つ．
+  bool
+  close();
+
+  /// @brief ファイルが開いている時 true を返す．
+  bool
+  is_open() const;
+
+  /// @brief 実際に用いられる圧縮形式を返す．
+  ///
+  /// MvnCompType::Auto を指定した場合は拡張子から決めた形式を返す．
+  MvnCompType
+  comp_type() const;
+
+  /// @brief 圧縮レベルを設定する．
+  ///
+  /// open() の前に設定する．
+  /// 0 から 9 までの値で，大きいほど圧縮率が高い．
+  /// デフォルトは 6
+  void
+  set_level(
+    int level ///< [in] 圧縮レベル
+  );
+
+  /// @brief ファイル名の拡張子から圧縮形式を決める．
+  static
+  MvnCompType
+  comp_type_from_filename(
+    const string& filename ///< [in] ファイル名
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 実際の処理を行うバッファ
+  unique_ptr<CompStreamBuf> mBuf;
+
+  // 圧縮レベル
+  int mLevel{6};
+
+};
+
+END_NAMESPACE_YM_MVN
+
+#endif // YM_MVNCOMPOSTREAM_H
@@ -0,0 +1,77 @@
+﻿#ifndef YM_MVNCXXWRITER_H
+#define YM_MVNCXXWRITER_H
+
+/// @file ym/MvnCxxWriter.h
+/// @brief MvnCxxWriter のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/mvn.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+class CxxWriterImpl;
+
+//////////////////////////////////////////////////////////////////////
+/// @class MvnCxxWriter MvnCxxWriter.h "ym/MvnCxxWriter.h"
+/// @brief Mvn の内容をコンパイル型シミュレーション用の C++ で出力するクラス
+///
+/// モジュールごとに以下のメンバを持つ構造体 mvn_<モジュール名> を出力する．
+/// - input_words/output_words: 入出力用の配列のワード数
+/// - reset(): 状態(DFF とラッチ)を 0 にする．
+/// - eval(in, out): 組み合わせ回路を評価する．
+/// - step(): クロックを1サイクル進めて DFF の値を更新する．
+///
+/// in には入力ノード，入力の接続されていない入出力ノードの順に
+/// 各々 64 ビット単位のワードで値を詰める．
+/// out には出力ノード，入出力ノードの順に値が書き込まれる．
+/// 評価はトポロジカル順の直線的なコードで行い，64 ビット以下のノードは
+/// uint64_t の演算で，それより大きいノードは出力ファイル中に
+/// 含まれる多倍長演算用の補助関数で計算する．
+/// 値の意味は MvnSimulator と同一である．
+///
+/// 実際には CxxWriterImpl に丸投げする facade パタン
+//////////////////////////////////////////////////////////////////////
+class MvnCxxWriter
+{
+public:
+
+  /// @brief コンストラクタ
+  MvnCxxWriter();
+
+  /// @brief デストラクタ
+  ~MvnCxxWriter();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // メインの関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 内容を C++ 形式で出力する
+  ///
+  /// 組み合わせ回路のループを持つモジュールはその旨のコメントのみを出力し，
+  /// 全てのモジュールを出力した後で s に failbit を立てる．
+  void
+  operator()(
+    ostream& s,       ///< [in] 出力先のストリーム
+    const MvnMgr& mgr ///< [in] Mvn ネットワーク
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 実際に処理を行う実装クラス
+  unique_ptr<CxxWriterImpl> mImpl;
+
+};
+
+END_NAMESPACE_YM_MVN
+
+#endif // YM_MVNCXXWRITER_H
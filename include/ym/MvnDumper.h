@@ -16,6 +16,14 @@ BEGIN_NAMESPACE_YM_MVN
 //////////////////////////////////////////////////////////////////////
 /// @class MvnDumper MvnDumper.h "ym/MvnDumper.h"
 /// @brief Mvn の内容を出力するためのクラス
+///
+/// 出力は固定長のバッファに詰めてまとめて書き出す．
+/// バッファの領域はオブジェクトごとに確保して使い回す．
+///
+/// 以下の制限を設けることができる．
+/// - 出力する総文字数の上限
+/// - 出力するノードの型
+/// - 出力するモジュールの名前
 //////////////////////////////////////////////////////////////////////
 class MvnDumper
 {
@@ -28,6 +36,53 @@ public:
   ~MvnDumper();
 
 
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 設定を行う関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 出力する総文字数の上限を設定する．
+  ///
+  /// 0 の時は上限を設けない．
+  /// 上限はノード単位で判定するので，実際の出力は
+  /// 最後のノードの分と打ち切りを表す行の分だけ上限を超えることがある．
+  void
+  set_limit(
+    SizeType limit ///< [in] 総文字数の上限
+  )
+  {
+    mLimit = limit;
+  }
+
+  /// @brief 出力するノードの型を設定する．
+  ///
+  /// 空の時は全ての型のノードを出力する．
+  void
+  set_type_filter(
+    const vector<MvnNodeType>& type_list ///< [in] ノードの型のリスト
+  );
+
+  /// @brief 出力するモジュールの名前を設定する．
+  ///
+  /// 空の時は全てのモジュールを出力する．
+  void
+  set_module_filter(
+    const vector<string>& name_list ///< [in] モジュール名のリスト
+  )
+  {
+    mModuleFilter = name_list;
+  }
+
+  /// @brief 全ての制限を解除する．
+  void
+  clear_filter()
+  {
+    mLimit = 0;
+    mTypeFilter.clear();
+    mModuleFilter.clear();
+  }
+
+
 public:
   //////////////////////////////////////////////////////////////////////
   // メインの関数
@@ -40,6 +95,56 @@ public:
     const MvnMgr& mgr ///< [in] Mvn ネットワーク
   );
 
+  /// @brief 内容をファイルに出力する
+  /// @return 書き出せた時 true を返す．
+  ///
+  /// comp_type が MvnCompType::Auto の時は拡張子で圧縮形式を決める．
+  /// 圧縮はバックグラウンドのスレッドで行われる．
+  bool
+  operator()(
+    const string& filename,                   ///< [in] ファイル名
+    const MvnMgr& mgr,                        ///< [in] Mvn ネットワーク
+    MvnCompType comp_type = MvnCompType::Auto ///< [in] 圧縮形式
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief モジュールが出力対象の時 true を返す．
+  bool
+  is_selected(
+    const MvnModule* module ///< [in] 対象のモジュール
+  ) const;
+
+  /// @brief ノードが出力対象の時 true を返す．
+  bool
+  is_selected(
+    const MvnNode* node ///< [in] 対象のノード
+  ) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 総文字数の上限
+  SizeType mLimit{0};
+
+  // ノードの型をキーにして出力対象の時 true となる配列
+  // 空の時は全ての型が対象となる．
+  vector<bool> mTypeFilter;
+
+  // 出力対象のモジュール名のリスト
+  // 空の時は全てのモジュールが対象となる．
+  vector<string> mModuleFilter;
+
+  // 出力用のバッファの領域
+  vector<char> mBuffer;
+
 };
 
 END_NAMESPACE_YM_MVN
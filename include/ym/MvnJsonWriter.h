@@ -0,0 +1,108 @@
+﻿#ifndef YM_MVNJSONWRITER_H
+#define YM_MVNJSONWRITER_H
+
+/// @file ym/MvnJsonWriter.h
+/// @brief MvnJsonWriter のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/mvn.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+class JsonWriterImpl;
+
+//////////////////////////////////////////////////////////////////////
+/// @class MvnJsonWriter MvnJsonWriter.h "ym/MvnJsonWriter.h"
+/// @brief Mvn の内容を JSON Lines 形式で出力するクラス
+///
+/// 1行に1つの JSON オブジェクトを出力する．"kind" の値でレコードの種類を表す．
+/// - "module": id, name, parent(階層化されたモジュールの場合), inputs, outputs, inouts
+/// - "node": id, module, type, width および型ごとの属性
+///   (DFF の clock_pol/control_pol/control_val, CASEEQ の xmask,
+///    CONSTBITSELECT の bitpos, CONSTPARTSELECT の msb/lsb,
+///    CONSTVALUE の value, CELL の cell など)
+/// - "edge": src, dst, pin, width
+///
+/// 枝のレコードは終点のノードのレコードの直後に出力する．
+///
+/// set_cone() を用いると出力対象を指定したノードの
+/// ファンイン/ファンアウトのコーンに制限できる．
+/// 両端が出力対象のノードの枝のみを出力する．
+///
+/// 実際には JsonWriterImpl に丸投げする facade パタン
+//////////////////////////////////////////////////////////////////////
+class MvnJsonWriter
+{
+public:
+
+  /// @brief コンストラクタ
+  MvnJsonWriter();
+
+  /// @brief デストラクタ
+  ~MvnJsonWriter();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 設定を行う関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 出力対象を根のノードのコーンに制限する．
+  ///
+  /// 根のノードから入力ピンの接続をたどって fanin_depth 段までの
+  /// ファンインと fanout_depth 段までのファンアウトを出力対象とする．
+  /// 深さに制限を設けない場合には十分大きな値を指定する．
+  void
+  set_cone(
+    const vector<SizeType>& root_list, ///< [in] 根のノード番号のリスト
+    SizeType fanin_depth,              ///< [in] ファンイン方向の深さ
+    SizeType fanout_depth              ///< [in] ファンアウト方向の深さ
+  );
+
+  /// @brief コーンの制限を解除する．
+  ///
+  /// 全てのノードが出力対象となる．
+  void
+  clear_cone();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // メインの関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 内容を JSON Lines 形式で出力する
+  void
+  operator()(
+    ostream& s,       ///< [in] 出力先のストリーム
+    const MvnMgr& mgr ///< [in] Mvn ネットワーク
+  );
+
+  /// @brief 内容を JSON Lines 形式で出力する
+  ///
+  /// ノードに対応する Verilog 名も出力する．
+  void
+  operator()(
+    ostream& s,              ///< [in] 出力先のストリーム
+    const MvnMgr& mgr,       ///< [in] Mvn ネットワーク
+    const MvnVlMap& node_map ///< [in] ノードと Verilog 名の対応表
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 実際に処理を行う実装クラス
+  unique_ptr<JsonWriterImpl> mImpl;
+
+};
+
+END_NAMESPACE_YM_MVN
+
+#endif // YM_MVNJSONWRITER_H
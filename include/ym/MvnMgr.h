@@ -665,6 +665,10 @@ private:
     SizeType obit_width                       ///< [in] 出力のビット幅
   );
 
+  /// @brief 削除を遅らせたノードをノードリストから取り除いて解放する．
+  void
+  flush_garbage();
+
   /// @brief ノードを登録する．
   void
   reg_node(
@@ -700,6 +704,13 @@ private:
   // ノードのID番号を管理するためのオブジェクト
   ItvlMgr mNodeItvlMgr;
 
+  // ノードリストからの削除を遅らせる時 true にするフラグ
+  // sweep() の間だけ true になる．
+  bool mDeferUnlink{false};
+
+  // 削除を遅らせたノードのリスト
+  vector<MvnNode*> mGarbageList;
+
 };
 
 
@@ -0,0 +1,276 @@
+﻿#ifndef YM_MVNPATTERNSIMULATOR_H
+#define YM_MVNPATTERNSIMULATOR_H
+
+/// @file ym/MvnPatternSimulator.h
+/// @brief MvnPatternSimulator のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/mvn.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+class SimNetwork;
+struct SimOp;
+
+//////////////////////////////////////////////////////////////////////
+/// @class MvnPatternSimulator MvnPatternSimulator.h "ym/MvnPatternSimulator.h"
+/// @brief MvnModule のビット並列パタンシミュレータ
+///
+/// 各ノードの各ビットに対して pattern_num() 個の独立したパタンの値を
+/// ビットごとに詰めて保持し，ビット演算で一度に評価する．
+/// 1ビットあたりのワード数 pat_words を増やすと内側のループが
+/// コンパイラによってベクトル化されるので，AVX2/AVX-512 が使える環境では
+/// 4/8 を指定するとよい．
+///
+/// 値の配置は「ビット」→「ワード」の順で，ノードの b ビット目の
+/// k ワード目は [b * pat_words + k] に置かれる．
+///
+/// 算術演算はビットスライス化した加算器/乗算器/除算器で評価する．
+/// 順序回路の扱いは MvnSimulator と同様である．
+//////////////////////////////////////////////////////////////////////
+class MvnPatternSimulator
+{
+public:
+
+  /// @brief コンストラクタ
+  MvnPatternSimulator(
+    const MvnMgr& mgr,       ///< [in] MvnMgr
+    const MvnModule* module, ///< [in] 対象のモジュール
+    SizeType pat_words = 1   ///< [in] 1ビットあたりのワード数
+  );
+
+  /// @brief デストラクタ
+  ~MvnPatternSimulator();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 値を設定する関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 1ビットあたりのワード数を返す．
+  SizeType
+  pat_words() const
+  {
+    return mPatWords;
+  }
+
+  /// @brief 一度に扱うパタン数を返す．
+  SizeType
+  pattern_num() const
+  {
+    return mPatWords * 64;
+  }
+
+  /// @brief 入力の値を設定する．
+  void
+  set_input(
+    SizeType pos,                    ///< [in] 入力番号 ( 0 <= pos < module->input_num() )
+    const vector<std::uint64_t>& val ///< [in] 値 ( bit_width * pat_words() ワード )
+  );
+
+  /// @brief ノードの値を設定する．
+  ///
+  /// 対象のノードは INPUT，入力の接続されていない INOUT，DFF のいずれか
+  void
+  set_value(
+    const MvnNode* node,             ///< [in] 対象のノード
+    const vector<std::uint64_t>& val ///< [in] 値 ( bit_width * pat_words() ワード )
+  );
+
+  /// @brief 全ての入力にランダムな値を設定する．
+  template<class URNG>
+  void
+  set_random_input(
+    URNG& rg ///< [in] 乱数生成器 ( 64ビットの値を生成するもの )
+  )
+  {
+    for ( SizeType pos = 0; pos < mInputList.size(); ++ pos ) {
+      auto dst{_value_ptr(mInputList[pos])};
+      SizeType n{_bit_width(mInputList[pos]) * mPatWords};
+      for ( SizeType i = 0; i < n; ++ i ) {
+	dst[i] = rg();
+      }
+    }
+    mDirty = true;
+  }
+
+  /// @brief 全ての DFF にランダムな値を設定する．
+  template<class URNG>
+  void
+  set_random_state(
+    URNG& rg ///< [in] 乱数生成器 ( 64ビットの値を生成するもの )
+  )
+  {
+    for ( auto id: mDffIdList ) {
+      auto dst{_value_ptr(id)};
+      SizeType n{_bit_width(id) * mPatWords};
+      for ( SizeType i = 0; i < n; ++ i ) {
+	dst[i] = rg();
+      }
+    }
+    mDirty = true;
+  }
+
+  /// @brief 全ての DFF の状態を 0 にする．
+  void
+  reset_state();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // シミュレーションを行う関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 現在の入力と状態で組み合わせ回路部分を評価する．
+  void
+  eval();
+
+  /// @brief クロックを進める．
+  void
+  step(
+    SizeType n = 1 ///< [in] サイクル数
+  );
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 値を取り出す関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 出力の値を返す．
+  vector<std::uint64_t>
+  output(
+    SizeType pos ///< [in] 出力番号 ( 0 <= pos < module->output_num() )
+  );
+
+  /// @brief ノードの値を返す．
+  vector<std::uint64_t>
+  value(
+    const MvnNode* node ///< [in] 対象のノード
+  );
+
+  /// @brief ノードの1ビット分の値を返す．
+  ///
+  /// pat_words() ワードの領域を指している．
+  /// 次に値を変更する関数を呼ぶまで有効
+  const std::uint64_t*
+  bit_value(
+    const MvnNode* node, ///< [in] 対象のノード
+    SizeType bit         ///< [in] ビット位置
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ノードのビット幅を返す．
+  SizeType
+  _bit_width(
+    SizeType id ///< [in] ノード番号
+  ) const
+  {
+    return mWidthArray[id];
+  }
+
+  /// @brief ノードの値の先頭を返す．
+  std::uint64_t*
+  _value_ptr(
+    SizeType id ///< [in] ノード番号
+  )
+  {
+    return &mValArray[mOffsetArray[id] * mPatWords];
+  }
+
+  /// @brief ノード番号を指定して値を設定する．
+  void
+  _set_value(
+    SizeType id,                     ///< [in] ノード番号
+    const vector<std::uint64_t>& val ///< [in] 値
+  );
+
+  /// @brief ノード番号を指定して値を取り出す．
+  vector<std::uint64_t>
+  _value(
+    SizeType id ///< [in] ノード番号
+  );
+
+  /// @brief 組み合わせ回路ノードを一つ評価する．
+  void
+  _eval_op(
+    const SimOp& op ///< [in] 評価情報
+  );
+
+  /// @brief 非同期制御信号を反映させる．
+  /// @return 値が変化したら true を返す．
+  bool
+  _apply_async();
+
+  /// @brief 必要なら評価を行う．
+  void
+  _update()
+  {
+    if ( mDirty ) {
+      eval();
+    }
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // コンパイル済みのネットワーク
+  std::shared_ptr<const SimNetwork> mNetwork;
+
+  // 1ビットあたりのワード数
+  SizeType mPatWords;
+
+  // ノード番号をキーにしてビット幅を格納する配列
+  vector<SizeType> mWidthArray;
+
+  // ノード番号をキーにして値の先頭位置(ビット単位)を格納する配列
+  vector<SizeType> mOffsetArray;
+
+  // 入力ノード番号のリスト
+  vector<SizeType> mInputList;
+
+  // DFF ノード番号のリスト
+  vector<SizeType> mDffIdList;
+
+  // DFF ごとの次状態バッファ上の位置(ビット単位)
+  vector<SizeType> mNextOffsetArray;
+
+  // 値バッファ
+  vector<std::uint64_t> mValArray;
+
+  // 次状態バッファ
+  vector<std::uint64_t> mNextArray;
+
+  // 作業領域
+  vector<std::uint64_t> mWorkArray;
+
+  // 作業領域1つ分のワード数
+  SizeType mWorkSize;
+
+  // キャリー用の作業領域
+  vector<std::uint64_t> mCarryArray;
+
+  // セルの入力値用の作業領域
+  vector<std::uint64_t> mCellInputArray;
+
+  // 再評価が必要な時 true にするフラグ
+  bool mDirty{true};
+
+};
+
+END_NAMESPACE_YM_MVN
+
+#endif // YM_MVNPATTERNSIMULATOR_H
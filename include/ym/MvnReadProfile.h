@@ -0,0 +1,241 @@
+﻿#ifndef YM_MVNREADPROFILE_H
+#define YM_MVNREADPROFILE_H
+
+/// @file ym/MvnReadProfile.h
+/// @brief MvnReadProfile のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/mvn.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+/// @class MvnReadProfile MvnReadProfile.h "ym/MvnReadProfile.h"
+/// @brief MvnVerilogReader::gen_network() の処理段階ごとの計測結果
+///
+/// 段階ごとに以下の値を記録する．
+/// - 経過時間(秒)
+/// - gen_network() を呼んだスレッドの CPU 時間(秒)
+///   (RUSAGE_THREAD が使えない環境ではプロセス全体の CPU 時間)
+/// - 生成したノード数(ノードの ID 番号の増分なので後で削除されたものも含む)
+/// - 段階の開始時と終了時のプロセスの常駐メモリ量の差(KB)
+///   (/proc/self/statm から求める．解放された分があると負になる．
+///    /proc が使えない環境では常に 0)
+///
+/// 常駐メモリ量はプロセス全体の値なので，他のスレッドが同時に
+/// メモリを使った場合はその分も含まれる．
+///
+/// 段階名は以下のとおり．
+/// - gen_network: 全体
+/// - cache_load:  キャッシュファイルの読み込み
+/// - parse:       キャッシュを用いる時に保留していた構文解析
+/// - elaborate:   エラボレーション
+/// - gen_module:  モジュールの生成
+/// - decl:        モジュール(インスタンス)ごとの宣言要素の生成
+/// - item:        モジュール(インスタンス)ごとの要素の生成
+/// - connect:     ドライバの結線
+/// - sweep:       冗長なノードの削除
+/// - cache_save:  キャッシュファイルの書き出し
+///
+/// decl と item は MvnVerilogReader::set_module_profile() で
+/// 指定した時のみ記録され，module_name() にはインスタンスの
+/// 階層名が入る．
+///
+/// 段階は入れ子になっており，level() が入れ子の深さを表す．
+/// 内側の段階の値は外側の段階の値にも含まれる．
+/// 記録は段階の開始順に並んでいる．
+//////////////////////////////////////////////////////////////////////
+class MvnReadProfile
+{
+public:
+
+  /// @brief コンストラクタ
+  MvnReadProfile() = default;
+
+  /// @brief デストラクタ
+  ~MvnReadProfile() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 内容を取得する関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 記録数を返す．
+  SizeType
+  phase_num() const
+  {
+    return mRecList.size();
+  }
+
+  /// @brief 段階名を返す．
+  const string&
+  phase_name(
+    SizeType pos ///< [in] 位置番号 ( 0 <= pos < phase_num() )
+  ) const
+  {
+    return rec(pos).mName;
+  }
+
+  /// @brief モジュール名を返す．
+  ///
+  /// モジュールごとの段階でない場合は空文字列を返す．
+  const string&
+  module_name(
+    SizeType pos ///< [in] 位置番号 ( 0 <= pos < phase_num() )
+  ) const
+  {
+    return rec(pos).mModuleName;
+  }
+
+  /// @brief 入れ子の深さを返す．
+  SizeType
+  level(
+    SizeType pos ///< [in] 位置番号 ( 0 <= pos < phase_num() )
+  ) const
+  {
+    return rec(pos).mLevel;
+  }
+
+  /// @brief 経過時間(秒)を返す．
+  double
+  wall_time(
+    SizeType pos ///< [in] 位置番号 ( 0 <= pos < phase_num() )
+  ) const
+  {
+    return rec(pos).mWallTime;
+  }
+
+  /// @brief 呼び出したスレッドの CPU 時間(秒)を返す．
+  double
+  cpu_time(
+    SizeType pos ///< [in] 位置番号 ( 0 <= pos < phase_num() )
+  ) const
+  {
+    return rec(pos).mCpuTime;
+  }
+
+  /// @brief 生成したノード数を返す．
+  SizeType
+  node_num(
+    SizeType pos ///< [in] 位置番号 ( 0 <= pos < phase_num() )
+  ) const
+  {
+    return rec(pos).mNodeNum;
+  }
+
+  /// @brief 開始時と終了時の常駐メモリ量の差(KB)を返す．
+  std::int64_t
+  rss_delta(
+    SizeType pos ///< [in] 位置番号 ( 0 <= pos < phase_num() )
+  ) const
+  {
+    return rec(pos).mRssDelta;
+  }
+
+  /// @brief 内容を表形式で出力する．
+  void
+  print(
+    ostream& s ///< [in] 出力先のストリーム
+  ) const;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 記録を行う関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 内容をクリアする．
+  void
+  clear()
+  {
+    mRecList.clear();
+    mLevel = 0;
+  }
+
+  /// @brief 段階の開始を記録する．
+  /// @return 記録の位置番号を返す．
+  SizeType
+  begin_phase(
+    const string& name,       ///< [in] 段階名
+    const string& module_name ///< [in] モジュール名
+  );
+
+  /// @brief 段階の終了を記録する．
+  void
+  end_phase(
+    SizeType pos,      ///< [in] begin_phase() の返した位置番号
+    double wall_time,  ///< [in] 経過時間(秒)
+    double cpu_time,       ///< [in] CPU 時間(秒)
+    SizeType node_num,     ///< [in] 生成したノード数
+    std::int64_t rss_delta ///< [in] 常駐メモリ量の差(KB)
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // 1つの段階の記録
+  struct Rec
+  {
+    // 段階名
+    string mName;
+
+    // モジュール名
+    string mModuleName;
+
+    // 入れ子の深さ
+    SizeType mLevel{0};
+
+    // 経過時間
+    double mWallTime{0.0};
+
+    // CPU 時間
+    double mCpuTime{0.0};
+
+    // 生成したノード数
+    SizeType mNodeNum{0};
+
+    // 常駐メモリ量の差
+    std::int64_t mRssDelta{0};
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 記録を取り出す．
+  const Rec&
+  rec(
+    SizeType pos ///< [in] 位置番号 ( 0 <= pos < phase_num() )
+  ) const
+  {
+    ASSERT_COND( 0 <= pos && pos < phase_num() );
+    return mRecList[pos];
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 記録のリスト
+  vector<Rec> mRecList;
+
+  // 現在の入れ子の深さ
+  SizeType mLevel{0};
+
+};
+
+END_NAMESPACE_YM_MVN
+
+#endif // YM_MVNREADPROFILE_H
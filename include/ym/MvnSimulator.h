@@ -0,0 +1,229 @@
+﻿#ifndef YM_MVNSIMULATOR_H
+#define YM_MVNSIMULATOR_H
+
+/// @file ym/MvnSimulator.h
+/// @brief MvnSimulator のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/mvn.h"
+#include "ym/MvnBvConst.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+class SimNetwork;
+class SimEventQueue;
+
+//////////////////////////////////////////////////////////////////////
+/// @class MvnSimulator MvnSimulator.h "ym/MvnSimulator.h"
+/// @brief MvnModule のサイクルベースのシミュレータ
+///
+/// 構築時にノードをレベル順に並べ，ワード単位の評価情報を作っておく．
+/// 以降は入力値を設定して eval() や step() を呼ぶだけで
+/// ノード単位の評価を順に行う．
+///
+/// - クロックは一つとみなし，step() 一回で全ての DFF が一度だけ
+///   状態を更新する．クロック信号の値は参照しない．
+/// - 非同期セット/リセットは eval() の中でも反映される．
+/// - LATCH はイネーブルが 0 の間は値を保持する組み合わせ回路として扱う．
+/// - X/Z は扱わない(0 とみなす)．
+///
+/// 最初の eval() では全てのノードを評価するが，それ以降は
+/// 値の変化した入力や DFF からファンアウト( dst_pin_list() )をたどり，
+/// 値の変化したノードのみをレベル順に評価するイベントドリブン方式となる．
+/// 組み合わせ回路のループがある場合は毎回全てのノードを評価する．
+//////////////////////////////////////////////////////////////////////
+class MvnSimulator
+{
+public:
+
+  /// @brief コンストラクタ
+  MvnSimulator(
+    const MvnMgr& mgr,      ///< [in] MvnMgr
+    const MvnModule* module ///< [in] 対象のモジュール
+  );
+
+  /// @brief デストラクタ
+  ~MvnSimulator();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 値を設定する関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 入力の値を設定する．
+  void
+  set_input(
+    SizeType pos,         ///< [in] 入力番号 ( 0 <= pos < module->input_num() )
+    const MvnBvConst& val ///< [in] 値
+  );
+
+  /// @brief 入力の値を設定する．
+  ///
+  /// 64ビットを超える部分は 0 となる．
+  void
+  set_input(
+    SizeType pos,     ///< [in] 入力番号 ( 0 <= pos < module->input_num() )
+    std::uint64_t val ///< [in] 値
+  );
+
+  /// @brief ノードの値を設定する．
+  ///
+  /// 対象のノードは INPUT，入力の接続されていない INOUT，DFF のいずれか
+  /// DFF の場合は現在の状態を設定することになる．
+  void
+  set_value(
+    const MvnNode* node,  ///< [in] 対象のノード
+    const MvnBvConst& val ///< [in] 値
+  );
+
+  /// @brief 全ての DFF の状態を 0 にする．
+  void
+  reset_state();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // シミュレーションを行う関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 現在の入力と状態で組み合わせ回路部分を評価する．
+  ///
+  /// 値を取り出す関数は必要に応じてこの関数を呼ぶので
+  /// 明示的に呼び出す必要はない．
+  void
+  eval();
+
+  /// @brief クロックを進める．
+  ///
+  /// 1サイクルごとに組み合わせ回路を評価し DFF の状態を更新する．
+  void
+  step(
+    SizeType n = 1 ///< [in] サイクル数
+  );
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 値を取り出す関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 出力の値を返す．
+  MvnBvConst
+  output(
+    SizeType pos ///< [in] 出力番号 ( 0 <= pos < module->output_num() )
+  );
+
+  /// @brief 出力の値の下位64ビットを返す．
+  std::uint64_t
+  output_uint(
+    SizeType pos ///< [in] 出力番号 ( 0 <= pos < module->output_num() )
+  );
+
+  /// @brief ノードの値を返す．
+  MvnBvConst
+  value(
+    const MvnNode* node ///< [in] 対象のノード
+  );
+
+  /// @brief 直前の eval() で値が変化したノードのリストを返す．
+  ///
+  /// 直前の eval() 以前に set_input() などで値を変えたノードや
+  /// step() で状態が変化した DFF も含まれる．
+  vector<const MvnNode*>
+  changed_node_list() const;
+
+  /// @brief 組み合わせ回路のループがある時 true を返す．
+  ///
+  /// ループがある場合，eval() は毎回全てのノードを評価する．
+  bool
+  has_loop() const;
+
+  /// @brief ループのために順序づけられなかったノードのリストを返す．
+  ///
+  /// ループに含まれるノードとその先にあるノードが入る．
+  vector<const MvnNode*>
+  loop_node_list() const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ノード番号を指定して値を設定する．
+  void
+  _set_value(
+    SizeType id,          ///< [in] ノード番号
+    const MvnBvConst& val ///< [in] 値
+  );
+
+  /// @brief ノード番号を指定して値を取り出す．
+  MvnBvConst
+  _value(
+    SizeType id ///< [in] ノード番号
+  );
+
+  /// @brief 値が変化したノードを記録する．
+  void
+  _add_event(
+    SizeType id ///< [in] ノード番号
+  );
+
+  /// @brief 必要なら評価を行う．
+  void
+  _update()
+  {
+    if ( mDirty ) {
+      eval();
+    }
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 対象の MvnMgr
+  const MvnMgr& mMgr;
+
+  // コンパイル済みのネットワーク
+  std::shared_ptr<const SimNetwork> mNetwork;
+
+  // イベントキュー
+  unique_ptr<SimEventQueue> mQueue;
+
+  // 直前の eval() で値が変化したノード番号のリスト
+  vector<SizeType> mChangedList;
+
+  // 次の eval() で全てのノードを評価する時 true にするフラグ
+  bool mFullEval{true};
+
+  // 値バッファ
+  vector<std::uint64_t> mValArray;
+
+  // 前回の eval() 終了時の値
+  vector<std::uint64_t> mPrevArray;
+
+  // 次状態バッファ
+  vector<std::uint64_t> mNextArray;
+
+  // 作業領域
+  vector<std::uint64_t> mWorkArray;
+
+  // セルの入力値用の作業領域
+  vector<std::uint64_t> mCellInputArray;
+
+  // 再評価が必要な時 true にするフラグ
+  bool mDirty{true};
+
+};
+
+END_NAMESPACE_YM_MVN
+
+#endif // YM_MVNSIMULATOR_H
@@ -59,6 +59,111 @@ public:
     const vector<VlLineWatcher*> watcher_list ///< [in] 行番号ウォッチャーのリスト
     = vector<VlLineWatcher*>());
 
+  /// @brief 複数の verilog 形式のファイルを読み込む．
+  /// @retval true 正常に読み込めた．
+  /// @retval false 読込中にエラーが起こった．
+  ///
+  /// ファイルはリストの順に読み込み，エラーが起きた時点で中断する．
+  /// 結果はファイルごとに read() を呼んだ場合と同一になる．
+  /// 構文解析自体は呼び出したスレッドで順に行う．
+  /// set_prefetch_num() で先読み用のスレッドを指定した時は
+  /// 構文解析と並行して後続のファイルを読んでページキャッシュに載せておく．
+  bool
+  read(
+    const vector<string>& filename_list,      ///< [in] ファイル名のリスト
+    const SearchPathList& searchpath          ///< [in] サーチパス
+    = SearchPathList(),
+    const vector<VlLineWatcher*> watcher_list ///< [in] 行番号ウォッチャーのリスト
+    = vector<VlLineWatcher*>());
+
+  /// @brief メモリ上の verilog 記述を読み込む．
+  /// @retval true 正常に読み込めた．
+  /// @retval false 読込中にエラーが起こった．
+  ///
+  /// include_list には `include で参照される記述を (名前, 内容) の形で与える．
+  /// 名前は `include 文中のファイル名と一致させる．
+  /// これらはサーチパス上のファイルより優先される．
+  /// VlMgr はファイルからしか読み込めないため，内部では
+  /// メモリ上のファイルシステム(なければ $TMPDIR か /tmp)に
+  /// 一時ファイルを書き出してから読み込む．
+  /// メッセージ中のファイル名は一時ディレクトリ内のパスとなる．
+  /// 一時ファイルは clear() を呼ぶかこのオブジェクトが破棄されるまで残る．
+  bool
+  read_buffer(
+    const string& name,                       ///< [in] 名前
+    const string& text,                       ///< [in] verilog 記述
+    const vector<pair<string, string>>& include_list
+    = vector<pair<string, string>>(),         ///< [in] `include で参照される
+                                              ///<      (名前, 内容) のリスト
+    const SearchPathList& searchpath          ///< [in] サーチパス
+    = SearchPathList(),
+    const vector<VlLineWatcher*> watcher_list ///< [in] 行番号ウォッチャーのリスト
+    = vector<VlLineWatcher*>());
+
+  /// @brief 先読みに用いるスレッド数を設定する．
+  ///
+  /// 複数ファイルの read() でのみ用いられる．
+  /// 構文解析を並列に行うわけではない．
+  /// 0 の時(既定値)は先読みを行わない．
+  void
+  set_prefetch_num(
+    SizeType prefetch_num ///< [in] スレッド数
+  );
+
+  /// @brief 先読みに用いるスレッド数を返す．
+  SizeType
+  prefetch_num() const;
+
+  /// @brief 読み込み結果のキャッシュを置くディレクトリを設定する．
+  ///
+  /// 空文字列の時(既定値)はキャッシュを用いない．
+  /// キャッシュを用いる時は read() と read_buffer() は
+  /// ファイルが存在することを確かめてキーを計算するだけで，
+  /// 構文解析を gen_network() まで遅らせる．
+  /// キーは読み込んだ全ての記述の名前と内容，サーチパス，
+  /// およびセルライブラリの内容から SHA-256 で計算する．
+  /// `include で参照されるファイルは構文解析の際に実際に開かれたものを
+  /// 内容のハッシュ値とともにキャッシュに記録しておき，
+  /// キャッシュを用いる前に内容が変わっていないことを確かめる．
+  /// gen_network() は有効なキャッシュがあれば
+  /// 構文解析とネットワークの生成を行わずに MvnBinReader で読み込み，
+  /// なければ通常の処理を行った結果を MvnBinWriter の形式で保存する．
+  /// キャッシュの結果のセルは mgr のセルライブラリから探されるので，
+  /// それが gen_network() に与えたセルライブラリと異なる時はキャッシュを用いない．
+  /// キャッシュを用いる時は，キャッシュから読み込んだかどうかに関わらず
+  /// node_map には名前のみが登録される(get_name() 以外は未登録に見える)．
+  /// 読み込みの前に設定する必要がある．
+  void
+  set_cache_dir(
+    const string& dirname ///< [in] ディレクトリ名
+  );
+
+  /// @brief 読み込み結果のキャッシュを置くディレクトリを返す．
+  const string&
+  cache_dir() const;
+
+  /// @brief モジュールごとの計測を行うかどうかを設定する．
+  ///
+  /// 既定値は false で，この時は gen_network() の大まかな処理段階
+  /// (elaborate, gen_module, connect, sweep など)のみを計測する．
+  /// true の時はモジュール(インスタンス)ごとに宣言要素の生成(decl)と
+  /// 要素の生成(item)も計測する．
+  /// インスタンス数に比例した記録が作られるので注意が必要．
+  void
+  set_module_profile(
+    bool flag ///< [in] true の時モジュールごとの計測を行う．
+  );
+
+  /// @brief モジュールごとの計測を行う時 true を返す．
+  bool
+  module_profile() const;
+
+  /// @brief 直前の gen_network() の処理段階ごとの計測結果を返す．
+  ///
+  /// 内容は gen_network() を呼ぶたびに作り直される．
+  const MvnReadProfile&
+  profile() const;
+
   /// @brief 今まで読み込んだ情報からネットワークを生成する．
   /// @retval true 正常に処理を行った．
   /// @retval false 生成中にエラーが起こった．
@@ -32,6 +32,52 @@ public:
   ~MvnVerilogWriter();
 
 
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 出力形式の設定
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 式の埋め込みを行うかどうかを設定する．
+  ///
+  /// true の時はファンアウトが一つの組み合わせ回路のノードを
+  /// wire と assign 文を作らずにファンアウト先の式の中に埋め込む．
+  /// 優先順位に応じて括弧を補い，ビット幅が文脈で決まる演算は
+  /// 埋め込んだ先で同じビット幅で評価される場合のみ埋め込む．
+  /// 部分選択の対象，DFF の制御入力，セルの入力には埋め込まない．
+  /// デフォルトは false
+  void
+  set_inline_expr(
+    bool flag ///< [in] 埋め込みを行う時 true にするフラグ
+  );
+
+  /// @brief 式の埋め込みを行う時 true を返す．
+  bool
+  inline_expr() const;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 並列出力の設定
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 出力に用いるスレッド数を設定する．
+  ///
+  /// 1 の時(デフォルト)はモジュールを一つずつ順に出力する．
+  /// 2 以上の時はモジュールごと，および大きなモジュールのノードリストを
+  /// 区切った部分ごとに別々のバッファへ並列に書き込んだ後，
+  /// 決まった順にバッファの内容をストリームに書き出す．
+  /// 出力内容はスレッド数によらず 1 の時と同一になる．
+  /// 0 の時はハードウェアのスレッド数を用いる．
+  void
+  set_thread_num(
+    SizeType thread_num ///< [in] スレッド数
+  );
+
+  /// @brief 出力に用いるスレッド数を返す．
+  SizeType
+  thread_num() const;
+
+
 public:
   //////////////////////////////////////////////////////////////////////
   // メインの関数
@@ -52,6 +98,31 @@ public:
     const MvnVlMap& node_map ///< [in] ノードと Verilog 名の対応表
   );
 
+  /// @brief 内容を Verilog-HDL 形式でファイルに出力する
+  /// @return 書き出せた時 true を返す．
+  ///
+  /// comp_type が MvnCompType::Auto の時は拡張子で圧縮形式を決める．
+  /// 圧縮はバックグラウンドのスレッドで行われる．
+  bool
+  operator()(
+    const string& filename,                   ///< [in] ファイル名
+    const MvnMgr& mgr,                        ///< [in] Mvn ネットワーク
+    MvnCompType comp_type = MvnCompType::Auto ///< [in] 圧縮形式
+  );
+
+  /// @brief 内容を Verilog-HDL 形式でファイルに出力する
+  /// @return 書き出せた時 true を返す．
+  ///
+  /// comp_type が MvnCompType::Auto の時は拡張子で圧縮形式を決める．
+  /// 圧縮はバックグラウンドのスレッドで行われる．
+  bool
+  operator()(
+    const string& filename,                   ///< [in] ファイル名
+    const MvnMgr& mgr,                        ///< [in] Mvn ネットワーク
+    const MvnVlMap& node_map,                 ///< [in] ノードと Verilog 名の対応表
+    MvnCompType comp_type = MvnCompType::Auto ///< [in] 圧縮形式
+  );
+
 
 private:
   //////////////////////////////////////////////////////////////////////
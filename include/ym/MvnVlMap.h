@@ -66,6 +66,16 @@ public:
     SizeType offset               ///< [in] オフセット
   );
 
+  /// @brief 名前のみを登録する．
+  ///
+  /// 宣言要素を持たない場合(バイナリ形式から読み込んだ場合など)に用いる．
+  /// get_name() 以外の取得関数からは登録されていないように見える．
+  void
+  reg_node(
+    SizeType id,       ///< [in] MvNode の ID番号
+    const string& name ///< [in] 名前
+  );
+
   /// @brief src_id の内容を dst_id にムーブする．
   void
   move(
@@ -115,6 +125,15 @@ public:
     SizeType id ///< [in] MvNode の ID番号
   ) const;
 
+  /// @brief id に対応する名前を返す．
+  ///
+  /// 配列要素の場合はインデックスを付けた名前を返す．
+  /// 登録されていない場合は空文字列を返す．
+  string
+  get_name(
+    SizeType id ///< [in] MvNode の ID番号
+  ) const;
+
 
 private:
   //////////////////////////////////////////////////////////////////////
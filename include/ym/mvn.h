@@ -143,6 +143,23 @@ enum class MvnPolarity {
 };
 
 
+//////////////////////////////////////////////////////////////////////
+/// @brief 出力ファイルの圧縮形式
+//////////////////////////////////////////////////////////////////////
+enum class MvnCompType {
+  /// @brief ファイル名の拡張子で決める．
+  ///
+  /// ".gz" なら Gzip, ".zz" か ".zlib" なら Zlib, それ以外は None
+  Auto,
+  /// @brief 圧縮しない．
+  None,
+  /// @brief gzip 形式
+  Gzip,
+  /// @brief zlib 形式
+  Zlib,
+};
+
+
 // クラス名の先行宣言
 class MvnMgr;
 class MvnModule;
@@ -153,10 +170,27 @@ class MvnInputPin;
 class MvnBvConst;
 
 class MvnVerilogReader;
+class MvnReadProfile;
 class MvnVlMap;
 
+class MvnBnConv;
+class MvnBnMap;
+
+class MvnAigerWriter;
+class MvnCompOStream;
+class MvnBinReader;
+class MvnBinWriter;
+class MvnBtorWriter;
+class MvnCnfWriter;
+class MvnDotWriter;
 class MvnDumper;
+class MvnJsonWriter;
 class MvnVerilogWriter;
+class MvnCxxWriter;
+
+class MvnSimulator;
+class MvnBatchSimulator;
+class MvnPatternSimulator;
 
 END_NAMESPACE_YM_MVN
 
@@ -164,6 +198,7 @@ BEGIN_NAMESPACE_YM
 
 using nsMvn::MvnNodeType;
 using nsMvn::MvnPolarity;
+using nsMvn::MvnCompType;
 
 using nsMvn::MvnMgr;
 using nsMvn::MvnModule;
@@ -174,10 +209,27 @@ using nsMvn::MvnInputPin;
 using nsMvn::MvnBvConst;
 
 using nsMvn::MvnVerilogReader;
+using nsMvn::MvnReadProfile;
 using nsMvn::MvnVlMap;
 
+using nsMvn::MvnBnConv;
+using nsMvn::MvnBnMap;
+
+using nsMvn::MvnAigerWriter;
+using nsMvn::MvnCompOStream;
+using nsMvn::MvnBinReader;
+using nsMvn::MvnBinWriter;
+using nsMvn::MvnBtorWriter;
+using nsMvn::MvnCnfWriter;
+using nsMvn::MvnDotWriter;
 using nsMvn::MvnDumper;
+using nsMvn::MvnJsonWriter;
 using nsMvn::MvnVerilogWriter;
+using nsMvn::MvnCxxWriter;
+
+using nsMvn::MvnSimulator;
+using nsMvn::MvnBatchSimulator;
+using nsMvn::MvnPatternSimulator;
 
 END_NAMESPACE_YM
 
@@ -0,0 +1,230 @@
+﻿#ifndef BITBUILDER_H
+#define BITBUILDER_H
+
+/// @file BitBuilder.h
+/// @brief BitBuilder のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/mvn.h"
+#include "ym/BnNodeHandle.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+/// @class BitBuilder BitBuilder.h "BitBuilder.h"
+/// @brief ビットレベルの論理ゲートを生成するための基底クラス
+///
+/// 定数の伝搬や自明な簡単化は非仮想関数の make_XXX() で行い，
+/// 実際のゲートの生成は継承クラスの _make_and()/_make_xor() で行う．
+/// これにより変換処理(MvnConv)を出力先の形式と独立にしている．
+//////////////////////////////////////////////////////////////////////
+class BitBuilder
+{
+public:
+
+  /// @brief デストラクタ
+  virtual
+  ~BitBuilder() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // ゲートを作る関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief AND を作る．
+  BnNodeHandle
+  make_and(
+    BnNodeHandle a, ///< [in] 入力1
+    BnNodeHandle b  ///< [in] 入力2
+  )
+  {
+    if ( a.is_zero() || b.is_zero() ) {
+      return BnNodeHandle::zero();
+    }
+    if ( a.is_one() ) {
+      return b;
+    }
+    if ( b.is_one() ) {
+      return a;
+    }
+    if ( a == b ) {
+      return a;
+    }
+    if ( a == ~b ) {
+      return BnNodeHandle::zero();
+    }
+    if ( a.body() > b.body() ) {
+      std::swap(a, b);
+    }
+    return _make_and(a, b);
+  }
+
+  /// @brief OR を作る．
+  BnNodeHandle
+  make_or(
+    BnNodeHandle a, ///< [in] 入力1
+    BnNodeHandle b  ///< [in] 入力2
+  )
+  {
+    return ~make_and(~a, ~b);
+  }
+
+  /// @brief XOR を作る．
+  BnNodeHandle
+  make_xor(
+    BnNodeHandle a, ///< [in] 入力1
+    BnNodeHandle b  ///< [in] 入力2
+  )
+  {
+    if ( a.is_zero() ) {
+      return b;
+    }
+    if ( a.is_one() ) {
+      return ~b;
+    }
+    if ( b.is_zero() ) {
+      return a;
+    }
+    if ( b.is_one() ) {
+      return ~a;
+    }
+    if ( a == b ) {
+      return BnNodeHandle::zero();
+    }
+    if ( a == ~b ) {
+      return BnNodeHandle::one();
+    }
+    // 極性は外に出しておく．
+    bool inv{a.inv() != b.inv()};
+    a = a.posi();
+    b = b.posi();
+    if ( a.body() > b.body() ) {
+      std::swap(a, b);
+    }
+    auto ans{_make_xor(a, b)};
+    return inv ? ~ans : ans;
+  }
+
+  /// @brief マルチプレクサを作る．
+  /// @return s が 1 の時 a1 を，0 の時 a0 を返す．
+  BnNodeHandle
+  make_mux(
+    BnNodeHandle s,  ///< [in] 選択信号
+    BnNodeHandle a1, ///< [in] s = 1 の時の入力
+    BnNodeHandle a0  ///< [in] s = 0 の時の入力
+  )
+  {
+    if ( s.is_one() ) {
+      return a1;
+    }
+    if ( s.is_zero() ) {
+      return a0;
+    }
+    if ( a1 == a0 ) {
+      return a1;
+    }
+    if ( a1 == ~a0 ) {
+      return make_xor(~s, a1);
+    }
+    return make_or(make_and(s, a1), make_and(~s, a0));
+  }
+
+  /// @brief 多入力の AND を作る．
+  BnNodeHandle
+  make_and(
+    const vector<BnNodeHandle>& fanin_list ///< [in] 入力のリスト
+  )
+  {
+    return make_tree(fanin_list, 0, fanin_list.size(), Op::And);
+  }
+
+  /// @brief 多入力の OR を作る．
+  BnNodeHandle
+  make_or(
+    const vector<BnNodeHandle>& fanin_list ///< [in] 入力のリスト
+  )
+  {
+    return make_tree(fanin_list, 0, fanin_list.size(), Op::Or);
+  }
+
+  /// @brief 多入力の XOR を作る．
+  BnNodeHandle
+  make_xor(
+    const vector<BnNodeHandle>& fanin_list ///< [in] 入力のリスト
+  )
+  {
+    return make_tree(fanin_list, 0, fanin_list.size(), Op::Xor);
+  }
+
+
+protected:
+  //////////////////////////////////////////////////////////////////////
+  // 継承クラスが実装する仮想関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief AND ゲートを作る．
+  ///
+  /// a, b は定数ではなく，a.body() < b.body() かつ a != ~b である．
+  virtual
+  BnNodeHandle
+  _make_and(
+    BnNodeHandle a, ///< [in] 入力1
+    BnNodeHandle b  ///< [in] 入力2
+  ) = 0;
+
+  /// @brief XOR ゲートを作る．
+  ///
+  /// a, b は定数ではない正極性のハンドルで a.body() < b.body() である．
+  virtual
+  BnNodeHandle
+  _make_xor(
+    BnNodeHandle a, ///< [in] 入力1
+    BnNodeHandle b  ///< [in] 入力2
+  ) = 0;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  enum class Op {
+    And, Or, Xor
+  };
+
+  /// @brief 平衡木を作る．
+  BnNodeHandle
+  make_tree(
+    const vector<BnNodeHandle>& fanin_list,
+    SizeType begin,
+    SizeType end,
+    Op op
+  )
+  {
+    if ( begin == end ) {
+      return op == Op::And ? BnNodeHandle::one() : BnNodeHandle::zero();
+    }
+    if ( begin + 1 == end ) {
+      return fanin_list[begin];
+    }
+    SizeType mid{(begin + end) / 2};
+    auto a{make_tree(fanin_list, begin, mid, op)};
+    auto b{make_tree(fanin_list, mid, end, op)};
+    switch ( op ) {
+    case Op::And: return make_and(a, b);
+    case Op::Or:  return make_or(a, b);
+    case Op::Xor: return make_xor(a, b);
+    }
+    return BnNodeHandle{};
+  }
+
+};
+
+END_NAMESPACE_YM_MVN
+
+#endif // BITBUILDER_H
@@ -0,0 +1,384 @@
+﻿#ifndef MVNCONV_H
+#define MVNCONV_H
+
+/// @file MvnConv.h
+/// @brief MvnConv とその継承クラスのヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/mvn.h"
+#include "ym/BnNodeHandle.h"
+#include "ym/MvnBnConv.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+class BitBuilder;
+
+//////////////////////////////////////////////////////////////////////
+/// @class MvnConv MvnConv.h "MvnConv.h"
+/// @brief MvnNode をビットレベルのゲートに変換するクラスの基底クラス
+///
+/// 各ノードのビットは LSB から順に MvnBnMap に登録する．
+/// 変換結果の値の意味は MvnSimulator と同一にしてある．
+//////////////////////////////////////////////////////////////////////
+class MvnConv
+{
+public:
+
+  /// @brief デストラクタ
+  virtual
+  ~MvnConv() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief MvnNode をビットレベルのゲートに変換する．
+  /// @retval true このクラスで変換処理を行った．
+  /// @retval false このクラスでは変換処理を行わなかった．
+  ///
+  /// ファンインのノードは変換済みでなければならない．
+  virtual
+  bool
+  operator()(
+    const MvnNode* node,  ///< [in] ノード
+    BitBuilder& builder,  ///< [in] ゲートを作るオブジェクト
+    MvnBnMap& nodemap     ///< [inout] ノードの対応関係を表すマップ
+  ) = 0;
+
+
+protected:
+  //////////////////////////////////////////////////////////////////////
+  // 継承クラスから用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ファンインのビットベクタを得る．
+  ///
+  /// セルノードの場合は代表ノードの入力を用いる．
+  /// 接続されていない入力は入力ピンのビット幅の 0 とみなす．
+  static
+  vector<BnNodeHandle>
+  input_bits(
+    const MvnNode* node,     ///< [in] ノード
+    SizeType pos,            ///< [in] 入力番号
+    const MvnBnMap& nodemap  ///< [in] ノードの対応関係を表すマップ
+  );
+
+  /// @brief ノードのビットベクタを登録する．
+  ///
+  /// bits のサイズがノードのビット幅と異なる場合は
+  /// 0 拡張あるいは切り詰めを行う．
+  static
+  void
+  put_bits(
+    const MvnNode* node,               ///< [in] ノード
+    const vector<BnNodeHandle>& bits,  ///< [in] ビットベクタ
+    MvnBnMap& nodemap                  ///< [out] ノードの対応関係を表すマップ
+  );
+
+  /// @brief 0 拡張もしくは切り詰めを行う．
+  static
+  vector<BnNodeHandle>
+  ext_bits(
+    const vector<BnNodeHandle>& bits, ///< [in] ビットベクタ
+    SizeType bw                       ///< [in] 結果のビット幅
+  );
+
+  /// @brief 全ビットが 0 でない時 1 となる信号を作る．
+  static
+  BnNodeHandle
+  make_nonzero(
+    BitBuilder& builder,             ///< [in] ゲートを作るオブジェクト
+    const vector<BnNodeHandle>& bits ///< [in] ビットベクタ
+  );
+
+  /// @brief 加算器を作る．
+  /// @return a + b + cin の下位 a.size() ビットを返す．
+  ///
+  /// a と b のサイズは等しくなければならない．
+  static
+  vector<BnNodeHandle>
+  make_adder(
+    BitBuilder& builder,              ///< [in] ゲートを作るオブジェクト
+    const vector<BnNodeHandle>& a,    ///< [in] 入力1
+    const vector<BnNodeHandle>& b,    ///< [in] 入力2
+    BnNodeHandle cin,                 ///< [in] キャリー入力
+    BnNodeHandle* cout = nullptr,     ///< [out] キャリー出力
+    MvnAdderArch arch                 ///< [in] 加算器の構成
+    = MvnAdderArch::RippleCarry
+  );
+
+  /// @brief 減算器を作る．
+  /// @return a - b の下位 a.size() ビットを返す．
+  ///
+  /// a と b のサイズは等しくなければならない．
+  /// borrow には a < b の時 1 となる信号が入る．
+  static
+  vector<BnNodeHandle>
+  make_subtractor(
+    BitBuilder& builder,              ///< [in] ゲートを作るオブジェクト
+    const vector<BnNodeHandle>& a,    ///< [in] 入力1
+    const vector<BnNodeHandle>& b,    ///< [in] 入力2
+    BnNodeHandle* borrow = nullptr,   ///< [out] ボロー出力
+    MvnAdderArch arch                 ///< [in] 加算器の構成
+    = MvnAdderArch::RippleCarry
+  );
+
+  /// @brief 乗算器を作る．
+  /// @return a * b の下位 bw ビットを返す．
+  static
+  vector<BnNodeHandle>
+  make_multiplier(
+    BitBuilder& builder,              ///< [in] ゲートを作るオブジェクト
+    const vector<BnNodeHandle>& a,    ///< [in] 入力1
+    const vector<BnNodeHandle>& b,    ///< [in] 入力2
+    SizeType bw,                      ///< [in] 結果のビット幅
+    const MvnArithArch& arch          ///< [in] 構成
+    = MvnArithArch{}
+  );
+
+  /// @brief Wallace tree で部分積を圧縮する．
+  ///
+  /// 結果は各桁のビット数が 2 以下になる．
+  /// 最上位の桁からのキャリーは捨てる．
+  static
+  void
+  reduce_wallace(
+    BitBuilder& builder,                     ///< [in] ゲートを作るオブジェクト
+    vector<vector<BnNodeHandle>>& col_list   ///< [inout] 桁ごとのビットのリスト
+  );
+
+  /// @brief Dadda tree で部分積を圧縮する．
+  ///
+  /// 結果は各桁のビット数が 2 以下になる．
+  /// 最上位の桁からのキャリーは捨てる．
+  static
+  void
+  reduce_dadda(
+    BitBuilder& builder,                     ///< [in] ゲートを作るオブジェクト
+    vector<vector<BnNodeHandle>>& col_list   ///< [inout] 桁ごとのビットのリスト
+  );
+
+  /// @brief 多数決関数を作る．
+  static
+  BnNodeHandle
+  make_majority(
+    BitBuilder& builder, ///< [in] ゲートを作るオブジェクト
+    BnNodeHandle x,      ///< [in] 入力1
+    BnNodeHandle y,      ///< [in] 入力2
+    BnNodeHandle z       ///< [in] 入力3
+  );
+
+  /// @brief バレルシフタを作る．
+  ///
+  /// 左シフトでは空いたビットは 0 になる．
+  /// シフト量が a.size() 以上の時は全ビットが空いたビットの値となる．
+  static
+  vector<BnNodeHandle>
+  make_shifter(
+    BitBuilder& builder,              ///< [in] ゲートを作るオブジェクト
+    const vector<BnNodeHandle>& a,    ///< [in] シフトする値
+    const vector<BnNodeHandle>& sft,  ///< [in] シフト量
+    bool left,                        ///< [in] 左シフトの時 true
+    BnNodeHandle fill                 ///< [in] 右シフトで空いたビットに入れる値
+  );
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class MvnConstConv MvnConv.h "MvnConv.h"
+/// @brief CONSTVALUE 用の変換器
+//////////////////////////////////////////////////////////////////////
+class MvnConstConv :
+  public MvnConv
+{
+public:
+
+  /// @brief MvnNode をビットレベルのゲートに変換する．
+  bool
+  operator()(
+    const MvnNode* node,
+    BitBuilder& builder,
+    MvnBnMap& nodemap
+  ) override;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class MvnLogicConv MvnConv.h "MvnConv.h"
+/// @brief ビットごとの論理演算と縮約演算用の変換器
+///
+/// OUTPUT, INOUT, THROUGH, NOT, AND, OR, XOR, RAND, ROR, RXOR を扱う．
+//////////////////////////////////////////////////////////////////////
+class MvnLogicConv :
+  public MvnConv
+{
+public:
+
+  /// @brief MvnNode をビットレベルのゲートに変換する．
+  bool
+  operator()(
+    const MvnNode* node,
+    BitBuilder& builder,
+    MvnBnMap& nodemap
+  ) override;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class MvnCmpConv MvnConv.h "MvnConv.h"
+/// @brief 比較演算用の変換器
+///
+/// EQ, CASEEQ, LT を扱う．
+/// LT の減算器の構成は MvnBnConv::arith_arch() に従う．
+//////////////////////////////////////////////////////////////////////
+class MvnCmpConv :
+  public MvnConv
+{
+public:
+
+  /// @brief コンストラクタ
+  MvnCmpConv(
+    const MvnBnConv& conv ///< [in] 構成を問い合わせる親のオブジェクト
+  ) : mConv{conv}
+  {
+  }
+
+  /// @brief MvnNode をビットレベルのゲートに変換する．
+  bool
+  operator()(
+    const MvnNode* node,
+    BitBuilder& builder,
+    MvnBnMap& nodemap
+  ) override;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 親のオブジェクト
+  const MvnBnConv& mConv;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class MvnShiftConv MvnConv.h "MvnConv.h"
+/// @brief シフト演算用の変換器
+///
+/// SLL, SLA, SRL, SRA を扱う．
+/// シフトは max(入力のビット幅, 出力のビット幅) で計算する．
+//////////////////////////////////////////////////////////////////////
+class MvnShiftConv :
+  public MvnConv
+{
+public:
+
+  /// @brief MvnNode をビットレベルのゲートに変換する．
+  bool
+  operator()(
+    const MvnNode* node,
+    BitBuilder& builder,
+    MvnBnMap& nodemap
+  ) override;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class MvnArithConv MvnConv.h "MvnConv.h"
+/// @brief 算術演算用の変換器
+///
+/// CMPL, ADD, SUB, MUL, DIV, MOD, POW を扱う．
+/// 0 による除算の結果は商も余りも 0 とする．
+/// 加算器と乗算器の構成は MvnBnConv::arith_arch() に従う．
+//////////////////////////////////////////////////////////////////////
+class MvnArithConv :
+  public MvnConv
+{
+public:
+
+  /// @brief コンストラクタ
+  MvnArithConv(
+    const MvnBnConv& conv ///< [in] 構成を問い合わせる親のオブジェクト
+  ) : mConv{conv}
+  {
+  }
+
+  /// @brief MvnNode をビットレベルのゲートに変換する．
+  bool
+  operator()(
+    const MvnNode* node,
+    BitBuilder& builder,
+    MvnBnMap& nodemap
+  ) override;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 親のオブジェクト
+  const MvnBnConv& mConv;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class MvnSelectConv MvnConv.h "MvnConv.h"
+/// @brief 選択と連結用の変換器
+///
+/// ITE, CONCAT, CONSTBITSELECT, CONSTPARTSELECT, BITSELECT, PARTSELECT を扱う．
+//////////////////////////////////////////////////////////////////////
+class MvnSelectConv :
+  public MvnConv
+{
+public:
+
+  /// @brief MvnNode をビットレベルのゲートに変換する．
+  bool
+  operator()(
+    const MvnNode* node,
+    BitBuilder& builder,
+    MvnBnMap& nodemap
+  ) override;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class MvnCellConv MvnConv.h "MvnConv.h"
+/// @brief CELL 用の変換器
+///
+/// セルの論理式を AND/OR/XOR に分解する．
+/// 論理式を持たないセルの出力は 0 とする．
+//////////////////////////////////////////////////////////////////////
+class MvnCellConv :
+  public MvnConv
+{
+public:
+
+  /// @brief MvnNode をビットレベルのゲートに変換する．
+  bool
+  operator()(
+    const MvnNode* node,
+    BitBuilder& builder,
+    MvnBnMap& nodemap
+  ) override;
+
+};
+
+END_NAMESPACE_YM_MVN
+
+#endif // MVNCONV_H
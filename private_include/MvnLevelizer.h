@@ -0,0 +1,165 @@
+﻿#ifndef MVNLEVELIZER_H
+#define MVNLEVELIZER_H
+
+/// @file MvnLevelizer.h
+/// @brief MvnLevelizer のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/mvn.h"
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+/// @class MvnLevelizer MvnLevelizer.h "MvnLevelizer.h"
+/// @brief MvnModule のノードをレベル順に並べるクラス
+///
+/// 以下のノードをソース(レベル0)とみなす．
+/// - INPUT
+/// - 入力が接続されていない INOUT
+/// - CONSTVALUE
+/// - DFF
+///
+/// 残りのノードのレベルはファンインのレベルの最大値 + 1 となる．
+/// DFF のファンインは次状態の計算にのみ用いられるので
+/// レベルの計算には含めない．
+/// LATCH は組み合わせ回路ノードとして扱う．
+//////////////////////////////////////////////////////////////////////
+class MvnLevelizer
+{
+public:
+
+  /// @brief コンストラクタ
+  MvnLevelizer(
+    const MvnMgr& mgr,      ///< [in] MvnMgr
+    const MvnModule* module ///< [in] 対象のモジュール
+  );
+
+  /// @brief デストラクタ
+  ~MvnLevelizer() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ノードの ID 番号の最大値 + 1 を返す．
+  SizeType
+  max_node_id() const
+  {
+    return mLevelArray.size();
+  }
+
+  /// @brief モジュールに属する全ノードをトポロジカル順に並べたリストを返す．
+  ///
+  /// ソースノードが先頭に来る．
+  const vector<const MvnNode*>&
+  node_list() const
+  {
+    return mNodeList;
+  }
+
+  /// @brief DFF ノードのリストを返す．
+  const vector<const MvnNode*>&
+  dff_list() const
+  {
+    return mDffList;
+  }
+
+  /// @brief ノードのレベルを返す．
+  ///
+  /// モジュールに属さないノードの場合は 0 を返す．
+  SizeType
+  level(
+    SizeType id ///< [in] ノード番号 ( 0 <= id < max_node_id() )
+  ) const
+  {
+    ASSERT_COND( 0 <= id && id < max_node_id() );
+    return mLevelArray[id];
+  }
+
+  /// @brief レベルの最大値を返す．
+  SizeType
+  max_level() const
+  {
+    return mMaxLevel;
+  }
+
+  /// @brief 組み合わせ回路のループがあった時 true を返す．
+  ///
+  /// ループに含まれるノードは node_list() の末尾に任意の順で置かれる．
+  bool
+  has_loop() const
+  {
+    return mHasLoop;
+  }
+
+  /// @brief 順序づけられなかったノードのリストを返す．
+  ///
+  /// ループに含まれるノードとその先にあるノードが入る．
+  /// ループがなければ空となる．
+  const vector<const MvnNode*>&
+  loop_node_list() const
+  {
+    return mLoopList;
+  }
+
+  /// @brief ソースノードの時 true を返す．
+  static
+  bool
+  is_source(
+    const MvnNode* node ///< [in] 対象のノード
+  );
+
+  /// @brief 評価の際に参照するファンインのノードを返す．
+  ///
+  /// 多くのノードは input(pos)->src_node() と同じだが
+  /// セルノードの場合には代表ノードの入力を返す．
+  /// 接続されていない場合は nullptr を返す．
+  static
+  const MvnNode*
+  fanin(
+    const MvnNode* node, ///< [in] 対象のノード
+    SizeType pos         ///< [in] ファンイン番号 ( 0 <= pos < fanin_num(node) )
+  );
+
+  /// @brief 評価の際に参照するファンイン数を返す．
+  static
+  SizeType
+  fanin_num(
+    const MvnNode* node ///< [in] 対象のノード
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // トポロジカル順に並べたノードのリスト
+  vector<const MvnNode*> mNodeList;
+
+  // DFF ノードのリスト
+  vector<const MvnNode*> mDffList;
+
+  // ノード番号をキーにしてレベルを格納する配列
+  vector<SizeType> mLevelArray;
+
+  // レベルの最大値
+  SizeType mMaxLevel{0};
+
+  // ループがあった時 true にするフラグ
+  bool mHasLoop{false};
+
+  // 順序づけられなかったノードのリスト
+  vector<const MvnNode*> mLoopList;
+
+};
+
+END_NAMESPACE_YM_MVN
+
+#endif // MVNLEVELIZER_H
@@ -0,0 +1,266 @@
+﻿#ifndef WRITEBUF_H
+#define WRITEBUF_H
+
+/// @file WriteBuf.h
+/// @brief WriteBuf のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/mvn.h"
+#include <cstring>
+#include <type_traits>
+
+
+BEGIN_NAMESPACE_YM_MVN
+
+//////////////////////////////////////////////////////////////////////
+/// @class WriteBuf WriteBuf.h "WriteBuf.h"
+/// @brief 出力をまとめて書き出すためのバッファ
+///
+/// 文字列と整数を固定長のバッファに詰め込み，
+/// 一杯になった時とデストラクタでまとめて ostream::write() を呼ぶ．
+/// 整数は一時オブジェクトを作らずに直接バッファ上で文字列に変換する．
+/// バッファの領域は呼び出し側が用意したものを使い回す．
+///
+/// ストリームを指定せずに作った場合はメモリ上のバッファとして動作し，
+/// 一杯になると領域を拡張して全ての内容を保持する．
+/// 書き込んだ内容は data() と size() で取り出す．
+//////////////////////////////////////////////////////////////////////
+class WriteBuf
+{
+public:
+
+  /// @brief コンストラクタ
+  WriteBuf(
+    ostream& s,           ///< [in] 出力先のストリーム
+    vector<char>& storage ///< [in] バッファに用いる領域
+  ) : mS{&s},
+      mBuf{storage}
+  {
+    if ( mBuf.size() < DEFAULT_SIZE ) {
+      mBuf.resize(DEFAULT_SIZE);
+    }
+  }
+
+  /// @brief メモリ上のバッファとして用いる時のコンストラクタ
+  explicit
+  WriteBuf(
+    vector<char>& storage ///< [in] 内容を格納する領域
+  ) : mS{nullptr},
+      mBuf{storage}
+  {
+    if ( mBuf.empty() ) {
+      mBuf.resize(MIN_SIZE);
+    }
+  }
+
+  /// @brief デストラクタ
+  ///
+  /// 残っている内容を書き出す．
+  ~WriteBuf()
+  {
+    flush();
+  }
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 文字列を書き込む．
+  void
+  put(
+    const char* str, ///< [in] 文字列の先頭
+    SizeType n       ///< [in] 文字数
+  )
+  {
+    if ( mPos + n > mBuf.size() ) {
+      if ( mS == nullptr ) {
+	expand(mPos + n);
+      }
+      flush();
+      if ( n > mBuf.size() ) {
+	// バッファより長いものはそのまま書き出す．
+	mS->write(str, n);
+	mFlushed += n;
+	return;
+      }
+    }
+    std::memcpy(mBuf.data() + mPos, str, n);
+    mPos += n;
+  }
+
+  /// @brief 1文字書き込む．
+  void
+  put(
+    char c ///< [in] 文字
+  )
+  {
+    if ( mPos == mBuf.size() ) {
+      if ( mS == nullptr ) {
+	expand(mPos + 1);
+      }
+      flush();
+    }
+    mBuf[mPos] = c;
+    ++ mPos;
+  }
+
+  /// @brief 符号なし整数を10進数で書き込む．
+  void
+  put_num(
+    std::uint64_t val ///< [in] 値
+  );
+
+  /// @brief 符号付き整数を10進数で書き込む．
+  void
+  put_num(
+    std::int64_t val ///< [in] 値
+  )
+  {
+    if ( val < 0 ) {
+      put('-');
+      put_num(static_cast<std::uint64_t>(0) - static_cast<std::uint64_t>(val));
+    }
+    else {
+      put_num(static_cast<std::uint64_t>(val));
+    }
+  }
+
+  /// @brief バッファの内容を書き出す．
+  ///
+  /// メモリ上のバッファの場合は何もしない．
+  void
+  flush()
+  {
+    if ( mS != nullptr && mPos > 0 ) {
+      mS->write(mBuf.data(), mPos);
+      mFlushed += mPos;
+      mPos = 0;
+    }
+  }
+
+  /// @brief 書き出されていない内容の先頭を返す．
+  const char*
+  data() const
+  {
+    return mBuf.data();
+  }
+
+  /// @brief 書き出されていない内容の長さを返す．
+  SizeType
+  size() const
+  {
+    return mPos;
+  }
+
+  /// @brief これまでに書き込んだ文字数を返す．
+  ///
+  /// 書き出し済みの内容も含む．
+  SizeType
+  count() const
+  {
+    return mFlushed + mPos;
+  }
+
+  /// @brief 文字列を書き込む．
+  WriteBuf&
+  operator<<(
+    const char* str ///< [in] 文字列
+  )
+  {
+    put(str, std::strlen(str));
+    return *this;
+  }
+
+  /// @brief 文字列を書き込む．
+  WriteBuf&
+  operator<<(
+    const string& str ///< [in] 文字列
+  )
+  {
+    put(str.data(), str.size());
+    return *this;
+  }
+
+  /// @brief 1文字書き込む．
+  WriteBuf&
+  operator<<(
+    char c ///< [in] 文字
+  )
+  {
+    put(c);
+    return *this;
+  }
+
+  /// @brief 整数を書き込む．
+  template<typename T,
+	   typename = typename std::enable_if<std::is_integral<T>::value>::type>
+  WriteBuf&
+  operator<<(
+    T val ///< [in] 値
+  )
+  {
+    if ( std::is_signed<T>::value ) {
+      put_num(static_cast<std::int64_t>(val));
+    }
+    else {
+      put_num(static_cast<std::uint64_t>(val));
+    }
+    return *this;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 領域を拡張する．
+  void
+  expand(
+    SizeType req_size ///< [in] 必要なサイズ
+  )
+  {
+    SizeType new_size{mBuf.size() * 2};
+    if ( new_size < req_size ) {
+      new_size = req_size;
+    }
+    mBuf.resize(new_size);
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // バッファの既定のサイズ
+  static
+  const SizeType DEFAULT_SIZE{1 << 20};
+
+  // メモリ上のバッファの初期サイズ
+  static
+  const SizeType MIN_SIZE{1 << 12};
+
+  // 出力先のストリーム
+  // メモリ上のバッファの場合は nullptr
+  ostream* mS;
+
+  // バッファ
+  vector<char>& mBuf;
+
+  // 書き込み位置
+  SizeType mPos{0};
+
+  // 書き出し済みの文字数
+  SizeType mFlushed{0};
+
+};
+
+END_NAMESPACE_YM_MVN
+
+#endif // WRITEBUF_H
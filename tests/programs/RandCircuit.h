@@ -0,0 +1,524 @@
+﻿#ifndef RANDCIRCUIT_H
+#define RANDCIRCUIT_H
+
+/// @file RandCircuit.h
+/// @brief テスト用に乱数で回路を作るクラス
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/MvnMgr.h"
+#include "ym/MvnModule.h"
+#include "ym/MvnNode.h"
+#include "ym/MvnInputPin.h"
+#include "ym/MvnPort.h"
+#include "ym/MvnBvConst.h"
+#include "ym/MvnVlMap.h"
+#include <random>
+
+
+BEGIN_NAMESPACE_YM
+
+//////////////////////////////////////////////////////////////////////
+/// @class RandCircuit RandCircuit.h "RandCircuit.h"
+/// @brief 乱数で回路を作るクラス
+///
+/// 作るモジュールは以下の形をしている．
+/// - 入力は乱数で決めたビット幅のもの input_num() 個と1ビットのもの1個
+///   クロック入力を用いる時はさらに clk, rst の2つの1ビット入力を持つ．
+/// - 出力は乱数で決めたビット幅のもの output_num() 個
+/// - 入出力は inout_num() 個で，ビット幅は最大ビット幅
+/// - DFF は2つで，2つ目は負極性の非同期セットを持つ．
+/// 演算ノードの入力ピンにはそれまでに作ったノードのうち
+/// ピンと同じビット幅のものを選んでつなぐ．
+/// 見つからない時は定数ノードを作る．
+//////////////////////////////////////////////////////////////////////
+class RandCircuit
+{
+public:
+
+  /// @brief コンストラクタ
+  RandCircuit(
+    MvnMgr& mgr,  ///< [in] 対象の MvnMgr
+    SizeType seed ///< [in] 乱数の種
+  ) : mMgr{mgr},
+      mRandGen{seed},
+      mTypeList{default_type_list()}
+  {
+  }
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 設定を行う関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 作る演算ノードの種類を設定する．
+  void
+  set_type_list(
+    const vector<MvnNodeType>& type_list ///< [in] ノードの種類のリスト
+  )
+  {
+    mTypeList = type_list;
+  }
+
+  /// @brief 入出力の数を設定する．
+  void
+  set_io_num(
+    SizeType input_num,  ///< [in] 乱数で決めたビット幅の入力数
+    SizeType output_num, ///< [in] 出力数
+    SizeType inout_num   ///< [in] 入出力数
+  )
+  {
+    mInputNum = input_num;
+    mOutputNum = output_num;
+    mInoutNum = inout_num;
+  }
+
+  /// @brief DFF のクロックと非同期セットを専用の入力 clk, rst にする．
+  ///
+  /// false の時は1ビットのノードを乱数で選ぶ．
+  void
+  set_clock_input(
+    bool flag ///< [in] フラグ
+  )
+  {
+    mClockInput = flag;
+  }
+
+  /// @brief ポートを作る．
+  ///
+  /// 入出力ごとに単純なポートを作る．
+  /// 名前は入力が i0, i1, ... (クロック入力は clk, rst)，
+  /// 出力が o0, o1, ...，入出力が io0, io1, ... となる．
+  /// extra が true の時はビット指定(bs)，範囲指定(ps)，連結の
+  /// ポートも作る．
+  void
+  set_port(
+    bool flag,         ///< [in] ポートを作る時 true にするフラグ
+    bool extra = false ///< [in] 単純でないポートも作る時 true にするフラグ
+  )
+  {
+    mMakePort = flag;
+    mExtraPort = extra;
+  }
+
+  /// @brief 削除したノードで ID 番号に隙間を作る．
+  void
+  set_garbage(
+    bool flag ///< [in] フラグ
+  )
+  {
+    mGarbage = flag;
+  }
+
+  /// @brief 最初の入力ピンには半分の確率で最後に作ったノードを選ぶ．
+  ///
+  /// ファンアウトが一つのノードの連鎖ができやすくなる．
+  void
+  set_chain_bias(
+    bool flag ///< [in] フラグ
+  )
+  {
+    mChainBias = flag;
+  }
+
+  /// @brief ノードに名前をつける．
+  ///
+  /// 入出力には "モジュール名.i0" などの名前を，
+  /// 演算ノードのおよそ 1/3 には "モジュール名.n0" などの名前をつける．
+  void
+  set_node_map(
+    MvnVlMap* node_map ///< [in] 名前を登録する対応表
+  )
+  {
+    mNodeMap = node_map;
+  }
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 回路を作る関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief モジュールを作る．
+  MvnModule*
+  make(
+    const string& name, ///< [in] モジュール名
+    SizeType max_width, ///< [in] ビット幅の最大値
+    SizeType node_num   ///< [in] 演算ノード数
+  )
+  {
+    mPool.clear();
+    vector<SizeType> iw;
+    for ( SizeType i = 0; i < mInputNum; ++ i ) {
+      iw.push_back(rand(max_width) + 1);
+    }
+    iw.push_back(1);
+    if ( mClockInput ) {
+      iw.push_back(1);
+      iw.push_back(1);
+    }
+    vector<SizeType> ow;
+    for ( SizeType i = 0; i < mOutputNum; ++ i ) {
+      ow.push_back(rand(max_width) + 1);
+    }
+    vector<SizeType> iow(mInoutNum, max_width);
+    SizeType ni{iw.size()};
+    SizeType no{ow.size()};
+    SizeType nio{iow.size()};
+    SizeType np{0};
+    if ( mMakePort ) {
+      np = ni + no + nio;
+      if ( mExtraPort ) {
+	np += nio > 0 ? 3 : 2;
+      }
+    }
+    auto module{mMgr.new_module(name, np, iw, ow, iow)};
+    vector<string> iname_list;
+    for ( SizeType i = 0; i <= mInputNum; ++ i ) {
+      iname_list.push_back("i" + std::to_string(i));
+      mPool.push_back(module->input(i));
+    }
+    MvnNode* clk{nullptr};
+    MvnNode* rst{nullptr};
+    if ( mClockInput ) {
+      iname_list.push_back("clk");
+      iname_list.push_back("rst");
+      clk = module->input(mInputNum + 1);
+      rst = module->input(mInputNum + 2);
+    }
+    vector<string> oname_list;
+    for ( SizeType i = 0; i < no; ++ i ) {
+      oname_list.push_back("o" + std::to_string(i));
+    }
+    vector<string> ioname_list;
+    for ( SizeType i = 0; i < nio; ++ i ) {
+      ioname_list.push_back("io" + std::to_string(i));
+    }
+
+    // DFF は後で入力をつなぐ．
+    vector<MvnNode*> dff_list;
+    for ( SizeType i = 0; i < 2; ++ i ) {
+      SizeType w{rand(max_width) + 1};
+      vector<MvnPolarity> pol_array;
+      vector<MvnNode*> val_array;
+      if ( i == 1 ) {
+	pol_array.push_back(MvnPolarity::Negative);
+	val_array.push_back(mMgr.new_const(module, rand_const(w)));
+      }
+      auto dff{mMgr.new_dff(module, MvnPolarity::Positive,
+			    pol_array, val_array, w)};
+      dff_list.push_back(dff);
+      mPool.push_back(dff);
+    }
+
+    vector<MvnNode*> garbage_list;
+    for ( SizeType k = 0; k < node_num; ++ k ) {
+      if ( mGarbage && rand(4) == 0 ) {
+	garbage_list.push_back(mMgr.new_const(module, rand_const(rand(max_width) + 1)));
+      }
+      make_node(module, max_width);
+    }
+    for ( auto node: garbage_list ) {
+      mMgr.delete_node(node);
+    }
+
+    for ( auto dff: dff_list ) {
+      mMgr.connect(same_width(module, dff->bit_width()), 0, dff, 0);
+      mMgr.connect(mClockInput ? clk : same_width(module, 1), 0, dff, 1);
+      if ( dff->input_num() > 2 ) {
+	mMgr.connect(mClockInput ? rst : same_width(module, 1), 0, dff, 2);
+      }
+    }
+    for ( SizeType i = 0; i < nio; ++ i ) {
+      auto ionode{module->inout(i)};
+      mMgr.connect(same_width(module, max_width), 0, ionode, 0);
+    }
+    for ( SizeType i = 0; i < no; ++ i ) {
+      auto onode{module->output(i)};
+      mMgr.connect(same_width(module, onode->bit_width()), 0, onode, 0);
+    }
+
+    if ( mNodeMap != nullptr ) {
+      for ( SizeType i = 0; i < ni; ++ i ) {
+	mNodeMap->reg_node(module->input(i)->id(), name + "." + iname_list[i]);
+      }
+      for ( SizeType i = 0; i < no; ++ i ) {
+	mNodeMap->reg_node(module->output(i)->id(), name + "." + oname_list[i]);
+      }
+      for ( SizeType i = 0; i < nio; ++ i ) {
+	mNodeMap->reg_node(module->inout(i)->id(), name + "." + ioname_list[i]);
+      }
+    }
+
+    if ( mMakePort ) {
+      SizeType pos{0};
+      for ( SizeType i = 0; i < ni; ++ i, ++ pos ) {
+	mMgr.init_port(module, pos, {MvnPortRef{module->input(i)}}, iname_list[i]);
+      }
+      for ( SizeType i = 0; i < no; ++ i, ++ pos ) {
+	mMgr.init_port(module, pos, {MvnPortRef{module->output(i)}}, oname_list[i]);
+      }
+      for ( SizeType i = 0; i < nio; ++ i, ++ pos ) {
+	mMgr.init_port(module, pos, {MvnPortRef{module->inout(i)}}, ioname_list[i]);
+      }
+      if ( mExtraPort ) {
+	auto o0{module->output(0)};
+	mMgr.init_port(module, pos, {MvnPortRef{o0, rand(o0->bit_width())}}, "bs");
+	++ pos;
+	mMgr.init_port(module, pos, {MvnPortRef{module->input(0)},
+				     MvnPortRef{module->input(mInputNum)}});
+	++ pos;
+	if ( nio > 0 ) {
+	  mMgr.init_port(module, pos, {MvnPortRef{module->inout(0), max_width - 1, 0}}, "ps");
+	  ++ pos;
+	}
+      }
+    }
+    return module;
+  }
+
+  /// @brief 名前をつけた演算ノードのリストを返す．
+  const vector<std::pair<MvnNode*, string>>&
+  named_list() const
+  {
+    return mNamedList;
+  }
+
+  /// @brief 0 以上 n 未満の乱数を返す．
+  SizeType
+  rand(
+    SizeType n ///< [in] 上限
+  )
+  {
+    if ( n == 0 ) {
+      return 0;
+    }
+    std::uniform_int_distribution<SizeType> rd(0, n - 1);
+    return rd(mRandGen);
+  }
+
+  /// @brief 乱数で定数を作る．
+  MvnBvConst
+  rand_const(
+    SizeType w ///< [in] ビット幅
+  )
+  {
+    MvnBvConst val(w);
+    for ( SizeType b = 0; b < w; ++ b ) {
+      val.set_val(b, rand(2) == 1);
+    }
+    return val;
+  }
+
+  /// @brief 作ることのできる全ての演算ノードの種類を返す．
+  ///
+  /// POW は値が大きくなりすぎるので含まない．
+  static
+  vector<MvnNodeType>
+  default_type_list()
+  {
+    return vector<MvnNodeType>{
+      MvnNodeType::THROUGH,
+      MvnNodeType::NOT,
+      MvnNodeType::AND,
+      MvnNodeType::OR,
+      MvnNodeType::XOR,
+      MvnNodeType::RAND,
+      MvnNodeType::ROR,
+      MvnNodeType::RXOR,
+      MvnNodeType::EQ,
+      MvnNodeType::LT,
+      MvnNodeType::CASEEQ,
+      MvnNodeType::SLL,
+      MvnNodeType::SRL,
+      MvnNodeType::SLA,
+      MvnNodeType::SRA,
+      MvnNodeType::CMPL,
+      MvnNodeType::ADD,
+      MvnNodeType::SUB,
+      MvnNodeType::MUL,
+      MvnNodeType::DIV,
+      MvnNodeType::MOD,
+      MvnNodeType::ITE,
+      MvnNodeType::CONCAT,
+      MvnNodeType::CONSTBITSELECT,
+      MvnNodeType::CONSTPARTSELECT,
+      MvnNodeType::BITSELECT,
+      MvnNodeType::PARTSELECT,
+      MvnNodeType::CONSTVALUE,
+      MvnNodeType::LATCH
+    };
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  // 指定されたビット幅のノードを選ぶ．
+  //
+  // recent が true の時は半分の確率で最後に作ったノードを選ぶ．
+  // 見つからなければ定数ノードを作る．
+  MvnNode*
+  same_width(
+    MvnModule* module,
+    SizeType w,
+    bool recent = false
+  )
+  {
+    vector<MvnNode*> cand_list;
+    for ( auto node: mPool ) {
+      if ( node->bit_width() == w ) {
+	cand_list.push_back(node);
+      }
+    }
+    if ( cand_list.empty() ) {
+      return mMgr.new_const(module, rand_const(w));
+    }
+    if ( recent && rand(2) == 0 ) {
+      return cand_list.back();
+    }
+    return cand_list[rand(cand_list.size())];
+  }
+
+  // 演算ノードを一つ作る．
+  void
+  make_node(
+    MvnModule* module,
+    SizeType max_width
+  )
+  {
+    // 連鎖を作る時は直前のノードのビット幅を使いやすくする．
+    SizeType wa{mChainBias && rand(2) == 0 ?
+		mPool.back()->bit_width() : rand(max_width) + 1};
+    SizeType wb{rand(max_width) + 1};
+    SizeType ws{rand(4) + 1};
+    SizeType wo{rand(max_width) + 1};
+    MvnNode* node{nullptr};
+    switch ( mTypeList[rand(mTypeList.size())] ) {
+    case MvnNodeType::THROUGH: node = mMgr.new_through(module, wa); break;
+    case MvnNodeType::NOT:     node = mMgr.new_not(module, wa); break;
+    case MvnNodeType::AND:     node = mMgr.new_and(module, rand(2) + 2, wa); break;
+    case MvnNodeType::OR:      node = mMgr.new_or(module, rand(2) + 2, wa); break;
+    case MvnNodeType::XOR:     node = mMgr.new_xor(module, rand(2) + 2, wa); break;
+    case MvnNodeType::RAND:    node = mMgr.new_rand(module, wa); break;
+    case MvnNodeType::ROR:     node = mMgr.new_ror(module, wa); break;
+    case MvnNodeType::RXOR:    node = mMgr.new_rxor(module, wa); break;
+    case MvnNodeType::EQ:      node = mMgr.new_equal(module, wa); break;
+    case MvnNodeType::LT:      node = mMgr.new_lt(module, wa); break;
+    case MvnNodeType::CASEEQ:
+      {
+	MvnBvConst xmask(wa);
+	for ( SizeType b = 0; b < wa; ++ b ) {
+	  xmask.set_val(b, rand(3) == 0);
+	}
+	node = mMgr.new_caseeq(module, wa, xmask);
+      }
+      break;
+    case MvnNodeType::SLL:     node = mMgr.new_sll(module, wa, ws, wo); break;
+    case MvnNodeType::SRL:     node = mMgr.new_srl(module, wa, ws, wo); break;
+    case MvnNodeType::SLA:     node = mMgr.new_sla(module, wa, ws, wo); break;
+    case MvnNodeType::SRA:     node = mMgr.new_sra(module, wa, ws, wo); break;
+    case MvnNodeType::CMPL:    node = mMgr.new_cmpl(module, wa); break;
+    case MvnNodeType::ADD:     node = mMgr.new_add(module, wa, wb, wo); break;
+    case MvnNodeType::SUB:     node = mMgr.new_sub(module, wa, wb, wo); break;
+    case MvnNodeType::MUL:     node = mMgr.new_mult(module, wa, wb, wo); break;
+    case MvnNodeType::DIV:     node = mMgr.new_div(module, wa, wb, wo); break;
+    case MvnNodeType::MOD:     node = mMgr.new_mod(module, wa, wb, wo); break;
+    case MvnNodeType::POW:     node = mMgr.new_pow(module, wa, ws, wo); break;
+    case MvnNodeType::ITE:     node = mMgr.new_ite(module, wa); break;
+    case MvnNodeType::CONCAT:  node = mMgr.new_concat(module, {wa, wb}); break;
+    case MvnNodeType::CONSTBITSELECT:
+      node = mMgr.new_constbitselect(module, rand(wa), wa);
+      break;
+    case MvnNodeType::CONSTPARTSELECT:
+      {
+	SizeType lsb{rand(wa)};
+	SizeType msb{lsb + rand(wa - lsb)};
+	node = mMgr.new_constpartselect(module, msb, lsb, wa);
+      }
+      break;
+    case MvnNodeType::BITSELECT:
+      node = mMgr.new_bitselect(module, wa, ws);
+      break;
+    case MvnNodeType::PARTSELECT:
+      node = mMgr.new_partselect(module, wa, ws, wo);
+      break;
+    case MvnNodeType::CONSTVALUE:
+      node = mMgr.new_const(module, rand_const(wo));
+      break;
+    case MvnNodeType::LATCH:   node = mMgr.new_latch(module, wa); break;
+    default:
+      ASSERT_NOT_REACHED;
+      break;
+    }
+    for ( SizeType i = 0; i < node->input_num(); ++ i ) {
+      auto src{same_width(module, node->input(i)->bit_width(),
+			  mChainBias && i == 0)};
+      mMgr.connect(src, 0, node, i);
+    }
+    mPool.push_back(node);
+    if ( mNodeMap != nullptr && rand(3) == 0 ) {
+      auto name{module->name() + ".n" + std::to_string(mNamedList.size())};
+      mNodeMap->reg_node(node->id(), name);
+      mNamedList.push_back({node, name});
+    }
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 対象の MvnMgr
+  MvnMgr& mMgr;
+
+  // 乱数発生器
+  std::mt19937_64 mRandGen;
+
+  // 作る演算ノードの種類のリスト
+  vector<MvnNodeType> mTypeList;
+
+  // 乱数で決めたビット幅の入力数
+  SizeType mInputNum{4};
+
+  // 出力数
+  SizeType mOutputNum{8};
+
+  // 入出力数
+  SizeType mInoutNum{0};
+
+  // DFF の制御に専用の入力を用いる時 true にするフラグ
+  bool mClockInput{false};
+
+  // ポートを作る時 true にするフラグ
+  bool mMakePort{false};
+
+  // 単純でないポートも作る時 true にするフラグ
+  bool mExtraPort{false};
+
+  // 削除したノードで ID 番号に隙間を作る時 true にするフラグ
+  bool mGarbage{false};
+
+  // 直前のノードを選びやすくする時 true にするフラグ
+  bool mChainBias{false};
+
+  // 名前を登録する対応表
+  MvnVlMap* mNodeMap{nullptr};
+
+  // 作ったノードのリスト
+  vector<MvnNode*> mPool;
+
+  // 名前をつけた演算ノードのリスト
+  vector<std::pair<MvnNode*, string>> mNamedList;
+
+};
+
+END_NAMESPACE_YM
+
+#endif // RANDCIRCUIT_H
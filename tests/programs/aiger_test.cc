@@ -0,0 +1,154 @@
+﻿
+/// @file aiger_test.cc
+/// @brief MvnAigerWriter のテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+///
+/// 手で作った小さな回路の出力を期待される AIGER の内容と比較する．
+
+
+#include "ym/MvnMgr.h"
+#include "ym/MvnModule.h"
+#include "ym/MvnNode.h"
+#include "ym/MvnPort.h"
+#include "ym/MvnAigerWriter.h"
+#include <sstream>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+int error_num = 0;
+
+// 出力を期待値と比較する．
+void
+check_text(
+  const string& what,
+  const string& text,
+  const string& exp_text
+)
+{
+  if ( text != exp_text ) {
+    cerr << "Error: " << what << ": unexpected output" << endl
+	 << "---- output ----" << endl
+	 << text
+	 << "---- expected ----" << endl
+	 << exp_text;
+    ++ error_num;
+  }
+}
+
+// 2ビットの AND を2つと1ビットの DFF を持つ回路
+//
+// y = a & b, z = b & a, q = DFF(c)
+// y と z は構造ハッシュで同じ AND ノードになる．
+void
+and_dff_test()
+{
+  MvnMgr mgr;
+  auto module{mgr.new_module("m", 7, {2, 2, 1, 1}, {2, 2, 1}, {})};
+  vector<string> name_list{"a", "b", "c", "clk", "y", "z", "q"};
+  for ( SizeType i = 0; i < 4; ++ i ) {
+    mgr.init_port(module, i, {MvnPortRef{module->input(i)}}, name_list[i]);
+  }
+  for ( SizeType i = 0; i < 3; ++ i ) {
+    mgr.init_port(module, i + 4, {MvnPortRef{module->output(i)}},
+		  name_list[i + 4]);
+  }
+  auto a{module->input(0)};
+  auto b{module->input(1)};
+  auto and1{mgr.new_and(module, 2, 2)};
+  mgr.connect(a, 0, and1, 0);
+  mgr.connect(b, 0, and1, 1);
+  auto and2{mgr.new_and(module, 2, 2)};
+  mgr.connect(b, 0, and2, 0);
+  mgr.connect(a, 0, and2, 1);
+  auto dff{mgr.new_dff(module, MvnPolarity::Positive, {}, {}, 1)};
+  mgr.connect(module->input(2), 0, dff, 0);
+  mgr.connect(module->input(3), 0, dff, 1);
+  mgr.connect(and1, 0, module->output(0), 0);
+  mgr.connect(and2, 0, module->output(1), 0);
+  mgr.connect(dff, 0, module->output(2), 0);
+
+  std::ostringstream buf;
+  MvnAigerWriter writer;
+  writer(buf, mgr);
+
+  // 変数は a[0]:1, a[1]:2, b[0]:3, b[1]:4, c:5, clk:6, ラッチ:7,
+  // AND: 8 = a[0] & b[0], 9 = a[1] & b[1]
+  // AND ノードは (lhs - rhs0, rhs0 - rhs1) を可変長符号で表す．
+  // 16 - 6 = 10 ('\n'), 6 - 2 = 4, 18 - 8 = 10, 8 - 4 = 4
+  std::ostringstream exp_buf;
+  exp_buf << "aig 9 6 1 5 2\n"
+	  << "10\n"
+	  << "16\n"
+	  << "18\n"
+	  << "16\n"
+	  << "18\n"
+	  << "14\n"
+	  << "\n\x04"
+	  << "\n\x04"
+	  << "i0 a[0]\n"
+	  << "i1 a[1]\n"
+	  << "i2 b[0]\n"
+	  << "i3 b[1]\n"
+	  << "i4 c\n"
+	  << "i5 clk\n"
+	  << "l0 node" << dff->id() << "\n"
+	  << "o0 y[0]\n"
+	  << "o1 y[1]\n"
+	  << "o2 z[0]\n"
+	  << "o3 z[1]\n"
+	  << "o4 q\n";
+  check_text("and_dff", buf.str(), exp_buf.str());
+}
+
+// 1ビットの XOR
+//
+// XOR は3つの AND で表される．
+void
+xor_test()
+{
+  MvnMgr mgr;
+  auto module{mgr.new_module("x", 0, {1, 1}, {1}, {})};
+  auto xor1{mgr.new_xor(module, 2, 1)};
+  mgr.connect(module->input(0), 0, xor1, 0);
+  mgr.connect(module->input(1), 0, xor1, 1);
+  mgr.connect(xor1, 0, module->output(0), 0);
+
+  std::ostringstream buf;
+  MvnAigerWriter writer;
+  writer(buf, mgr);
+  auto text{buf.str()};
+  auto header{text.substr(0, text.find('\n'))};
+  if ( header != "aig 5 2 0 1 3" ) {
+    cerr << "Error: xor: header is \"" << header << "\"" << endl;
+    ++ error_num;
+  }
+}
+
+END_NONAMESPACE
+
+END_NAMESPACE_YM
+
+
+int
+main(int argc,
+     const char** argv)
+{
+  using namespace std;
+  using namespace nsYm;
+
+  and_dff_test();
+  xor_test();
+
+  if ( error_num > 0 ) {
+    cerr << error_num << " error(s)" << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
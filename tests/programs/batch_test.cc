@@ -0,0 +1,142 @@
+﻿
+/// @file batch_test.cc
+/// @brief MvnBatchSimulator のテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+///
+/// 乱数で作った回路と入力系列のリストを1スレッドと複数スレッドの
+/// MvnBatchSimulator で処理し，入力系列ごとに MvnSimulator で求めた
+/// 出力系列と比較する．
+
+
+#include "ym/MvnMgr.h"
+#include "ym/MvnModule.h"
+#include "ym/MvnNode.h"
+#include "ym/MvnBvConst.h"
+#include "ym/MvnSimulator.h"
+#include "ym/MvnBatchSimulator.h"
+#include "RandCircuit.h"
+
+
+BEGIN_NAMESPACE_YM
+
+using nsMvn::MvnStimulus;
+using nsMvn::MvnResponse;
+
+BEGIN_NONAMESPACE
+
+int error_num = 0;
+
+// MvnSimulator で出力系列を求める．
+MvnResponse
+simulate(
+  const MvnMgr& mgr,
+  const MvnModule* module,
+  const MvnStimulus& stim
+)
+{
+  MvnSimulator sim{mgr, module};
+  MvnResponse resp;
+  for ( auto& ivals: stim ) {
+    for ( SizeType i = 0; i < ivals.size(); ++ i ) {
+      sim.set_input(i, ivals[i]);
+    }
+    vector<MvnBvConst> ovals;
+    for ( SizeType i = 0; i < module->output_num(); ++ i ) {
+      ovals.push_back(sim.output(i));
+    }
+    resp.push_back(ovals);
+    sim.step(1);
+  }
+  return resp;
+}
+
+// 乱数で作った回路で比較する．
+void
+batch_test(
+  SizeType seed
+)
+{
+  MvnMgr mgr;
+  RandCircuit rc{mgr, seed};
+  // 多ワードの演算を含むように奇数番目は幅を広くとる．
+  SizeType max_width = seed % 2 == 0 ? 8 : 100;
+  auto module{rc.make("top", max_width, 40)};
+  string prefix{"seed " + std::to_string(seed)};
+
+  // 系列ごとに長さを変えてスレッドごとの仕事量に偏りを作る．
+  vector<MvnStimulus> stim_list(50);
+  for ( auto& stim: stim_list ) {
+    SizeType nc{rc.rand(12) + 1};
+    for ( SizeType c = 0; c < nc; ++ c ) {
+      vector<MvnBvConst> ivals;
+      for ( SizeType i = 0; i < module->input_num(); ++ i ) {
+	ivals.push_back(rc.rand_const(module->input(i)->bit_width()));
+      }
+      stim.push_back(ivals);
+    }
+  }
+  vector<MvnResponse> exp_list;
+  for ( auto& stim: stim_list ) {
+    exp_list.push_back(simulate(mgr, module, stim));
+  }
+
+  for ( SizeType nt: {1, 4} ) {
+    MvnBatchSimulator bsim{mgr, module, nt};
+    if ( bsim.thread_num() != nt ) {
+      cerr << "Error: " << prefix
+	   << ": thread_num() = " << bsim.thread_num()
+	   << ", expected " << nt << endl;
+      ++ error_num;
+    }
+    auto resp_list{bsim.run(stim_list)};
+    if ( resp_list.size() != stim_list.size() ) {
+      cerr << "Error: " << prefix << ", " << nt << " thread(s)"
+	   << ": " << resp_list.size() << " responses for "
+	   << stim_list.size() << " stimuli" << endl;
+      ++ error_num;
+      continue;
+    }
+    for ( SizeType k = 0; k < stim_list.size(); ++ k ) {
+      if ( resp_list[k] != exp_list[k] ) {
+	cerr << "Error: " << prefix << ", " << nt << " thread(s)"
+	     << ": response#" << k << " differs from MvnSimulator" << endl;
+	++ error_num;
+	break;
+      }
+    }
+  }
+
+  // 入力系列がない場合
+  MvnBatchSimulator bsim{mgr, module, 4};
+  if ( !bsim.run({}).empty() ) {
+    cerr << "Error: " << prefix << ": run() on no stimulus" << endl;
+    ++ error_num;
+  }
+}
+
+END_NONAMESPACE
+
+END_NAMESPACE_YM
+
+
+int
+main(int argc,
+     const char** argv)
+{
+  using namespace std;
+  using namespace nsYm;
+
+  for ( SizeType seed = 0; seed < 16; ++ seed ) {
+    batch_test(seed);
+  }
+
+  if ( error_num > 0 ) {
+    cerr << error_num << " error(s)" << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
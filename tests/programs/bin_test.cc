@@ -0,0 +1,391 @@
+﻿
+/// @file bin_test.cc
+/// @brief MvnBinWriter/MvnBinReader のテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+///
+/// 乱数で作った回路を書き出して読み込み，
+/// - 読み込んだ結果を書き出したものが元の出力と一致すること
+/// - 元の回路と読み込んだ回路のシミュレーション結果が一致すること
+/// - ファンインコーンだけを読み込んだ回路の出力が元の回路と一致すること
+/// - 壊れたファイルの読み込みが失敗すること
+/// を確かめる．
+
+
+#include "ym/MvnMgr.h"
+#include "ym/MvnModule.h"
+#include "ym/MvnNode.h"
+#include "ym/MvnInputPin.h"
+#include "ym/MvnPort.h"
+#include "ym/MvnBvConst.h"
+#include "ym/MvnVlMap.h"
+#include "ym/MvnSimulator.h"
+#include "ym/MvnBinWriter.h"
+#include "ym/MvnBinReader.h"
+#include "RandCircuit.h"
+#include <random>
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+int error_num = 0;
+
+// ファイルの内容を読み込む．
+string
+read_file(
+  const string& filename
+)
+{
+  std::ifstream s{filename, std::ios::binary};
+  std::ostringstream buf;
+  buf << s.rdbuf();
+  return buf.str();
+}
+
+// ファイルに書き出す．
+void
+write_file(
+  const string& filename,
+  const string& data
+)
+{
+  std::ofstream s{filename, std::ios::binary};
+  s << data;
+}
+
+// 名前でモジュールを探す．
+const MvnModule*
+find_module(
+  const MvnMgr& mgr,
+  const string& name
+)
+{
+  for ( SizeType id = 0; id < mgr.max_module_id(); ++ id ) {
+    auto module{mgr.module(id)};
+    if ( module != nullptr && module->name() == name ) {
+      return module;
+    }
+  }
+  return nullptr;
+}
+
+// 二つのシミュレータに同じ入力系列を与えて値を比較する．
+//
+// ipos_map[i] は sim2 の i 番目の入力に対応する sim1 の入力番号
+// pair_list の各要素は比較するノードの組
+void
+compare_sim(
+  const string& what,
+  const MvnMgr& mgr1,
+  const MvnModule* module1,
+  const MvnMgr& mgr2,
+  const MvnModule* module2,
+  const vector<SizeType>& ipos_map,
+  const vector<std::pair<const MvnNode*, const MvnNode*>>& pair_list,
+  SizeType seed
+)
+{
+  MvnSimulator sim1{mgr1, module1};
+  MvnSimulator sim2{mgr2, module2};
+  std::mt19937_64 rg{seed};
+  SizeType ni{module1->input_num()};
+  for ( SizeType k = 0; k < 20; ++ k ) {
+    vector<MvnBvConst> val_list;
+    for ( SizeType i = 0; i < ni; ++ i ) {
+      SizeType w{module1->input(i)->bit_width()};
+      MvnBvConst val(w);
+      for ( SizeType b = 0; b < w; ++ b ) {
+	val.set_val(b, (rg() & 1) != 0);
+      }
+      sim1.set_input(i, val);
+      val_list.push_back(val);
+    }
+    for ( SizeType i = 0; i < ipos_map.size(); ++ i ) {
+      sim2.set_input(i, val_list[ipos_map[i]]);
+    }
+    for ( auto& p: pair_list ) {
+      if ( sim1.value(p.first) != sim2.value(p.second) ) {
+	cerr << "Error: " << what << ": cycle " << k
+	     << ": values of node#" << p.first->id()
+	     << " differ: " << sim1.value(p.first)
+	     << " vs " << sim2.value(p.second) << endl;
+	++ error_num;
+	return;
+      }
+    }
+    sim1.step();
+    sim2.step();
+  }
+}
+
+// コーンの入力を元の入力に対応づける．
+//
+// コーンのポートは入出力ごとに作られ，単純なポートの名前を受け継ぐ．
+bool
+cone_input_map(
+  const MvnModule* module,
+  const MvnModule* cone,
+  vector<SizeType>& ipos_map
+)
+{
+  for ( SizeType i = 0; i < cone->input_num(); ++ i ) {
+    auto name{cone->port(i)->name()};
+    SizeType pos{module->input_num()};
+    for ( SizeType j = 0; j < module->input_num(); ++ j ) {
+      if ( module->port(j)->name() == name ) {
+	pos = j;
+      }
+    }
+    if ( pos == module->input_num() ) {
+      return false;
+    }
+    ipos_map.push_back(pos);
+  }
+  return true;
+}
+
+// 書き出して読み込む．
+void
+bin_test(
+  const string& dir,
+  SizeType seed
+)
+{
+  MvnMgr mgr;
+  MvnVlMap node_map;
+  RandCircuit rc{mgr, seed};
+  rc.set_io_num(3, 6, 1);
+  rc.set_port(true, true);
+  rc.set_garbage(true);
+  rc.set_node_map(&node_map);
+  // 多ワードの演算を含むように 2 つ目のモジュールは幅を広くとる．
+  auto top{rc.make("top", 8, 40)};
+  rc.make("wide", 100, 20);
+  auto named_list{rc.named_list()};
+
+  string prefix{"seed " + std::to_string(seed)};
+  string filename{dir + "/" + std::to_string(seed) + ".mvnbin"};
+  {
+    std::ofstream s{filename, std::ios::binary};
+    MvnBinWriter writer;
+    writer(s, mgr, node_map);
+  }
+  string bin1{read_file(filename)};
+
+  // 読み込んだ結果を書き出したものは元の出力と一致する．
+  MvnMgr mgr2;
+  MvnVlMap node_map2;
+  MvnBinReader reader;
+  if ( !reader.read(filename, mgr2, node_map2) ) {
+    cerr << "Error: " << prefix << ": read() failed" << endl;
+    ++ error_num;
+    return;
+  }
+  std::ostringstream buf2;
+  MvnBinWriter writer;
+  writer(buf2, mgr2, node_map2);
+  if ( buf2.str() != bin1 ) {
+    cerr << "Error: " << prefix << ": save(load(save(x))) != save(x)" << endl;
+    ++ error_num;
+  }
+
+  // 入出力のビット幅とポートと名前が一致する．
+  auto top2{find_module(mgr2, "top")};
+  if ( top2 == nullptr ) {
+    cerr << "Error: " << prefix << ": module 'top' is missing" << endl;
+    ++ error_num;
+    return;
+  }
+  if ( top2->input_num() != top->input_num() ||
+       top2->output_num() != top->output_num() ||
+       top2->inout_num() != top->inout_num() ||
+       top2->port_num() != top->port_num() ) {
+    cerr << "Error: " << prefix << ": interface of 'top' differs" << endl;
+    ++ error_num;
+    return;
+  }
+  vector<SizeType> ipos_map;
+  vector<std::pair<const MvnNode*, const MvnNode*>> pair_list;
+  for ( SizeType i = 0; i < top->input_num(); ++ i ) {
+    ipos_map.push_back(i);
+  }
+  for ( SizeType i = 0; i < top->output_num(); ++ i ) {
+    auto onode1{top->output(i)};
+    auto onode2{top2->output(i)};
+    if ( onode1->bit_width() != onode2->bit_width() ||
+	 node_map.get_name(onode1->id()) != node_map2.get_name(onode2->id()) ) {
+      cerr << "Error: " << prefix << ": output#" << i << " differs" << endl;
+      ++ error_num;
+    }
+    pair_list.push_back({onode1, onode2});
+  }
+  for ( SizeType i = 0; i < top->port_num(); ++ i ) {
+    auto port1{top->port(i)};
+    auto port2{top2->port(i)};
+    if ( port1->name() != port2->name() ||
+	 port1->port_ref_num() != port2->port_ref_num() ||
+	 port1->bit_width() != port2->bit_width() ) {
+      cerr << "Error: " << prefix << ": port#" << i << " differs" << endl;
+      ++ error_num;
+    }
+  }
+
+  // シミュレーション結果が一致する．
+  compare_sim(prefix + ": load", mgr, top, mgr2, top2,
+	      ipos_map, pair_list, seed);
+
+  // 出力番号で指定したファンインコーンだけを読み込む．
+  for ( SizeType opos = 0; opos < top->output_num(); ++ opos ) {
+    MvnMgr mgr3;
+    MvnVlMap node_map3;
+    if ( !reader.read_cone(filename, "top", {opos}, mgr3, node_map3) ) {
+      cerr << "Error: " << prefix << ": read_cone(" << opos << ") failed" << endl;
+      ++ error_num;
+      continue;
+    }
+    auto top3{find_module(mgr3, "top")};
+    if ( top3 == nullptr || top3->output_num() != 1 ) {
+      cerr << "Error: " << prefix << ": read_cone(" << opos
+	   << ") made a wrong module" << endl;
+      ++ error_num;
+      continue;
+    }
+    vector<SizeType> ipos_map3;
+    if ( !cone_input_map(top, top3, ipos_map3) ) {
+      cerr << "Error: " << prefix << ": read_cone(" << opos
+	   << "): unknown input" << endl;
+      ++ error_num;
+      continue;
+    }
+    compare_sim(prefix + ": cone#" + std::to_string(opos),
+		mgr, top, mgr3, top3, ipos_map3,
+		{{top->output(opos), top3->output(0)}}, seed);
+  }
+
+  // 名前で指定したファンインコーンだけを読み込む．
+  for ( auto& p: named_list ) {
+    auto node{p.first};
+    if ( node->parent() != top ) {
+      continue;
+    }
+    MvnMgr mgr3;
+    MvnVlMap node_map3;
+    if ( !reader.read_cone(filename, {p.second}, mgr3, node_map3) ) {
+      cerr << "Error: " << prefix << ": read_cone(" << p.second
+	   << ") failed" << endl;
+      ++ error_num;
+      continue;
+    }
+    auto top3{find_module(mgr3, "top")};
+    if ( top3 == nullptr || top3->output_num() != 1 ) {
+      cerr << "Error: " << prefix << ": read_cone(" << p.second
+	   << ") made a wrong module" << endl;
+      ++ error_num;
+      continue;
+    }
+    vector<SizeType> ipos_map3;
+    if ( !cone_input_map(top, top3, ipos_map3) ) {
+      cerr << "Error: " << prefix << ": read_cone(" << p.second
+	   << "): unknown input" << endl;
+      ++ error_num;
+      continue;
+    }
+    compare_sim(prefix + ": cone " + p.second,
+		mgr, top, mgr3, top3, ipos_map3,
+		{{node, top3->output(0)}}, seed);
+  }
+
+  // 名前なしで書き出したファイルは名前以外は同じ内容になる．
+  {
+    std::ofstream s{filename, std::ios::binary};
+    writer(s, mgr);
+  }
+  MvnMgr mgr4;
+  MvnVlMap node_map4;
+  if ( !reader.read(filename, mgr4, node_map4) ) {
+    cerr << "Error: " << prefix << ": read() without names failed" << endl;
+    ++ error_num;
+  }
+  else {
+    std::ostringstream buf4;
+    writer(buf4, mgr4);
+    std::ostringstream buf1;
+    writer(buf1, mgr);
+    if ( buf4.str() != buf1.str() ) {
+      cerr << "Error: " << prefix << ": round trip without names differs" << endl;
+      ++ error_num;
+    }
+  }
+
+  // 壊れたファイルは読み込みに失敗する．
+  // (エラーメッセージが出力される)
+  std::mt19937_64 rg{seed};
+  for ( SizeType k = 0; k < 4; ++ k ) {
+    std::uniform_int_distribution<SizeType> rd(0, bin1.size() - 1);
+    SizeType size{k == 0 ? 0 : rd(rg)};
+    write_file(filename, bin1.substr(0, size));
+    MvnMgr mgr5;
+    MvnVlMap node_map5;
+    if ( reader.read(filename, mgr5, node_map5) ) {
+      cerr << "Error: " << prefix << ": read() of a file truncated to "
+	   << size << " bytes succeeded" << endl;
+      ++ error_num;
+    }
+  }
+  {
+    string bad{bin1};
+    bad[0] ^= 1;
+    write_file(filename, bad);
+    MvnMgr mgr5;
+    if ( reader.read(filename, mgr5) ) {
+      cerr << "Error: " << prefix << ": read() of a file with a wrong magic succeeded" << endl;
+      ++ error_num;
+    }
+  }
+  if ( reader.read(dir + "/no_such_file.mvnbin", mgr2) ) {
+    cerr << "Error: " << prefix << ": read() of a missing file succeeded" << endl;
+    ++ error_num;
+  }
+}
+
+END_NONAMESPACE
+
+END_NAMESPACE_YM
+
+
+int
+main(
+  int argc,
+  const char** argv
+)
+{
+  using namespace std;
+  using namespace nsYm;
+
+  char tmpl[] = "/tmp/mvn_bin_test_XXXXXX";
+  if ( mkdtemp(tmpl) == nullptr ) {
+    cerr << "could not create a temporary directory" << endl;
+    return 1;
+  }
+  string dir{tmpl};
+
+  for ( SizeType seed = 0; seed < 20; ++ seed ) {
+    bin_test(dir, seed);
+  }
+
+  system(("rm -rf " + dir).c_str());
+
+  if ( error_num > 0 ) {
+    cerr << error_num << " error(s)" << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -0,0 +1,326 @@
+﻿
+/// @file bnconv_test.cc
+/// @brief MvnBnConv のテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+///
+/// 乱数で作った回路を BnNetwork に変換して，
+/// BnNetwork 上で計算した出力値を MvnSimulator の値と比較する．
+
+
+#include "ym/MvnMgr.h"
+#include "ym/MvnModule.h"
+#include "ym/MvnNode.h"
+#include "ym/MvnBvConst.h"
+#include "ym/MvnSimulator.h"
+#include "ym/MvnBnConv.h"
+#include "ym/MvnBnMap.h"
+#include "ym/BnNetwork.h"
+#include "ym/BnPort.h"
+#include "ym/BnDff.h"
+#include "ym/BnNode.h"
+#include "RandCircuit.h"
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+int error_num = 0;
+
+//////////////////////////////////////////////////////////////////////
+// BnNetwork の値を計算するクラス
+//////////////////////////////////////////////////////////////////////
+class BnEval
+{
+public:
+
+  // コンストラクタ
+  BnEval(
+    const BnNetwork& network
+  ) : mNetwork{network},
+      mSrcVal(network.node_num(), 0),
+      mVal(network.node_num(), -1)
+  {
+  }
+
+  // 入力ノード(DFFの出力を含む)の値を設定する．
+  void
+  set_src(
+    BnNode node,
+    int val
+  )
+  {
+    mSrcVal[node.id()] = val;
+  }
+
+  // 入力ノードの値を返す．
+  int
+  src(
+    BnNode node
+  ) const
+  {
+    return mSrcVal[node.id()];
+  }
+
+  // 計算済みの値を捨てる．
+  void
+  clear()
+  {
+    std::fill(mVal.begin(), mVal.end(), -1);
+  }
+
+  // ノードの値を返す．
+  int
+  eval(
+    BnNode node
+  )
+  {
+    auto id{node.id()};
+    if ( mVal[id] >= 0 ) {
+      return mVal[id];
+    }
+    int val{0};
+    if ( node.is_input() ) {
+      val = mSrcVal[id];
+    }
+    else if ( node.is_output() ) {
+      val = eval(node.output_src());
+    }
+    else {
+      switch ( node.primitive_type() ) {
+      case PrimType::C0:   val = 0; break;
+      case PrimType::C1:   val = 1; break;
+      case PrimType::Buff: val = eval(node.fanin(0)); break;
+      case PrimType::Not:  val = 1 - eval(node.fanin(0)); break;
+      case PrimType::And:  val = eval(node.fanin(0)) & eval(node.fanin(1)); break;
+      case PrimType::Xor:  val = eval(node.fanin(0)) ^ eval(node.fanin(1)); break;
+      default: ASSERT_NOT_REACHED;
+      }
+    }
+    mVal[id] = val;
+    return val;
+  }
+
+
+private:
+
+  // 対象のネットワーク
+  const BnNetwork& mNetwork;
+
+  // 入力ノードの値
+  vector<int> mSrcVal;
+
+  // 計算済みの値(-1 は未計算)
+  vector<int> mVal;
+
+};
+
+// 1クロック分の値を計算する．
+//
+// 非同期のクリア/プリセットが働いた DFF は出力を変えて計算し直す．
+void
+eval_cycle(
+  const BnNetwork& network,
+  BnEval& eval
+)
+{
+  for ( ; ; ) {
+    eval.clear();
+    bool changed{false};
+    for ( SizeType i = 0; i < network.dff_num(); ++ i ) {
+      auto dff{network.dff(i)};
+      auto out{dff.data_out()};
+      int val{eval.src(out)};
+      if ( dff.preset().is_valid() && eval.eval(dff.preset()) ) {
+	val = 1;
+      }
+      else if ( dff.clear().is_valid() && eval.eval(dff.clear()) ) {
+	val = 0;
+      }
+      if ( val != eval.src(out) ) {
+	eval.set_src(out, val);
+	changed = true;
+      }
+    }
+    if ( !changed ) {
+      break;
+    }
+  }
+}
+
+// クロックを1回入れる．
+//
+// 非同期のクリア/プリセットが働いている DFF はその値を保持する．
+void
+clock_cycle(
+  const BnNetwork& network,
+  BnEval& eval
+)
+{
+  vector<int> next_list;
+  for ( SizeType i = 0; i < network.dff_num(); ++ i ) {
+    auto dff{network.dff(i)};
+    int val;
+    if ( dff.preset().is_valid() && eval.eval(dff.preset()) ) {
+      val = 1;
+    }
+    else if ( dff.clear().is_valid() && eval.eval(dff.clear()) ) {
+      val = 0;
+    }
+    else {
+      val = eval.eval(dff.data_in());
+    }
+    next_list.push_back(val);
+  }
+  for ( SizeType i = 0; i < network.dff_num(); ++ i ) {
+    eval.set_src(network.dff(i).data_out(), next_list[i]);
+  }
+}
+
+// MvnSimulator と比較する．
+void
+compare(
+  const MvnMgr& mgr,
+  const MvnModule* module,
+  const BnNetwork& network,
+  RandCircuit& rc,
+  SizeType seed
+)
+{
+  MvnSimulator sim{mgr, module};
+  BnEval eval{network};
+  SizeType ni{module->input_num()};
+  SizeType no{module->output_num()};
+  // 入力ポート，出力ポートの順に作られている．
+  for ( SizeType cycle = 0; cycle < 8; ++ cycle ) {
+    for ( SizeType i = 0; i < ni; ++ i ) {
+      SizeType w{module->input(i)->bit_width()};
+      auto val{rc.rand_const(w)};
+      auto port{network.port(i)};
+      for ( SizeType b = 0; b < w; ++ b ) {
+	eval.set_src(port.bit(b), val[b] ? 1 : 0);
+      }
+      sim.set_input(i, val);
+    }
+    eval_cycle(network, eval);
+    for ( SizeType i = 0; i < no; ++ i ) {
+      auto val{sim.output(i)};
+      auto port{network.port(ni + i)};
+      for ( SizeType b = 0; b < val.size(); ++ b ) {
+	int bn_val{eval.eval(port.bit(b))};
+	if ( bn_val != (val[b] ? 1 : 0) ) {
+	  cerr << "Error: seed " << seed
+	       << ", cycle " << cycle
+	       << ", output" << i << "[" << b << "]"
+	       << ": BnNetwork = " << bn_val
+	       << ", MvnSimulator = " << val[b] << endl;
+	  ++ error_num;
+	  return;
+	}
+      }
+    }
+    clock_cycle(network, eval);
+    sim.step(1);
+  }
+}
+
+// 乱数で作った回路を変換して比較する．
+void
+conv_test(
+  SizeType seed
+)
+{
+  MvnMgr mgr;
+  RandCircuit rc{mgr, seed};
+  rc.set_type_list({MvnNodeType::NOT, MvnNodeType::AND, MvnNodeType::OR,
+		    MvnNodeType::XOR, MvnNodeType::RXOR, MvnNodeType::EQ,
+		    MvnNodeType::LT, MvnNodeType::SLL, MvnNodeType::SRA,
+		    MvnNodeType::CMPL, MvnNodeType::ADD, MvnNodeType::SUB,
+		    MvnNodeType::MUL, MvnNodeType::DIV, MvnNodeType::MOD,
+		    MvnNodeType::ITE, MvnNodeType::CONCAT,
+		    MvnNodeType::CONSTBITSELECT, MvnNodeType::CONSTPARTSELECT,
+		    MvnNodeType::BITSELECT, MvnNodeType::CASEEQ,
+		    MvnNodeType::CONSTVALUE});
+  SizeType max_width = seed % 2 == 0 ? 8 : 40;
+  auto module{rc.make("top", max_width, 80)};
+
+  MvnBnConv conv;
+  nsMvn::MvnArithArch arch;
+  arch.mAdder = static_cast<nsMvn::MvnAdderArch>(seed % 3);
+  arch.mMult = static_cast<nsMvn::MvnMultArch>((seed / 3) % 3);
+  arch.mBooth = (seed / 9) % 2 == 1;
+  conv.set_arith_arch(arch);
+  conv.set_thread_num(seed % 4 == 3 ? 4 : 1);
+
+  BnNetwork network;
+  MvnBnMap mvnode_map{mgr};
+  if ( !conv(mgr, network, mvnode_map) ) {
+    cerr << "Error: seed " << seed << ": conversion failed" << endl;
+    ++ error_num;
+    return;
+  }
+  compare(mgr, module, network, rc, seed);
+
+  // 一部のノードを定数に置き換えて差分変換する．
+  for ( SizeType i = 0; i < 3; ++ i ) {
+    SizeType id{rc.rand(mgr.max_node_id())};
+    auto node{mgr._node(id)};
+    if ( node == nullptr ||
+	 node->type() == MvnNodeType::INPUT ||
+	 node->type() == MvnNodeType::OUTPUT ||
+	 node->type() == MvnNodeType::DFF ||
+	 node->type() == MvnNodeType::CONSTVALUE ) {
+      continue;
+    }
+    auto cnode{mgr.new_const(module, rc.rand_const(node->bit_width()))};
+    mgr.replace(node, cnode);
+  }
+  MvnBnMap mvnode_map2{mgr};
+  if ( !conv.update(mgr, network, mvnode_map2) ) {
+    cerr << "Error: seed " << seed << ": update failed" << endl;
+    ++ error_num;
+    return;
+  }
+  compare(mgr, module, network, rc, seed);
+
+  // 置き換えられたゲートが残っていないことを
+  // 変更後の回路を最初から変換した結果と比べて確かめる．
+  MvnBnConv conv2;
+  conv2.set_arith_arch(arch);
+  BnNetwork network2;
+  MvnBnMap mvnode_map3{mgr};
+  conv2(mgr, network2, mvnode_map3);
+  if ( network.logic_num() != network2.logic_num() ) {
+    cerr << "Error: seed " << seed
+	 << ": update() left " << network.logic_num()
+	 << " gates, full conversion made " << network2.logic_num() << endl;
+    ++ error_num;
+  }
+}
+
+END_NONAMESPACE
+
+END_NAMESPACE_YM
+
+
+int
+main(int argc,
+     const char** argv)
+{
+  using namespace std;
+  using namespace nsYm;
+
+  for ( SizeType seed = 0; seed < 36; ++ seed ) {
+    conv_test(seed);
+  }
+
+  if ( error_num > 0 ) {
+    cerr << error_num << " error(s)" << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
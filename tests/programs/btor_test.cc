@@ -0,0 +1,112 @@
+﻿
+/// @file btor_test.cc
+/// @brief MvnBtorWriter のテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+///
+/// 手で作った小さな回路の出力を期待される BTOR2 の内容と比較する．
+
+
+#include "ym/MvnMgr.h"
+#include "ym/MvnModule.h"
+#include "ym/MvnNode.h"
+#include "ym/MvnPort.h"
+#include "ym/MvnBvConst.h"
+#include "ym/MvnBtorWriter.h"
+#include <sstream>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+int error_num = 0;
+
+// 出力を期待値と比較する．
+void
+check_text(
+  const string& what,
+  const string& text,
+  const string& exp_text
+)
+{
+  if ( text != exp_text ) {
+    cerr << "Error: " << what << ": unexpected output" << endl
+	 << "---- output ----" << endl
+	 << text
+	 << "---- expected ----" << endl
+	 << exp_text;
+    ++ error_num;
+  }
+}
+
+// 負極性の非同期リセットを持つ4ビットのレジスタ
+//
+// rst が 0 の時に 0101 になる．
+void
+register_test()
+{
+  MvnMgr mgr;
+  auto module{mgr.new_module("r", 4, {4, 1, 1}, {4}, {})};
+  vector<string> name_list{"d", "clk", "rst"};
+  for ( SizeType i = 0; i < 3; ++ i ) {
+    mgr.init_port(module, i, {MvnPortRef{module->input(i)}}, name_list[i]);
+  }
+  mgr.init_port(module, 3, {MvnPortRef{module->output(0)}}, "q");
+  MvnBvConst val(4);
+  val.set_val(0, true);
+  val.set_val(2, true);
+  auto cnode{mgr.new_const(module, val)};
+  auto dff{mgr.new_dff(module, MvnPolarity::Positive,
+		       {MvnPolarity::Negative}, {cnode}, 4)};
+  mgr.connect(module->input(0), 0, dff, 0);
+  mgr.connect(module->input(1), 0, dff, 1);
+  mgr.connect(module->input(2), 0, dff, 2);
+  mgr.connect(dff, 0, module->output(0), 0);
+
+  std::ostringstream buf;
+  MvnBtorWriter writer;
+  writer(buf, mgr);
+
+  // クロックは無視され，リセットは next の ite に同期化される．
+  // リセット値は組み合わせ回路として出力した定数の行を再利用する．
+  std::ostringstream exp_buf;
+  exp_buf << "1 sort bitvec 4\n"
+	  << "2 input 1 d\n"
+	  << "3 sort bitvec 1\n"
+	  << "4 input 3 clk\n"
+	  << "5 input 3 rst\n"
+	  << "6 state 1 node" << dff->id() << "\n"
+	  << "7 zero 1\n"
+	  << "8 init 1 6 7\n"
+	  << "9 const 1 0101\n"
+	  << "10 output 6 q\n"
+	  << "11 not 3 5\n"
+	  << "12 ite 1 11 9 2\n"
+	  << "13 next 1 6 12\n";
+  check_text("register", buf.str(), exp_buf.str());
+}
+
+END_NONAMESPACE
+
+END_NAMESPACE_YM
+
+
+int
+main(int argc,
+     const char** argv)
+{
+  using namespace std;
+  using namespace nsYm;
+
+  register_test();
+
+  if ( error_num > 0 ) {
+    cerr << error_num << " error(s)" << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -0,0 +1,225 @@
+﻿
+/// @file cache_test.cc
+/// @brief MvnVerilogReader のキャッシュのテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+///
+/// 一時ディレクトリに置いた記述をキャッシュを用いずに読んだ結果と
+/// キャッシュを用いて読んだ結果(キャッシュを作る場合と使う場合)を
+/// MvnBinWriter の出力(ノードの通し番号で表した正規形)で比較する．
+/// `include のファイル名はマクロで与えておき，
+/// その内容を変えた時にキャッシュが使われないことも確かめる．
+
+
+#include "ym/MvnMgr.h"
+#include "ym/MvnVerilogReader.h"
+#include "ym/MvnVlMap.h"
+#include "ym/MvnReadProfile.h"
+#include "ym/MvnBinWriter.h"
+#include "ym/ClibCellLibrary.h"
+#include "ym/MsgMgr.h"
+#include "ym/MsgHandler.h"
+#include "ym/StreamMsgHandler.h"
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+int error_num = 0;
+
+const char* top_text =
+  "`define SUB_FILE \"sub.vh\"\n"
+  "`include `SUB_FILE\n"
+  "module top(input [7:0] a, b, output [7:0] x, output y);\n"
+  "  wire [7:0] t;\n"
+  "  sub u0(.a(a), .b(b), .x(t));\n"
+  "  assign x = t ^ b;\n"
+  "  assign y = &a;\n"
+  "endmodule\n";
+
+const char* sub_text1 =
+  "module sub(input [7:0] a, b, output [7:0] x);\n"
+  "  assign x = a + b;\n"
+  "endmodule\n";
+
+const char* sub_text2 =
+  "module sub(input [7:0] a, b, output [7:0] x);\n"
+  "  assign x = a - b;\n"
+  "endmodule\n";
+
+// ファイルを書く．
+void
+write_file(
+  const string& filename,
+  const char* text
+)
+{
+  std::ofstream s{filename};
+  s << text;
+}
+
+// 読み込み結果
+struct Result
+{
+  bool mOk{false};
+  bool mHit{false};
+  string mBin;
+  vector<string> mNameList;
+  vector<bool> mSingleList;
+};
+
+// 読み込んでネットワークを作る．
+Result
+read_design(
+  const string& dirname,
+  const string& filename,
+  const string& cache_dir
+)
+{
+  Result ans;
+  MvnVerilogReader reader;
+  if ( cache_dir != string{} ) {
+    reader.set_cache_dir(cache_dir);
+  }
+  if ( !reader.read(filename, SearchPathList{dirname}) ) {
+    return ans;
+  }
+  MvnMgr mgr;
+  MvnVlMap node_map;
+  if ( !reader.gen_network(mgr, ClibCellLibrary{}, node_map) ) {
+    return ans;
+  }
+  ans.mOk = true;
+  auto& profile = reader.profile();
+  for ( SizeType i = 0; i < profile.phase_num(); ++ i ) {
+    if ( profile.phase_name(i) == "cache_load" ) {
+      ans.mHit = true;
+    }
+  }
+  ostringstream buf;
+  MvnBinWriter writer;
+  writer(buf, mgr, node_map);
+  ans.mBin = buf.str();
+  SizeType n{mgr.max_node_id()};
+  for ( SizeType id = 0; id < n; ++ id ) {
+    ans.mNameList.push_back(node_map.get_name(id));
+    ans.mSingleList.push_back(node_map.is_single_elem(id));
+  }
+  return ans;
+}
+
+// 結果を比べる．
+void
+check(
+  const string& label,
+  const Result& result,
+  const Result& ref,
+  bool hit
+)
+{
+  if ( !result.mOk ) {
+    cerr << "Error: " << label << ": read failed" << endl;
+    ++ error_num;
+    return;
+  }
+  if ( result.mHit != hit ) {
+    cerr << "Error: " << label << ": cache was "
+	 << (result.mHit ? "" : "not ") << "used" << endl;
+    ++ error_num;
+  }
+  if ( result.mBin != ref.mBin ) {
+    cerr << "Error: " << label << ": network differs from the reference" << endl;
+    ++ error_num;
+  }
+}
+
+END_NONAMESPACE
+
+END_NAMESPACE_YM
+
+
+int
+main(
+  int argc,
+  const char** argv
+)
+{
+  using namespace std;
+  using namespace nsYm;
+
+  MsgHandler* mh = new StreamMsgHandler(cerr);
+  mh->set_mask(kMsgMaskAll);
+  mh->delete_mask(MsgType::Info);
+  mh->delete_mask(MsgType::Debug);
+  MsgMgr::attach_handler(mh);
+
+  char tmpl[] = "/tmp/mvn_cache_test_XXXXXX";
+  if ( mkdtemp(tmpl) == nullptr ) {
+    cerr << "could not create a temporary directory" << endl;
+    return 1;
+  }
+  string dir{tmpl};
+  string cache_dir{dir + "/cache"};
+  string top_file{dir + "/top.v"};
+  string sub_file{dir + "/sub.vh"};
+  system(("mkdir " + cache_dir).c_str());
+  write_file(top_file, top_text);
+  write_file(sub_file, sub_text1);
+
+  auto ref1 = read_design(dir, top_file, string{});
+  if ( !ref1.mOk ) {
+    cerr << "Error: reference read failed" << endl;
+    ++ error_num;
+  }
+  else {
+    // キャッシュを作る場合と使う場合
+    auto miss = read_design(dir, top_file, cache_dir);
+    check("miss", miss, ref1, false);
+    auto hit = read_design(dir, top_file, cache_dir);
+    check("hit", hit, ref1, true);
+
+    // node_map の内容はキャッシュを使ったかどうかで変わらない．
+    if ( hit.mNameList != miss.mNameList ||
+	 hit.mSingleList != miss.mSingleList ) {
+      cerr << "Error: node_map differs between hit and miss" << endl;
+      ++ error_num;
+    }
+
+    // `include で参照されるファイルを変えるとキャッシュは使われない．
+    write_file(sub_file, sub_text2);
+    auto ref2 = read_design(dir, top_file, string{});
+    if ( ref2.mBin == ref1.mBin ) {
+      cerr << "Error: reference did not change" << endl;
+      ++ error_num;
+    }
+    auto miss2 = read_design(dir, top_file, cache_dir);
+    check("miss after edit", miss2, ref2, false);
+    auto hit2 = read_design(dir, top_file, cache_dir);
+    check("hit after edit", hit2, ref2, true);
+  }
+
+  // キャッシュを用いる時も存在しないファイルは read() で失敗する．
+  {
+    MvnVerilogReader reader;
+    reader.set_cache_dir(cache_dir);
+    if ( reader.read(dir + "/no_such_file.v") ) {
+      cerr << "Error: read() succeeded for a missing file" << endl;
+      ++ error_num;
+    }
+  }
+
+  system(("rm -rf " + dir).c_str());
+
+  if ( error_num > 0 ) {
+    cerr << error_num << " error(s)" << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
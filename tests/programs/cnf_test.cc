@@ -0,0 +1,180 @@
+﻿
+/// @file cnf_test.cc
+/// @brief MvnCnfWriter のテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+///
+/// 手で作った小さな回路の出力を期待される CNF と比較する．
+/// シークできる出力先とできない出力先の両方を確かめる．
+
+
+#include "ym/MvnMgr.h"
+#include "ym/MvnModule.h"
+#include "ym/MvnNode.h"
+#include "ym/MvnCnfWriter.h"
+#include <sstream>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+int error_num = 0;
+
+//////////////////////////////////////////////////////////////////////
+// シークできない出力先
+//////////////////////////////////////////////////////////////////////
+class NoSeekBuf :
+  public std::streambuf
+{
+public:
+
+  // 書き込まれた内容を返す．
+  const string&
+  str() const
+  {
+    return mStr;
+  }
+
+
+protected:
+
+  // 1文字書き込む．
+  int_type
+  overflow(
+    int_type c
+  ) override
+  {
+    if ( c != traits_type::eof() ) {
+      mStr.push_back(traits_type::to_char_type(c));
+    }
+    return c;
+  }
+
+
+private:
+
+  // 書き込まれた内容
+  string mStr;
+
+};
+
+// 出力を期待値と比較する．
+void
+check_text(
+  const string& what,
+  const string& text,
+  const string& exp_text
+)
+{
+  if ( text != exp_text ) {
+    cerr << "Error: " << what << ": unexpected output" << endl
+	 << "---- output ----" << endl
+	 << text
+	 << "---- expected ----" << endl
+	 << exp_text;
+    ++ error_num;
+  }
+}
+
+// シークできる出力先でのヘッダ行
+//
+// 後から数を書き込むので予約した幅の残りは空白になる．
+string
+padded_header(
+  const string& header
+)
+{
+  return header + string(47 - header.size(), ' ') + "\n";
+}
+
+// y = a & b, x = a ^ b の回路
+void
+and_xor_test()
+{
+  MvnMgr mgr;
+  auto module{mgr.new_module("m", 0, {1, 1}, {1, 1}, {})};
+  auto a{module->input(0)};
+  auto b{module->input(1)};
+  auto y{module->output(0)};
+  auto x{module->output(1)};
+  auto and1{mgr.new_and(module, 2, 1)};
+  mgr.connect(a, 0, and1, 0);
+  mgr.connect(b, 0, and1, 1);
+  auto xor1{mgr.new_xor(module, 2, 1)};
+  mgr.connect(a, 0, xor1, 0);
+  mgr.connect(b, 0, xor1, 1);
+  mgr.connect(and1, 0, y, 0);
+  mgr.connect(xor1, 0, x, 0);
+
+  string a_name{"node" + std::to_string(a->id())};
+  string b_name{"node" + std::to_string(b->id())};
+  string y_name{"node" + std::to_string(y->id())};
+  string x_name{"node" + std::to_string(x->id())};
+
+  // 変数は a:1, b:2, y:3, x:4
+  string body{"c input " + a_name + " 0 1\n"
+	      "c input " + b_name + " 0 2\n"
+	      // 3 = 1 & 2
+	      "-3 1 0\n"
+	      "-3 2 0\n"
+	      "3 -1 -2 0\n"
+	      // 4 = 1 ^ 2
+	      "-4 1 2 0\n"
+	      "-4 -1 -2 0\n"
+	      "4 -1 2 0\n"
+	      "4 1 -2 0\n"
+	      "c output " + y_name + " 0 3\n"
+	      "c output " + x_name + " 0 4\n"};
+
+  MvnCnfWriter writer;
+  {
+    std::ostringstream buf;
+    writer(buf, mgr, module);
+    check_text("and_xor", buf.str(), padded_header("p cnf 4 7") + body);
+  }
+  {
+    NoSeekBuf sbuf;
+    ostream s{&sbuf};
+    writer(s, mgr, module);
+    check_text("and_xor(no seek)", sbuf.str(), "p cnf 4 7\n" + body);
+  }
+
+  // y のコーンには XOR の節は含まれない．
+  {
+    std::ostringstream buf;
+    writer(buf, mgr, vector<const MvnNode*>{y});
+    string exp_text{padded_header("p cnf 3 3") +
+		    "c input " + a_name + " 0 1\n"
+		    "c input " + b_name + " 0 2\n"
+		    "-3 1 0\n"
+		    "-3 2 0\n"
+		    "3 -1 -2 0\n"
+		    "c output " + y_name + " 0 3\n"};
+    check_text("and_cone", buf.str(), exp_text);
+  }
+}
+
+END_NONAMESPACE
+
+END_NAMESPACE_YM
+
+
+int
+main(int argc,
+     const char** argv)
+{
+  using namespace std;
+  using namespace nsYm;
+
+  and_xor_test();
+
+  if ( error_num > 0 ) {
+    cerr << error_num << " error(s)" << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
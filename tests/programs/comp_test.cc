@@ -0,0 +1,233 @@
+﻿
+/// @file comp_test.cc
+/// @brief MvnCompOStream のテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+///
+/// MvnCompOStream で書き出したファイルを zlib で伸長して
+/// 書き込んだ内容と一致することを確かめる．
+/// 空の場合と，内部バッファの大きさ(1MB)をまたぐ大きな場合も含む．
+
+
+#include "ym/MvnCompOStream.h"
+#include <zlib.h>
+#include <fstream>
+#include <sstream>
+#include <random>
+#include <cstdlib>
+#include <cstring>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+int error_num = 0;
+
+// ファイルの内容を読み込む．
+string
+read_file(
+  const string& filename
+)
+{
+  std::ifstream s{filename, std::ios::binary};
+  std::ostringstream buf;
+  buf << s.rdbuf();
+  return buf.str();
+}
+
+// gzip/zlib 形式のデータを伸長する．
+//
+// 形式はヘッダから自動的に判定する．
+bool
+inflate_data(
+  const string& data,
+  string& result
+)
+{
+  z_stream zs;
+  std::memset(&zs, 0, sizeof(zs));
+  // windowBits に 32 を足すと gzip と zlib を自動判定する．
+  if ( inflateInit2(&zs, 15 + 32) != Z_OK ) {
+    return false;
+  }
+  zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+  zs.avail_in = data.size();
+  result.clear();
+  vector<char> buf(1 << 16);
+  int stat;
+  do {
+    zs.next_out = reinterpret_cast<Bytef*>(buf.data());
+    zs.avail_out = buf.size();
+    stat = inflate(&zs, Z_NO_FLUSH);
+    if ( stat != Z_OK && stat != Z_STREAM_END ) {
+      inflateEnd(&zs);
+      return false;
+    }
+    result.append(buf.data(), buf.size() - zs.avail_out);
+  } while ( stat != Z_STREAM_END );
+  // 全ての入力を使い切っていなければならない．
+  bool ok = zs.avail_in == 0;
+  inflateEnd(&zs);
+  return ok;
+}
+
+// 圧縮形式の名前を返す．
+string
+type_name(
+  MvnCompType comp_type
+)
+{
+  switch ( comp_type ) {
+  case MvnCompType::None: return "none";
+  case MvnCompType::Gzip: return "gzip";
+  case MvnCompType::Zlib: return "zlib";
+  default: break;
+  }
+  return "auto";
+}
+
+// 内容を書き出して読み戻す．
+//
+// flush_pos が data.size() 未満の時はその位置で flush() する．
+void
+round_trip(
+  const string& dir,
+  const string& what,
+  MvnCompType comp_type,
+  const string& data,
+  SizeType flush_pos
+)
+{
+  string label{what + "(" + type_name(comp_type) + ")"};
+  string filename{dir + "/" + what + "." + type_name(comp_type)};
+  {
+    MvnCompOStream s{filename, comp_type};
+    if ( !s ) {
+      cerr << "Error: " << label << ": could not open " << filename << endl;
+      ++ error_num;
+      return;
+    }
+    // 一度に書き込む量を変えて境界をずらす．
+    SizeType pos = 0;
+    SizeType chunk = 1;
+    while ( pos < data.size() ) {
+      SizeType n{std::min(chunk, data.size() - pos)};
+      if ( pos < flush_pos && flush_pos < pos + n ) {
+	n = flush_pos - pos;
+      }
+      s.write(data.data() + pos, n);
+      pos += n;
+      if ( pos == flush_pos ) {
+	s.flush();
+      }
+      chunk = chunk * 3 + 1;
+      if ( chunk > 200000 ) {
+	chunk = 1;
+      }
+    }
+    if ( !s.close() ) {
+      cerr << "Error: " << label << ": close() failed" << endl;
+      ++ error_num;
+      return;
+    }
+  }
+
+  auto file_data{read_file(filename)};
+  string result;
+  if ( comp_type == MvnCompType::None ) {
+    result = file_data;
+  }
+  else if ( !inflate_data(file_data, result) ) {
+    cerr << "Error: " << label << ": could not decompress "
+	 << filename << endl;
+    ++ error_num;
+    return;
+  }
+  if ( result != data ) {
+    cerr << "Error: " << label << ": " << result.size()
+	 << " bytes read back, " << data.size()
+	 << " bytes written" << endl;
+    ++ error_num;
+  }
+}
+
+// 大きなデータを作る．
+//
+// ある程度圧縮の効く内容にしておく．
+string
+large_data(
+  SizeType size
+)
+{
+  std::mt19937_64 rg{1};
+  string data;
+  data.reserve(size);
+  while ( data.size() < size ) {
+    data += "node" + std::to_string(rg() % 100000) + " = ";
+    data += static_cast<char>(rg() % 256);
+    data += "\n";
+  }
+  data.resize(size);
+  return data;
+}
+
+END_NONAMESPACE
+
+END_NAMESPACE_YM
+
+
+int
+main(
+  int argc,
+  const char** argv
+)
+{
+  using namespace std;
+  using namespace nsYm;
+
+  char tmpl[] = "/tmp/mvn_comp_test_XXXXXX";
+  if ( mkdtemp(tmpl) == nullptr ) {
+    cerr << "could not create a temporary directory" << endl;
+    return 1;
+  }
+  string dir{tmpl};
+
+  // 内部バッファは 1MB なので 2 つ以上をまたぐようにする．
+  auto large{large_data((1 << 21) + 12345)};
+  for ( auto comp_type: {MvnCompType::None,
+			 MvnCompType::Gzip,
+			 MvnCompType::Zlib} ) {
+    round_trip(dir, "empty", comp_type, string{}, 0);
+    round_trip(dir, "small", comp_type, "module top;\nendmodule\n", 100);
+    round_trip(dir, "large", comp_type, large, large.size());
+    // バッファの途中で flush() して圧縮の区切りを入れる．
+    round_trip(dir, "flush", comp_type, large, (1 << 20) - 7);
+  }
+
+  // 拡張子による形式の判定
+  if ( MvnCompOStream::comp_type_from_filename("a.v.gz") != MvnCompType::Gzip ||
+       MvnCompOStream::comp_type_from_filename("a.v.zz") != MvnCompType::Zlib ||
+       MvnCompOStream::comp_type_from_filename("a.v") != MvnCompType::None ) {
+    cerr << "Error: comp_type_from_filename() failed" << endl;
+    ++ error_num;
+  }
+
+  // 開けないファイル
+  MvnCompOStream s{dir + "/no_such_dir/a.gz"};
+  if ( s || s.is_open() ) {
+    cerr << "Error: opening a file in a missing directory succeeded" << endl;
+    ++ error_num;
+  }
+
+  system(("rm -rf " + dir).c_str());
+
+  if ( error_num > 0 ) {
+    cerr << error_num << " error(s)" << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
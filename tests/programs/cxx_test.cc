@@ -0,0 +1,250 @@
+﻿
+/// @file cxx_test.cc
+/// @brief MvnCxxWriter のテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+///
+/// 乱数で作った回路を C++ で出力し，それを呼び出すドライバと一緒に
+/// コンパイルして実行する．
+/// 各サイクルの出力値を MvnSimulator の値と比較する．
+
+
+#include "ym/MvnMgr.h"
+#include "ym/MvnModule.h"
+#include "ym/MvnNode.h"
+#include "ym/MvnBvConst.h"
+#include "ym/MvnSimulator.h"
+#include "ym/MvnCxxWriter.h"
+#include "RandCircuit.h"
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+
+// 生成したコードをコンパイルするコマンド
+#ifndef MVN_CXX_COMPILER
+#define MVN_CXX_COMPILER "c++"
+#endif
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+int error_num = 0;
+
+// サイクル数
+const SizeType cycle_num = 8;
+
+// 生成したコードの後ろにつけるドライバ
+//
+// 標準入力から1サイクル分の入力ワードを読んで評価し，
+// 出力ワードを標準出力に書いてからクロックを進める．
+const char* driver = R"DRIVER(
+#include <cstdio>
+
+template<class M>
+void
+run(int cycle_num)
+{
+  M m;
+  m.reset();
+  mvn_word in[M::input_words + 1];
+  mvn_word out[M::output_words + 1];
+  for ( int c = 0; c < cycle_num; ++ c ) {
+    for ( std::size_t i = 0; i < M::input_words; ++ i ) {
+      unsigned long long v;
+      if ( std::scanf("%llx", &v) != 1 ) {
+	return;
+      }
+      in[i] = v;
+    }
+    m.eval(in, out);
+    for ( std::size_t i = 0; i < M::output_words; ++ i ) {
+      std::printf("%llx\n", static_cast<unsigned long long>(out[i]));
+    }
+    m.step();
+  }
+}
+)DRIVER";
+
+// MvnBvConst を 64 ビット単位のワードに詰める．
+void
+put_words(
+  const MvnBvConst& val,
+  vector<std::uint64_t>& word_list
+)
+{
+  SizeType n{(val.size() + 63) / 64};
+  for ( SizeType i = 0; i < n; ++ i ) {
+    std::uint64_t w = 0;
+    for ( SizeType b = i * 64; b < val.size() && b < (i + 1) * 64; ++ b ) {
+      if ( val[b] ) {
+	w |= (1ULL << (b % 64));
+      }
+    }
+    word_list.push_back(w);
+  }
+}
+
+// 乱数で作った回路で比較する．
+//
+// 幅の狭いモジュールと多倍長演算を含む幅の広いモジュールを
+// 一つのファイルに出力する．
+void
+cxx_test(
+  const string& dir,
+  SizeType seed
+)
+{
+  MvnMgr mgr;
+  RandCircuit rc{mgr, seed};
+  vector<const MvnModule*> module_list{
+    rc.make("top", 8, 40),
+    rc.make("wide", 100, 20)
+  };
+  string prefix{"seed " + std::to_string(seed)};
+  string base{dir + "/" + std::to_string(seed)};
+
+  // 入力系列と期待値を作る．
+  vector<std::uint64_t> in_words;
+  vector<std::uint64_t> exp_words;
+  for ( auto module: module_list ) {
+    MvnSimulator sim{mgr, module};
+    for ( SizeType c = 0; c < cycle_num; ++ c ) {
+      for ( SizeType i = 0; i < module->input_num(); ++ i ) {
+	auto val{rc.rand_const(module->input(i)->bit_width())};
+	sim.set_input(i, val);
+	put_words(val, in_words);
+      }
+      for ( SizeType i = 0; i < module->output_num(); ++ i ) {
+	put_words(sim.output(i), exp_words);
+      }
+      sim.step(1);
+    }
+  }
+
+  {
+    std::ofstream s{base + ".cc"};
+    MvnCxxWriter writer;
+    writer(s, mgr);
+    s << driver
+      << "int main()" << endl
+      << "{" << endl;
+    for ( auto module: module_list ) {
+      s << "  run<mvn_" << module->name() << ">("
+	<< cycle_num << ");" << endl;
+    }
+    s << "  return 0;" << endl
+      << "}" << endl;
+  }
+  {
+    std::ofstream s{base + ".in"};
+    s << std::hex;
+    for ( auto w: in_words ) {
+      s << w << endl;
+    }
+  }
+
+  string cmd{string{MVN_CXX_COMPILER} + " -std=c++11 -o " + base + ".exe "
+	     + base + ".cc"};
+  if ( system(cmd.c_str()) != 0 ) {
+    cerr << "Error: " << prefix << ": could not compile "
+	 << base << ".cc" << endl;
+    ++ error_num;
+    return;
+  }
+  cmd = base + ".exe < " + base + ".in > " + base + ".out";
+  if ( system(cmd.c_str()) != 0 ) {
+    cerr << "Error: " << prefix << ": " << base << ".exe failed" << endl;
+    ++ error_num;
+    return;
+  }
+
+  std::ifstream s{base + ".out"};
+  s >> std::hex;
+  for ( SizeType i = 0; i < exp_words.size(); ++ i ) {
+    std::uint64_t w;
+    if ( !(s >> w) ) {
+      cerr << "Error: " << prefix << ": output is too short" << endl;
+      ++ error_num;
+      return;
+    }
+    if ( w != exp_words[i] ) {
+      cerr << "Error: " << prefix << ": output word#" << i
+	   << " = " << std::hex << w
+	   << ", MvnSimulator = " << exp_words[i] << std::dec << endl;
+      ++ error_num;
+      return;
+    }
+  }
+}
+
+// 組み合わせ回路のループを持つモジュールは飛ばして failbit を立てる．
+void
+loop_test()
+{
+  MvnMgr mgr;
+  auto module{mgr.new_module("loop", 0, {1}, {1}, vector<SizeType>{})};
+  auto x{mgr.new_and(module, 2)};
+  mgr.connect(module->input(0), 0, x, 0);
+  mgr.connect(x, 0, x, 1);
+  mgr.connect(x, 0, module->output(0), 0);
+  auto module2{mgr.new_module("noloop", 0, {1}, {1}, vector<SizeType>{})};
+  mgr.connect(module2->input(0), 0, module2->output(0), 0);
+
+  std::ostringstream s;
+  MvnCxxWriter writer;
+  writer(s, mgr);
+  if ( !s.fail() ) {
+    cerr << "Error: loop: failbit is not set" << endl;
+    ++ error_num;
+  }
+  auto text{s.str()};
+  if ( text.find("// module loop is skipped") == string::npos ) {
+    cerr << "Error: loop: no skip comment" << endl;
+    ++ error_num;
+  }
+  // 後ろのモジュールは出力される．
+  if ( text.find("struct mvn_noloop") == string::npos ) {
+    cerr << "Error: loop: module noloop is not written" << endl;
+    ++ error_num;
+  }
+}
+
+END_NONAMESPACE
+
+END_NAMESPACE_YM
+
+
+int
+main(
+  int argc,
+  const char** argv
+)
+{
+  using namespace std;
+  using namespace nsYm;
+
+  char tmpl[] = "/tmp/mvn_cxx_test_XXXXXX";
+  if ( mkdtemp(tmpl) == nullptr ) {
+    cerr << "could not create a temporary directory" << endl;
+    return 1;
+  }
+  string dir{tmpl};
+
+  for ( SizeType seed = 0; seed < 8; ++ seed ) {
+    cxx_test(dir, seed);
+  }
+  loop_test();
+
+  system(("rm -rf " + dir).c_str());
+
+  if ( error_num > 0 ) {
+    cerr << error_num << " error(s)" << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
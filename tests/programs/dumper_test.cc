@@ -0,0 +1,197 @@
+﻿
+/// @file dumper_test.cc
+/// @brief MvnDumper のテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+///
+/// ノードの型，モジュール名，文字数の制限を設定した出力が
+/// 対象外のものを含まないことを確かめる．
+
+
+#include "ym/MvnMgr.h"
+#include "ym/MvnModule.h"
+#include "ym/MvnNode.h"
+#include "ym/MvnDumper.h"
+#include <sstream>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+int error_num = 0;
+
+// 出力に含まれるモジュールの名前とノードの型の名前
+struct DumpSummary
+{
+  // モジュール名のリスト
+  vector<string> mModuleList;
+
+  // ノードの型の名前のリスト
+  vector<string> mTypeList;
+};
+
+// 出力を解析する．
+//
+// "Module#<ID>(<名前>)" と "Node[<ID>] : <型>" の行を拾う．
+DumpSummary
+summarize(
+  const string& text
+)
+{
+  DumpSummary summary;
+  std::istringstream s{text};
+  string line;
+  while ( std::getline(s, line) ) {
+    if ( line.compare(0, 7, "Module#") == 0 ) {
+      auto p1{line.find('(')};
+      auto p2{line.rfind(')')};
+      summary.mModuleList.push_back(line.substr(p1 + 1, p2 - p1 - 1));
+    }
+    else if ( line.compare(0, 5, "Node[") == 0 ) {
+      auto p{line.find(" : ")};
+      auto type{line.substr(p + 3)};
+      type = type.substr(0, type.find_first_of("[("));
+      summary.mTypeList.push_back(type);
+    }
+  }
+  return summary;
+}
+
+// 出力を行う．
+string
+dump(
+  MvnDumper& dumper,
+  const MvnMgr& mgr
+)
+{
+  std::ostringstream buf;
+  dumper(buf, mgr);
+  return buf.str();
+}
+
+// リストの内容を比較する．
+void
+check_list(
+  const string& what,
+  const vector<string>& list,
+  const vector<string>& exp_list
+)
+{
+  if ( list != exp_list ) {
+    cerr << "Error: " << what << ":";
+    for ( auto& name: list ) {
+      cerr << " " << name;
+    }
+    cerr << ", expected";
+    for ( auto& name: exp_list ) {
+      cerr << " " << name;
+    }
+    cerr << endl;
+    ++ error_num;
+  }
+}
+
+// 制限のテスト
+//
+// top: o0 = ~(a & b), o1 = DFF(a)
+// sub: o0 = ~a
+void
+filter_test()
+{
+  MvnMgr mgr;
+  auto top{mgr.new_module("top", 0, {4, 4, 1}, {4, 4}, {})};
+  auto and1{mgr.new_and(top, 2, 4)};
+  mgr.connect(top->input(0), 0, and1, 0);
+  mgr.connect(top->input(1), 0, and1, 1);
+  auto not1{mgr.new_not(top, 4)};
+  mgr.connect(and1, 0, not1, 0);
+  mgr.connect(not1, 0, top->output(0), 0);
+  auto dff{mgr.new_dff(top, MvnPolarity::Positive, {}, {}, 4)};
+  mgr.connect(top->input(0), 0, dff, 0);
+  mgr.connect(top->input(2), 0, dff, 1);
+  mgr.connect(dff, 0, top->output(1), 0);
+
+  auto sub{mgr.new_module("sub", 0, vector<SizeType>{2}, vector<SizeType>{2},
+			   vector<SizeType>{})};
+  auto not2{mgr.new_not(sub, 2)};
+  mgr.connect(sub->input(0), 0, not2, 0);
+  mgr.connect(not2, 0, sub->output(0), 0);
+
+  MvnDumper dumper;
+  auto full_text{dump(dumper, mgr)};
+  auto full{summarize(full_text)};
+  check_list("no filter: modules", full.mModuleList, {"top", "sub"});
+  check_list("no filter: types", full.mTypeList,
+	     {"Input", "Input", "Input", "Output", "Output", "And", "Not", "DFF",
+	      "Input", "Output", "Not"});
+
+  // ノードの型
+  dumper.set_type_filter({MvnNodeType::NOT, MvnNodeType::DFF});
+  auto type_sum{summarize(dump(dumper, mgr))};
+  check_list("type filter: modules", type_sum.mModuleList, {"top", "sub"});
+  check_list("type filter: types", type_sum.mTypeList, {"Not", "DFF", "Not"});
+
+  // モジュール名
+  dumper.set_type_filter({});
+  dumper.set_module_filter({"sub"});
+  auto module_sum{summarize(dump(dumper, mgr))};
+  check_list("module filter: modules", module_sum.mModuleList, {"sub"});
+  check_list("module filter: types", module_sum.mTypeList,
+	     {"Input", "Output", "Not"});
+
+  // 両方
+  dumper.set_type_filter({MvnNodeType::AND});
+  dumper.set_module_filter({"top"});
+  auto both_sum{summarize(dump(dumper, mgr))};
+  check_list("both filters: modules", both_sum.mModuleList, {"top"});
+  check_list("both filters: types", both_sum.mTypeList, {"And"});
+
+  // 文字数
+  dumper.clear_filter();
+  dumper.set_limit(100);
+  auto limit_text{dump(dumper, mgr)};
+  auto limit_sum{summarize(limit_text)};
+  const string trailer{"*** output truncated at "};
+  if ( limit_text.find(trailer) == string::npos ) {
+    cerr << "Error: limit: no truncation line" << endl;
+    ++ error_num;
+  }
+  if ( limit_sum.mTypeList.size() >= full.mTypeList.size() ||
+       limit_text.size() >= full_text.size() ) {
+    cerr << "Error: limit: output is not truncated" << endl;
+    ++ error_num;
+  }
+
+  // 制限の解除
+  dumper.clear_filter();
+  if ( dump(dumper, mgr) != full_text ) {
+    cerr << "Error: clear_filter: output differs from the unfiltered one"
+	 << endl;
+    ++ error_num;
+  }
+}
+
+END_NONAMESPACE
+
+END_NAMESPACE_YM
+
+
+int
+main(int argc,
+     const char** argv)
+{
+  using namespace std;
+  using namespace nsYm;
+
+  filter_test();
+
+  if ( error_num > 0 ) {
+    cerr << error_num << " error(s)" << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
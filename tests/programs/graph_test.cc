@@ -0,0 +1,207 @@
+﻿
+/// @file graph_test.cc
+/// @brief MvnJsonWriter/MvnDotWriter のテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+///
+/// 手で作った小さなモジュールの出力を期待される内容と比較する．
+/// Verilog 名の付加とエスケープ，コーンによる制限も確かめる．
+
+
+#include "ym/MvnMgr.h"
+#include "ym/MvnModule.h"
+#include "ym/MvnNode.h"
+#include "ym/MvnVlMap.h"
+#include "ym/MvnJsonWriter.h"
+#include "ym/MvnDotWriter.h"
+#include <sstream>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+int error_num = 0;
+
+// 出力を期待値と比較する．
+void
+check_text(
+  const string& what,
+  const string& text,
+  const string& exp_text
+)
+{
+  if ( text != exp_text ) {
+    cerr << "Error: " << what << ": unexpected output" << endl
+	 << "---- output ----" << endl
+	 << text
+	 << "---- expected ----" << endl
+	 << exp_text;
+    ++ error_num;
+  }
+}
+
+// テスト用のモジュール
+//
+// y = a & b, z = y[1]
+// ノード番号は a:0, b:1, y:2, z:3, AND:4, CONSTBITSELECT:5 となる．
+struct TestModule
+{
+  // コンストラクタ
+  TestModule()
+  {
+    auto module{mMgr.new_module("m", 0, {2, 2}, {2, 1}, {})};
+    mAnd = mMgr.new_and(module, 2, 2);
+    mMgr.connect(module->input(0), 0, mAnd, 0);
+    mMgr.connect(module->input(1), 0, mAnd, 1);
+    mSel = mMgr.new_constbitselect(module, 1, 2);
+    mMgr.connect(mAnd, 0, mSel, 0);
+    mMgr.connect(mAnd, 0, module->output(0), 0);
+    mMgr.connect(mSel, 0, module->output(1), 0);
+    mNodeMap.reg_node(module->input(0)->id(), "a");
+    // エスケープが必要な名前
+    mNodeMap.reg_node(mAnd->id(), "x\"y\\z");
+  }
+
+  // ネットワーク
+  MvnMgr mMgr;
+
+  // AND ノード
+  MvnNode* mAnd;
+
+  // CONSTBITSELECT ノード
+  MvnNode* mSel;
+
+  // Verilog 名の対応表
+  MvnVlMap mNodeMap;
+};
+
+// MvnJsonWriter のテスト
+void
+json_test()
+{
+  TestModule tm;
+  MvnJsonWriter writer;
+  {
+    std::ostringstream buf;
+    writer(buf, tm.mMgr);
+    string exp_text{
+      "{\"kind\":\"module\",\"id\":0,\"name\":\"m\",\"inputs\":[0,1],\"outputs\":[2,3],\"inouts\":[]}\n"
+      "{\"kind\":\"node\",\"id\":0,\"module\":0,\"type\":\"INPUT\",\"width\":2}\n"
+      "{\"kind\":\"node\",\"id\":1,\"module\":0,\"type\":\"INPUT\",\"width\":2}\n"
+      "{\"kind\":\"node\",\"id\":2,\"module\":0,\"type\":\"OUTPUT\",\"width\":2}\n"
+      "{\"kind\":\"edge\",\"src\":4,\"dst\":2,\"pin\":0,\"width\":2}\n"
+      "{\"kind\":\"node\",\"id\":3,\"module\":0,\"type\":\"OUTPUT\",\"width\":1}\n"
+      "{\"kind\":\"edge\",\"src\":5,\"dst\":3,\"pin\":0,\"width\":1}\n"
+      "{\"kind\":\"node\",\"id\":4,\"module\":0,\"type\":\"AND\",\"width\":2}\n"
+      "{\"kind\":\"edge\",\"src\":0,\"dst\":4,\"pin\":0,\"width\":2}\n"
+      "{\"kind\":\"edge\",\"src\":1,\"dst\":4,\"pin\":1,\"width\":2}\n"
+      "{\"kind\":\"node\",\"id\":5,\"module\":0,\"type\":\"CONSTBITSELECT\",\"width\":1,\"bitpos\":1}\n"
+      "{\"kind\":\"edge\",\"src\":4,\"dst\":5,\"pin\":0,\"width\":2}\n"
+    };
+    check_text("json", buf.str(), exp_text);
+  }
+  {
+    std::ostringstream buf;
+    writer(buf, tm.mMgr, tm.mNodeMap);
+    auto text{buf.str()};
+    string line0{"{\"kind\":\"node\",\"id\":0,\"module\":0,\"type\":\"INPUT\",\"width\":2,\"name\":\"a\"}\n"};
+    string line4{"{\"kind\":\"node\",\"id\":4,\"module\":0,\"type\":\"AND\",\"width\":2,\"name\":\"x\\\"y\\\\z\"}\n"};
+    if ( text.find(line0) == string::npos ||
+	 text.find(line4) == string::npos ) {
+      cerr << "Error: json(node_map): names are missing" << endl
+	   << text;
+      ++ error_num;
+    }
+  }
+  {
+    // CONSTBITSELECT から1段のファンイン
+    writer.set_cone({tm.mSel->id()}, 1, 0);
+    std::ostringstream buf;
+    writer(buf, tm.mMgr);
+    string exp_text{
+      "{\"kind\":\"module\",\"id\":0,\"name\":\"m\",\"inputs\":[0,1],\"outputs\":[2,3],\"inouts\":[]}\n"
+      "{\"kind\":\"node\",\"id\":4,\"module\":0,\"type\":\"AND\",\"width\":2}\n"
+      "{\"kind\":\"node\",\"id\":5,\"module\":0,\"type\":\"CONSTBITSELECT\",\"width\":1,\"bitpos\":1}\n"
+      "{\"kind\":\"edge\",\"src\":4,\"dst\":5,\"pin\":0,\"width\":2}\n"
+    };
+    check_text("json(cone)", buf.str(), exp_text);
+  }
+}
+
+// MvnDotWriter のテスト
+void
+dot_test()
+{
+  TestModule tm;
+  MvnDotWriter writer;
+  {
+    std::ostringstream buf;
+    writer(buf, tm.mMgr, tm.mNodeMap);
+    string exp_text{
+      "digraph mvn {\n"
+      "  rankdir=LR;\n"
+      "  subgraph cluster_m0 {\n"
+      "    label=\"m\";\n"
+      "    n0 [shape=invhouse, label=\"0: INPUT[2]\\na\"];\n"
+      "    n1 [shape=invhouse, label=\"1: INPUT[2]\"];\n"
+      "    n2 [shape=house, label=\"2: OUTPUT[2]\"];\n"
+      "    n3 [shape=house, label=\"3: OUTPUT[1]\"];\n"
+      "    n4 [shape=ellipse, label=\"4: AND[2]\\nx\\\"y\\\\z\"];\n"
+      "    n5 [shape=ellipse, label=\"5: CONSTBITSELECT[1]\\n[1]\"];\n"
+      "  }\n"
+      "  n4 -> n2;\n"
+      "  n5 -> n3;\n"
+      "  n0 -> n4 [label=\"0\"];\n"
+      "  n1 -> n4 [label=\"1\"];\n"
+      "  n4 -> n5;\n"
+      "}\n"
+    };
+    check_text("dot", buf.str(), exp_text);
+  }
+  {
+    // AND から1段のファンアウト
+    writer.set_cone({tm.mAnd->id()}, 0, 1);
+    std::ostringstream buf;
+    writer(buf, tm.mMgr);
+    string exp_text{
+      "digraph mvn {\n"
+      "  rankdir=LR;\n"
+      "  subgraph cluster_m0 {\n"
+      "    label=\"m\";\n"
+      "    n2 [shape=house, label=\"2: OUTPUT[2]\"];\n"
+      "    n4 [shape=ellipse, label=\"4: AND[2]\"];\n"
+      "    n5 [shape=ellipse, label=\"5: CONSTBITSELECT[1]\\n[1]\"];\n"
+      "  }\n"
+      "  n4 -> n2;\n"
+      "  n4 -> n5;\n"
+      "}\n"
+    };
+    check_text("dot(cone)", buf.str(), exp_text);
+  }
+}
+
+END_NONAMESPACE
+
+END_NAMESPACE_YM
+
+
+int
+main(int argc,
+     const char** argv)
+{
+  using namespace std;
+  using namespace nsYm;
+
+  json_test();
+  dot_test();
+
+  if ( error_num > 0 ) {
+    cerr << error_num << " error(s)" << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -0,0 +1,227 @@
+﻿
+/// @file mgr_test.cc
+/// @brief MvnMgr の接続操作のテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym/MvnMgr.h"
+#include "ym/MvnModule.h"
+#include "ym/MvnNode.h"
+#include "ym/MvnInputPin.h"
+#include "ym/MvnBvConst.h"
+#include <algorithm>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+int error_num = 0;
+
+void
+check(
+  bool cond,
+  const char* msg
+)
+{
+  if ( !cond ) {
+    cerr << "Error: " << msg << endl;
+    ++ error_num;
+  }
+}
+
+// ノードが dst_pin_list() に含まれている数を返す．
+SizeType
+fanout_count(
+  const MvnNode* src_node,
+  const MvnNode* dst_node
+)
+{
+  SizeType n = 0;
+  for ( auto ipin: src_node->dst_pin_list() ) {
+    if ( ipin->node() == dst_node ) {
+      ++ n;
+    }
+  }
+  return n;
+}
+
+// モジュールのノードリストに含まれている時 true を返す．
+bool
+in_node_list(
+  const MvnModule* module,
+  const MvnNode* node
+)
+{
+  auto& node_list = module->node_list();
+  return std::find(node_list.begin(), node_list.end(), node) != node_list.end();
+}
+
+// disconnect() のテスト
+void
+disconnect_test()
+{
+  MvnMgr mgr;
+  auto module = mgr.new_module("top", 0,
+			       vector<SizeType>{4},
+			       vector<SizeType>{4},
+			       vector<SizeType>{});
+  auto input = module->input(0);
+  auto node1 = mgr.new_not(module, 4);
+  auto node2 = mgr.new_not(module, 4);
+  mgr.connect(input, 0, node1, 0);
+  mgr.connect(input, 0, node2, 0);
+  check( input->dst_pin_list().size() == 2, "connect: fanout count" );
+
+  mgr.disconnect(input, 0, node1, 0);
+  check( node1->input(0)->src_node() == nullptr,
+	 "disconnect: src_node remains" );
+  check( fanout_count(input, node1) == 0,
+	 "disconnect: stale pin in dst_pin_list" );
+  check( fanout_count(input, node2) == 1,
+	 "disconnect: other fanout removed" );
+}
+
+// replace() のテスト
+void
+replace_test()
+{
+  MvnMgr mgr;
+  auto module = mgr.new_module("top", 0,
+			       vector<SizeType>{4, 4},
+			       vector<SizeType>{4, 4},
+			       vector<SizeType>{});
+  auto node1 = mgr.new_through(module, 4);
+  mgr.connect(module->input(0), 0, node1, 0);
+  mgr.connect(node1, 0, module->output(0), 0);
+  mgr.connect(node1, 0, module->output(1), 0);
+
+  auto alt_node = module->input(1);
+  mgr.replace(node1, alt_node);
+  check( node1->dst_pin_list().empty(),
+	 "replace: old node keeps fanouts" );
+  check( fanout_count(alt_node, module->output(0)) == 1 &&
+	 fanout_count(alt_node, module->output(1)) == 1,
+	 "replace: fanouts not moved" );
+  check( module->output(0)->input(0)->src_node() == alt_node,
+	 "replace: src_node not updated" );
+}
+
+// delete_node() のテスト
+void
+delete_test()
+{
+  MvnMgr mgr;
+  auto module = mgr.new_module("top", 0,
+			       vector<SizeType>{4},
+			       vector<SizeType>{4},
+			       vector<SizeType>{});
+  auto node1 = mgr.new_not(module, 4);
+  auto node2 = mgr.new_not(module, 4);
+  SizeType id1 = node1->id();
+  check( in_node_list(module, node1), "new_not: not in node_list" );
+  mgr.delete_node(node1);
+  check( mgr.node(id1) == nullptr, "delete_node: node remains" );
+  check( module->node_num() == 1 && in_node_list(module, node2),
+	 "delete_node: node_list not updated" );
+}
+
+// sweep() のテスト
+void
+sweep_test()
+{
+  MvnMgr mgr;
+  auto module = mgr.new_module("top", 0,
+			       vector<SizeType>{4, 1},
+			       vector<SizeType>{4, 4},
+			       vector<SizeType>{});
+  auto input = module->input(0);
+
+  // 削除済みのノードの ID を作っておく．
+  auto dummy = mgr.new_not(module, 4);
+  mgr.delete_node(dummy);
+
+  // 非同期セットの値としてのみ使われる定数
+  MvnBvConst val{4};
+  val.set_val(0, true);
+  auto cnode = mgr.new_const(module, val);
+  auto dff = mgr.new_dff(module, MvnPolarity::Positive,
+			 vector<MvnPolarity>{MvnPolarity::Positive},
+			 vector<MvnNode*>{cnode}, 4);
+  mgr.connect(input, 0, dff, 0);
+  mgr.connect(module->input(1), 0, dff, 1);
+  mgr.connect(module->input(1), 0, dff, 2);
+  mgr.connect(dff, 0, module->output(1), 0);
+
+  // through ノードと出力のないノード
+  auto tnode = mgr.new_through(module, 4);
+  mgr.connect(input, 0, tnode, 0);
+  mgr.connect(tnode, 0, module->output(0), 0);
+  auto dangling = mgr.new_not(module, 4);
+  mgr.connect(input, 0, dangling, 0);
+  SizeType tid = tnode->id();
+  SizeType did = dangling->id();
+  SizeType cid = cnode->id();
+
+  mgr.sweep();
+
+  check( mgr.node(tid) == nullptr, "sweep: through node remains" );
+  check( mgr.node(did) == nullptr, "sweep: dangling node remains" );
+  check( mgr.node(cid) == cnode, "sweep: async value node removed" );
+  check( mgr.node(input->id()) == input, "sweep: input removed" );
+  check( module->output(0)->input(0)->src_node() == input,
+	 "sweep: output not reconnected" );
+  check( input->dst_pin_list().size() == 2,
+	 "sweep: stale pins in input's dst_pin_list" );
+  check( !in_node_list(module, tnode) && !in_node_list(module, dangling),
+	 "sweep: deleted node in node_list" );
+  check( module->node_num() == 2 &&
+	 module->node_list()[0] == cnode && module->node_list()[1] == dff,
+	 "sweep: node_list not compacted in order" );
+
+  // 長い鎖を削除しても残ったノードの順序は保たれる．
+  auto keep1 = mgr.new_not(module, 4);
+  mgr.connect(input, 0, keep1, 0);
+  auto src = input;
+  for ( SizeType i = 0; i < 10000; ++ i ) {
+    auto node = mgr.new_not(module, 4);
+    mgr.connect(src, 0, node, 0);
+    src = node;
+  }
+  auto keep2 = mgr.new_not(module, 4);
+  mgr.connect(keep1, 0, keep2, 0);
+  mgr.disconnect(input, 0, module->output(0), 0);
+  mgr.connect(keep2, 0, module->output(0), 0);
+  mgr.sweep();
+  check( module->node_num() == 4 &&
+	 module->node_list()[2] == keep1 && module->node_list()[3] == keep2,
+	 "sweep: chain not removed" );
+}
+
+END_NONAMESPACE
+
+END_NAMESPACE_YM
+
+
+int
+main(int argc,
+     const char** argv)
+{
+  using namespace std;
+  using namespace nsYm;
+
+  disconnect_test();
+  replace_test();
+  delete_test();
+  sweep_test();
+
+  if ( error_num > 0 ) {
+    cerr << error_num << " error(s)" << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -0,0 +1,136 @@
+﻿
+/// @file patsim_test.cc
+/// @brief MvnPatternSimulator のテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+///
+/// 乱数で作った回路を MvnPatternSimulator で数サイクル動かし，
+/// 全てのパタンの出力値をパタンごとに MvnSimulator で求めた値と比較する．
+
+
+#include "ym/MvnMgr.h"
+#include "ym/MvnModule.h"
+#include "ym/MvnNode.h"
+#include "ym/MvnBvConst.h"
+#include "ym/MvnSimulator.h"
+#include "ym/MvnPatternSimulator.h"
+#include "RandCircuit.h"
+#include <random>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+int error_num = 0;
+
+// サイクル数
+const SizeType cycle_num = 6;
+
+// ビットスライスされた値から k 番目のパタンの値を取り出す．
+MvnBvConst
+get_slot(
+  const vector<std::uint64_t>& val,
+  SizeType bw,
+  SizeType pw,
+  SizeType k
+)
+{
+  MvnBvConst bv(bw);
+  for ( SizeType b = 0; b < bw; ++ b ) {
+    auto word{val[b * pw + k / 64]};
+    bv.set_val(b, ((word >> (k % 64)) & 1ULL) != 0);
+  }
+  return bv;
+}
+
+// 乱数で作った回路で比較する．
+void
+patsim_test(
+  SizeType seed
+)
+{
+  MvnMgr mgr;
+  RandCircuit rc{mgr, seed};
+  // 多ワードの演算を含むように奇数番目は幅を広くとる．
+  SizeType max_width = seed % 2 == 0 ? 8 : 100;
+  auto module{rc.make("top", max_width, 40)};
+  SizeType pw{seed % 3 + 1};
+  SizeType ni{module->input_num()};
+  SizeType no{module->output_num()};
+  string prefix{"seed " + std::to_string(seed)};
+
+  // 全サイクルの入力値と出力値を記録しておく．
+  MvnPatternSimulator psim{mgr, module, pw};
+  std::mt19937_64 rg{seed};
+  vector<vector<vector<std::uint64_t>>> input_vals(cycle_num);
+  vector<vector<vector<std::uint64_t>>> output_vals(cycle_num);
+  for ( SizeType c = 0; c < cycle_num; ++ c ) {
+    for ( SizeType i = 0; i < ni; ++ i ) {
+      SizeType n{module->input(i)->bit_width() * pw};
+      vector<std::uint64_t> val(n);
+      for ( auto& v: val ) {
+	v = rg();
+      }
+      psim.set_input(i, val);
+      input_vals[c].push_back(val);
+    }
+    for ( SizeType i = 0; i < no; ++ i ) {
+      output_vals[c].push_back(psim.output(i));
+    }
+    psim.step(1);
+  }
+
+  // パタンごとに MvnSimulator で求めた値と比べる．
+  for ( SizeType k = 0; k < psim.pattern_num(); ++ k ) {
+    MvnSimulator sim{mgr, module};
+    for ( SizeType c = 0; c < cycle_num; ++ c ) {
+      for ( SizeType i = 0; i < ni; ++ i ) {
+	SizeType bw{module->input(i)->bit_width()};
+	sim.set_input(i, get_slot(input_vals[c][i], bw, pw, k));
+      }
+      for ( SizeType i = 0; i < no; ++ i ) {
+	SizeType bw{module->output(i)->bit_width()};
+	auto exp_val{sim.output(i)};
+	auto val{get_slot(output_vals[c][i], bw, pw, k)};
+	if ( val != exp_val ) {
+	  cerr << "Error: " << prefix
+	       << ", pattern " << k
+	       << ", cycle " << c
+	       << ", output" << i
+	       << ": MvnPatternSimulator = " << val
+	       << ", MvnSimulator = " << exp_val << endl;
+	  ++ error_num;
+	  return;
+	}
+      }
+      sim.step(1);
+    }
+  }
+}
+
+END_NONAMESPACE
+
+END_NAMESPACE_YM
+
+
+int
+main(int argc,
+     const char** argv)
+{
+  using namespace std;
+  using namespace nsYm;
+
+  for ( SizeType seed = 0; seed < 24; ++ seed ) {
+    patsim_test(seed);
+  }
+
+  if ( error_num > 0 ) {
+    cerr << error_num << " error(s)" << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
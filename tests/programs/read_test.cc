@@ -10,6 +10,7 @@
 #include "ym/MvnMgr.h"
 #include "ym/MvnVerilogReader.h"
 #include "ym/MvnVlMap.h"
+#include "ym/MvnReadProfile.h"
 #include "ym/MvnDumper.h"
 #include "ym/MvnVerilogWriter.h"
 
@@ -34,11 +35,17 @@ main(int argc,
   PoptStr popt_mislib("mislib", 0, "specify mislib library", "\"file name\"");
   PoptNone popt_dump("dump", 'd', "dump network");
   PoptNone popt_verilog("verilog", 'V', "dump verilog");
+  PoptNone popt_multi("multi", 'm', "read all files at once");
+  PoptInt popt_prefetch("prefetch", 0, "specify prefetch thread number (with --multi)", "<INT>");
+  PoptNone popt_profile("profile", 'p', "print phase profile");
 
   popt.add_option(&popt_dotlib);
   popt.add_option(&popt_mislib);
   popt.add_option(&popt_dump);
   popt.add_option(&popt_verilog);
+  popt.add_option(&popt_multi);
+  popt.add_option(&popt_prefetch);
+  popt.add_option(&popt_profile);
 
   popt.set_other_option_help("<file-name> ...");
 
@@ -152,21 +159,41 @@ main(int argc,
     MsgMgr::attach_handler(mh);
 
     MvnVerilogReader reader;
+    if ( popt_prefetch.is_specified() ) {
+      reader.set_prefetch_num(popt_prefetch.val());
+    }
+    if ( popt_profile.is_specified() ) {
+      reader.set_module_profile(true);
+    }
 
-    for (auto& name: filename_list ) {
-      cerr << "Reading " << name;
+    if ( popt_multi.is_specified() ) {
+      cerr << "Reading " << filename_list.size() << " files";
       cerr.flush();
-      bool stat = reader.read(name);
+      bool stat = reader.read(filename_list);
       cerr << " end" << endl;
       if ( !stat ) {
 	return 1;
       }
     }
+    else {
+      for (auto& name: filename_list ) {
+	cerr << "Reading " << name;
+	cerr.flush();
+	bool stat = reader.read(name);
+	cerr << " end" << endl;
+	if ( !stat ) {
+	  return 1;
+	}
+      }
+    }
     cerr << "Generating MvnNetwork" << endl;
     MvnMgr mgr;
     MvnVlMap node_map;
     bool stat = reader.gen_network(mgr, cell_library, node_map);
     cerr << " End" << endl;
+    if ( popt_profile.is_specified() ) {
+      reader.profile().print(cerr);
+    }
     if ( !stat ) {
       cerr << "error occured" << endl;
       return 2;
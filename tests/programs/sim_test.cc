@@ -0,0 +1,538 @@
+﻿
+/// @file sim_test.cc
+/// @brief MvnSimulator のテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+///
+/// 演算ノードを1つずつ出力につないだ回路を作り，
+/// MvnSimulator の出力値を整数演算で求めた期待値と比較する．
+
+
+#include "ym/MvnMgr.h"
+#include "ym/MvnModule.h"
+#include "ym/MvnNode.h"
+#include "ym/MvnBvConst.h"
+#include "ym/MvnSimulator.h"
+#include <random>
+#include <functional>
+#include <algorithm>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+int error_num = 0;
+
+// 128ビット以下の値を表す型
+using Val = unsigned __int128;
+
+// 下位 w ビットを取り出す．
+Val
+mask(
+  Val v,
+  SizeType w
+)
+{
+  if ( w >= 128 ) {
+    return v;
+  }
+  return v & ((static_cast<Val>(1) << w) - 1);
+}
+
+// Val を MvnBvConst に変換する．
+MvnBvConst
+to_bv(
+  Val v,
+  SizeType w
+)
+{
+  MvnBvConst bv(w);
+  for ( SizeType b = 0; b < w; ++ b ) {
+    bv.set_val(b, ((v >> b) & 1) != 0);
+  }
+  return bv;
+}
+
+// MvnBvConst を Val に変換する．
+Val
+from_bv(
+  const MvnBvConst& bv
+)
+{
+  Val v = 0;
+  for ( SizeType b = 0; b < bv.size(); ++ b ) {
+    if ( bv[b] ) {
+      v |= static_cast<Val>(1) << b;
+    }
+  }
+  return v;
+}
+
+// 16進表記の文字列を返す．
+string
+hex_str(
+  Val v
+)
+{
+  const char* digits = "0123456789abcdef";
+  string ans;
+  do {
+    ans = digits[static_cast<int>(v & 15)] + ans;
+    v >>= 4;
+  } while ( v != 0 );
+  return ans;
+}
+
+// 入力のビット幅
+const SizeType A = 0;
+const SizeType B = 1;
+const SizeType C = 2;
+const SizeType D = 3;
+const SizeType P = 4;
+const SizeType Q = 5;
+const SizeType E = 6;
+const SizeType F = 7;
+const vector<SizeType> iw_list{8, 8, 1, 4, 100, 100, 64, 64};
+
+//////////////////////////////////////////////////////////////////////
+// 出力ごとの演算と期待値の計算方法
+//////////////////////////////////////////////////////////////////////
+struct OpCase
+{
+  // 名前
+  string mName;
+
+  // 出力のビット幅
+  SizeType mWidth;
+
+  // 演算ノードの入力となる入力番号のリスト
+  vector<SizeType> mInputList;
+
+  // 演算ノードを作る関数
+  std::function<MvnNode*(MvnMgr&, MvnModule*)> mMake;
+
+  // 期待値を計算する関数
+  std::function<Val(const vector<Val>&)> mRef;
+};
+
+// 算術右シフトの期待値
+Val
+sra_ref(
+  Val v,
+  SizeType w,
+  SizeType s
+)
+{
+  bool neg = ((v >> (w - 1)) & 1) != 0;
+  if ( s >= w ) {
+    return neg ? mask(~static_cast<Val>(0), w) : 0;
+  }
+  Val ans = v >> s;
+  if ( neg ) {
+    ans |= mask(~static_cast<Val>(0), w) & ~mask(~static_cast<Val>(0), w - s);
+  }
+  return ans;
+}
+
+// 演算のリストを作る．
+vector<OpCase>
+make_case_list()
+{
+  using I = const vector<Val>&;
+  vector<OpCase> case_list{
+    {"and", 8, {A, B},
+     [](MvnMgr& m, MvnModule* md) { return m.new_and(md, 2, 8); },
+     [](I x) { return x[A] & x[B]; }},
+    {"or", 8, {A, B},
+     [](MvnMgr& m, MvnModule* md) { return m.new_or(md, 2, 8); },
+     [](I x) { return x[A] | x[B]; }},
+    {"xor", 8, {A, B},
+     [](MvnMgr& m, MvnModule* md) { return m.new_xor(md, 2, 8); },
+     [](I x) { return x[A] ^ x[B]; }},
+    {"not", 8, {A},
+     [](MvnMgr& m, MvnModule* md) { return m.new_not(md, 8); },
+     [](I x) { return mask(~x[A], 8); }},
+    {"add", 9, {A, B},
+     [](MvnMgr& m, MvnModule* md) { return m.new_add(md, 8, 8, 9); },
+     [](I x) { return x[A] + x[B]; }},
+    {"sub", 8, {A, B},
+     [](MvnMgr& m, MvnModule* md) { return m.new_sub(md, 8, 8, 8); },
+     [](I x) { return mask(x[A] - x[B], 8); }},
+    {"mult", 16, {A, B},
+     [](MvnMgr& m, MvnModule* md) { return m.new_mult(md, 8, 8, 16); },
+     [](I x) { return x[A] * x[B]; }},
+    {"div", 8, {A, B},
+     [](MvnMgr& m, MvnModule* md) { return m.new_div(md, 8, 8, 8); },
+     [](I x) { return x[B] == 0 ? 0 : x[A] / x[B]; }},
+    {"mod", 8, {A, B},
+     [](MvnMgr& m, MvnModule* md) { return m.new_mod(md, 8, 8, 8); },
+     [](I x) { return x[B] == 0 ? 0 : x[A] % x[B]; }},
+    {"equal", 1, {A, B},
+     [](MvnMgr& m, MvnModule* md) { return m.new_equal(md, 8); },
+     [](I x) { return static_cast<Val>(x[A] == x[B]); }},
+    {"lt", 1, {A, B},
+     [](MvnMgr& m, MvnModule* md) { return m.new_lt(md, 8); },
+     [](I x) { return static_cast<Val>(x[A] < x[B]); }},
+    {"sll", 8, {A, D},
+     [](MvnMgr& m, MvnModule* md) { return m.new_sll(md, 8, 4, 8); },
+     [](I x) { return mask(x[A] << static_cast<int>(x[D]), 8); }},
+    {"srl", 8, {A, D},
+     [](MvnMgr& m, MvnModule* md) { return m.new_srl(md, 8, 4, 8); },
+     [](I x) { return x[A] >> static_cast<int>(x[D]); }},
+    {"sra", 8, {A, D},
+     [](MvnMgr& m, MvnModule* md) { return m.new_sra(md, 8, 4, 8); },
+     [](I x) { return sra_ref(x[A], 8, x[D]); }},
+    {"cmpl", 8, {A},
+     [](MvnMgr& m, MvnModule* md) { return m.new_cmpl(md, 8); },
+     [](I x) { return mask(-x[A], 8); }},
+    {"ite", 8, {C, A, B},
+     [](MvnMgr& m, MvnModule* md) { return m.new_ite(md, 8); },
+     [](I x) { return x[C] ? x[A] : x[B]; }},
+    {"concat", 17, {A, C, B},
+     [](MvnMgr& m, MvnModule* md) { return m.new_concat(md, {8, 1, 8}); },
+     [](I x) { return (x[A] << 9) | (x[C] << 8) | x[B]; }},
+    {"bitselect", 1, {A},
+     [](MvnMgr& m, MvnModule* md) { return m.new_constbitselect(md, 3, 8); },
+     [](I x) { return (x[A] >> 3) & 1; }},
+    {"partselect", 5, {A},
+     [](MvnMgr& m, MvnModule* md) { return m.new_constpartselect(md, 6, 2, 8); },
+     [](I x) { return (x[A] >> 2) & 31; }},
+    {"rand", 1, {A},
+     [](MvnMgr& m, MvnModule* md) { return m.new_rand(md, 8); },
+     [](I x) { return static_cast<Val>(x[A] == 255); }},
+    {"ror", 1, {A},
+     [](MvnMgr& m, MvnModule* md) { return m.new_ror(md, 8); },
+     [](I x) { return static_cast<Val>(x[A] != 0); }},
+    {"rxor", 1, {A},
+     [](MvnMgr& m, MvnModule* md) { return m.new_rxor(md, 8); },
+     [](I x) { return static_cast<Val>(__builtin_popcount(static_cast<unsigned>(x[A])) & 1); }},
+    // 以降は複数ワードにまたがる演算
+    {"add100", 100, {P, Q},
+     [](MvnMgr& m, MvnModule* md) { return m.new_add(md, 100, 100, 100); },
+     [](I x) { return mask(x[P] + x[Q], 100); }},
+    {"sub100", 100, {P, Q},
+     [](MvnMgr& m, MvnModule* md) { return m.new_sub(md, 100, 100, 100); },
+     [](I x) { return mask(x[P] - x[Q], 100); }},
+    {"xor100", 100, {P, Q},
+     [](MvnMgr& m, MvnModule* md) { return m.new_xor(md, 2, 100); },
+     [](I x) { return x[P] ^ x[Q]; }},
+    {"mult100", 100, {P, Q},
+     [](MvnMgr& m, MvnModule* md) { return m.new_mult(md, 100, 100, 100); },
+     [](I x) { return mask(x[P] * x[Q], 100); }},
+    {"div100", 100, {P, Q},
+     [](MvnMgr& m, MvnModule* md) { return m.new_div(md, 100, 100, 100); },
+     [](I x) { return x[Q] == 0 ? 0 : x[P] / x[Q]; }},
+    {"mod100", 100, {P, Q},
+     [](MvnMgr& m, MvnModule* md) { return m.new_mod(md, 100, 100, 100); },
+     [](I x) { return x[Q] == 0 ? 0 : x[P] % x[Q]; }},
+    {"lt100", 1, {P, Q},
+     [](MvnMgr& m, MvnModule* md) { return m.new_lt(md, 100); },
+     [](I x) { return static_cast<Val>(x[P] < x[Q]); }},
+    {"sll100", 100, {P, D},
+     [](MvnMgr& m, MvnModule* md) { return m.new_sll(md, 100, 4, 100); },
+     [](I x) { return mask(x[P] << static_cast<int>(x[D]), 100); }},
+    {"sra100", 100, {P, D},
+     [](MvnMgr& m, MvnModule* md) { return m.new_sra(md, 100, 4, 100); },
+     [](I x) { return sra_ref(x[P], 100, x[D]); }},
+    {"cmpl100", 100, {P},
+     [](MvnMgr& m, MvnModule* md) { return m.new_cmpl(md, 100); },
+     [](I x) { return mask(-x[P], 100); }},
+    {"add64", 64, {E, F},
+     [](MvnMgr& m, MvnModule* md) { return m.new_add(md, 64, 64, 64); },
+     [](I x) { return mask(x[E] + x[F], 64); }},
+    {"mult64", 65, {E, F},
+     [](MvnMgr& m, MvnModule* md) { return m.new_mult(md, 64, 64, 65); },
+     [](I x) { return mask(x[E] * x[F], 65); }},
+    {"concat128", 128, {E, F},
+     [](MvnMgr& m, MvnModule* md) { return m.new_concat(md, {64, 64}); },
+     [](I x) { return (x[E] << 64) | x[F]; }},
+  };
+  return case_list;
+}
+
+// 乱数で入力値を作る．
+//
+// 割り算の 0 除算や比較の等号のような境界を踏むように
+// 時々 0 や他の入力と同じ値を返す．
+Val
+rand_val(
+  std::mt19937& rg,
+  SizeType w,
+  const vector<Val>& cur_vals
+)
+{
+  std::uniform_int_distribution<int> rd(0, 15);
+  int r = rd(rg);
+  if ( r == 0 ) {
+    return 0;
+  }
+  if ( r == 1 ) {
+    return mask(~static_cast<Val>(0), w);
+  }
+  if ( r == 2 ) {
+    // 同じビット幅の他の入力と同じ値にする．
+    for ( SizeType i = 0; i < iw_list.size(); ++ i ) {
+      if ( iw_list[i] == w ) {
+	return cur_vals[i];
+      }
+    }
+  }
+  Val v = (static_cast<Val>(rg()) << 96) | (static_cast<Val>(rg()) << 64)
+    | (static_cast<Val>(rg()) << 32) | static_cast<Val>(rg());
+  if ( r == 3 ) {
+    // 小さい値にする．
+    return mask(v, std::min<SizeType>(w, 3));
+  }
+  return mask(v, w);
+}
+
+// 組み合わせ回路のテスト
+void
+comb_test(
+  SizeType seed
+)
+{
+  auto case_list{make_case_list()};
+  vector<SizeType> ow_list;
+  for ( auto& c: case_list ) {
+    ow_list.push_back(c.mWidth);
+  }
+
+  MvnMgr mgr;
+  auto module{mgr.new_module("top", 0, iw_list, ow_list, vector<SizeType>{})};
+  for ( SizeType i = 0; i < case_list.size(); ++ i ) {
+    auto& c{case_list[i]};
+    auto node{c.mMake(mgr, module)};
+    ASSERT_COND( node->bit_width() == c.mWidth );
+    for ( SizeType j = 0; j < c.mInputList.size(); ++ j ) {
+      mgr.connect(module->input(c.mInputList[j]), 0, node, j);
+    }
+    mgr.connect(node, 0, module->output(i), 0);
+  }
+
+  MvnSimulator sim{mgr, module};
+  std::mt19937 rg{static_cast<std::mt19937::result_type>(seed)};
+  SizeType ni = iw_list.size();
+  vector<Val> vals(ni, 0);
+
+  auto check = [&](const string& what) {
+    for ( SizeType i = 0; i < case_list.size(); ++ i ) {
+      auto& c{case_list[i]};
+      Val exp = mask(c.mRef(vals), c.mWidth);
+      auto bv{sim.output(i)};
+      if ( bv.size() != c.mWidth ) {
+	cerr << "Error: seed " << seed << ": " << c.mName
+	     << ": output width is " << bv.size()
+	     << ", expected " << c.mWidth << endl;
+	++ error_num;
+	continue;
+      }
+      Val got = from_bv(bv);
+      if ( got != exp ) {
+	cerr << "Error: seed " << seed << ": " << what
+	     << ": " << c.mName << "(";
+	const char* comma = "";
+	for ( auto pos: c.mInputList ) {
+	  cerr << comma << hex_str(vals[pos]);
+	  comma = ", ";
+	}
+	cerr << ") = " << hex_str(got)
+	     << ", expected " << hex_str(exp) << endl;
+	++ error_num;
+      }
+      else if ( c.mWidth <= 64 && sim.output_uint(i) != static_cast<std::uint64_t>(exp) ) {
+	cerr << "Error: seed " << seed << ": " << what
+	     << ": " << c.mName << ": output_uint() differs from output()" << endl;
+	++ error_num;
+      }
+    }
+  };
+
+  // 全ての入力を変える．
+  for ( SizeType k = 0; k < 50; ++ k ) {
+    for ( SizeType i = 0; i < ni; ++ i ) {
+      vals[i] = rand_val(rg, iw_list[i], vals);
+      if ( iw_list[i] <= 64 ) {
+	sim.set_input(i, static_cast<std::uint64_t>(vals[i]));
+      }
+      else {
+	sim.set_input(i, to_bv(vals[i], iw_list[i]));
+      }
+    }
+    check("all inputs");
+  }
+
+  // 1つの入力だけを変えて，変化の伝搬だけで正しい値になることを確かめる．
+  std::uniform_int_distribution<SizeType> rd(0, ni - 1);
+  for ( SizeType k = 0; k < 200; ++ k ) {
+    SizeType i = rd(rg);
+    vals[i] = rand_val(rg, iw_list[i], vals);
+    sim.set_input(i, to_bv(vals[i], iw_list[i]));
+    check("input#" + std::to_string(i));
+  }
+}
+
+// DFF を用いたカウンタのテスト
+//
+// q <= en ? q + 1 : q
+// rst_n が 0 の間は非同期に q = 0 となる．
+void
+dff_test()
+{
+  MvnMgr mgr;
+  // 入力: clk, rst_n, en
+  // 出力: q
+  auto module{mgr.new_module("counter", 0, {1, 1, 1}, {8}, vector<SizeType>{})};
+  auto clk{module->input(0)};
+  auto rst_n{module->input(1)};
+  auto en{module->input(2)};
+  auto zero{mgr.new_const(module, MvnBvConst(8))};
+  auto dff{mgr.new_dff(module, MvnPolarity::Positive,
+		       {MvnPolarity::Negative}, {zero}, 8)};
+  MvnBvConst one_val(8);
+  one_val.set_val(0, true);
+  auto one{mgr.new_const(module, one_val)};
+  auto inc{mgr.new_add(module, 8, 8, 8)};
+  mgr.connect(dff, 0, inc, 0);
+  mgr.connect(one, 0, inc, 1);
+  auto ite{mgr.new_ite(module, 8)};
+  mgr.connect(en, 0, ite, 0);
+  mgr.connect(inc, 0, ite, 1);
+  mgr.connect(dff, 0, ite, 2);
+  mgr.connect(ite, 0, dff, 0);
+  mgr.connect(clk, 0, dff, 1);
+  mgr.connect(rst_n, 0, dff, 2);
+  mgr.connect(dff, 0, module->output(0), 0);
+
+  MvnSimulator sim{mgr, module};
+  auto expect = [&](std::uint64_t exp,
+		    const char* what) {
+    auto got = sim.output_uint(0);
+    if ( got != exp ) {
+      cerr << "Error: counter: " << what << ": q = " << got
+	   << ", expected " << exp << endl;
+      ++ error_num;
+    }
+  };
+
+  sim.set_input(1, 1);
+  sim.set_input(2, 1);
+  expect(0, "initial state");
+  sim.step();
+  expect(1, "after 1 step");
+  sim.step(9);
+  expect(10, "after 10 steps");
+  sim.set_input(2, 0);
+  sim.step(5);
+  expect(10, "while disabled");
+  sim.set_input(2, 1);
+  sim.step(250);
+  expect(4, "after wrap around");
+
+  // 非同期リセットはクロックを待たずに効く．
+  sim.set_input(1, 0);
+  expect(0, "asynchronous reset");
+  sim.step(3);
+  expect(0, "while reset");
+  sim.set_input(1, 1);
+  sim.step(2);
+  expect(2, "after reset released");
+
+  // 状態を直接設定する．
+  sim.set_value(dff, to_bv(200, 8));
+  expect(200, "after set_value()");
+  sim.step();
+  expect(201, "step after set_value()");
+  sim.reset_state();
+  expect(0, "after reset_state()");
+}
+
+// 組み合わせ回路のループを持つモジュールのテスト
+// x = a & y, y = x | a というループがあり，o0 = x, o1 = ~a とする．
+void
+loop_test()
+{
+  MvnMgr mgr;
+  auto module{mgr.new_module("loop", 0, {1}, {1, 1}, vector<SizeType>{})};
+  auto a{module->input(0)};
+  auto x{mgr.new_and(module, 2)};
+  auto y{mgr.new_or(module, 2)};
+  auto na{mgr.new_not(module)};
+  mgr.connect(a, 0, x, 0);
+  mgr.connect(y, 0, x, 1);
+  mgr.connect(x, 0, y, 0);
+  mgr.connect(a, 0, y, 1);
+  mgr.connect(a, 0, na, 0);
+  mgr.connect(x, 0, module->output(0), 0);
+  mgr.connect(na, 0, module->output(1), 0);
+
+  MvnSimulator sim{mgr, module};
+  if ( !sim.has_loop() ) {
+    cerr << "Error: loop: has_loop() returned false" << endl;
+    ++ error_num;
+  }
+  // ループの先にある出力ノードも順序づけられない．
+  auto loop_list{sim.loop_node_list()};
+  std::sort(loop_list.begin(), loop_list.end(),
+	    [](const MvnNode* n1, const MvnNode* n2) {
+	      return n1->id() < n2->id();
+	    });
+  vector<const MvnNode*> exp_list{x, y, module->output(0)};
+  std::sort(exp_list.begin(), exp_list.end(),
+	    [](const MvnNode* n1, const MvnNode* n2) {
+	      return n1->id() < n2->id();
+	    });
+  if ( loop_list != exp_list ) {
+    cerr << "Error: loop: loop_node_list() has "
+	 << loop_list.size() << " node(s), expected "
+	 << exp_list.size() << endl;
+    ++ error_num;
+  }
+
+  // ループの外側は普通に評価される．
+  sim.set_input(0, 1);
+  sim.eval();
+  if ( sim.output_uint(1) != 0 ) {
+    cerr << "Error: loop: o1 = " << sim.output_uint(1)
+	 << ", expected 0" << endl;
+    ++ error_num;
+  }
+
+  // ループのないモジュールでは空になる．
+  auto module2{mgr.new_module("noloop", 0, {1}, {1}, vector<SizeType>{})};
+  mgr.connect(module2->input(0), 0, module2->output(0), 0);
+  MvnSimulator sim2{mgr, module2};
+  if ( sim2.has_loop() || !sim2.loop_node_list().empty() ) {
+    cerr << "Error: noloop: has_loop() returned true" << endl;
+    ++ error_num;
+  }
+}
+
+END_NONAMESPACE
+
+END_NAMESPACE_YM
+
+
+int
+main(int argc,
+     const char** argv)
+{
+  using namespace std;
+  using namespace nsYm;
+
+  for ( SizeType seed = 0; seed < 20; ++ seed ) {
+    comb_test(seed);
+  }
+  dff_test();
+  loop_test();
+
+  if ( error_num > 0 ) {
+    cerr << error_num << " error(s)" << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -0,0 +1,342 @@
+﻿
+/// @file vwriter_test.cc
+/// @brief MvnVerilogWriter の式の埋め込みのテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+///
+/// 乱数で作った回路を式の埋め込みを行わない場合と行う場合で出力し，
+/// それぞれを MvnVerilogReader で読み直した回路のシミュレーション結果を
+/// 元の回路と比較する．
+/// 埋め込みを行った出力の方が小さいことと，
+/// 並列出力でも内容が変わらないことも確かめる．
+
+
+#include "ym/MvnMgr.h"
+#include "ym/MvnModule.h"
+#include "ym/MvnNode.h"
+#include "ym/MvnInputPin.h"
+#include "ym/MvnPort.h"
+#include "ym/MvnBvConst.h"
+#include "ym/MvnVlMap.h"
+#include "ym/MvnSimulator.h"
+#include "ym/MvnVerilogWriter.h"
+#include "ym/MvnVerilogReader.h"
+#include "ym/ClibCellLibrary.h"
+#include "ym/MsgMgr.h"
+#include "ym/MsgHandler.h"
+#include "ym/StreamMsgHandler.h"
+#include "RandCircuit.h"
+#include <random>
+#include <sstream>
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+int error_num = 0;
+
+// Verilog 記述を読み込む．
+bool
+read_text(
+  const string& name,
+  const string& text,
+  MvnMgr& mgr
+)
+{
+  MvnVerilogReader reader;
+  if ( !reader.read_buffer(name, text) ) {
+    return false;
+  }
+  MvnVlMap node_map;
+  return reader.gen_network(mgr, ClibCellLibrary{}, node_map);
+}
+
+// 名前でモジュールを探す．
+const MvnModule*
+find_module(
+  const MvnMgr& mgr,
+  const string& name
+)
+{
+  for ( auto module: mgr.topmodule_list() ) {
+    if ( module->name() == name ) {
+      return module;
+    }
+  }
+  return nullptr;
+}
+
+// 名前でポートのノードを探す．
+const MvnNode*
+find_port_node(
+  const MvnModule* module,
+  const string& name
+)
+{
+  for ( SizeType i = 0; i < module->port_num(); ++ i ) {
+    auto port{module->port(i)};
+    if ( port->name() == name && port->port_ref_num() == 1 ) {
+      return port->port_ref(0).node();
+    }
+  }
+  return nullptr;
+}
+
+// 対応する入出力ノードの組
+struct IoPair
+{
+  // ポート名
+  string mName;
+
+  // 元の回路のノード
+  const MvnNode* mNode1;
+
+  // 読み直した回路のノード
+  const MvnNode* mNode2;
+};
+
+// 元の回路と読み直した回路のシミュレーション結果を比べる．
+//
+// 入出力はポート名で対応づける．
+void
+compare_sim(
+  const string& what,
+  const MvnMgr& mgr1,
+  const MvnModule* module1,
+  const MvnMgr& mgr2,
+  const MvnModule* module2,
+  SizeType seed
+)
+{
+  vector<IoPair> input_list;
+  vector<IoPair> output_list;
+  for ( SizeType i = 0; i < module1->port_num(); ++ i ) {
+    auto port{module1->port(i)};
+    auto node1{port->port_ref(0).node()};
+    auto node2{find_port_node(module2, port->name())};
+    if ( node2 == nullptr || node2->bit_width() != node1->bit_width() ) {
+      cerr << "Error: " << what << ": port '" << port->name()
+	   << "' is missing or has a different width" << endl;
+      ++ error_num;
+      return;
+    }
+    if ( node1->type() == MvnNodeType::INPUT ) {
+      input_list.push_back({port->name(), node1, node2});
+    }
+    else {
+      output_list.push_back({port->name(), node1, node2});
+    }
+  }
+
+  MvnSimulator sim1{mgr1, module1};
+  MvnSimulator sim2{mgr2, module2};
+  std::mt19937_64 rg{seed};
+  for ( SizeType k = 0; k < 30; ++ k ) {
+    for ( auto& p: input_list ) {
+      SizeType w{p.mNode1->bit_width()};
+      MvnBvConst val(w);
+      for ( SizeType b = 0; b < w; ++ b ) {
+	val.set_val(b, (rg() & 1) != 0);
+      }
+      if ( p.mName == "rst" ) {
+	// リセットは時々しかかけない．
+	val.set_val(0, (rg() % 8) != 0);
+      }
+      sim1.set_value(p.mNode1, val);
+      sim2.set_value(p.mNode2, val);
+    }
+    for ( auto& p: output_list ) {
+      auto val1{sim1.value(p.mNode1)};
+      auto val2{sim2.value(p.mNode2)};
+      if ( val1 != val2 ) {
+	cerr << "Error: " << what << ": cycle " << k
+	     << ": output '" << p.mName
+	     << "' = " << val2 << ", expected " << val1 << endl;
+	++ error_num;
+	return;
+      }
+    }
+    sim1.step();
+    sim2.step();
+  }
+}
+
+// 定数と X マスクと可変範囲選択の出力を確かめる．
+//
+// 定数と X マスクは全てのビットが正しい位置に出力されることを
+// 文字列で比較する．
+void
+literal_test()
+{
+  MvnMgr mgr;
+  auto module{mgr.new_module("lit", 5, {8, 3}, {8, 1, 4}, vector<SizeType>{})};
+  vector<string> name_list{"a", "b", "o0", "o1", "o2"};
+  for ( SizeType i = 0; i < 2; ++ i ) {
+    mgr.init_port(module, i, {MvnPortRef{module->input(i)}}, name_list[i]);
+  }
+  for ( SizeType i = 0; i < 3; ++ i ) {
+    mgr.init_port(module, i + 2, {MvnPortRef{module->output(i)}},
+		  name_list[i + 2]);
+  }
+  // MSB から書くと 10110010
+  MvnBvConst val(8);
+  for ( auto b: {1, 4, 5, 7} ) {
+    val.set_val(b, true);
+  }
+  auto cnode{mgr.new_const(module, val)};
+  mgr.connect(cnode, 0, module->output(0), 0);
+  // MSB から書くと 00001100
+  MvnBvConst xmask(8);
+  for ( auto b: {2, 3} ) {
+    xmask.set_val(b, true);
+  }
+  auto eq{mgr.new_caseeq(module, 8, xmask)};
+  mgr.connect(module->input(0), 0, eq, 0);
+  mgr.connect(cnode, 0, eq, 1);
+  mgr.connect(eq, 0, module->output(1), 0);
+  auto ps{mgr.new_partselect(module, 8, 3, 4)};
+  mgr.connect(module->input(0), 0, ps, 0);
+  mgr.connect(module->input(1), 0, ps, 1);
+  mgr.connect(ps, 0, module->output(2), 0);
+
+  for ( bool inline_expr: {false, true} ) {
+    MvnVerilogWriter writer;
+    writer.set_inline_expr(inline_expr);
+    std::ostringstream buf;
+    writer(buf, mgr);
+    string text{buf.str()};
+    for ( auto pat: {"8'b10110010", " ^ 8'b0000??00", " = a >> b;"} ) {
+      if ( text.find(pat) == string::npos ) {
+	cerr << "Error: literal (inline = " << inline_expr << "): '"
+	     << pat << "' not found in" << endl
+	     << text;
+	++ error_num;
+      }
+    }
+  }
+}
+
+// 出力と読み直しを行う．
+void
+vwriter_test(
+  SizeType seed
+)
+{
+  MvnMgr mgr;
+  RandCircuit rc{mgr, seed};
+  // 埋め込みが起こるように直前に作ったノードを入力に選びやすくする．
+  // clk と rst は DFF の制御にのみ用いる．
+  rc.set_type_list({MvnNodeType::NOT, MvnNodeType::AND, MvnNodeType::OR,
+		    MvnNodeType::XOR, MvnNodeType::RAND, MvnNodeType::ROR,
+		    MvnNodeType::RXOR, MvnNodeType::EQ, MvnNodeType::LT,
+		    MvnNodeType::SLL, MvnNodeType::SRL, MvnNodeType::ADD,
+		    MvnNodeType::SUB, MvnNodeType::MUL, MvnNodeType::DIV,
+		    MvnNodeType::MOD, MvnNodeType::ITE, MvnNodeType::CONCAT,
+		    MvnNodeType::CONSTBITSELECT, MvnNodeType::CONSTPARTSELECT,
+		    MvnNodeType::CMPL, MvnNodeType::PARTSELECT});
+  rc.set_io_num(3, 6, 0);
+  rc.set_clock_input(true);
+  rc.set_port(true);
+  rc.set_chain_bias(true);
+  auto top{rc.make("top", 8, 40)};
+
+  string prefix{"seed " + std::to_string(seed)};
+
+  MvnVerilogWriter writer;
+  std::ostringstream plain_buf;
+  writer(plain_buf, mgr);
+  string plain_text{plain_buf.str()};
+
+  writer.set_inline_expr(true);
+  std::ostringstream inline_buf;
+  writer(inline_buf, mgr);
+  string inline_text{inline_buf.str()};
+
+  // 埋め込みを行うと小さくなる．
+  if ( inline_text.size() >= plain_text.size() ) {
+    cerr << "Error: " << prefix << ": inlined output (" << inline_text.size()
+	 << " bytes) is not smaller than the plain one ("
+	 << plain_text.size() << " bytes)" << endl;
+    ++ error_num;
+  }
+
+  // 並列出力でも内容は変わらない．
+  writer.set_thread_num(4);
+  std::ostringstream mt_buf;
+  writer(mt_buf, mgr);
+  if ( mt_buf.str() != inline_text ) {
+    cerr << "Error: " << prefix << ": output with 4 threads differs" << endl;
+    ++ error_num;
+  }
+
+  // 読み直した回路は元の回路と同じ動作をする．
+  MvnMgr plain_mgr;
+  if ( !read_text("plain.v", plain_text, plain_mgr) ) {
+    cerr << "Error: " << prefix << ": could not read the plain output" << endl
+	 << plain_text;
+    ++ error_num;
+  }
+  else {
+    auto plain_top{find_module(plain_mgr, "top")};
+    if ( plain_top == nullptr ) {
+      cerr << "Error: " << prefix << ": module 'top' is missing" << endl;
+      ++ error_num;
+    }
+    else {
+      compare_sim(prefix + ": plain", mgr, top, plain_mgr, plain_top, seed);
+    }
+  }
+
+  MvnMgr inline_mgr;
+  if ( !read_text("inline.v", inline_text, inline_mgr) ) {
+    cerr << "Error: " << prefix << ": could not read the inlined output" << endl
+	 << inline_text;
+    ++ error_num;
+  }
+  else {
+    auto inline_top{find_module(inline_mgr, "top")};
+    if ( inline_top == nullptr ) {
+      cerr << "Error: " << prefix << ": module 'top' is missing" << endl;
+      ++ error_num;
+    }
+    else {
+      compare_sim(prefix + ": inline", mgr, top, inline_mgr, inline_top, seed);
+    }
+  }
+}
+
+END_NONAMESPACE
+
+END_NAMESPACE_YM
+
+
+int
+main(
+  int argc,
+  const char** argv
+)
+{
+  using namespace std;
+  using namespace nsYm;
+
+  MsgHandler* mh = new StreamMsgHandler(cerr);
+  mh->set_mask(kMsgMaskAll);
+  mh->delete_mask(MsgType::Info);
+  mh->delete_mask(MsgType::Debug);
+  MsgMgr::attach_handler(mh);
+
+  literal_test();
+  for ( SizeType seed = 0; seed < 20; ++ seed ) {
+    vwriter_test(seed);
+  }
+
+  if ( error_num > 0 ) {
+    cerr << error_num << " error(s)" << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}